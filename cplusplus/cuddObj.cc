@@ -82,6 +82,7 @@ public:
     Capsule(unsigned int numVars, unsigned int numVarsZ,
             unsigned int numSlots, unsigned int cacheSize,
             unsigned long maxMemory, PFC defaultHandler);
+    Capsule(DdManager *mgr, Capsule const & from);
     ~Capsule();
 #if HAVE_MODERN_CXX == 1
     Capsule(Capsule const &) = delete;
@@ -122,6 +123,26 @@ Capsule::Capsule(
 } // Capsule::Capsule
 
 
+Capsule::Capsule(
+  DdManager *mgr,
+  Capsule const & from)
+{
+    errorHandler = from.errorHandler;
+    timeoutHandler = from.timeoutHandler;
+    terminationHandler = from.terminationHandler;
+    manager = mgr;
+    for (vector<char *>::const_iterator it = from.varnames.begin();
+         it != from.varnames.end(); ++it) {
+        char * name = new char[strlen(*it) + 1];
+        strcpy(name, *it);
+        varnames.push_back(name);
+    }
+    verbose = from.verbose;
+    ref = 1;
+
+} // Capsule::Capsule
+
+
 Capsule::~Capsule()
 {
 #ifdef DD_DEBUG
@@ -1199,6 +1220,14 @@ Cudd::Cudd(
 } // Cudd::Cudd
 
 
+Cudd::Cudd(
+  Capsule *cap)
+{
+    p = cap;
+
+} // Cudd::Cudd
+
+
 Cudd::Cudd(
   const Cudd& x)
 {
@@ -1608,6 +1637,42 @@ Cudd::bddNewVarAtLevel(
 } // Cudd::bddNewVarAtLevel
 
 
+vector<ADD>
+Cudd::addNewVarsAtLevel(
+  int n,
+  int level) const
+{
+    DdNode **result = new DdNode *[n > 0 ? n : 1];
+    int ok = Cudd_addNewVarsAtLevel(p->manager, n, level, result);
+    vector<ADD> vect;
+    for (int i = 0; ok && i < n; i++) {
+	vect.push_back(ADD(p, result[i]));
+    }
+    delete [] result;
+    checkReturnValue(ok);
+    return vect;
+
+} // Cudd::addNewVarsAtLevel
+
+
+vector<BDD>
+Cudd::bddNewVarsAtLevel(
+  int n,
+  int level) const
+{
+    DdNode **result = new DdNode *[n > 0 ? n : 1];
+    int ok = Cudd_bddNewVarsAtLevel(p->manager, n, level, result);
+    vector<BDD> vect;
+    for (int i = 0; ok && i < n; i++) {
+	vect.push_back(BDD(p, result[i]));
+    }
+    delete [] result;
+    checkReturnValue(ok);
+    return vect;
+
+} // Cudd::bddNewVarsAtLevel
+
+
 void
 Cudd::zddVarsFromBddVars(
   int multiplicity) const
@@ -1950,6 +2015,23 @@ Cudd::SetMaxCacheHard(
 } // Cudd::SetMaxCacheHard
 
 
+int
+Cudd::ReadCachePreservation() const
+{
+    return Cudd_ReadCachePreservation(p->manager);
+
+} // Cudd::ReadCachePreservation
+
+
+void
+Cudd::SetCachePreservation(
+  int preserve) const
+{
+    Cudd_SetCachePreservation(p->manager, preserve);
+
+} // Cudd::SetCachePreservation
+
+
 int
 Cudd::ReadSize() const
 {
@@ -2079,6 +2161,40 @@ Cudd::SetSiftMaxSwap(
 } // Cudd::SetSiftMaxSwap
 
 
+int
+Cudd::ReadTightSifting() const
+{
+    return Cudd_ReadTightSifting(p->manager);
+
+} // Cudd::ReadTightSifting
+
+
+void
+Cudd::SetTightSifting(
+  int enable) const
+{
+    Cudd_SetTightSifting(p->manager, enable);
+
+} // Cudd::SetTightSifting
+
+
+int
+Cudd::ReadIncrementalSiftWindow() const
+{
+    return Cudd_ReadIncrementalSiftWindow(p->manager);
+
+} // Cudd::ReadIncrementalSiftWindow
+
+
+void
+Cudd::SetIncrementalSiftWindow(
+  int window) const
+{
+    Cudd_SetIncrementalSiftWindow(p->manager, window);
+
+} // Cudd::SetIncrementalSiftWindow
+
+
 double
 Cudd::ReadMaxGrowth() const
 {
@@ -2251,6 +2367,30 @@ Cudd::DisableGarbageCollection() const
 } // Cudd::DisableGarbageCollection
 
 
+bool
+Cudd::CompactionEnabled() const
+{
+    return Cudd_CompactionEnabled(p->manager);
+
+} // Cudd::CompactionEnabled
+
+
+void
+Cudd::EnableCompaction() const
+{
+    Cudd_EnableCompaction(p->manager);
+
+} // Cudd::EnableCompaction
+
+
+void
+Cudd::DisableCompaction() const
+{
+    Cudd_DisableCompaction(p->manager);
+
+} // Cudd::DisableCompaction
+
+
 bool
 Cudd::DeadAreCounted() const
 {
@@ -2385,6 +2525,25 @@ Cudd::ReadMemoryInUse() const
 } // Cudd::ReadMemoryInUse
 
 
+void
+Cudd::ReadMemoryBreakdown(
+  DdMemoryBreakdown * info) const
+{
+    Cudd_ReadMemoryBreakdown(p->manager, info);
+
+} // Cudd::ReadMemoryBreakdown
+
+
+void
+Cudd::PrintMemoryBreakdown() const
+{
+    cout.flush();
+    int retval = Cudd_PrintMemoryBreakdown(p->manager,stdout);
+    checkReturnValue(retval);
+
+} // Cudd::PrintMemoryBreakdown
+
+
 long
 Cudd::ReadPeakNodeCount() const
 {
@@ -2393,6 +2552,14 @@ Cudd::ReadPeakNodeCount() const
 } // Cudd::ReadPeakNodeCount
 
 
+long
+Cudd::ReadAllocatedNodeCount() const
+{
+    return Cudd_ReadAllocatedNodeCount(p->manager);
+
+} // Cudd::ReadAllocatedNodeCount
+
+
 long
 Cudd::ReadNodeCount() const
 {
@@ -2579,6 +2746,41 @@ Cudd::SetMaxMemory(size_t maxMem) const
 } // Cudd::SetMaxMemory
 
 
+double
+Cudd::ReadMemoryReleaseThreshold() const
+{
+    return Cudd_ReadMemoryReleaseThreshold(p->manager);
+
+} // Cudd::ReadMemoryReleaseThreshold
+
+
+double
+Cudd::SetMemoryReleaseThreshold(double threshold) const
+{
+    return Cudd_SetMemoryReleaseThreshold(p->manager, threshold);
+
+} // Cudd::SetMemoryReleaseThreshold
+
+
+void
+Cudd::RegisterMemoryPressureHandler(
+  DD_MPHFP handler,
+  void * arg) const
+{
+    Cudd_RegisterMemoryPressureHandler(p->manager, handler, arg);
+
+} // Cudd::RegisterMemoryPressureHandler
+
+
+DD_MPHFP
+Cudd::ReadMemoryPressureHandler(
+  void ** argp) const
+{
+    return Cudd_ReadMemoryPressureHandler(p->manager, argp);
+
+} // Cudd::ReadMemoryPressureHandler
+
+
 int
 Cudd::bddBindVar(int index) const
 {
@@ -5323,6 +5525,100 @@ Cudd::Reserve(
 } // Cudd::Reserve
 
 
+int
+Cudd::Compact() const
+{
+    return Cudd_Compact(p->manager);
+
+} // Cudd::Compact
+
+
+bool
+Cudd::EnableSpill(
+  const char * path) const
+{
+    return Cudd_EnableSpill(p->manager, path);
+
+} // Cudd::EnableSpill
+
+
+int
+Cudd::SpillLevels(
+  int low,
+  int high) const
+{
+    return Cudd_SpillLevels(p->manager, low, high);
+
+} // Cudd::SpillLevels
+
+
+Cudd
+Cudd::Clone(
+  std::vector<BDD> const & roots,
+  std::vector<BDD> & images,
+  bool copyCache) const
+{
+    size_t n = roots.size();
+    DdNode **F = new DdNode *[n];
+    DdNode **G = new DdNode *[n];
+    for (size_t i = 0; i != n; ++i) {
+        if (roots[i].manager() != p->manager)
+            p->errorHandler("Operands come from different manager.");
+        F[i] = roots[i].getNode();
+    }
+    DdManager *mgr = Cudd_CloneManager(p->manager, F, G, (int) n, copyCache);
+    delete [] F;
+    if (mgr == 0) {
+        delete [] G;
+        checkReturnValue(mgr);
+        return *this;
+    }
+    Cudd copy(new Capsule(mgr, *p));
+    images.clear();
+    for (size_t i = 0; i != n; ++i) {
+        // Each image takes over the reference inherited from its root.
+        // The nodes held by other objects stay referenced in the copy.
+        images.push_back(BDD(copy, G[i]));
+        Cudd_Deref(G[i]);
+    }
+    delete [] G;
+    return copy;
+
+} // Cudd::Clone
+
+
+std::vector<BDD>
+Cudd::Transfer(
+  std::vector<BDD> const & roots,
+  Cudd& destination) const
+{
+    size_t n = roots.size();
+    DdNode **F = new DdNode *[n];
+    DdNode **G = new DdNode *[n];
+    for (size_t i = 0; i != n; ++i) {
+        if (roots[i].manager() != p->manager)
+            p->errorHandler("Operands come from different manager.");
+        F[i] = roots[i].getNode();
+    }
+    int result = Cudd_bddTransferVector(p->manager, destination.p->manager,
+                                        F, G, (int) n);
+    delete [] F;
+    if (result == 0) {
+        delete [] G;
+        destination.checkReturnValue(result);
+        return vector<BDD>();
+    }
+    vector<BDD> vect;
+    for (size_t i = 0; i != n; ++i) {
+        Cudd_Deref(G[i]);
+        vect.push_back(BDD(destination.p, G[i]));
+    }
+    delete [] G;
+    return vect;
+
+} // Cudd::Transfer
+
+
 void
 ABDD::PrintMinterm() const
 {
@@ -454,6 +454,7 @@ class Cudd {
     friend std::ostream & operator<<(std::ostream & os, BDD const & f);
 private:
     Capsule *p;
+    Cudd(Capsule *cap);
 public:
     Cudd(
       unsigned int numVars = 0,
@@ -497,6 +498,8 @@ public:
     ZDD zddZero(void) const;
     ADD addNewVarAtLevel(int level) const;
     BDD bddNewVarAtLevel(int level) const;
+    std::vector<ADD> addNewVarsAtLevel(int n, int level) const;
+    std::vector<BDD> bddNewVarsAtLevel(int n, int level) const;
     void zddVarsFromBddVars(int multiplicity) const;
     unsigned long ReadStartTime(void) const;
     unsigned long ReadElapsedTime(void) const;
@@ -538,6 +541,8 @@ public:
     unsigned int ReadMaxCache(void) const;
     unsigned int ReadMaxCacheHard(void) const;
     void SetMaxCacheHard(unsigned int mc) const;
+    int ReadCachePreservation(void) const;
+    void SetCachePreservation(int preserve) const;
     int ReadSize(void) const;
     int ReadZddSize(void) const;
     unsigned int ReadSlots(void) const;
@@ -554,6 +559,10 @@ public:
     void SetSiftMaxVar(int smv) const;
     int ReadSiftMaxSwap(void) const;
     void SetSiftMaxSwap(int sms) const;
+    int ReadTightSifting(void) const;
+    void SetTightSifting(int enable) const;
+    int ReadIncrementalSiftWindow(void) const;
+    void SetIncrementalSiftWindow(int window) const;
     double ReadMaxGrowth(void) const;
     void SetMaxGrowth(double mg) const;
 #ifdef MTR_H_
@@ -580,6 +589,9 @@ public:
     bool GarbageCollectionEnabled(void) const;
     void EnableGarbageCollection(void) const;
     void DisableGarbageCollection(void) const;
+    bool CompactionEnabled(void) const;
+    void EnableCompaction(void) const;
+    void DisableCompaction(void) const;
     bool DeadAreCounted(void) const;
     void TurnOnCountDead(void) const;
     void TurnOffCountDead(void) const;
@@ -596,7 +608,10 @@ public:
     unsigned int ReadOrderRandomization(void) const;
     void SetOrderRandomization(unsigned int factor) const;
     unsigned long ReadMemoryInUse(void) const;
+    void ReadMemoryBreakdown(DdMemoryBreakdown * info) const;
+    void PrintMemoryBreakdown(void) const;
     long ReadPeakNodeCount(void) const;
+    long ReadAllocatedNodeCount(void) const;
     long ReadNodeCount(void) const;
     long zddReadNodeCount(void) const;
     void AddHook(DD_HFP f, Cudd_HookType where) const;
@@ -619,6 +634,10 @@ public:
     void SetMaxLive(unsigned int) const;
     size_t ReadMaxMemory(void) const;
     size_t SetMaxMemory(size_t) const;
+    double ReadMemoryReleaseThreshold(void) const;
+    double SetMemoryReleaseThreshold(double) const;
+    void RegisterMemoryPressureHandler(DD_MPHFP handler, void * arg = 0) const;
+    DD_MPHFP ReadMemoryPressureHandler(void ** argp = 0) const;
     int bddBindVar(int) const;
     int bddUnbindVar(int) const;
     bool bddVarIsBound(int) const;
@@ -675,6 +694,13 @@ public:
     void SymmProfile(int lower, int upper) const;
     unsigned int Prime(unsigned int pr) const;
     void Reserve(int amount) const;
+    int Compact(void) const;
+    bool EnableSpill(const char * path) const;
+    int SpillLevels(int low, int high) const;
+    Cudd Clone(std::vector<BDD> const & roots, std::vector<BDD> & images,
+               bool copyCache = true) const;
+    std::vector<BDD> Transfer(std::vector<BDD> const & roots,
+                              Cudd& destination) const;
     int SharingSize(DD* nodes, int n) const;
     int SharingSize(const std::vector<BDD>& v) const;
     BDD bddComputeCube(BDD * vars, int * phase, int n) const;
@@ -113,7 +113,8 @@ typedef enum {
     CUDD_REORDER_LINEAR,
     CUDD_REORDER_LINEAR_CONVERGE,
     CUDD_REORDER_LAZY_SIFT,
-    CUDD_REORDER_EXACT
+    CUDD_REORDER_EXACT,
+    CUDD_REORDER_SIFT_INCREMENTAL
 } Cudd_ReorderingType;
 
 
@@ -183,6 +184,20 @@ typedef enum {
     CUDD_VAR_NEXT_STATE
 } Cudd_VariableType;
 
+
+/**
+  @brief Type of event reported by reordering telemetry.
+
+  @see DdReorderEvent Cudd_SetReorderingTelemetry
+
+*/
+typedef enum {
+    CUDD_REORDER_EVENT_SIFT,	/**< a %BDD variable (or group) was sifted */
+    CUDD_REORDER_EVENT_ZDD_SIFT,	/**< a %ZDD variable was sifted */
+    CUDD_REORDER_EVENT_GC,	/**< garbage was collected while reordering */
+    CUDD_REORDER_EVENT_CACHE_FLUSH	/**< the cache was flushed for reordering */
+} Cudd_ReorderEventType;
+
 /**
    @brief Type of the value of a terminal node.
 */
@@ -228,6 +243,59 @@ typedef DdApaDigit const * DdConstApaNumber;
 */
 typedef struct DdTlcInfo DdTlcInfo;
 
+/**
+   @brief Record of one reordering event passed to telemetry callbacks.
+
+   @details For sifting events, the sizes are the live nodes before
+   and after the variable was sifted, and swaps is the number of
+   swaps it took.  For garbage collection they are the nodes in the
+   unique table before and after.  Times are in milliseconds.
+*/
+typedef struct DdReorderEvent {
+    Cudd_ReorderEventType type;	/**< kind of event */
+    int index;			/**< variable sifted (-1 for other events) */
+    int startLevel;		/**< level of the variable before sifting */
+    int bestLevel;		/**< level of the variable after sifting */
+    int swaps;			/**< swaps performed */
+    int cutByGrowth;		/**< directions cut short by the growth limit */
+    unsigned int sizeBefore;	/**< size before the event */
+    unsigned int sizeAfter;	/**< size after the event */
+    unsigned long time;		/**< CPU time taken (ms) */
+} DdReorderEvent;
+
+/**
+   @brief Memory used by the parts of a manager.
+
+   @details Sizes are in bytes; the node fields are numbers of nodes.
+   The total is the sum of the byte counts but for the node blocks
+   already released, which are no longer allocated.  It exceeds
+   Cudd_ReadMemoryInUse by the parts that are not charged to the
+   memory in use: node blocks kept in a spill file, hash tables,
+   interaction matrix, stash and reordering state.
+
+   @see Cudd_ReadMemoryBreakdown
+*/
+typedef struct DdMemoryBreakdown {
+    size_t nodeArena;		/**< blocks of nodes */
+    size_t liveNodes;		/**< nodes in use */
+    size_t deadNodes;		/**< dead nodes not yet collected */
+    size_t freeNodes;		/**< node slots on the free list */
+    size_t releasedArena;	/**< node blocks released so far */
+    size_t spillArena;		/**< node blocks kept in the spill file */
+    size_t uniqueTable;		/**< buckets of the unique subtables */
+    size_t variables;		/**< manager, subtables and variable arrays */
+    size_t cache;		/**< computed table */
+    size_t localCaches;		/**< local caches */
+    size_t hashTables;		/**< hash tables of recursive procedures */
+    size_t deathRow;		/**< queue of deferred dereferences */
+    size_t interaction;		/**< interaction matrix and log */
+    size_t linear;		/**< linear transform matrix */
+    size_t stash;		/**< reserve for out-of-memory recovery */
+    size_t reordering;		/**< state kept between reorderings */
+    size_t other;		/**< rest of the memory in use */
+    size_t total;		/**< sum of the byte counts */
+} DdMemoryBreakdown;
+
 /**
    @brief Type of hook function.
 */
@@ -268,6 +336,18 @@ typedef int (*DD_THFP)(const void *);
    @brief Type of timeout handler.
 */
 typedef void (*DD_TOHFP)(DdManager *, void *);
+/**
+   @brief Type of memory pressure handler.
+*/
+typedef void (*DD_MPHFP)(DdManager *, void *);
+/**
+   @brief Type of reordering trigger.
+*/
+typedef int (*DD_RTFP)(DdManager *, void *);
+/**
+   @brief Type of reordering telemetry callback.
+*/
+typedef void (*DD_RECFP)(DdManager *, DdReorderEvent const *, void *);
 
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
@@ -507,6 +587,8 @@ extern DdNode * Cudd_addNewVar(DdManager *dd);
 extern DdNode * Cudd_addNewVarAtLevel(DdManager *dd, int level);
 extern DdNode * Cudd_bddNewVar(DdManager *dd);
 extern DdNode * Cudd_bddNewVarAtLevel(DdManager *dd, int level);
+extern int Cudd_bddNewVarsAtLevel(DdManager *dd, int n, int level, DdNode **vars);
+extern int Cudd_addNewVarsAtLevel(DdManager *dd, int n, int level, DdNode **vars);
 extern int Cudd_bddIsVar(DdManager * dd, DdNode * f);
 extern DdNode * Cudd_addIthVar(DdManager *dd, int i);
 extern DdNode * Cudd_bddIthVar(DdManager *dd, int i);
@@ -535,6 +617,8 @@ extern DD_OOMFP Cudd_RegisterOutOfMemoryCallback(DdManager *unique, DD_OOMFP cal
 extern void Cudd_UnregisterOutOfMemoryCallback(DdManager *unique);
 extern void Cudd_RegisterTimeoutHandler(DdManager *unique, DD_TOHFP handler, void *arg);
 extern DD_TOHFP Cudd_ReadTimeoutHandler(DdManager *unique, void **argp);
+extern void Cudd_RegisterMemoryPressureHandler(DdManager *unique, DD_MPHFP handler, void *arg);
+extern DD_MPHFP Cudd_ReadMemoryPressureHandler(DdManager *unique, void **argp);
 extern void Cudd_AutodynEnable(DdManager *unique, Cudd_ReorderingType method);
 extern void Cudd_AutodynDisable(DdManager *unique);
 extern int Cudd_ReorderingStatus(DdManager *unique, Cudd_ReorderingType *method);
@@ -567,6 +651,8 @@ extern void Cudd_SetLooseUpTo(DdManager *dd, unsigned int lut);
 extern unsigned int Cudd_ReadMaxCache(DdManager *dd);
 extern unsigned int Cudd_ReadMaxCacheHard(DdManager *dd);
 extern void Cudd_SetMaxCacheHard(DdManager *dd, unsigned int mc);
+extern int Cudd_ReadCachePreservation(DdManager *dd);
+extern void Cudd_SetCachePreservation(DdManager *dd, int preserve);
 extern int Cudd_ReadSize(DdManager *dd);
 extern int Cudd_ReadZddSize(DdManager *dd);
 extern unsigned int Cudd_ReadSlots(DdManager *dd);
@@ -589,6 +675,15 @@ extern int Cudd_ReadSiftMaxVar(DdManager *dd);
 extern void Cudd_SetSiftMaxVar(DdManager *dd, int smv);
 extern int Cudd_ReadSiftMaxSwap(DdManager *dd);
 extern void Cudd_SetSiftMaxSwap(DdManager *dd, int sms);
+extern int Cudd_ReadTightSifting(DdManager *dd);
+extern void Cudd_SetTightSifting(DdManager *dd, int enable);
+extern int Cudd_ReadIncrementalSiftWindow(DdManager *dd);
+extern void Cudd_SetIncrementalSiftWindow(DdManager *dd, int window);
+extern unsigned long Cudd_ReadReorderingDeadline(DdManager *dd);
+extern void Cudd_SetReorderingDeadline(DdManager *dd, unsigned long deadline);
+extern int Cudd_ReadReorderingMaxSwaps(DdManager *dd);
+extern void Cudd_SetReorderingMaxSwaps(DdManager *dd, int swaps);
+extern int Cudd_ReadReorderingCoverage(DdManager *dd, int *sifted, int *pending);
 extern double Cudd_ReadMaxGrowth(DdManager *dd);
 extern void Cudd_SetMaxGrowth(DdManager *dd, double mg);
 extern double Cudd_ReadMaxGrowthAlternate(DdManager * dd);
@@ -608,6 +703,9 @@ extern void Cudd_SetGroupcheck(DdManager *dd, Cudd_AggregationType gc);
 extern int Cudd_GarbageCollectionEnabled(DdManager *dd);
 extern void Cudd_EnableGarbageCollection(DdManager *dd);
 extern void Cudd_DisableGarbageCollection(DdManager *dd);
+extern int Cudd_CompactionEnabled(DdManager *dd);
+extern void Cudd_EnableCompaction(DdManager *dd);
+extern void Cudd_DisableCompaction(DdManager *dd);
 extern int Cudd_DeadAreCounted(DdManager *dd);
 extern void Cudd_TurnOnCountDead(DdManager *dd);
 extern void Cudd_TurnOffCountDead(DdManager *dd);
@@ -621,11 +719,16 @@ extern int Cudd_ReadPopulationSize(DdManager *dd);
 extern void Cudd_SetPopulationSize(DdManager *dd, int populationSize);
 extern int Cudd_ReadNumberXovers(DdManager *dd);
 extern void Cudd_SetNumberXovers(DdManager *dd, int numberXovers);
+extern int Cudd_ReadReorderingThreads(DdManager *dd);
+extern void Cudd_SetReorderingThreads(DdManager *dd, int threads);
 extern unsigned int Cudd_ReadOrderRandomization(DdManager * dd);
 extern void Cudd_SetOrderRandomization(DdManager * dd, unsigned int factor);
 extern size_t Cudd_ReadMemoryInUse(DdManager *dd);
+extern void Cudd_ReadMemoryBreakdown(DdManager *dd, DdMemoryBreakdown *info);
+extern int Cudd_PrintMemoryBreakdown(DdManager *dd, FILE *fp);
 extern int Cudd_PrintInfo(DdManager *dd, FILE *fp);
 extern long Cudd_ReadPeakNodeCount(DdManager *dd);
+extern long Cudd_ReadAllocatedNodeCount(DdManager *dd);
 extern int Cudd_ReadPeakLiveNodeCount(DdManager * dd);
 extern long Cudd_ReadNodeCount(DdManager *dd);
 extern long Cudd_zddReadNodeCount(DdManager *dd);
@@ -652,11 +755,23 @@ extern FILE * Cudd_ReadStderr(DdManager *dd);
 extern void Cudd_SetStderr(DdManager *dd, FILE *fp);
 extern unsigned int Cudd_ReadNextReordering(DdManager *dd);
 extern void Cudd_SetNextReordering(DdManager *dd, unsigned int next);
+extern void Cudd_SetReorderingTrigger(DdManager *dd, DD_RTFP trigger, void *arg);
+extern DD_RTFP Cudd_ReadReorderingTrigger(DdManager *dd, void **argp);
+extern double Cudd_ReadRecentCacheHitRate(DdManager *dd);
+extern double Cudd_ReadRecentThroughput(DdManager *dd);
+extern double Cudd_ReadRecentGrowth(DdManager *dd);
+extern double Cudd_ReadReorderingPayoff(DdManager *dd);
+extern double Cudd_ReadReorderingCostShare(DdManager *dd);
+extern void Cudd_SetReorderingTelemetry(DdManager *dd, DD_RECFP callback, void *arg);
+extern DD_RECFP Cudd_ReadReorderingTelemetry(DdManager *dd, void **argp);
+extern int Cudd_PrintReorderingSummary(DdManager *dd, FILE *fp);
 extern double Cudd_ReadSwapSteps(DdManager *dd);
 extern unsigned int Cudd_ReadMaxLive(DdManager *dd);
 extern void Cudd_SetMaxLive(DdManager *dd, unsigned int maxLive);
 extern size_t Cudd_ReadMaxMemory(DdManager *dd);
 extern size_t Cudd_SetMaxMemory(DdManager *dd, size_t maxMemory);
+extern double Cudd_ReadMemoryReleaseThreshold(DdManager *dd);
+extern double Cudd_SetMemoryReleaseThreshold(DdManager *dd, double threshold);
 extern int Cudd_bddBindVar(DdManager *dd, int index);
 extern int Cudd_bddUnbindVar(DdManager *dd, int index);
 extern int Cudd_bddVarIsBound(DdManager *dd, int index);
@@ -753,8 +868,15 @@ extern DdNode * Cudd_addBddIthBit(DdManager *dd, DdNode *f, int bit);
 extern DdNode * Cudd_BddToAdd(DdManager *dd, DdNode *B);
 extern DdNode * Cudd_addBddPattern(DdManager *dd, DdNode *f);
 extern DdNode * Cudd_bddTransfer(DdManager *ddSource, DdManager *ddDestination, DdNode *f);
+extern int Cudd_bddTransferVector(DdManager *ddSource, DdManager *ddDestination, DdNode * const *F, DdNode **G, int n);
 extern int Cudd_DebugCheck(DdManager *table);
 extern int Cudd_CheckKeys(DdManager *table);
+extern int Cudd_Checkpoint(DdManager *dd, char const *path, char const * const *inames);
+extern DdManager * Cudd_Restore(char const *path, char ***inames, DdNode ***roots, int *nroots);
+extern int Cudd_SaveOrder(DdManager *dd, FILE *fp, char const * const *varnames);
+extern int Cudd_LoadOrder(DdManager *dd, FILE *fp, char const * const *varnames, int *matched);
+extern int Cudd_EnableSpill(DdManager *dd, char const *path);
+extern int Cudd_SpillLevels(DdManager *dd, int low, int high);
 extern DdNode * Cudd_bddClippingAnd(DdManager *dd, DdNode *f, DdNode *g, int maxDepth, int direction);
 extern DdNode * Cudd_bddClippingAndAbstract(DdManager *dd, DdNode *f, DdNode *g, DdNode *cube, int maxDepth, int direction);
 extern DdNode * Cudd_Cofactor(DdManager *dd, DdNode *f, DdNode *g);
@@ -810,6 +932,7 @@ extern DdNode * Cudd_SupersetCompress(DdManager *dd, DdNode *f, int nvars, int t
 extern int Cudd_addHarwell(FILE *fp, DdManager *dd, DdNode **E, DdNode ***x, DdNode ***y, DdNode ***xn, DdNode ***yn_, int *nx, int *ny, int *m, int *n, int bx, int sx, int by, int sy, int pr);
 extern DdManager * Cudd_Init(unsigned int numVars, unsigned int numVarsZ, unsigned int numSlots, unsigned int cacheSize, size_t maxMemory);
 extern void Cudd_Quit(DdManager *unique);
+extern DdManager * Cudd_CloneManager(DdManager *dd, DdNode * const *roots, DdNode **images, int n, int copyCache);
 extern int Cudd_PrintLinear(DdManager *table);
 extern int Cudd_ReadLinear(DdManager *table, int x, int y);
 extern DdNode * Cudd_bddLiteralSetIntersection(DdManager *dd, DdNode *f, DdNode *g);
@@ -841,6 +964,7 @@ extern void Cudd_Deref(DdNode *node);
 extern int Cudd_CheckZeroRef(DdManager *manager);
 extern int Cudd_ReduceHeap(DdManager *table, Cudd_ReorderingType heuristic, int minsize);
 extern int Cudd_ShuffleHeap(DdManager *table, int *permutation);
+extern int Cudd_AdaptiveReorderingTrigger(DdManager *dd, void *arg);
 extern DdNode * Cudd_Eval(DdManager *dd, DdNode *f, int *inputs);
 extern DdNode * Cudd_ShortestPath(DdManager *manager, DdNode *f, int *weight, int *support, int *length);
 extern DdNode * Cudd_LargestCube(DdManager *manager, DdNode *f, int *length);
@@ -864,6 +988,7 @@ extern DdNode * Cudd_SupersetShortPaths(DdManager *dd, DdNode *f, int numVars, i
 extern void Cudd_SymmProfile(DdManager *table, int lower, int upper);
 extern unsigned int Cudd_Prime(unsigned int p);
 extern int Cudd_Reserve(DdManager *manager, int amount);
+extern int Cudd_Compact(DdManager *unique);
 extern int Cudd_PrintMinterm(DdManager *manager, DdNode *node);
 extern int Cudd_bddPrintCover(DdManager *dd, DdNode *l, DdNode *u);
 extern int Cudd_PrintDebug(DdManager *dd, DdNode *f, int n, int pr);
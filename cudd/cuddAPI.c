@@ -135,6 +135,7 @@ Cudd_addNewVar(
   @sideeffect None
 
   @see Cudd_addNewVar Cudd_addIthVar Cudd_bddNewVarAtLevel
+  Cudd_addNewVarsAtLevel
 
 */
 DdNode *
@@ -204,6 +205,7 @@ Cudd_bddNewVar(
   @sideeffect None
 
   @see Cudd_bddNewVar Cudd_bddIthVar Cudd_addNewVarAtLevel
+  Cudd_bddNewVarsAtLevel
 
 */
 DdNode *
@@ -226,6 +228,114 @@ Cudd_bddNewVarAtLevel(
 } /* end of Cudd_bddNewVarAtLevel */
 
 
+/**
+  @brief Returns n new %BDD variables at a specified level.
+
+  @details The new variables have consecutive indices starting from
+  the largest previous index plus 1, and are positioned at levels
+  level, level+1, ..., level+n-1 in the order.  If level is not an
+  existing level, the variables are appended after the last level.
+  Creating the variables in one call moves the existing subtables
+  only once, which is much faster than calling Cudd_bddNewVarAtLevel
+  n times when many variables are inserted in the middle of the
+  order.  If vars is not NULL, the projection functions of the new
+  variables are stored in vars[0], ..., vars[n-1].
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect The array vars is filled if it is not NULL.
+
+  @see Cudd_bddNewVarAtLevel Cudd_addNewVarsAtLevel
+
+*/
+int
+Cudd_bddNewVarsAtLevel(
+  DdManager * dd,
+  int  n,
+  int  level,
+  DdNode ** vars)
+{
+    int i, first;
+
+    if (n <= 0 || level < 0 ||
+	(unsigned int) dd->size + n >= CUDD_MAXINDEX - 1) {
+        dd->errorCode = CUDD_INVALID_ARG;
+        return(0);
+    }
+    first = dd->size;
+    if (level >= dd->size) {
+	if (Cudd_bddIthVar(dd,first + n - 1) == NULL) return(0);
+    } else {
+	if (!cuddInsertSubtables(dd,n,level)) return(0);
+    }
+    if (vars != NULL) {
+	for (i = 0; i < n; i++) {
+	    vars[i] = dd->vars[first + i];
+	}
+    }
+
+    return(1);
+
+} /* end of Cudd_bddNewVarsAtLevel */
+
+
+/**
+  @brief Returns n new %ADD variables at a specified level.
+
+  @details The new variables have consecutive indices starting from
+  the largest previous index plus 1, and are positioned at levels
+  level, level+1, ..., level+n-1 in the order.  If level is not an
+  existing level, the variables are appended after the last level.
+  If vars is not NULL, the new %ADD variables are stored in vars[0],
+  ..., vars[n-1].
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect The array vars is filled if it is not NULL.
+
+  @see Cudd_addNewVarAtLevel Cudd_bddNewVarsAtLevel
+
+*/
+int
+Cudd_addNewVarsAtLevel(
+  DdManager * dd,
+  int  n,
+  int  level,
+  DdNode ** vars)
+{
+    int i, first;
+    DdNode *res;
+
+    first = dd->size;
+    if (!Cudd_bddNewVarsAtLevel(dd,n,level,NULL)) return(0);
+    if (vars == NULL) return(1);
+    for (i = 0; i < n; i++) {
+	do {
+	    dd->reordered = 0;
+	    res = cuddUniqueInter(dd,first + i,DD_ONE(dd),DD_ZERO(dd));
+	} while (dd->reordered == 1);
+	if (res == NULL) {
+	    while (i > 0) {
+		i--;
+		Cudd_RecursiveDeref(dd,vars[i]);
+	    }
+	    if (dd->errorCode == CUDD_TIMEOUT_EXPIRED && dd->timeoutHandler) {
+		dd->timeoutHandler(dd, dd->tohArg);
+	    }
+	    return(0);
+	}
+	cuddRef(res);
+	vars[i] = res;
+    }
+    for (i = 0; i < n; i++) {
+	cuddDeref(vars[i]);
+    }
+
+    return(1);
+
+} /* end of Cudd_addNewVarsAtLevel */
+
+
 /**
   @brief Returns 1 if the given node is a %BDD variable; 0 otherwise.
 
@@ -972,6 +1082,56 @@ Cudd_ReadTimeoutHandler(
 } /* end of Cudd_ReadTimeoutHandler */
 
 
+/**
+  @brief Registers a memory pressure handler.
+
+  @details When a new block of nodes would take the memory in use
+  past the hard limit set with Cudd_SetMaxMemory, the package first
+  collects garbage, releases the empty node blocks, and shrinks the
+  computed table and the sparse subtables of the unique table.  If
+  that is not enough, it calls the handler, which may dereference the
+  diagrams the application can recompute (it must not create new
+  ones), and collects garbage again.  Only if the memory in use is
+  still above the limit does the operation fail with
+  CUDD_MAX_MEM_EXCEEDED.  To unregister a handler, register a NULL
+  pointer.
+
+  @sideeffect None
+
+  @see Cudd_ReadMemoryPressureHandler Cudd_SetMaxMemory
+*/
+void
+Cudd_RegisterMemoryPressureHandler(
+  DdManager *unique,
+  DD_MPHFP handler,
+  void *arg)
+{
+    unique->pressureHandler = handler;
+    unique->mphArg = arg;
+
+} /* end of Cudd_RegisterMemoryPressureHandler */
+
+
+/**
+  @brief Reads the current memory pressure handler.
+
+  @sideeffect If argp is non-null, the second argument to
+  the handler is written to the location it points to.
+
+  @see Cudd_RegisterMemoryPressureHandler
+*/
+DD_MPHFP
+Cudd_ReadMemoryPressureHandler(
+  DdManager *unique,
+  void **argp)
+{
+    if (argp != NULL)
+        *argp = unique->mphArg;
+    return unique->pressureHandler;
+
+} /* end of Cudd_ReadMemoryPressureHandler */
+
+
 /**
   @brief Enables automatic dynamic reordering of BDDs and ADDs.
 
@@ -998,6 +1158,7 @@ Cudd_AutodynEnable(
     ** invocations. Hence, we shrink the death row to just one entry.
     */
     cuddClearDeathRow(unique);
+    unique->memused -= (unique->deathRowDepth - 1) * sizeof(DdNodePtr);
     unique->deathRowDepth = 1;
     unique->deadMask = unique->deathRowDepth - 1;
     if ((unsigned) unique->nextDead > unique->deadMask) {
@@ -1682,6 +1843,57 @@ Cudd_SetMaxCacheHard(
 } /* end of Cudd_SetMaxCacheHard */
 
 
+/**
+  @brief Tells whether the cache is preserved across reordering.
+
+  @return 1 if valid cache entries survive reordering; 0 if the cache
+  is cleared.
+
+  @sideeffect None
+
+  @see Cudd_SetCachePreservation
+
+*/
+int
+Cudd_ReadCachePreservation(
+  DdManager * dd)
+{
+    return(dd->preserveCache);
+
+} /* end of Cudd_ReadCachePreservation */
+
+
+/**
+  @brief Sets whether the cache is preserved across reordering.
+
+  @details By default, reordering clears the cache.  If preservation
+  is enabled, reordering only removes the entries that refer to nodes
+  freed in the process; the others remain valid, because every node
+  that stays alive keeps its function.  This saves recomputation
+  right after reordering, at the cost of a filter of the nodes
+  appearing in the cache while reordering is in progress.  Results of
+  operations that depend on the variable order (e.g., Cudd_bddConstrain,
+  Cudd_bddRestrict, and the approximation functions) may then be
+  those computed under the previous order; they still satisfy the
+  specification of those operations.  Linear sifting, and reordering
+  with realignment of the %BDD and %ZDD orders, always clear the
+  cache.
+
+  @sideeffect None
+
+  @see Cudd_ReadCachePreservation Cudd_ReduceHeap
+
+*/
+void
+Cudd_SetCachePreservation(
+  DdManager * dd,
+  int preserve)
+{
+    dd->preserveCache = preserve != 0;
+
+} /* end of Cudd_SetCachePreservation */
+
+
 /**
   @brief Returns the number of %BDD variables in existance.
 
@@ -2229,6 +2441,226 @@ Cudd_SetSiftMaxSwap(
 } /* end of Cudd_SetSiftMaxSwap */
 
 
+/**
+  @brief Tells whether tight sifting is enabled.
+
+  @return 1 if tight sifting is enabled; 0 otherwise.
+
+  @sideeffect None
+
+  @see Cudd_SetTightSifting
+
+*/
+int
+Cudd_ReadTightSifting(
+  DdManager * dd)
+{
+    return(dd->siftTight);
+
+} /* end of Cudd_ReadTightSifting */
+
+
+/**
+  @brief Enables or disables tight sifting.
+
+  @details Sifting stops moving a variable in one direction when a
+  lower bound on the size of the %DD heap, computed from the
+  interaction matrix, shows that no further improvement is possible.
+  Tight sifting strengthens the bound by noting that one node of each
+  variable survives reordering, because reordering does not change
+  the support of the functions.  It also considers the variables in
+  decreasing order of the largest decrease in size that the bounds
+  allow, instead of in decreasing order of the number of nodes labeled
+  by them, and skips the variables that cannot decrease the size at
+  their current position.  On problems with many variables that
+  interact with few others, this saves most of the swaps, and
+  concentrates those allowed by siftMaxVar and siftMaxSwap where they
+  can pay off.  The results may differ from those of regular sifting
+  when several positions of a variable give the same size.  This
+  affects plain sifting (CUDD_REORDER_SIFT and
+  CUDD_REORDER_SIFT_CONVERGE) and the methods that use it as a step,
+  but not symmetric, group, or linear sifting.
+
+  @sideeffect None
+
+  @see Cudd_ReadTightSifting Cudd_SetSiftMaxVar Cudd_SetSiftMaxSwap
+
+*/
+void
+Cudd_SetTightSifting(
+  DdManager * dd,
+  int  enable)
+{
+    dd->siftTight = enable != 0;
+
+} /* end of Cudd_SetTightSifting */
+
+
+/**
+  @brief Reads the window of incremental sifting.
+
+  @return the number of levels by which incremental sifting may move a
+  variable in either direction, or 0 if there is no limit.
+
+  @sideeffect None
+
+  @see Cudd_SetIncrementalSiftWindow
+
+*/
+int
+Cudd_ReadIncrementalSiftWindow(
+  DdManager * dd)
+{
+    return(dd->siftWindow);
+
+} /* end of Cudd_ReadIncrementalSiftWindow */
+
+
+/**
+  @brief Sets the window of incremental sifting.
+
+  @details Incremental sifting (CUDD_REORDER_SIFT_INCREMENTAL) only
+  sifts the variables whose number of nodes grew most since the last
+  reordering, and moves each of them by at most window levels up or
+  down from its position.  A value of 0 or less lets the variables
+  move over the whole range, as in regular sifting.  The default is
+  16.
+
+  @sideeffect None
+
+  @see Cudd_ReadIncrementalSiftWindow Cudd_SetSiftMaxVar
+
+*/
+void
+Cudd_SetIncrementalSiftWindow(
+  DdManager * dd,
+  int  window)
+{
+    dd->siftWindow = window > 0 ? window : 0;
+
+} /* end of Cudd_SetIncrementalSiftWindow */
+
+
+/**
+  @brief Reads the real time allowed for each reordering.
+
+  @return the time in milliseconds; 0 if there is no limit.
+
+  @sideeffect None
+
+  @see Cudd_SetReorderingDeadline Cudd_ReadReorderingCoverage
+
+*/
+unsigned long
+Cudd_ReadReorderingDeadline(
+  DdManager * dd)
+{
+    return(dd->reordDeadline);
+
+} /* end of Cudd_ReadReorderingDeadline */
+
+
+/**
+  @brief Sets the real time allowed for each reordering.
+
+  @details When a call to Cudd_ReduceHeap has run for this many
+  milliseconds, sifting stops, leaving the variable being sifted at
+  the best position seen so far.  Unlike the time limit set with
+  Cudd_SetTimeLimit, this does not abort the current operation nor
+  disable further reordering: the variables that were not sifted are
+  sifted first by the next reordering.  A value of 0 removes the
+  limit.
+
+  @sideeffect None
+
+  @see Cudd_ReadReorderingDeadline Cudd_SetReorderingMaxSwaps
+
+*/
+void
+Cudd_SetReorderingDeadline(
+  DdManager * dd,
+  unsigned long deadline)
+{
+    dd->reordDeadline = deadline;
+
+} /* end of Cudd_SetReorderingDeadline */
+
+
+/**
+  @brief Reads the number of swaps allowed for each reordering.
+
+  @return the number of swaps; 0 if there is no limit.
+
+  @sideeffect None
+
+  @see Cudd_SetReorderingMaxSwaps Cudd_ReadReorderingCoverage
+
+*/
+int
+Cudd_ReadReorderingMaxSwaps(
+  DdManager * dd)
+{
+    return(dd->reordMaxSwaps);
+
+} /* end of Cudd_ReadReorderingMaxSwaps */
+
+
+/**
+  @brief Sets the number of swaps allowed for each reordering.
+
+  @details Differs from the siftMaxSwap parameter in that sifting
+  stops as soon as the limit is reached, even in the middle of the
+  sifting of a variable, which is then moved back to the best
+  position seen so far.  The variables that were not sifted are sifted
+  first by the next reordering.  A value of 0 removes the limit.
+
+  @sideeffect None
+
+  @see Cudd_ReadReorderingMaxSwaps Cudd_SetReorderingDeadline
+  Cudd_SetSiftMaxSwap
+
+*/
+void
+Cudd_SetReorderingMaxSwaps(
+  DdManager * dd,
+  int  swaps)
+{
+    dd->reordMaxSwaps = swaps;
+
+} /* end of Cudd_SetReorderingMaxSwaps */
+
+
+/**
+  @brief Reports how much of the variable set the last reordering
+  covered.
+
+  @details Only sifting keeps track of the variables it sifts.  If
+  sifted is not NULL, it receives the number of variables sifted by
+  the last reordering; if pending is not NULL, it receives the number
+  of variables that it left out because its budget was exhausted.
+  These will be sifted first by the next reordering.
+
+  @return 1 if the last reordering was interrupted by its budget; 0
+  otherwise.
+
+  @sideeffect None
+
+  @see Cudd_SetReorderingDeadline Cudd_SetReorderingMaxSwaps
+
+*/
+int
+Cudd_ReadReorderingCoverage(
+  DdManager * dd,
+  int * sifted,
+  int * pending)
+{
+    if (sifted != NULL) *sifted = dd->siftedVars;
+    if (pending != NULL) *pending = dd->siftNPending;
+    return(dd->reordInterrupted);
+
+} /* end of Cudd_ReadReorderingCoverage */
+
+
 /**
   @brief Reads the maxGrowth parameter of the manager.
 
@@ -2778,72 +3210,132 @@ Cudd_DisableGarbageCollection(
 
 
 /**
-  @brief Tells whether dead nodes are counted towards triggering
-  reordering.
+  @brief Tells whether the heap is compacted after reordering.
 
-  @return 1 if dead nodes are counted; 0 otherwise.
+  @return 1 if compaction after reordering is enabled; 0 otherwise.
 
   @sideeffect None
 
-  @see Cudd_TurnOnCountDead Cudd_TurnOffCountDead
+  @see Cudd_EnableCompaction Cudd_DisableCompaction
 
 */
 int
-Cudd_DeadAreCounted(
+Cudd_CompactionEnabled(
   DdManager * dd)
 {
-    return(dd->countDead == 0 ? 1 : 0);
+    return(dd->autoCompact);
 
-} /* end of Cudd_DeadAreCounted */
+} /* end of Cudd_CompactionEnabled */
 
 
 /**
-  @brief Causes the dead nodes to be counted towards triggering
-  reordering.
+  @brief Enables compaction of the heap after reordering.
 
-  @details This causes more frequent reorderings. By default dead
-  nodes are not counted.
+  @details Once enabled, Cudd_Compact is called at the end of each
+  reordering, including those triggered by dynamic reordering, to
+  restore the locality of the nodes that reordering scatters.  This
+  is only safe if the application references every node it keeps a
+  pointer to, including the arguments of the operations that may
+  trigger reordering.  Compaction is initially disabled.
 
-  @sideeffect Changes the manager.
+  @sideeffect None
 
-  @see Cudd_TurnOffCountDead Cudd_DeadAreCounted
+  @see Cudd_DisableCompaction Cudd_CompactionEnabled Cudd_Compact
 
 */
 void
-Cudd_TurnOnCountDead(
+Cudd_EnableCompaction(
   DdManager * dd)
 {
-    dd->countDead = 0;
+    dd->autoCompact = 1;
 
-} /* end of Cudd_TurnOnCountDead */
+} /* end of Cudd_EnableCompaction */
 
 
 /**
-  @brief Causes the dead nodes not to be counted towards triggering
-  reordering.
-
-  @details This causes less frequent reorderings. By default dead
-  nodes are not counted. Therefore there is no need to call this
-  function unless Cudd_TurnOnCountDead has been previously called.
+  @brief Disables compaction of the heap after reordering.
 
-  @sideeffect Changes the manager.
+  @sideeffect None
 
-  @see Cudd_TurnOnCountDead Cudd_DeadAreCounted
+  @see Cudd_EnableCompaction Cudd_CompactionEnabled
 
 */
 void
-Cudd_TurnOffCountDead(
+Cudd_DisableCompaction(
   DdManager * dd)
 {
-    dd->countDead = ~0U;
+    dd->autoCompact = 0;
 
-} /* end of Cudd_TurnOffCountDead */
+} /* end of Cudd_DisableCompaction */
 
 
 /**
-  @brief Returns the current value of the recombination parameter used
-  in group sifting.
-
+  @brief Tells whether dead nodes are counted towards triggering
+  reordering.
+
+  @return 1 if dead nodes are counted; 0 otherwise.
+
+  @sideeffect None
+
+  @see Cudd_TurnOnCountDead Cudd_TurnOffCountDead
+
+*/
+int
+Cudd_DeadAreCounted(
+  DdManager * dd)
+{
+    return(dd->countDead == 0 ? 1 : 0);
+
+} /* end of Cudd_DeadAreCounted */
+
+
+/**
+  @brief Causes the dead nodes to be counted towards triggering
+  reordering.
+
+  @details This causes more frequent reorderings. By default dead
+  nodes are not counted.
+
+  @sideeffect Changes the manager.
+
+  @see Cudd_TurnOffCountDead Cudd_DeadAreCounted
+
+*/
+void
+Cudd_TurnOnCountDead(
+  DdManager * dd)
+{
+    dd->countDead = 0;
+
+} /* end of Cudd_TurnOnCountDead */
+
+
+/**
+  @brief Causes the dead nodes not to be counted towards triggering
+  reordering.
+
+  @details This causes less frequent reorderings. By default dead
+  nodes are not counted. Therefore there is no need to call this
+  function unless Cudd_TurnOnCountDead has been previously called.
+
+  @sideeffect Changes the manager.
+
+  @see Cudd_TurnOnCountDead Cudd_DeadAreCounted
+
+*/
+void
+Cudd_TurnOffCountDead(
+  DdManager * dd)
+{
+    dd->countDead = ~0U;
+
+} /* end of Cudd_TurnOffCountDead */
+
+
+/**
+  @brief Returns the current value of the recombination parameter used
+  in group sifting.
+
   @details A larger (positive) value makes the aggregation of
   variables due to the second difference criterion more likely. A
   smaller (negative) value makes aggregation less likely.
@@ -3082,6 +3574,66 @@ Cudd_SetNumberXovers(
 } /* end of Cudd_SetNumberXovers */
 
 
+/**
+  @brief Reads the number of threads used by the genetic algorithm,
+  by simulated annealing, and by exact reordering.
+
+  @details With more than one thread, the genetic algorithm evaluates
+  the members of its population in parallel, and simulated annealing
+  runs one chain per thread at different temperatures (parallel
+  tempering), and exact reordering expands the subsets of variables
+  of each size in parallel.  Each thread works on its own copy of the
+  heap.  The default value is 1, in which case the algorithms run in
+  the calling thread on the heap itself.  The setting has no effect if the package
+  is compiled without thread support.
+
+  @sideeffect None
+
+  @see Cudd_SetReorderingThreads
+
+*/
+int
+Cudd_ReadReorderingThreads(
+  DdManager * dd)
+{
+    return(dd->reordThreads);
+
+} /* end of Cudd_ReadReorderingThreads */
+
+
+/**
+  @brief Sets the number of threads used by the genetic algorithm,
+  by simulated annealing, and by exact reordering.
+
+  @details Values less than 1 are treated as 1.  Since each thread
+  works on its own copy of the heap, memory use grows with the number
+  of threads.  The expected speedup on as many cores as threads,
+  estimated from the CPU time of the longest thread of each parallel
+  step, is 1.9 to 2 with 2 threads and 3.3 to 3.8 with 4 threads for
+  exact reordering (random functions of 14 and 16 variables), and 1.5
+  to 1.8 with 2 threads and 2.7 to 3.1 with 4 threads for the genetic
+  algorithm (s641 and mult32a from nanotrav), where the copies of the
+  heap make the evaluation of each order somewhat slower.  Simulated
+  annealing does not get faster: each additional thread runs one more
+  chain, the run lasts as long as the slowest chain (1.1 to 4.4 times
+  a single chain on the same benchmarks), and the extra chains are
+  meant to find better orders.
+
+  @sideeffect None
+
+  @see Cudd_ReadReorderingThreads
+
+*/
+void
+Cudd_SetReorderingThreads(
+  DdManager * dd,
+  int  threads)
+{
+    dd->reordThreads = threads < 1 ? 1 : threads;
+
+} /* end of Cudd_SetReorderingThreads */
+
+
 /**
   @brief Returns the order randomization factor.
 
@@ -3136,6 +3688,146 @@ Cudd_ReadMemoryInUse(
 } /* end of Cudd_ReadMemoryInUse */
 
 
+/**
+  @brief Reports where the memory of the manager goes.
+
+  @details Fills info with the memory taken by the node blocks, the
+  unique table, the computed table, the local caches and hash tables,
+  the death row, the interaction and linear transform matrices, the
+  stash, and the arrays kept per variable, together with the numbers
+  of live, dead and free nodes.  The memory in use that is not
+  attributed to any of these parts is reported as other.  The
+  breakdown is computed from the data structures; it does not change
+  the manager.
+
+  @sideeffect info is filled
+
+  @see Cudd_ReadMemoryInUse Cudd_PrintMemoryBreakdown
+
+*/
+void
+Cudd_ReadMemoryBreakdown(
+  DdManager * dd,
+  DdMemoryBreakdown * info)
+{
+    DdNodePtr *block;
+    DdLocalCache *cache;
+    size_t slots, spilled, charged;
+    int i;
+
+    slots = 0;
+    spilled = 0;
+    for (block = dd->memoryList; block != NULL;
+	 block = (DdNodePtr *) block[0]) {
+	slots += DD_MEM_CHUNK;
+	spilled += cuddSpillOwns(dd,block);
+    }
+    info->nodeArena = (slots / DD_MEM_CHUNK - spilled) * (DD_MEM_CHUNK + 1) *
+	sizeof(DdNode);
+    info->spillArena = dd->spill != NULL ? spilled * dd->spill->blockSize : 0;
+    info->liveNodes = (size_t) (dd->keys - dd->dead) +
+	(size_t) (dd->keysZ - dd->deadZ);
+    info->deadNodes = (size_t) dd->dead + (size_t) dd->deadZ;
+    info->freeNodes = slots - (size_t) dd->keys - (size_t) dd->keysZ;
+    info->releasedArena = (size_t) dd->releasedBlocks *
+	(DD_MEM_CHUNK + 1) * sizeof(DdNode);
+
+    slots = dd->constants.slots;
+    for (i = 0; i < dd->size; i++) slots += dd->subtables[i].slots;
+    for (i = 0; i < dd->sizeZ; i++) slots += dd->subtableZ[i].slots;
+    info->uniqueTable = slots * sizeof(DdNodePtr);
+    info->variables = sizeof(DdManager) +
+	(size_t) (dd->maxSize + dd->maxSizeZ) *
+	(sizeof(DdSubtable) + 2 * sizeof(int)) +
+	(size_t) dd->maxSize * sizeof(DdNodePtr) +
+	(size_t) (ddMax(dd->maxSize,dd->maxSizeZ) + 1) * sizeof(DdNodePtr);
+    if (dd->map != NULL) info->variables += dd->maxSize * sizeof(int);
+
+    info->cache = (dd->cacheSlots + 1) * sizeof(DdCache);
+    if (dd->cacheFilter != NULL) {
+	info->cache += (1U << (32 - dd->cacheFilterShift)) / 8;
+    }
+    info->localCaches = 0;
+    for (cache = dd->localCaches; cache != NULL; cache = cache->next) {
+	info->localCaches += sizeof(DdLocalCache) +
+	    (size_t) cache->slots * cache->itemsize;
+    }
+    info->hashTables = dd->hashMemused;
+#ifndef DD_NO_DEATH_ROW
+    info->deathRow = dd->deathRowDepth * sizeof(DdNodePtr);
+#else
+    info->deathRow = 0;
+#endif
+    info->interaction = cuddInteractMemory(dd);
+    info->linear = 0;
+    if (dd->linear != NULL) {
+	info->linear = (size_t) ((dd->linearSize - 1) /
+				 (sizeof(ptruint) * 8) + 1) *
+	    dd->linearSize * sizeof(ptruint);
+    }
+    info->stash = dd->stash != NULL ? dd->stashSize : 0;
+    info->reordering = (size_t) dd->reordKeysSize * sizeof(unsigned int);
+
+    charged = info->nodeArena + info->uniqueTable + info->variables +
+	info->cache + info->localCaches + info->deathRow + info->linear;
+    info->other = dd->memused > charged ? dd->memused - charged : 0;
+    info->total = charged + info->other + info->spillArena +
+	info->hashTables + info->interaction + info->stash + info->reordering;
+
+} /* end of Cudd_ReadMemoryBreakdown */
+
+
+/**
+  @brief Prints the breakdown of the memory used by the manager.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+  @see Cudd_ReadMemoryBreakdown Cudd_PrintInfo
+
+*/
+int
+Cudd_PrintMemoryBreakdown(
+  DdManager * dd,
+  FILE * fp)
+{
+    DdMemoryBreakdown info;
+    int retval;
+
+    Cudd_ReadMemoryBreakdown(dd, &info);
+    retval = fprintf(fp,"**** CUDD memory breakdown ****\n"
+		     "Node blocks: %" PRIszt " bytes\n"
+		     "  live nodes: %" PRIszt "\n"
+		     "  dead nodes: %" PRIszt "\n"
+		     "  free nodes: %" PRIszt "\n"
+		     "  released: %" PRIszt " bytes\n"
+		     "Spill file: %" PRIszt " bytes\n"
+		     "Unique table: %" PRIszt " bytes\n"
+		     "Variables: %" PRIszt " bytes\n"
+		     "Computed table: %" PRIszt " bytes\n"
+		     "Local caches: %" PRIszt " bytes\n"
+		     "Hash tables: %" PRIszt " bytes\n"
+		     "Death row: %" PRIszt " bytes\n"
+		     "Interaction matrix: %" PRIszt " bytes\n"
+		     "Linear matrix: %" PRIszt " bytes\n"
+		     "Stash: %" PRIszt " bytes\n"
+		     "Reordering: %" PRIszt " bytes\n"
+		     "Other: %" PRIszt " bytes\n"
+		     "Total: %" PRIszt " bytes\n",
+		     info.nodeArena, info.liveNodes, info.deadNodes,
+		     info.freeNodes, info.releasedArena, info.spillArena,
+		     info.uniqueTable,
+		     info.variables, info.cache, info.localCaches,
+		     info.hashTables, info.deathRow, info.interaction,
+		     info.linear, info.stash, info.reordering, info.other,
+		     info.total);
+    if (retval == EOF) return(0);
+    return(1);
+
+} /* end of Cudd_PrintMemoryBreakdown */
+
+
 /**
   @brief Prints out statistics and settings for a CUDD manager.
 
@@ -3323,29 +4015,44 @@ Cudd_PrintInfo(
 
   @details This number includes node on the free list. At the peak,
   the number of nodes on the free list is guaranteed to be less than
-  DD_MEM_CHUNK.
+  DD_MEM_CHUNK, except while Cudd_Compact holds both the old and the
+  new blocks.  The count never drops, even when node memory is
+  released.
 
   @sideeffect None
 
-  @see Cudd_ReadNodeCount Cudd_PrintInfo
+  @see Cudd_ReadNodeCount Cudd_PrintInfo Cudd_ReadAllocatedNodeCount
 
 */
 long
 Cudd_ReadPeakNodeCount(
   DdManager * dd)
 {
-    long count = 0;
-    DdNodePtr *scan = dd->memoryList;
-
-    while (scan != NULL) {
-	count += DD_MEM_CHUNK;
-	scan = (DdNodePtr *) *scan;
-    }
-    return(count);
+    return((long) dd->peakNodeBlocks * DD_MEM_CHUNK);
 
 } /* end of Cudd_ReadPeakNodeCount */
 
 
+/**
+  @brief Reports the number of nodes allocated.
+
+  @details This number includes the nodes on the free list.  Unlike
+  Cudd_ReadPeakNodeCount, it drops when node memory is released.
+
+  @sideeffect None
+
+  @see Cudd_ReadPeakNodeCount Cudd_SetMemoryReleaseThreshold
+
+*/
+long
+Cudd_ReadAllocatedNodeCount(
+  DdManager * dd)
+{
+    return((long) dd->nodeBlocks * DD_MEM_CHUNK);
+
+} /* end of Cudd_ReadAllocatedNodeCount */
+
+
 /**
   @brief Reports the peak number of live nodes.
 
@@ -3648,6 +4355,9 @@ Cudd_StdPreReordHook(
     case CUDD_REORDER_LAZY_SIFT:
 	retval = fprintf(dd->out,"lazy sifting");
 	break;
+    case CUDD_REORDER_SIFT_INCREMENTAL:
+	retval = fprintf(dd->out,"incremental sifting");
+	break;
     case CUDD_REORDER_GROUP_SIFT:
     case CUDD_REORDER_GROUP_SIFT_CONV:
 	retval = fprintf(dd->out,"group sifting");
@@ -4125,6 +4835,294 @@ Cudd_SetNextReordering(
 } /* end of Cudd_SetNextReordering */
 
 
+/**
+  @brief Installs a reordering trigger.
+
+  @details When the number of nodes reaches the threshold for dynamic
+  reordering, the trigger, if any, is called with the manager and arg.
+  If it returns 0, reordering is postponed and the threshold is raised
+  as if reordering had taken place.  The trigger may base its decision
+  on the signals measured by the manager over the window since the
+  previous consultation or reordering; see
+  Cudd_ReadRecentCacheHitRate, Cudd_ReadRecentThroughput,
+  Cudd_ReadRecentGrowth, Cudd_ReadReorderingPayoff, and
+  Cudd_ReadReorderingCostShare.  Cudd_AdaptiveReorderingTrigger is a
+  ready-made trigger.  To go back to reordering whenever the threshold
+  is reached, install a NULL trigger, which is the default.  The
+  trigger applies to %BDD and %ADD reordering.
+
+  @sideeffect None
+
+  @see Cudd_ReadReorderingTrigger Cudd_AdaptiveReorderingTrigger
+  Cudd_SetNextReordering
+
+*/
+void
+Cudd_SetReorderingTrigger(
+  DdManager *dd,
+  DD_RTFP trigger,
+  void *arg)
+{
+    dd->reordTrigger = trigger;
+    dd->rtArg = arg;
+
+} /* end of Cudd_SetReorderingTrigger */
+
+
+/**
+  @brief Reads the reordering trigger.
+
+  @sideeffect If argp is non-null, the second argument to the trigger
+  is written to the location it points to.
+
+  @see Cudd_SetReorderingTrigger
+
+*/
+DD_RTFP
+Cudd_ReadReorderingTrigger(
+  DdManager *dd,
+  void **argp)
+{
+    if (argp)
+	*argp = dd->rtArg;
+    return(dd->reordTrigger);
+
+} /* end of Cudd_ReadReorderingTrigger */
+
+
+/**
+  @brief Reads the cache hit rate of the current window.
+
+  @details The window starts at the last reordering or at the last
+  consultation of the reordering trigger, whichever came last.
+
+  @return the fraction of cache lookups in the window that were hits,
+  or 0 if there were no lookups.
+
+  @sideeffect None
+
+  @see Cudd_SetReorderingTrigger Cudd_ReadCacheHits
+
+*/
+double
+Cudd_ReadRecentCacheHitRate(
+  DdManager *dd)
+{
+    double lookups = Cudd_ReadCacheLookUps(dd) - dd->trigLookups;
+
+    if (lookups <= 0.0) return(0.0);
+    return((Cudd_ReadCacheHits(dd) - dd->trigHits) / lookups);
+
+} /* end of Cudd_ReadRecentCacheHitRate */
+
+
+/**
+  @brief Reads the operation throughput of the current window.
+
+  @details Since every recursive step of an operation looks up the
+  cache, throughput is measured in cache lookups per second of CPU
+  time.  The window starts at the last reordering or at the last
+  consultation of the reordering trigger, whichever came last.
+
+  @sideeffect None
+
+  @see Cudd_SetReorderingTrigger Cudd_ReadCacheLookUps
+
+*/
+double
+Cudd_ReadRecentThroughput(
+  DdManager *dd)
+{
+    unsigned long elapsed = util_cpu_time() - dd->trigTime;
+
+    if (elapsed == 0) elapsed = 1;
+    return((Cudd_ReadCacheLookUps(dd) - dd->trigLookups) * 1000.0 /
+	   (double) elapsed);
+
+} /* end of Cudd_ReadRecentThroughput */
+
+
+/**
+  @brief Reads the growth rate of the live nodes in the current window.
+
+  @details The rate is in nodes per second of CPU time, and is
+  negative if the number of live nodes went down.  The window starts
+  at the last reordering or at the last consultation of the reordering
+  trigger, whichever came last.
+
+  @sideeffect None
+
+  @see Cudd_SetReorderingTrigger
+
+*/
+double
+Cudd_ReadRecentGrowth(
+  DdManager *dd)
+{
+    unsigned long elapsed = util_cpu_time() - dd->trigTime;
+
+    if (elapsed == 0) elapsed = 1;
+    return(((double) (dd->keys - dd->dead) - (double) dd->trigKeys) *
+	   1000.0 / (double) elapsed);
+
+} /* end of Cudd_ReadRecentGrowth */
+
+
+/**
+  @brief Reads how well reordering has paid off recently.
+
+  @details The payoff of a reordering is the fraction of nodes it
+  removed.  The value returned is a running average that weighs recent
+  reorderings more.  It is 1 before the first reordering.
+
+  @sideeffect None
+
+  @see Cudd_ReadReorderingCostShare Cudd_SetReorderingTrigger
+
+*/
+double
+Cudd_ReadReorderingPayoff(
+  DdManager *dd)
+{
+    return(dd->reordPayoff);
+
+} /* end of Cudd_ReadReorderingPayoff */
+
+
+/**
+  @brief Reads the share of time reordering would take.
+
+  @details Compares a running average of the duration of recent
+  reorderings to the CPU time spent since the end of the last one.
+
+  @return the fraction of time that would go to reordering if
+  reordering took place now; 0 before the first reordering.
+
+  @sideeffect None
+
+  @see Cudd_ReadReorderingPayoff Cudd_SetReorderingTrigger
+
+*/
+double
+Cudd_ReadReorderingCostShare(
+  DdManager *dd)
+{
+    double elapsed = (double) (util_cpu_time() - dd->reordEnd);
+
+    if (dd->reordCost + elapsed <= 0.0) return(0.0);
+    return(dd->reordCost / (dd->reordCost + elapsed));
+
+} /* end of Cudd_ReadReorderingCostShare */
+
+
+/**
+  @brief Installs a reordering telemetry callback.
+
+  @details The callback is called with a DdReorderEvent record each
+  time a variable has been sifted, and each time the reordering
+  procedures have collected garbage or flushed the cache.  The
+  records are only valid during the call.  Totals over all events
+  are kept whether or not a callback is installed, and can be printed
+  with Cudd_PrintReorderingSummary.  Passing NULL removes the
+  callback.  The callback must not create or free nodes.
+
+  Sifting events come from the BDD sifting methods (plain, converging,
+  incremental, symmetric, group, lazy and linear sifting) and from
+  plain ZDD sifting.  The other methods do not report the variables
+  they move: ZDD symmetric, group and linear sifting, random swapping,
+  window permutation, simulated annealing, the genetic algorithm and
+  exact reordering only produce the garbage collection and cache
+  flush events of the preparation of the heap.
+
+  @sideeffect None
+
+  @see Cudd_ReadReorderingTelemetry Cudd_PrintReorderingSummary
+
+*/
+void
+Cudd_SetReorderingTelemetry(
+  DdManager *dd,
+  DD_RECFP callback,
+  void *arg)
+{
+    dd->telemetry.callback = callback;
+    dd->telemetry.arg = arg;
+
+} /* end of Cudd_SetReorderingTelemetry */
+
+
+/**
+  @brief Reads the reordering telemetry callback.
+
+  @sideeffect If argp is non-null, the last argument to the callback
+  is written to the location it points to.
+
+  @see Cudd_SetReorderingTelemetry
+
+*/
+DD_RECFP
+Cudd_ReadReorderingTelemetry(
+  DdManager *dd,
+  void **argp)
+{
+    if (argp)
+	*argp = dd->telemetry.arg;
+    return(dd->telemetry.callback);
+
+} /* end of Cudd_ReadReorderingTelemetry */
+
+
+/**
+  @brief Prints a summary of the reordering telemetry.
+
+  @details The summary is a JSON object with the reordering
+  parameters and the totals accumulated since the manager was created:
+  variables sifted, swaps, levels moved, nodes removed, and time spent
+  sifting; sifting directions cut short by the growth limit, and
+  variables left out because of the swap limit; garbage collections
+  and cache flushes performed while reordering, with their cost.
+  Times are in milliseconds.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+  @see Cudd_SetReorderingTelemetry Cudd_PrintInfo
+
+*/
+int
+Cudd_PrintReorderingSummary(
+  DdManager *dd,
+  FILE *fp)
+{
+    DdReorderTelemetry *tel = &(dd->telemetry);
+    int retval;
+
+    retval = fprintf(fp,
+		     "{\"reorderings\": %u, \"time\": %lu,\n"
+		     " \"parameters\": {\"maxGrowth\": %g, "
+		     "\"maxGrowthAlt\": %g, \"reorderingCycle\": %d, "
+		     "\"siftMaxVar\": %d, \"siftMaxSwap\": %d},\n"
+		     " \"sifting\": {\"variables\": %lu, \"swaps\": %.0f, "
+		     "\"levelsMoved\": %.0f, \"nodesRemoved\": %.0f, "
+		     "\"time\": %lu},\n"
+		     " \"cut\": {\"byGrowth\": %lu, \"bySwapLimit\": %lu},\n"
+		     " \"gc\": {\"count\": %lu, \"reclaimed\": %.0f, "
+		     "\"time\": %lu},\n"
+		     " \"cacheFlush\": {\"count\": %lu, \"time\": %lu}}\n",
+		     dd->reorderings, (unsigned long) dd->reordTime,
+		     dd->maxGrowth, dd->maxGrowthAlt, dd->reordCycle,
+		     dd->siftMaxVar, dd->siftMaxSwap,
+		     tel->sifted, tel->swaps, tel->moved, tel->removed,
+		     tel->siftTime, tel->cutGrowth, tel->cutSwap,
+		     tel->gcs, tel->reclaimed, tel->gcTime,
+		     tel->flushes, tel->flushTime);
+    if (retval == EOF) return(0);
+    return(1);
+
+} /* end of Cudd_PrintReorderingSummary */
+
+
 /**
   @brief Reads the number of elementary reordering steps.
 
@@ -4227,6 +5225,62 @@ Cudd_SetMaxMemory(
 } /* end of Cudd_SetMaxMemory */
 
 
+/**
+  @brief Reads the occupancy below which node memory is released.
+
+  @sideeffect none
+
+  @see Cudd_SetMemoryReleaseThreshold
+
+*/
+double
+Cudd_ReadMemoryReleaseThreshold(
+  DdManager *dd)
+{
+    return(dd->releaseFrac);
+
+} /* end of Cudd_ReadMemoryReleaseThreshold */
+
+
+/**
+  @brief Sets the occupancy below which node memory is released.
+
+  @details The nodes are allocated in blocks of DD_MEM_CHUNK nodes
+  that are normally kept until the manager is destroyed, so that the
+  memory in use never shrinks below its peak.  If the threshold is
+  positive, each garbage collection that leaves the live nodes below
+  that fraction of the allocated node slots frees the blocks with no
+  live nodes, until the occupancy is back at the threshold, and
+  Cudd_ReadMemoryInUse and Cudd_ReadAllocatedNodeCount drop
+  accordingly.  Where anonymous memory mappings are available, the
+  blocks are unmapped and their pages go back to the operating system
+  at once; elsewhere that is up to the allocator.  Blocks are
+  only released when the free list is kept sorted (the default).  A
+  threshold of 0 (the default) disables the release; values above 1
+  are clamped to 1.
+
+  @return the previous threshold.
+
+  @sideeffect none
+
+  @see Cudd_ReadMemoryReleaseThreshold Cudd_ReadMemoryInUse
+  Cudd_ReadAllocatedNodeCount
+
+*/
+double
+Cudd_SetMemoryReleaseThreshold(
+  DdManager *dd,
+  double threshold)
+{
+    double oldThreshold = dd->releaseFrac;
+    if (threshold < 0.0) threshold = 0.0;
+    if (threshold > 1.0) threshold = 1.0;
+    dd->releaseFrac = threshold;
+    return(oldThreshold);
+
+} /* end of Cudd_SetMemoryReleaseThreshold */
+
+
 /**
   @brief Prevents sifting of a variable.
 
@@ -46,6 +46,10 @@
 #include "util.h"
 #include "cuddInt.h"
 
+#ifdef DD_USE_THREADS
+#include <pthread.h>
+#endif
+
 /*---------------------------------------------------------------------------*/
 /* Constant declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -57,15 +61,37 @@
 #define JUMP_UP_PROB 0.36
 #define MAXGEN_RATIO 15.0
 #define STOP_TEMP 1.0
+/* Ratio of the temperatures of adjacent chains in parallel tempering */
+#define LADDER_RATIO 2.0
 
 /*---------------------------------------------------------------------------*/
 /* Stucture declarations                                                     */
 /*---------------------------------------------------------------------------*/
 
+/**
+ * @brief State of one annealing chain.
+ */
+struct AnnealChain {
+    DdManager *table;	/**< manager in which the chain moves */
+    int lower;		/**< lowest level to be reordered */
+    int upper;		/**< highest level to be reordered */
+    double temp;	/**< current temperature */
+    int maxGen;		/**< number of moves per temperature */
+    int size;		/**< current size */
+    int bestCost;	/**< size of the best order found */
+    int *bestOrder;	/**< best order found */
+    int ecount;		/**< number of exchanges */
+    int ucount;		/**< number of jumps up */
+    int dcount;		/**< number of jumps down */
+    int result;		/**< 0 after a failure */
+};
+
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
 /*---------------------------------------------------------------------------*/
 
+typedef struct AnnealChain AnnealChain_t;
+
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -89,6 +115,8 @@ static Move * ddJumpingDown (DdManager *table, int x, int x_high, int initial_si
 static int siftBackwardProb (DdManager *table, Move *moves, int size, double temp);
 static void copyOrder (DdManager *table, int *array, int lower, int upper);
 static int restoreOrder (DdManager *table, int *array, int lower, int upper);
+static void * ddAnnealGeneration (void *arg);
+static int ddAnnealParallel (DdManager *table, AnnealChain_t *chain, int nchains, double temp, int maxGen);
 
 /** \endcond */
 
@@ -108,12 +136,16 @@ static int restoreOrder (DdManager *table, int *array, int lower, int upper);
   exchange or jump randomly. In case of jump, choose between jump_up
   and jump_down randomly. Do exchange or jump and get optimal case.
   Loop until there is no improvement or temperature reaches
-  minimum.
+  minimum.  If more than one thread is allowed, one chain per thread
+  runs on a copy of the heap (parallel tempering), and only the best
+  order found is built in the heap.
 
   @return 1 in case of success; 0 otherwise.
 
   @sideeffect None
 
+  @see Cudd_SetReorderingThreads
+
 */
 int
 cuddAnnealing(
@@ -123,15 +155,11 @@ cuddAnnealing(
 {
     int         nvars;
     int         size;
-    int         x,y;
     int         result;
     int		c1, c2, c3, c4;
-    int		BestCost;
-    int		*BestOrder;
     double	NewTemp, temp;
-    double	rand1;
-    int         innerloop, maxGen;
-    int         ecount, ucount, dcount;
+    int         maxGen;
+    AnnealChain_t chain;
    
     nvars = upper - lower + 1;
 
@@ -144,22 +172,41 @@ cuddAnnealing(
     size = (int) (table->keys - table->isolated);
 
     /* Keep track of the best order. */
-    BestCost = size;
-    BestOrder = ALLOC(int,nvars);
-    if (BestOrder == NULL) {
+    chain.table = table;
+    chain.lower = lower;
+    chain.upper = upper;
+    chain.size = size;
+    chain.bestCost = size;
+    chain.bestOrder = ALLOC(int,nvars);
+    if (chain.bestOrder == NULL) {
 	table->errorCode = CUDD_MEMORY_OUT;
 	return(0);
     }
-    copyOrder(table,BestOrder,lower,upper);
+    copyOrder(table,chain.bestOrder,lower,upper);
+    chain.ecount = chain.ucount = chain.dcount = 0;
+    chain.result = 1;
 
     temp = BETA * size;
     maxGen = (int) (MAXGEN_RATIO * nvars);
 
+    if (table->reordThreads > 1) {
+	result = ddAnnealParallel(table,&chain,table->reordThreads,temp,maxGen);
+	if (result == 0) {
+	    FREE(chain.bestOrder);
+	    return(0);
+	}
+	if (result == 1) {
+	    result = restoreOrder(table,chain.bestOrder,lower,upper);
+	    FREE(chain.bestOrder);
+	    return(result);
+	}
+	/* No copy of the heap could be made: run a single chain. */
+    }
+
     c1 = size + 10;
     c2 = c1 + 10;
     c3 = size;
     c4 = c2 + 10;
-    ecount = ucount = dcount = 0;
  
     while (!stopping_criterion(c1, c2, c3, c4, temp)) {
 #ifdef DD_STATS
@@ -167,59 +214,14 @@ cuddAnnealing(
 		       temp,size,maxGen);
 	table->tosses = table->acceptances = 0;
 #endif
-	for (innerloop = 0; innerloop < maxGen; innerloop++) {
-	    /* Choose x, y  randomly. */
-	    x = (int) Cudd_Random(table) % nvars;
-	    do {
-		y = (int) Cudd_Random(table) % nvars;
-	    } while (x == y);
-	    x += lower;
-	    y += lower;
-	    if (x > y) {
-		int tmp = x;
-		x = y;
-		y = tmp;
-	    }
-
-	    /* Choose move with roulette wheel. */
-	    rand1 = random_generator(table);
-	    if (rand1 < EXC_PROB) {
-		result = ddExchange(table,x,y,temp);       /* exchange */
-		ecount++;
-#if 0
-		(void) fprintf(table->out,
-			       "Exchange of %d and %d: size = %d\n",
-			       x,y,table->keys - table->isolated);
-#endif
-	    } else if (rand1 < EXC_PROB + JUMP_UP_PROB) {
-		result = ddJumpingAux(table,y,x,y,temp); /* jumping_up */
-		ucount++;
-#if 0
-		(void) fprintf(table->out,
-			       "Jump up of %d to %d: size = %d\n",
-			       y,x,table->keys - table->isolated);
-#endif
-	    } else {
-		result = ddJumpingAux(table,x,x,y,temp); /* jumping_down */
-		dcount++;
-#if 0
-		(void) fprintf(table->out,
-			       "Jump down of %d to %d: size = %d\n",
-			       x,y,table->keys - table->isolated);
-#endif
-	    }
-
-	    if (!result) {
-		FREE(BestOrder);
-		return(0);
-	    }
-
-	    size = (int) (table->keys - table->isolated); /* keep current size */
-	    if (size < BestCost) {			/* update best order */
-		BestCost = size;
-		copyOrder(table,BestOrder,lower,upper);
-	    }
+	chain.temp = temp;
+	chain.maxGen = maxGen;
+	(void) ddAnnealGeneration(&chain);
+	if (!chain.result) {
+	    FREE(chain.bestOrder);
+	    return(0);
 	}
+	size = chain.size;	/* keep current size */
 	c1 = c2;
 	c2 = c3;
 	c3 = c4;
@@ -236,13 +238,13 @@ cuddAnnealing(
 #endif
     }
 
-    result = restoreOrder(table,BestOrder,lower,upper);
-    FREE(BestOrder);
+    result = restoreOrder(table,chain.bestOrder,lower,upper);
+    FREE(chain.bestOrder);
     if (!result) return(0);
 #ifdef DD_STATS
-    fprintf(table->out,"#:N_EXCHANGE %8d : total exchanges\n",ecount);
-    fprintf(table->out,"#:N_JUMPUP   %8d : total jumps up\n",ucount);
-    fprintf(table->out,"#:N_JUMPDOWN %8d : total jumps down",dcount);
+    fprintf(table->out,"#:N_EXCHANGE %8d : total exchanges\n",chain.ecount);
+    fprintf(table->out,"#:N_JUMPUP   %8d : total jumps up\n",chain.ucount);
+    fprintf(table->out,"#:N_JUMPDOWN %8d : total jumps down",chain.dcount);
 #endif
     return(1);
 
@@ -755,3 +757,231 @@ restoreOrder(
 
 } /* end of restoreOrder */
 
+
+/**
+  @brief Performs the moves of an annealing chain at one temperature.
+
+  @details Takes and returns a void pointer so that it can be the body
+  of a thread.
+
+  @return NULL.
+
+  @sideeffect Updates the size and best order of the chain; clears
+  the result field of the chain in case of failure.
+
+*/
+static void *
+ddAnnealGeneration(
+  void * arg)
+{
+    AnnealChain_t *chain = (AnnealChain_t *) arg;
+    DdManager *table = chain->table;
+    int nvars = chain->upper - chain->lower + 1;
+    int innerloop, x, y, result;
+    double rand1;
+
+    for (innerloop = 0; innerloop < chain->maxGen; innerloop++) {
+	/* Choose x, y  randomly. */
+	x = (int) Cudd_Random(table) % nvars;
+	do {
+	    y = (int) Cudd_Random(table) % nvars;
+	} while (x == y);
+	x += chain->lower;
+	y += chain->lower;
+	if (x > y) {
+	    int tmp = x;
+	    x = y;
+	    y = tmp;
+	}
+
+	/* Choose move with roulette wheel. */
+	rand1 = random_generator(table);
+	if (rand1 < EXC_PROB) {
+	    result = ddExchange(table,x,y,chain->temp);       /* exchange */
+	    chain->ecount++;
+#if 0
+	    (void) fprintf(table->out,
+			   "Exchange of %d and %d: size = %d\n",
+			   x,y,table->keys - table->isolated);
+#endif
+	} else if (rand1 < EXC_PROB + JUMP_UP_PROB) {
+	    result = ddJumpingAux(table,y,x,y,chain->temp); /* jumping_up */
+	    chain->ucount++;
+#if 0
+	    (void) fprintf(table->out,
+			   "Jump up of %d to %d: size = %d\n",
+			   y,x,table->keys - table->isolated);
+#endif
+	} else {
+	    result = ddJumpingAux(table,x,x,y,chain->temp); /* jumping_down */
+	    chain->dcount++;
+#if 0
+	    (void) fprintf(table->out,
+			   "Jump down of %d to %d: size = %d\n",
+			   x,y,table->keys - table->isolated);
+#endif
+	}
+
+	if (!result) {
+	    chain->result = 0;
+	    return(NULL);
+	}
+
+	chain->size = (int) (table->keys - table->isolated);
+	if (chain->size < chain->bestCost) {		/* update best order */
+	    chain->bestCost = chain->size;
+	    copyOrder(table,chain->bestOrder,chain->lower,chain->upper);
+	}
+    }
+    return(NULL);
+
+} /* end of ddAnnealGeneration */
+
+
+/**
+  @brief Runs annealing chains in parallel at different temperatures.
+
+  @details Each chain moves in its own copy of the heap.  The
+  temperatures form a geometric ladder whose lowest rung follows the
+  schedule of a single chain.  After each generation, chains on
+  adjacent rungs exchange temperatures with the probability prescribed
+  by parallel tempering, so that good orders found at high temperature
+  move down the ladder.  The annealing stops when the chain on the
+  lowest rung stops improving at a low enough temperature.
+
+  @return 1 if successful; 0 in case of failure; -1 if no copy of the
+  heap could be made.
+
+  @sideeffect The best order found by any chain, if better, replaces
+  the best order of chain.
+
+*/
+static int
+ddAnnealParallel(
+  DdManager * table,
+  AnnealChain_t * chain,
+  int  nchains,
+  double  temp,
+  int  maxGen)
+{
+#ifdef DD_USE_THREADS
+    AnnealChain_t *chains;
+    pthread_t *threads;
+    int *started, *rung;
+    int nvars = chain->upper - chain->lower + 1;
+    int c1, c2, c3, c4;
+    int k, r, tmp, result;
+    double NewTemp, ratio, delta;
+
+    chains = ALLOC(AnnealChain_t, nchains);
+    threads = ALLOC(pthread_t, nchains);
+    started = ALLOC(int, nchains);
+    rung = ALLOC(int, nchains);
+    if (chains == NULL || threads == NULL || started == NULL ||
+	rung == NULL) {
+	table->errorCode = CUDD_MEMORY_OUT;
+	if (chains != NULL) FREE(chains);
+	if (threads != NULL) FREE(threads);
+	if (started != NULL) FREE(started);
+	if (rung != NULL) FREE(rung);
+	return(0);
+    }
+    for (k = 0; k < nchains; k++) {
+	chains[k] = *chain;
+	chains[k].bestOrder = ALLOC(int, nvars);
+	if (chains[k].bestOrder == NULL) break;
+	chains[k].table = cuddReorderCopy(table);
+	if (chains[k].table == NULL) {
+	    FREE(chains[k].bestOrder);
+	    break;
+	}
+	Cudd_Srandom(chains[k].table, (int32_t) Cudd_Random(table));
+	copyOrder(table,chains[k].bestOrder,chain->lower,chain->upper);
+	rung[k] = k;
+    }
+    nchains = k;
+    result = -1;
+    if (nchains == 0) goto cleanup;
+
+    c1 = chain->size + 10;
+    c2 = c1 + 10;
+    c3 = chain->size;
+    c4 = c2 + 10;
+    result = 1;
+    while (!stopping_criterion(c1, c2, c3, c4, temp)) {
+	ratio = 1.0;
+	for (r = 0; r < nchains; r++) {
+	    chains[rung[r]].temp = temp * ratio;
+	    chains[rung[r]].maxGen = maxGen;
+	    ratio *= LADDER_RATIO;
+	}
+	for (k = 0; k < nchains; k++) {
+	    started[k] = pthread_create(&threads[k], NULL, ddAnnealGeneration,
+					&chains[k]) == 0;
+	}
+	for (k = 0; k < nchains; k++) {
+	    if (started[k]) {
+		(void) pthread_join(threads[k], NULL);
+	    } else {
+		(void) ddAnnealGeneration(&chains[k]);
+	    }
+	    if (!chains[k].result) {
+		result = 0;
+		if (chains[k].table->errorCode != CUDD_NO_ERROR) {
+		    table->errorCode = chains[k].table->errorCode;
+		}
+	    }
+	}
+	if (result == 0) break;
+
+	/* Offer each pair of adjacent rungs an exchange. */
+	for (r = 0; r + 1 < nchains; r++) {
+	    AnnealChain_t *cold = &chains[rung[r]];
+	    AnnealChain_t *hot = &chains[rung[r+1]];
+	    delta = (double) (cold->size - hot->size) *
+		(1.0 / cold->temp - 1.0 / hot->temp);
+	    if (delta >= 0.0 || random_generator(table) < exp(delta)) {
+		tmp = rung[r];
+		rung[r] = rung[r+1];
+		rung[r+1] = tmp;
+	    }
+	}
+
+	c1 = c2;
+	c2 = c3;
+	c3 = c4;
+	c4 = chains[rung[0]].size;
+	NewTemp = ALPHA * temp;
+	if (NewTemp >= 1.0) {
+	    maxGen = (int)(log(NewTemp) / log(temp) * maxGen);
+	}
+	temp = NewTemp;
+    }
+
+    if (result == 1) {
+	for (k = 0; k < nchains; k++) {
+	    if (chains[k].bestCost < chain->bestCost) {
+		chain->bestCost = chains[k].bestCost;
+		for (r = 0; r < nvars; r++) {
+		    chain->bestOrder[r] = chains[k].bestOrder[r];
+		}
+	    }
+	}
+    }
+
+cleanup:
+    for (k = 0; k < nchains; k++) {
+	cuddReorderCopyFree(table, chains[k].table);
+	FREE(chains[k].bestOrder);
+    }
+    FREE(chains);
+    FREE(threads);
+    FREE(started);
+    FREE(rung);
+    return(result);
+#else
+    (void) table; (void) chain; (void) nchains; (void) temp; (void) maxGen;
+    return(-1);
+#endif
+
+} /* end of ddAnnealParallel */
@@ -51,11 +51,33 @@
 /* Constant declarations                                                     */
 /*---------------------------------------------------------------------------*/
 
+/** Initial number of ids of a transfer map (a power of 2). */
+#define DD_TRANSFER_MAP_SIZE 1024
+
 
 /*---------------------------------------------------------------------------*/
 /* Stucture declarations                                                     */
 /*---------------------------------------------------------------------------*/
 
+/**
+ *  @brief Nodes of the source manager visited by a transfer.
+ *
+ *  @details Each visited node gets an id, in the order in which the
+ *  visit finishes, so that children come before parents; id 0 stands
+ *  for the constant.  An open-addressing table maps the nodes to their
+ *  ids.
+ */
+typedef struct DdTransferMap {
+    DdManager *manager;		/**< destination manager */
+    DdNodePtr *nodes;		/**< visited node of each id */
+    unsigned int *kids;		/**< ids of the two children of each node */
+    DdNodePtr *images;		/**< image in the destination of each node */
+    unsigned int capacity;	/**< ids allocated */
+    unsigned int count;		/**< ids in use */
+    unsigned int *slots;	/**< id of the node hashed to each slot, or 0 */
+    unsigned int mask;		/**< number of slots minus one */
+} DdTransferMap;
+
 
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
@@ -71,6 +93,15 @@
 /* Macro declarations                                                        */
 /*---------------------------------------------------------------------------*/
 
+/**
+  @brief Hash function for the nodes visited by a transfer.
+
+  @sideeffect None
+
+*/
+#define ddTransferHash(f,mask) \
+((unsigned int) (((ptruint) (f) / sizeof(DdNode)) * DD_P1) & (mask))
+
 /** \cond */
 
 /*---------------------------------------------------------------------------*/
@@ -82,7 +113,11 @@ static DdNode * addBddDoStrictThreshold (DdManager *dd, DdNode *f, DdNode *val);
 static DdNode * addBddDoInterval (DdManager *dd, DdNode *f, DdNode *l, DdNode *u);
 static DdNode * addBddDoIthBit (DdManager *dd, DdNode *f, DdNode *index);
 static DdNode * ddBddToAddRecur (DdManager *dd, DdNode *B);
-static DdNode * cuddBddTransferRecur (DdManager *ddS, DdManager *ddD, DdNode *f, st_table *table);
+static int ddTransferMapInit (DdTransferMap *map, DdManager *ddS, DdManager *ddD);
+static void ddTransferMapFree (DdTransferMap *map);
+static int ddTransferVisit (DdTransferMap *map, DdNode *f, unsigned int *id);
+static int ddTransferAdd (DdTransferMap *map, DdNode *f, unsigned int t, unsigned int e);
+static DdNode * ddTransferNode (DdManager *ddD, unsigned int index, DdNode *T, DdNode *E);
 
 /** \endcond */
 
@@ -374,6 +409,8 @@ Cudd_addBddPattern(
 
   @sideeffect None
 
+  @see Cudd_bddTransferVector
+
 */
 DdNode *
 Cudd_bddTransfer(
@@ -395,6 +432,49 @@ Cudd_bddTransfer(
 } /* end of Cudd_bddTransfer */
 
 
+/**
+  @brief Converts an array of BDDs from a manager to another one.
+
+  @details The orders of the variables in the two managers may be
+  different.  The nodes shared by the BDDs of F are transferred once.
+  They are visited without changing the source manager and built from
+  the bottom up; a node whose variable is above its children in the
+  destination order is created directly in the unique table, so that
+  no recursion is needed when the orders agree.  Otherwise the node is
+  built by ITE in the destination manager.  Each result is referenced.
+
+  @return 1 if successful; 0 otherwise.  On failure no result is
+  referenced.
+
+  @sideeffect G[i] is set to the copy of F[i] in ddDestination, for i
+  = 0,...,n-1.
+
+  @see Cudd_bddTransfer Cudd_CloneManager
+
+*/
+int
+Cudd_bddTransferVector(
+  DdManager * ddSource /**< manager of F */,
+  DdManager * ddDestination /**< manager of G */,
+  DdNode * const * F /**< BDDs to be transferred */,
+  DdNode ** G /**< receives the transferred BDDs */,
+  int  n /**< number of BDDs */)
+{
+    int result;
+
+    do {
+	ddDestination->reordered = 0;
+	result = cuddBddTransferVector(ddSource, ddDestination, F, G, n);
+    } while (ddDestination->reordered == 1);
+    if (ddDestination->errorCode == CUDD_TIMEOUT_EXPIRED &&
+        ddDestination->timeoutHandler) {
+        ddDestination->timeoutHandler(ddDestination, ddDestination->tohArg);
+    }
+    return(result);
+
+} /* end of Cudd_bddTransferVector */
+
+
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -418,37 +498,115 @@ cuddBddTransfer(
   DdNode * f)
 {
     DdNode *res;
-    st_table *table = NULL;
-    st_generator *gen = NULL;
-    DdNode *key, *value;
-
-    table = st_init_table(st_ptrcmp,st_ptrhash);
-    if (table == NULL) goto failure;
-    res = cuddBddTransferRecur(ddS, ddD, f, table);
-    if (res != NULL) cuddRef(res);
-
-    /* Dereference all elements in the table and dispose of the table.
-    ** This must be done also if res is NULL to avoid leaks in case of
-    ** reordering. */
-    gen = st_init_gen(table);
-    if (gen == NULL) goto failure;
-    while (st_gen(gen, (void **) &key, (void **) &value)) {
-	Cudd_RecursiveDeref(ddD, value);
-    }
-    st_free_gen(gen); gen = NULL;
-    st_free_table(table); table = NULL;
-
-    if (res != NULL) cuddDeref(res);
-    return(res);
 
-failure:
-    /* No need to free gen because it is always NULL here. */
-    if (table != NULL) st_free_table(table);
-    return(NULL);
+    if (cuddBddTransferVector(ddS, ddD, &f, &res, 1) == 0) return(NULL);
+    cuddDeref(res);
+    return(res);
 
 } /* end of cuddBddTransfer */
 
 
+/**
+  @brief Converts an array of BDDs from a manager to another one.
+
+  @details Visits the nodes of F, sorts them by level from the bottom
+  up, and builds their images in ddD.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect The results are stored in G and referenced.
+
+  @see Cudd_bddTransferVector
+
+*/
+int
+cuddBddTransferVector(
+  DdManager * ddS,
+  DdManager * ddD,
+  DdNode * const * F,
+  DdNode ** G,
+  int  n)
+{
+    DdTransferMap map;
+    unsigned int *order = NULL;
+    unsigned int *start = NULL;
+    DdNode *f, *T, *E, *res;
+    unsigned int id, k;
+    int i, level;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+
+    if (!ddTransferMapInit(&map, ddS, ddD)) goto memout;
+    for (i = 0; i < n; i++) {
+	if (!ddTransferVisit(&map, Cudd_Regular(F[i]), &id)) goto memout;
+    }
+
+    /* Sort the nodes by level in the source, from the bottom up.  The
+    ** children of each node still come before it, and the levels are
+    ** also those of the destination when the orders agree. */
+    saveHandler = MMoutOfMemory;
+    MMoutOfMemory = ddD->outOfMemCallback;
+    order = ALLOC(unsigned int, map.count);
+    start = ALLOC(unsigned int, ddS->size + 1);
+    MMoutOfMemory = saveHandler;
+    if (order == NULL || start == NULL) goto memout;
+    for (level = 0; level <= ddS->size; level++) start[level] = 0;
+    for (id = 1; id < map.count; id++) {
+	start[ddS->size - 1 - cuddI(ddS, map.nodes[id]->index)]++;
+    }
+    k = 0;
+    for (level = 0; level <= ddS->size; level++) {
+	unsigned int c = start[level];
+	start[level] = k;
+	k += c;
+    }
+    for (id = 1; id < map.count; id++) {
+	order[start[ddS->size - 1 - cuddI(ddS, map.nodes[id]->index)]++] = id;
+    }
+    FREE(start);
+
+    /* Build the images. */
+    for (k = 0; k < map.count - 1; k++) {
+	id = order[k];
+	f = map.nodes[id];
+	T = map.images[map.kids[2*id]];
+	E = Cudd_NotCond(map.images[map.kids[2*id+1]],
+			 Cudd_IsComplement(cuddE(f)));
+	res = ddTransferNode(ddD, f->index, T, E);
+	if (res == NULL) {
+	    while (k > 0) {
+		Cudd_RecursiveDeref(ddD, map.images[order[--k]]);
+	    }
+	    FREE(order);
+	    ddTransferMapFree(&map);
+	    return(0);
+	}
+	cuddRef(res);
+	map.images[id] = res;
+    }
+    FREE(order);
+
+    for (i = 0; i < n; i++) {
+	(void) ddTransferVisit(&map, Cudd_Regular(F[i]), &id);
+	G[i] = Cudd_NotCond(map.images[id], Cudd_IsComplement(F[i]));
+	cuddRef(G[i]);
+    }
+    for (id = 1; id < map.count; id++) {
+	Cudd_RecursiveDeref(ddD, map.images[id]);
+    }
+    ddTransferMapFree(&map);
+    return(1);
+
+memout:
+    if (order != NULL) FREE(order);
+    if (start != NULL) FREE(start);
+    ddTransferMapFree(&map);
+    ddD->errorCode = CUDD_MEMORY_OUT;
+    return(0);
+
+} /* end of cuddBddTransferVector */
+
+
 /**
   @brief Performs the recursive step for Cudd_addBddPattern.
 
@@ -906,81 +1064,218 @@ ddBddToAddRecur(
 
 
 /**
-  @brief Performs the recursive step of Cudd_bddTransfer.
+  @brief Initializes the map of the nodes visited by a transfer.
+
+  @details Gives id 0 to the constant one, whose image is the constant
+  one of the destination manager.
 
-  @return a pointer to the result if successful; NULL otherwise.
+  @return 1 if successful; 0 otherwise.
 
   @sideeffect None
 
-  @see cuddBddTransfer
+  @see ddTransferMapFree
 
 */
-static DdNode *
-cuddBddTransferRecur(
+static int
+ddTransferMapInit(
+  DdTransferMap * map,
   DdManager * ddS,
-  DdManager * ddD,
-  DdNode * f,
-  st_table * table)
+  DdManager * ddD)
 {
-    DdNode *ft, *fe, *t, *e, *var, *res;
-    DdNode *one, *zero;
-    unsigned int index;
-    int comple = 0;
+    unsigned int i;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+
+    map->manager = ddD;
+    map->capacity = DD_TRANSFER_MAP_SIZE;
+    map->mask = 2 * DD_TRANSFER_MAP_SIZE - 1;
+    saveHandler = MMoutOfMemory;
+    MMoutOfMemory = ddD->outOfMemCallback;
+    map->nodes = ALLOC(DdNodePtr, map->capacity);
+    map->kids = ALLOC(unsigned int, 2 * map->capacity);
+    map->images = ALLOC(DdNodePtr, map->capacity);
+    map->slots = ALLOC(unsigned int, map->mask + 1);
+    MMoutOfMemory = saveHandler;
+    if (map->nodes == NULL || map->kids == NULL || map->images == NULL ||
+	map->slots == NULL) {
+	ddTransferMapFree(map);
+	return(0);
+    }
+    for (i = 0; i <= map->mask; i++) map->slots[i] = 0;
+    map->nodes[0] = DD_ONE(ddS);
+    map->images[0] = DD_ONE(ddD);
+    map->kids[0] = map->kids[1] = 0;
+    map->count = 1;
+    return(1);
 
-    statLine(ddD);
-    one = DD_ONE(ddD);
-    comple = Cudd_IsComplement(f);
+} /* end of ddTransferMapInit */
 
-    /* Trivial cases. */
-    if (Cudd_IsConstantInt(f)) return(Cudd_NotCond(one, comple));
 
-    /* Make canonical to increase the utilization of the cache. */
-    f = Cudd_NotCond(f,comple);
-    /* Now f is a regular pointer to a non-constant node. */
+/**
+  @brief Frees the map of the nodes visited by a transfer.
 
-    /* Check the cache. */
-    if (st_lookup(table, f, (void **) &res))
-	return(Cudd_NotCond(res,comple));
-    
-    /* Recursive step. */
-    index = f->index;
-    ft = cuddT(f); fe = cuddE(f);
+  @sideeffect None
 
-    t = cuddBddTransferRecur(ddS, ddD, ft, table);
-    if (t == NULL) {
-    	return(NULL);
-    }
-    cuddRef(t);
+  @see ddTransferMapInit
 
-    e = cuddBddTransferRecur(ddS, ddD, fe, table);
-    if (e == NULL) {
-    	Cudd_RecursiveDeref(ddD, t);
-    	return(NULL);
-    }
-    cuddRef(e);
+*/
+static void
+ddTransferMapFree(
+  DdTransferMap * map)
+{
+    if (map->nodes != NULL) FREE(map->nodes);
+    if (map->kids != NULL) FREE(map->kids);
+    if (map->images != NULL) FREE(map->images);
+    if (map->slots != NULL) FREE(map->slots);
+
+} /* end of ddTransferMapFree */
+
+
+/**
+  @brief Visits a node of the source manager for a transfer.
 
-    zero = Cudd_Not(one);
-    var = cuddUniqueInter(ddD,index,one,zero);
-    if (var == NULL) {
-	Cudd_RecursiveDeref(ddD, t);
-	Cudd_RecursiveDeref(ddD, e);
-    	return(NULL);
+  @details Gives ids to the regular node f and to its descendants that
+  have not been visited yet.
+
+  @return 1 if successful; 0 if memory is exhausted.
+
+  @sideeffect The id of f is stored in id.
+
+  @see ddTransferAdd
+
+*/
+static int
+ddTransferVisit(
+  DdTransferMap * map,
+  DdNode * f,
+  unsigned int * id)
+{
+    unsigned int pos, t, e;
+
+    if (cuddIsConstant(f)) {
+	*id = 0;
+	return(1);
     }
-    res = cuddBddIteRecur(ddD,var,t,e);
-    if (res == NULL) {
-	Cudd_RecursiveDeref(ddD, t);
-	Cudd_RecursiveDeref(ddD, e);
-	return(NULL);
+    pos = ddTransferHash(f, map->mask);
+    while (map->slots[pos] != 0) {
+	if (map->nodes[map->slots[pos]] == f) {
+	    *id = map->slots[pos];
+	    return(1);
+	}
+	pos = (pos + 1) & map->mask;
     }
-    cuddRef(res);
-    Cudd_RecursiveDeref(ddD, t);
-    Cudd_RecursiveDeref(ddD, e);
+    if (!ddTransferVisit(map, cuddT(f), &t)) return(0);
+    if (!ddTransferVisit(map, Cudd_Regular(cuddE(f)), &e)) return(0);
+    if (!ddTransferAdd(map, f, t, e)) return(0);
+    *id = map->count - 1;
+    return(1);
 
-    if (st_add_direct(table, f, res) == ST_OUT_OF_MEM) {
-	Cudd_RecursiveDeref(ddD, res);
-	return(NULL);
+} /* end of ddTransferVisit */
+
+
+/**
+  @brief Gives the next id to a node of the source manager.
+
+  @details Grows the map when needed, keeping the table at most half
+  full.
+
+  @return 1 if successful; 0 if memory is exhausted.
+
+  @sideeffect None
+
+  @see ddTransferVisit
+
+*/
+static int
+ddTransferAdd(
+  DdTransferMap * map,
+  DdNode * f,
+  unsigned int t,
+  unsigned int e)
+{
+    unsigned int pos, i, capacity, *kids, *slots;
+    DdNodePtr *nodes, *images;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+
+    if (map->count == map->capacity) {
+	capacity = 2 * map->capacity;
+	saveHandler = MMoutOfMemory;
+	MMoutOfMemory = map->manager->outOfMemCallback;
+	nodes = REALLOC(DdNodePtr, map->nodes, capacity);
+	if (nodes != NULL) map->nodes = nodes;
+	kids = REALLOC(unsigned int, map->kids, 2 * capacity);
+	if (kids != NULL) map->kids = kids;
+	images = REALLOC(DdNodePtr, map->images, capacity);
+	if (images != NULL) map->images = images;
+	slots = ALLOC(unsigned int, 2 * capacity);
+	MMoutOfMemory = saveHandler;
+	if (nodes == NULL || kids == NULL || images == NULL || slots == NULL) {
+	    if (slots != NULL) FREE(slots);
+	    return(0);
+	}
+	map->capacity = capacity;
+	map->mask = 2 * capacity - 1;
+	for (i = 0; i <= map->mask; i++) slots[i] = 0;
+	for (i = 1; i < map->count; i++) {
+	    pos = ddTransferHash(map->nodes[i], map->mask);
+	    while (slots[pos] != 0) pos = (pos + 1) & map->mask;
+	    slots[pos] = i;
+	}
+	FREE(map->slots);
+	map->slots = slots;
+    }
+    pos = ddTransferHash(f, map->mask);
+    while (map->slots[pos] != 0) pos = (pos + 1) & map->mask;
+    map->slots[pos] = map->count;
+    map->nodes[map->count] = f;
+    map->kids[2 * map->count] = t;
+    map->kids[2 * map->count + 1] = e;
+    map->count++;
+    return(1);
+
+} /* end of ddTransferAdd */
+
+
+/**
+  @brief Builds the image of a node in the destination manager.
+
+  @details T and E are the images of the children.  If the variable of
+  the node is above both of them in the destination order, the node is
+  found or created in the unique table; otherwise it is built by ITE.
+
+  @return a pointer to the image if successful; NULL otherwise.
+
+  @sideeffect None
+
+  @see cuddBddTransferVector
+
+*/
+static DdNode *
+ddTransferNode(
+  DdManager * ddD,
+  unsigned int index,
+  DdNode * T,
+  DdNode * E)
+{
+    DdNode *one, *var, *res;
+
+#ifdef DD_DEBUG
+    assert(T != E);
+#endif
+    if ((int) index < ddD->size &&
+	ddD->perm[index] < cuddI(ddD, Cudd_Regular(T)->index) &&
+	ddD->perm[index] < cuddI(ddD, Cudd_Regular(E)->index)) {
+	if (Cudd_IsComplement(T)) {
+	    res = cuddUniqueInter(ddD, (int) index, Cudd_Not(T), Cudd_Not(E));
+	    return(Cudd_NotCond(res, res != NULL));
+	}
+	return(cuddUniqueInter(ddD, (int) index, T, E));
     }
-    return(Cudd_NotCond(res,comple));
+    one = DD_ONE(ddD);
+    var = cuddUniqueInter(ddD, (int) index, one, Cudd_Not(one));
+    if (var == NULL) return(NULL);
+    return(cuddBddIteRecur(ddD, var, T, E));
 
-} /* end of cuddBddTransferRecur */
+} /* end of ddTransferNode */
 
@@ -73,6 +73,17 @@
 /* Macro declarations                                                        */
 /*---------------------------------------------------------------------------*/
 
+/**
+  @brief Hash function for the filter of the nodes seen in the cache.
+
+  @details Two different primes give the two probes of the filter.
+
+  @sideeffect None
+
+*/
+#define ddFilterHash(node,prime,shift) \
+((unsigned) ((unsigned) ((ptruint) (node) >> 3) * (prime)) >> (shift))
+
 /** \cond */
 
 /*---------------------------------------------------------------------------*/
@@ -935,6 +946,110 @@ cuddCacheResize(
 } /* end of cuddCacheResize */
 
 
+/**
+  @brief Halves the cache.
+
+  @details Keeps the valid entries that still find a slot of their
+  own; the others are counted as deletions.  Used to relieve memory
+  pressure.  If hard is nonzero, the cache is not allowed to grow
+  again past its new size; otherwise it may grow again once the limits
+  are next recomputed.  The cache is not shrunk below
+  DD_MIN_CACHE_SLOTS entries.
+
+  @return 1 if the cache was shrunk; 0 otherwise.
+
+  @sideeffect None
+
+  @see cuddCacheResize
+
+*/
+int
+cuddCacheShrink(
+  DdManager * table,
+  int hard)
+{
+    DdCache *cache, *oldcache, *oldacache, *entry, *old;
+    int i;
+    int posn, shift;
+    unsigned int slots, oldslots;
+    double offset;
+    int moved = 0;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+#ifndef DD_CACHE_PROFILE
+    ptruint misalignment;
+    DdNodePtr *mem;
+#endif
+
+    oldcache = table->cache;
+    oldacache = table->acache;
+    oldslots = table->cacheSlots;
+    if (oldslots < 2 * DD_MIN_CACHE_SLOTS) return(0);
+    slots = oldslots >> 1;
+
+    saveHandler = MMoutOfMemory;
+    MMoutOfMemory = table->outOfMemCallback;
+    cache = ALLOC(DdCache,slots+1);
+    MMoutOfMemory = saveHandler;
+    if (cache == NULL) return(0);
+    table->acache = cache;
+#ifdef DD_CACHE_PROFILE
+    table->cache = cache;
+#else
+    mem = (DdNodePtr *) cache;
+    misalignment = (ptruint) mem & (sizeof(DdCache) - 1);
+    mem += (sizeof(DdCache) - misalignment) / sizeof(DdNodePtr);
+    table->cache = cache = (DdCache *) mem;
+    assert(((ptruint) table->cache & (sizeof(DdCache) - 1)) == 0);
+#endif
+    table->cacheSlots = slots;
+    shift = ++(table->cacheShift);
+    table->memused -= (oldslots - slots) * sizeof(DdCache);
+    /* Only the hard limit keeps the cache from growing again. */
+    if (hard) table->maxCacheHard = slots;
+    table->cacheSlack = - (int) (slots + 1);
+
+    for (i = 0; (unsigned) i < slots; i++) {
+	cache[i].data = NULL;
+	cache[i].h = 0;
+#ifdef DD_CACHE_PROFILE
+	cache[i].count = 0;
+#endif
+    }
+
+    for (i = 0; (unsigned) i < oldslots; i++) {
+	old = &oldcache[i];
+	if (old->data == NULL) continue;
+	posn = ddCHash2(old->h,old->f,old->g,shift);
+	entry = &cache[posn];
+	if (entry->data != NULL) {
+	    table->cachedeletions++;
+	    continue;
+	}
+	entry->f = old->f;
+	entry->g = old->g;
+	entry->h = old->h;
+	entry->data = old->data;
+#ifdef DD_CACHE_PROFILE
+	entry->count = 1;
+#endif
+	moved++;
+    }
+
+    FREE(oldacache);
+
+    offset = (double) (int) (slots * table->minHit + 1);
+    table->totCacheMisses += table->cacheMisses - offset;
+    table->cacheMisses = offset;
+    table->totCachehits += table->cacheHits;
+    table->cacheHits = 0;
+    table->cacheLastInserts = table->cacheinserts - (double) moved;
+
+    return(1);
+
+} /* end of cuddCacheShrink */
+
+
 /**
   @brief Flushes the cache.
 
@@ -961,6 +1076,293 @@ cuddCacheFlush(
 } /* end of cuddCacheFlush */
 
 
+/**
+  @brief Updates the cache after the nodes have been moved.
+
+  @details Called by Cudd_Compact while the next field of each live
+  internal node points to its new location, in which case source is
+  the same manager as table.  Called by Cudd_CloneManager while the
+  next field of every node of source, constants included, points to its
+  copy in table; then the entries of source are left in place.  The
+  entries are hashed again, since their positions depend on the
+  addresses of the nodes.  The entries that collide are dropped; if
+  there is not enough memory to hold the entries while they are moved,
+  the cache of table is flushed.  The operands keep their positions in
+  each entry: the commutative operations that put their operands in
+  address order before looking them up no longer find the entries
+  whose operands have changed order.  Such entries are wasted, but
+  never give wrong results.  Assumes that the cache of source only
+  refers to nodes in its unique table.
+
+  @sideeffect None
+
+  @see Cudd_Compact Cudd_CloneManager cuddCacheFlush
+
+*/
+void
+cuddCacheRelocate(
+  DdManager * table,
+  DdManager * source)
+{
+    int i, n, slots, posn, moveConstants;
+    DdCache *cache, *entry, *moved;
+    DdNode *f;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+
+    slots = source->cacheSlots;
+    cache = source->cache;
+    moveConstants = source != table;
+    n = 0;
+    for (i = 0; i < slots; i++) {
+	n += cache[i].data != NULL;
+    }
+    if (n == 0) return;
+    saveHandler = MMoutOfMemory;
+    MMoutOfMemory = table->outOfMemCallback;
+    moved = ALLOC(DdCache,n);
+    MMoutOfMemory = saveHandler;
+    if (moved == NULL) {
+	cuddCacheFlush(table);
+	return;
+    }
+
+    /* Translate the valid entries, keeping the tag bits of the
+    ** operands. */
+    n = 0;
+    for (i = 0; i < slots; i++) {
+	entry = &cache[i];
+	if (entry->data == NULL) continue;
+	moved[n] = *entry;
+	f = cuddClean(entry->f);
+	if (moveConstants || !cuddIsConstant(f))
+	    moved[n].f = (DdNode *) ((ptruint) f->next |
+				     ((ptruint) entry->f & 0xf));
+	f = cuddClean(entry->g);
+	if (moveConstants || !cuddIsConstant(f))
+	    moved[n].g = (DdNode *) ((ptruint) f->next |
+				     ((ptruint) entry->g & 0xf));
+	if ((ptruint) entry->f & 0x2) {
+	    f = Cudd_Regular(entry->h);
+	    if (moveConstants || !cuddIsConstant(f))
+		moved[n].h = (ptruint) Cudd_NotCond(f->next,
+						    Cudd_IsComplement(entry->h));
+	}
+	if (entry->data != DD_NON_CONSTANT) {
+	    f = Cudd_Regular(entry->data);
+	    if (moveConstants || !cuddIsConstant(f))
+		moved[n].data = Cudd_NotCond(f->next,
+					     Cudd_IsComplement(entry->data));
+	}
+	if (!moveConstants) entry->data = NULL;
+	n++;
+    }
+
+    /* Put them back where the lookups will find them. */
+    cache = table->cache;
+    for (i = 0; i < n; i++) {
+	posn = ddCHash2(moved[i].h,moved[i].f,moved[i].g,table->cacheShift);
+	entry = &cache[posn];
+	table->cachedeletions += entry->data != NULL;
+	*entry = moved[i];
+    }
+    FREE(moved);
+
+} /* end of cuddCacheRelocate */
+
+
+/**
+  @brief Removes from the cache the entries that refer to dead nodes.
+
+  @details An entry is removed if any of its operands or its result
+  has a reference count of 0.
+
+  @sideeffect None
+
+  @see cuddCacheFlush cuddGarbageCollect
+
+*/
+void
+cuddCacheClearDead(
+  DdManager * table)
+{
+    int i, slots;
+    DdCache *cache, *c;
+
+    slots = table->cacheSlots;
+    cache = table->cache;
+    for (i = 0; i < slots; i++) {
+	c = &cache[i];
+	if (c->data != NULL) {
+	    if (cuddClean(c->f)->ref == 0 ||
+	    cuddClean(c->g)->ref == 0 ||
+	    (((ptruint)c->f & 0x2) && Cudd_Regular(c->h)->ref == 0) ||
+	    (c->data != DD_NON_CONSTANT &&
+	    Cudd_Regular(c->data)->ref == 0)) {
+		c->data = NULL;
+		table->cachedeletions++;
+	    }
+	}
+    }
+
+} /* end of cuddCacheClearDead */
+
+
+/**
+  @brief Prepares the cache to survive reordering.
+
+  @details Reordering preserves the function of every node that
+  stays alive; hence, a cache entry is only invalidated if one of the
+  nodes it refers to is freed, and its memory is recycled for a
+  different node.  This function records the nodes that appear in the
+  cache in a Bloom filter.  While the filter exists, reordering sets
+  aside the freed nodes that may appear in the cache instead of
+  returning them to the free list.  It assumes that there are no dead
+  nodes.  If the filter cannot be allocated, the cache is flushed.
+
+  @sideeffect The filter is allocated.
+
+  @see cuddCacheRetireNode cuddCacheKeepEnd
+
+*/
+void
+cuddCacheKeepStart(
+  DdManager * table)
+{
+    int i, slots;
+    unsigned int nodes, bits, words, h;
+    int logBits;
+    DdCache *cache, *c;
+    DdNode *n[4];
+    int k, nn;
+    ptruint *filter;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+
+    slots = table->cacheSlots;
+    cache = table->cache;
+
+    /* Size the filter with at least eight bits for each of the (at
+    ** most four) node pointers of each valid entry. */
+    nodes = 0;
+    for (i = 0; i < slots; i++) {
+	if (cache[i].data != NULL) nodes += 4;
+    }
+    logBits = cuddComputeFloorLog2(nodes + 1) + 3;
+    if (logBits < 6) logBits = 6;
+    if (logBits > 31) logBits = 31;
+    bits = 1U << logBits;
+    words = bits / (sizeof(ptruint) * 8);
+    saveHandler = MMoutOfMemory;
+    MMoutOfMemory = table->outOfMemCallback;
+    filter = ALLOC(ptruint,words);
+    MMoutOfMemory = saveHandler;
+    if (filter == NULL) {
+	cuddCacheFlush(table);
+	return;
+    }
+    memset(filter, 0, words * sizeof(ptruint));
+    table->memused += words * sizeof(ptruint);
+    table->cacheFilter = filter;
+    table->cacheFilterShift = 32 - logBits;
+    table->cacheLimbo = NULL;
+
+    for (i = 0; i < slots; i++) {
+	c = &cache[i];
+	if (c->data == NULL) continue;
+	nn = 0;
+	n[nn++] = cuddClean(c->f);
+	n[nn++] = cuddClean(c->g);
+	if ((ptruint)c->f & 0x2) n[nn++] = Cudd_Regular(c->h);
+	if (c->data != DD_NON_CONSTANT) n[nn++] = Cudd_Regular(c->data);
+	for (k = 0; k < nn; k++) {
+	    if (cuddIsConstant(n[k])) continue;
+	    h = ddFilterHash(n[k],DD_P1,table->cacheFilterShift);
+	    filter[h / (sizeof(ptruint) * 8)] |=
+		(ptruint) 1 << (h % (sizeof(ptruint) * 8));
+	    h = ddFilterHash(n[k],DD_P2,table->cacheFilterShift);
+	    filter[h / (sizeof(ptruint) * 8)] |=
+		(ptruint) 1 << (h % (sizeof(ptruint) * 8));
+	}
+    }
+
+} /* end of cuddCacheKeepStart */
+
+
+/**
+  @brief Frees a node during reordering while the cache is preserved.
+
+  @details If the node may appear in the cache, it is put in limbo
+  until cuddCacheKeepEnd has removed the entries that refer to it.
+  Otherwise, it is returned to the free list.
+
+  @sideeffect None
+
+  @see cuddCacheKeepStart cuddCacheKeepEnd
+
+*/
+void
+cuddCacheRetireNode(
+  DdManager * table,
+  DdNode * node)
+{
+    ptruint *filter = table->cacheFilter;
+    unsigned int h1, h2;
+    int bitsPerWord = sizeof(ptruint) * 8;
+
+    h1 = ddFilterHash(node,DD_P1,table->cacheFilterShift);
+    h2 = ddFilterHash(node,DD_P2,table->cacheFilterShift);
+    if ((filter[h1 / bitsPerWord] & ((ptruint) 1 << (h1 % bitsPerWord))) &&
+	(filter[h2 / bitsPerWord] & ((ptruint) 1 << (h2 % bitsPerWord)))) {
+	node->next = table->cacheLimbo;
+	table->cacheLimbo = node;
+    } else {
+	cuddDeallocNode(table,node);
+    }
+
+} /* end of cuddCacheRetireNode */
+
+
+/**
+  @brief Ends the preservation of the cache across reordering.
+
+  @details Removes the entries that refer to nodes freed during
+  reordering, returns those nodes to the free list, and releases the
+  filter.  Does nothing if cuddCacheKeepStart did not allocate a
+  filter.
+
+  @sideeffect None
+
+  @see cuddCacheKeepStart cuddCacheRetireNode
+
+*/
+void
+cuddCacheKeepEnd(
+  DdManager * table)
+{
+    DdNode *node, *next;
+    unsigned int words;
+
+    if (table->cacheFilter == NULL) return;
+
+    /* The nodes in limbo have reference count 0. */
+    cuddCacheClearDead(table);
+    node = table->cacheLimbo;
+    while (node != NULL) {
+	next = node->next;
+	cuddDeallocNode(table,node);
+	node = next;
+    }
+    table->cacheLimbo = NULL;
+
+    words = (1U << (32 - table->cacheFilterShift)) / (sizeof(ptruint) * 8);
+    FREE(table->cacheFilter);
+    table->cacheFilter = NULL;
+    table->memused -= words * sizeof(ptruint);
+
+} /* end of cuddCacheKeepEnd */
+
+
 /**
   @brief Returns the floor of the logarithm to the base 2.
 
@@ -0,0 +1,1399 @@
+/**
+  @file
+
+  @ingroup cudd
+
+  @brief Checkpoint and restore of a manager, and persistent variable
+  orders.
+
+  @copyright@parblock
+  Copyright (c) 1995-2015, Regents of the University of Colorado
+
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+
+  Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  Neither the name of the University of Colorado nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+  @endparblock
+
+*/
+
+#include <ctype.h>
+#include "util.h"
+#include "cuddInt.h"
+
+#include "mtrInt.h"
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/** Initial number of node records of the checkpoint state. */
+#define DD_CHECKPOINT_INIT_ENTRIES 1024
+
+/** Longest variable name kept by an order database. */
+#define DD_ORDER_MAX_NAME 1023
+
+/*---------------------------------------------------------------------------*/
+/* Stucture declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/**
+ *  @brief Contents of one checkpoint of a file, except the nodes.
+ */
+typedef struct DdCheckpointHeader {
+    unsigned int epoch;		/**< number of the checkpoint */
+    int size;			/**< number of %BDD/%ADD variables */
+    int sizeZ;			/**< number of %ZDD variables */
+    int *invperm;		/**< %BDD/%ADD order */
+    int *invpermZ;		/**< %ZDD order */
+    char **names;		/**< variable names (or NULL) */
+    MtrNode *tree;		/**< %BDD/%ADD group tree */
+    MtrNode *treeZ;		/**< %ZDD group tree */
+    int nroots;			/**< number of roots */
+    int *roots;			/**< pairs (id, number of references) */
+} DdCheckpointHeader;
+
+/**
+ *  @brief One order of a variable-order database.
+ */
+typedef struct DdOrderRecord {
+    int size;			/**< number of variables */
+    int *invperm;		/**< saved index of each level */
+    char **names;		/**< saved name of each level (or NULL) */
+    MtrNode *tree;		/**< saved group tree */
+} DdOrderRecord;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+/** \cond */
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static DdCheckpoint * ddCheckpointAlloc(char const *path);
+static int ddCheckpointOrderKept(DdManager *dd, DdCheckpoint *ckpt);
+static int ddCheckpointReserve(DdCheckpoint *ckpt, int n);
+static int ddCheckpointSaveOrder(DdManager *dd, DdCheckpoint *ckpt);
+static int ddCheckpointNumber(DdManager *dd, DdCheckpoint *ckpt, DdNode **live, int *liveIds, int *nlive);
+static int ddCheckpointWrite(DdManager *dd, DdCheckpoint *ckpt, FILE *fp, char const * const *inames, int firstNew, int nroots, int *roots);
+static int ddCheckpointWriteTree(FILE *fp, MtrNode *node);
+static int ddCheckpointReadTree(FILE *fp, MtrNode **node);
+static int ddCheckpointReadEpoch(FILE *fp, DdCheckpointHeader *hdr, long *offset, int *count);
+static void ddCheckpointFreeHeader(DdCheckpointHeader *hdr);
+static int ddOrderRead(FILE *fp, DdOrderRecord *rec);
+static void ddOrderFree(DdOrderRecord *rec);
+static char * ddOrderSignature(char const *name);
+static int ddOrderMatch(DdManager *dd, DdOrderRecord *rec, char const * const *varnames, st_table *exact, st_table *loose, int *used, int *map);
+static void ddOrderTranslateTree(MtrNode *node, int *map, int size);
+
+/** \endcond */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**
+  @brief Writes a checkpoint of the manager to a file.
+
+  @details The checkpoint records the %BDD and %ADD variable order,
+  the number of %ZDD variables and their order, the variable group
+  trees, the names of the variables (if inames is not NULL), all the
+  live %BDD and %ADD nodes, and the nodes referenced from outside the
+  manager, with the number of such references.
+  <p>
+  A checkpoint is incremental if the previous checkpoint of the
+  manager was written to (or restored from) the same file and the
+  variables that existed then are still in the same relative order.
+  Only the nodes created since are then appended to the file, together
+  with the current orders, trees, names and roots.  Otherwise the file
+  is rewritten: the new file is written under a temporary name and
+  then renamed, so that the previous checkpoint survives a crash.  A
+  crash during an incremental checkpoint leaves an incomplete tail,
+  which Cudd_Restore ignores.
+  <p>
+  The manager keeps one record for every node written to the file,
+  and maps only the nodes live at the last checkpoint to their
+  records.  The file is also rewritten when more than half of its
+  records belong to nodes that have been freed since, so that neither
+  the file nor this state grows without bound over a long series of
+  checkpoints.
+  <p>
+  Node records are written in the native binary format of the
+  machine.  %ZDD nodes are not recorded, nor are the references to
+  the constants that the manager owns (one, zero and the infinities).
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect The manager remembers the nodes written to the file for
+  the next incremental checkpoint.
+
+  @see Cudd_Restore
+
+*/
+int
+Cudd_Checkpoint(
+  DdManager * dd /**< manager */,
+  char const * path /**< name of the checkpoint file */,
+  char const * const * inames /**< array of variable names (or NULL) */)
+{
+    DdCheckpoint *ckpt;
+    FILE *fp = NULL;
+    DdNode **live = NULL;
+    DdNode *node;
+    DdCheckpointEntry *entry;
+    char *tmpPath = NULL;
+    int *liveIds = NULL;
+    int *arcs = NULL;
+    int *roots = NULL;
+    int incremental, firstNew, nlive, nroots, i, id, ext;
+
+#ifndef DD_NO_DEATH_ROW
+    cuddClearDeathRow(dd);
+#endif
+
+    /* Decide whether this checkpoint can extend the previous one. */
+    ckpt = dd->checkpoint;
+    incremental = ckpt != NULL && strcmp(ckpt->path, path) == 0 &&
+	ckpt->nextId <= 2 * (int) (dd->keys - dd->dead) +
+	DD_CHECKPOINT_INIT_ENTRIES && ddCheckpointOrderKept(dd, ckpt);
+    if (incremental) {
+	fp = fopen(path, "r+b");
+	if (fp != NULL && fseek(fp, 0L, SEEK_END) != 0) {
+	    (void) fclose(fp);
+	    fp = NULL;
+	}
+	if (fp == NULL) incremental = 0;
+    }
+    if (!incremental) {
+	cuddFreeCheckpoint(dd);
+	ckpt = ddCheckpointAlloc(path);
+	tmpPath = ALLOC(char, strlen(path) + 5);
+	if (ckpt == NULL || tmpPath == NULL) {
+	    if (ckpt != NULL) {
+		dd->checkpoint = ckpt;
+		cuddFreeCheckpoint(dd);
+	    }
+	    if (tmpPath != NULL) FREE(tmpPath);
+	    dd->errorCode = CUDD_MEMORY_OUT;
+	    return(0);
+	}
+	dd->checkpoint = ckpt;
+	sprintf(tmpPath, "%s.tmp", path);
+	fp = fopen(tmpPath, "wb");
+	if (fp == NULL) goto failure;
+    }
+    ckpt->epoch++;
+    firstNew = ckpt->nextId;
+
+    /* Number the live nodes. */
+    live = ALLOC(DdNode *, dd->keys);
+    liveIds = ALLOC(int, dd->keys);
+    if (live == NULL || liveIds == NULL) {
+	dd->errorCode = CUDD_MEMORY_OUT;
+	goto failure;
+    }
+    if (!ddCheckpointNumber(dd, ckpt, live, liveIds, &nlive)) goto failure;
+
+    /* The references from outside the manager are those that come
+    ** neither from live nodes nor from the manager itself. */
+    arcs = ALLOC(int, ckpt->nextId);
+    roots = ALLOC(int, 2 * nlive + 1);
+    if (arcs == NULL || roots == NULL) {
+	dd->errorCode = CUDD_MEMORY_OUT;
+	goto failure;
+    }
+    for (i = 0; i < ckpt->nextId; i++) arcs[i] = 0;
+    for (i = 0; i < nlive; i++) {
+	entry = &ckpt->entries[liveIds[i]];
+	if (entry->index >= 0) {
+	    arcs[entry->u.kids.t]++;
+	    arcs[entry->u.kids.e >> 1]++;
+	}
+    }
+    nroots = 0;
+    for (i = 0; i < nlive; i++) {
+	node = live[i];
+	id = liveIds[i];
+	if (node->ref == DD_MAXREF) continue;
+	if (cuddIsConstant(node)) {
+	    if (node == DD_ONE(dd) || node == DD_ZERO(dd) ||
+		node == DD_PLUS_INFINITY(dd) || node == DD_MINUS_INFINITY(dd))
+		continue;
+	    ext = (int) node->ref - arcs[id];
+	} else {
+	    ext = (int) node->ref - arcs[id] - (node == dd->vars[node->index]);
+	}
+	if (ext > 0) {
+	    roots[2 * nroots] = id;
+	    roots[2 * nroots + 1] = ext;
+	    nroots++;
+	}
+    }
+
+    if (!ddCheckpointWrite(dd, ckpt, fp, inames, firstNew, nroots, roots))
+	goto failure;
+    i = fclose(fp);
+    fp = NULL;
+    if (i == EOF) goto failure;
+    if (tmpPath != NULL) {
+	if (rename(tmpPath, path) != 0) goto failure;
+	FREE(tmpPath);
+	tmpPath = NULL;
+    }
+    if (!ddCheckpointSaveOrder(dd, ckpt)) goto failure;
+
+    FREE(live);
+    FREE(liveIds);
+    FREE(arcs);
+    FREE(roots);
+    return(1);
+
+failure:
+    if (fp != NULL) (void) fclose(fp);
+    if (tmpPath != NULL) {
+	(void) remove(tmpPath);
+	FREE(tmpPath);
+    }
+    if (live != NULL) FREE(live);
+    if (liveIds != NULL) FREE(liveIds);
+    if (arcs != NULL) FREE(arcs);
+    if (roots != NULL) FREE(roots);
+    /* The file may be incomplete: start afresh next time. */
+    cuddFreeCheckpoint(dd);
+    return(0);
+
+} /* end of Cudd_Checkpoint */
+
+
+/**
+  @brief Restores a manager from a checkpoint file.
+
+  @details Reads the checkpoints in the file, as written by
+  Cudd_Checkpoint, creates a new manager with the variable orders and
+  group trees of the last complete one, and rebuilds its nodes.  An
+  incomplete checkpoint at the end of the file is ignored.  The roots
+  are returned in an array allocated with malloc, where each root
+  appears once for every reference it had from outside the manager:
+  the caller owns these references.  The roots are regular nodes,
+  because the references do not tell which phase the application
+  uses.  If roots is NULL, the roots are not referenced.  If inames is not NULL, it is set to the array of
+  variable names of the checkpoint (NULL if it had none), which the
+  caller must free together with its entries.  A checkpoint of the
+  restored manager to the same file is incremental.
+
+  @return a pointer to the new manager if successful; NULL otherwise.
+
+  @sideeffect None
+
+  @see Cudd_Checkpoint Cudd_Init
+
+*/
+DdManager *
+Cudd_Restore(
+  char const * path /**< name of the checkpoint file */,
+  char *** inames /**< array of variable names (output, may be NULL) */,
+  DdNode *** roots /**< array of roots (output, may be NULL) */,
+  int * nroots /**< number of roots (output, may be NULL) */)
+{
+    FILE *fp;
+    DdManager *dd = NULL;
+    DdCheckpoint *ckpt = NULL;
+    DdCheckpointHeader last, cur;
+    DdCheckpointEntry *entry;
+    DdNode **nodes = NULL;
+    DdNode **res;
+    DdNode *T, *E, *f;
+    long *offsets = NULL;
+    int *counts = NULL;
+    long offset;
+    int nepochs, total, complete, nres, n, i, j, k, id, status;
+
+    memset(&last, 0, sizeof(last));
+    memset(&cur, 0, sizeof(cur));
+
+    fp = fopen(path, "rb");
+    if (fp == NULL) return(NULL);
+
+    /* First pass: read the headers and the roots, skip the nodes. */
+    nepochs = 0;
+    while ((status = ddCheckpointReadEpoch(fp, &cur, &offset, &n)) == 1) {
+	offsets = REALLOC(long, offsets, nepochs + 1);
+	counts = REALLOC(int, counts, nepochs + 1);
+	if (offsets == NULL || counts == NULL) goto failure;
+	offsets[nepochs] = offset;
+	counts[nepochs] = n;
+	nepochs++;
+	ddCheckpointFreeHeader(&last);
+	last = cur;
+	memset(&cur, 0, sizeof(cur));
+    }
+    ddCheckpointFreeHeader(&cur);
+    complete = status == 0;
+    if (nepochs == 0) goto failure;
+
+    /* Create the manager with the last order and trees. */
+    dd = Cudd_Init((unsigned int) last.size, (unsigned int) last.sizeZ,
+		   CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+    if (dd == NULL) goto failure;
+    if (last.size > 1 && !Cudd_ShuffleHeap(dd, last.invperm)) goto failure;
+    if (last.sizeZ > 1 && !Cudd_zddShuffleHeap(dd, last.invpermZ))
+	goto failure;
+    dd->tree = last.tree;
+    dd->treeZ = last.treeZ;
+    last.tree = last.treeZ = NULL;
+
+    /* Second pass: rebuild the nodes, in the order of their ids. */
+    ckpt = ddCheckpointAlloc(path);
+    if (ckpt == NULL) goto failure;
+    for (i = 0, total = 0; i < nepochs; i++) total += counts[i];
+    nodes = ALLOC(DdNode *, total + 1);
+    if (nodes == NULL || !ddCheckpointReserve(ckpt, total + 1))
+	goto failure;
+    for (i = 0; i < nepochs; i++) {
+	if (fseek(fp, offsets[i], SEEK_SET) != 0 ||
+	    fread(ckpt->entries + ckpt->nextId, sizeof(DdCheckpointEntry),
+		  (size_t) counts[i], fp) != (size_t) counts[i])
+	    goto cleanup;
+	for (j = 0; j < counts[i]; j++) {
+	    id = ckpt->nextId;
+	    entry = &ckpt->entries[id];
+	    if (entry->index < 0) {
+		f = cuddUniqueConst(dd, entry->u.value);
+	    } else {
+		if (entry->index >= last.size || entry->u.kids.t < 1 ||
+		    entry->u.kids.t >= id || (entry->u.kids.e >> 1) < 1 ||
+		    (entry->u.kids.e >> 1) >= id) goto cleanup;
+		T = nodes[entry->u.kids.t];
+		E = Cudd_NotCond(nodes[entry->u.kids.e >> 1],
+				 entry->u.kids.e & 1);
+		if (T == E ||
+		    dd->perm[entry->index] >= cuddI(dd, T->index) ||
+		    dd->perm[entry->index] >= cuddI(dd, Cudd_Regular(E)->index))
+		    goto cleanup;
+		f = cuddUniqueInter(dd, entry->index, T, E);
+	    }
+	    if (f == NULL) goto cleanup;
+	    cuddRef(f);
+	    nodes[id] = f;
+	    ckpt->nextId++;
+	    if (st_insert(ckpt->ids, f, (void *) (ptrint) id) == ST_OUT_OF_MEM)
+		goto cleanup;
+	}
+    }
+
+    /* Reference the roots. */
+    for (i = 0, nres = 0; i < last.nroots; i++) {
+	if (last.roots[2 * i] < 1 || last.roots[2 * i] >= ckpt->nextId ||
+	    last.roots[2 * i + 1] < 1) goto cleanup;
+	nres += last.roots[2 * i + 1];
+    }
+    if (roots != NULL) {
+	res = ALLOC(DdNode *, nres + 1);
+	if (res == NULL) goto cleanup;
+	for (i = 0, k = 0; i < last.nroots; i++) {
+	    f = nodes[last.roots[2 * i]];
+	    for (j = 0; j < last.roots[2 * i + 1]; j++) {
+		cuddRef(f);
+		res[k++] = f;
+	    }
+	}
+	*roots = res;
+    }
+    if (nroots != NULL) *nroots = nres;
+    for (id = 1; id < ckpt->nextId; id++) {
+	Cudd_RecursiveDeref(dd, nodes[id]);
+    }
+
+    /* Further checkpoints to this file are incremental, unless its
+    ** tail is incomplete. */
+    ckpt->epoch = last.epoch;
+    dd->checkpoint = ckpt;
+    if (!complete || !ddCheckpointSaveOrder(dd, ckpt)) {
+	cuddFreeCheckpoint(dd);
+    }
+
+    if (inames != NULL) {
+	*inames = last.names;
+	last.names = NULL;
+    }
+    ddCheckpointFreeHeader(&last);
+    FREE(nodes);
+    FREE(offsets);
+    FREE(counts);
+    (void) fclose(fp);
+    return(dd);
+
+cleanup:
+    for (id = 1; id < ckpt->nextId; id++) {
+	Cudd_RecursiveDeref(dd, nodes[id]);
+    }
+failure:
+    (void) fclose(fp);
+    if (ckpt != NULL) {
+	st_free_table(ckpt->ids);
+	FREE(ckpt->entries);
+	FREE(ckpt->path);
+	FREE(ckpt);
+    }
+    if (dd != NULL) Cudd_Quit(dd);
+    if (nodes != NULL) FREE(nodes);
+    ddCheckpointFreeHeader(&last);
+    ddCheckpointFreeHeader(&cur);
+    if (offsets != NULL) FREE(offsets);
+    if (counts != NULL) FREE(counts);
+    return(NULL);
+
+} /* end of Cudd_Restore */
+
+
+/**
+  @brief Appends the current variable order to an order database.
+
+  @details Writes the %BDD/%ADD order, with the names of the
+  variables and the variable group tree, to fp as one record of a
+  database that Cudd_LoadOrder reads.  Records are appended in the
+  order in which they are written, so that several designs, or several
+  versions of one design, can share a file opened for appending.  A
+  variable without a name (or all variables, if varnames is NULL) is
+  matched by index when the order is loaded.  Names are taken to be
+  free of white space.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+  @see Cudd_LoadOrder
+
+*/
+int
+Cudd_SaveOrder(
+  DdManager * dd /**< manager */,
+  FILE * fp /**< database file */,
+  char const * const * varnames /**< variable names indexed by variable index (or NULL) */)
+{
+    char const *name;
+    int level, index;
+
+    if (fprintf(fp, ".order %d\n", dd->size) == EOF) return(0);
+    for (level = 0; level < dd->size; level++) {
+	index = dd->invperm[level];
+	name = varnames == NULL ? NULL : varnames[index];
+	if (name == NULL || *name == '\0') name = "*";
+	if (fprintf(fp, "%d %s\n", index, name) == EOF) return(0);
+    }
+    if (fprintf(fp, ".tree\n") == EOF ||
+	!ddCheckpointWriteTree(fp, dd->tree) ||
+	fprintf(fp, ".end\n") == EOF) return(0);
+    return(fflush(fp) != EOF);
+
+} /* end of Cudd_SaveOrder */
+
+
+/**
+  @brief Applies the best matching order of an order database.
+
+  @details Reads all the records written to fp by Cudd_SaveOrder and
+  matches each against the variables of the manager: first by exact
+  name, then by a signature of the name that ignores case and
+  punctuation (so that <tt>x[3]</tt>, <tt>x_3</tt> and <tt>X3</tt>
+  match) as long as the signature is unambiguous, and finally by index
+  for variables without names.  The record that matches most
+  variables, the most recent among equals, is applied: the matched
+  variables are permuted among the levels they occupy to follow the
+  saved order, while the other variables stay where they are.  If
+  every variable of the manager and of the record is matched, the
+  saved group tree replaces the current one; otherwise the current
+  tree is kept, and must be compatible with the saved order.  Starting
+  from an order that reordering has already improved lets an
+  application skip most early reorderings.
+
+  @return 1 if successful, including when nothing matches; 0
+  otherwise.
+
+  @sideeffect The number of matched variables is returned in matched,
+  if it is not NULL.
+
+  @see Cudd_SaveOrder Cudd_ShuffleHeap
+
+*/
+int
+Cudd_LoadOrder(
+  DdManager * dd /**< manager */,
+  FILE * fp /**< database file */,
+  char const * const * varnames /**< variable names indexed by variable index (or NULL) */,
+  int * matched /**< number of matched variables (output) */)
+{
+    DdOrderRecord rec, best;
+    st_table *exact = NULL, *loose = NULL;
+    char **sigs = NULL;
+    int *used = NULL, *map = NULL, *bestMap = NULL, *permutation = NULL;
+    int size = dd->size;
+    int i, j, level, count, bestCount, status, result;
+    void *value;
+
+    best.size = 0;
+    best.invperm = NULL;
+    best.names = NULL;
+    best.tree = NULL;
+    bestCount = 0;
+    result = 0;
+    if (matched != NULL) *matched = 0;
+
+    used = ALLOC(int, size + 1);
+    if (used == NULL) goto memout;
+    if (varnames != NULL) {
+	exact = st_init_table((st_compare_t) strcmp, st_strhash);
+	loose = st_init_table((st_compare_t) strcmp, st_strhash);
+	sigs = ALLOC(char *, size + 1);
+	if (exact == NULL || loose == NULL || sigs == NULL) goto memout;
+	for (i = 0; i < size; i++) sigs[i] = NULL;
+	for (i = 0; i < size; i++) {
+	    if (varnames[i] == NULL || *varnames[i] == '\0') continue;
+	    if (st_insert(exact, (void *) varnames[i], (void *) (ptrint) i) ==
+		ST_OUT_OF_MEM) goto memout;
+	    sigs[i] = ddOrderSignature(varnames[i]);
+	    if (sigs[i] == NULL) goto memout;
+	    if (st_lookup(loose, sigs[i], &value)) {
+		/* Ambiguous signatures match nothing. */
+		(void) st_insert(loose, sigs[i], (void *) (ptrint) -1);
+	    } else if (st_insert(loose, sigs[i], (void *) (ptrint) i) ==
+		       ST_OUT_OF_MEM) {
+		goto memout;
+	    }
+	}
+    }
+
+    while ((status = ddOrderRead(fp, &rec)) == 1) {
+	map = ALLOC(int, rec.size + 1);
+	if (map == NULL) {
+	    ddOrderFree(&rec);
+	    goto memout;
+	}
+	count = ddOrderMatch(dd, &rec, varnames, exact, loose, used, map);
+	if (count >= bestCount && count > 0) {
+	    ddOrderFree(&best);
+	    if (bestMap != NULL) FREE(bestMap);
+	    best = rec;
+	    bestMap = map;
+	    bestCount = count;
+	} else {
+	    ddOrderFree(&rec);
+	    FREE(map);
+	}
+	map = NULL;
+    }
+    if (status != 0) goto done;
+    if (bestCount == 0) {
+	result = 1;
+	goto done;
+    }
+
+    /* The matched variables take the levels they occupy now, in the
+    ** saved order. */
+    permutation = ALLOC(int, size + 1);
+    if (permutation == NULL) goto memout;
+    for (i = 0; i < size; i++) used[i] = 0;
+    for (level = 0; level < best.size; level++) {
+	if (bestMap[level] >= 0) used[bestMap[level]] = 1;
+    }
+    j = 0;
+    for (level = 0; level < size; level++) {
+	i = dd->invperm[level];
+	if (used[i]) {
+	    while (bestMap[j] < 0) j++;
+	    i = bestMap[j++];
+	}
+	permutation[level] = i;
+    }
+    if (bestCount == size && best.size == size) {
+	Cudd_FreeTree(dd);
+	if (!Cudd_ShuffleHeap(dd, permutation)) goto done;
+	if (best.tree != NULL) {
+	    ddOrderTranslateTree(best.tree, bestMap, size);
+	    Cudd_SetTree(dd, best.tree);
+	    best.tree = NULL;
+	}
+    } else {
+	if (!Cudd_ShuffleHeap(dd, permutation)) goto done;
+    }
+    if (matched != NULL) *matched = bestCount;
+    result = 1;
+    goto done;
+
+memout:
+    dd->errorCode = CUDD_MEMORY_OUT;
+done:
+    ddOrderFree(&best);
+    if (bestMap != NULL) FREE(bestMap);
+    if (permutation != NULL) FREE(permutation);
+    if (used != NULL) FREE(used);
+    if (exact != NULL) st_free_table(exact);
+    if (loose != NULL) st_free_table(loose);
+    if (sigs != NULL) {
+	for (i = 0; i < size; i++) {
+	    if (sigs[i] != NULL) FREE(sigs[i]);
+	}
+	FREE(sigs);
+    }
+    return(result);
+
+} /* end of Cudd_LoadOrder */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+
+/**
+  @brief Frees the checkpoint state of a manager.
+
+  @details After this call the next checkpoint is not incremental.
+
+  @sideeffect None
+
+  @see Cudd_Checkpoint
+
+*/
+void
+cuddFreeCheckpoint(
+  DdManager * dd)
+{
+    DdCheckpoint *ckpt = dd->checkpoint;
+
+    if (ckpt == NULL) return;
+    st_free_table(ckpt->ids);
+    FREE(ckpt->entries);
+    FREE(ckpt->path);
+    if (ckpt->invperm != NULL) FREE(ckpt->invperm);
+    FREE(ckpt);
+    dd->checkpoint = NULL;
+
+} /* end of cuddFreeCheckpoint */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+
+/**
+  @brief Allocates an empty checkpoint state.
+
+  @return a pointer to the state if successful; NULL otherwise.
+
+  @sideeffect None
+
+*/
+static DdCheckpoint *
+ddCheckpointAlloc(
+  char const * path)
+{
+    DdCheckpoint *ckpt;
+
+    ckpt = ALLOC(DdCheckpoint, 1);
+    if (ckpt == NULL) return(NULL);
+    ckpt->epoch = 0;
+    ckpt->nextId = 1;
+    ckpt->capacity = 0;
+    ckpt->entries = NULL;
+    ckpt->size = 0;
+    ckpt->invperm = NULL;
+    ckpt->path = util_strsav(path);
+    ckpt->ids = st_init_table(st_ptrcmp, st_ptrhash);
+    if (ckpt->path == NULL || ckpt->ids == NULL ||
+	!ddCheckpointReserve(ckpt, DD_CHECKPOINT_INIT_ENTRIES)) {
+	if (ckpt->path != NULL) FREE(ckpt->path);
+	if (ckpt->ids != NULL) st_free_table(ckpt->ids);
+	if (ckpt->entries != NULL) FREE(ckpt->entries);
+	FREE(ckpt);
+	return(NULL);
+    }
+    return(ckpt);
+
+} /* end of ddCheckpointAlloc */
+
+
+/**
+  @brief Checks whether the variables of the last checkpoint are still
+  in the same relative order.
+
+  @details Variables created since may be anywhere in the order.
+
+  @return 1 if the order is kept; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddCheckpointOrderKept(
+  DdManager * dd,
+  DdCheckpoint * ckpt)
+{
+    int i;
+
+    if (ckpt->size > dd->size) return(0);
+    for (i = 1; i < ckpt->size; i++) {
+	if (dd->perm[ckpt->invperm[i-1]] >= dd->perm[ckpt->invperm[i]])
+	    return(0);
+    }
+    return(1);
+
+} /* end of ddCheckpointOrderKept */
+
+
+/**
+  @brief Makes room for at least n node records.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddCheckpointReserve(
+  DdCheckpoint * ckpt,
+  int n)
+{
+    DdCheckpointEntry *entries;
+    int capacity;
+
+    if (n <= ckpt->capacity) return(1);
+    capacity = ckpt->capacity > 0 ? ckpt->capacity : 1;
+    while (capacity < n) capacity *= 2;
+    entries = REALLOC(DdCheckpointEntry, ckpt->entries, capacity);
+    if (entries == NULL) return(0);
+    ckpt->entries = entries;
+    ckpt->capacity = capacity;
+    return(1);
+
+} /* end of ddCheckpointReserve */
+
+
+/**
+  @brief Records the current order in the checkpoint state.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddCheckpointSaveOrder(
+  DdManager * dd,
+  DdCheckpoint * ckpt)
+{
+    int i;
+
+    if (ckpt->invperm != NULL) FREE(ckpt->invperm);
+    ckpt->size = 0;
+    ckpt->invperm = ALLOC(int, dd->size + 1);
+    if (ckpt->invperm == NULL) return(0);
+    for (i = 0; i < dd->size; i++) {
+	ckpt->invperm[i] = dd->invperm[i];
+    }
+    ckpt->size = dd->size;
+    return(1);
+
+} /* end of ddCheckpointSaveOrder */
+
+
+/**
+  @brief Assigns ids to the live %BDD and %ADD nodes.
+
+  @details Visits the constants first and then the subtables from the
+  bottom up, so that children are visited before their parents.  A
+  node keeps the id it had at the previous checkpoint if the record of
+  that id still describes it: a node freed since may have been reused
+  for a different node.  Otherwise it gets a new id, larger than all
+  those in use, so that the ids of the children of a node are always
+  smaller than its own.  The live nodes and their ids are stored in
+  live and liveIds.  The map from nodes to ids is then replaced by one
+  that only contains the live nodes.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect New records are added to the checkpoint state.
+
+*/
+static int
+ddCheckpointNumber(
+  DdManager * dd,
+  DdCheckpoint * ckpt,
+  DdNode ** live,
+  int * liveIds,
+  int * nlive)
+{
+    DdNode *sentinel = &(dd->sentinel);
+    DdNode **nodelist;
+    DdNode *node;
+    DdCheckpointEntry rec;
+    DdCheckpointEntry *old;
+    DdSubtable *subtable;
+    st_table *ids;
+    unsigned int j;
+    int i, n, id, idT, idE;
+
+    ids = st_init_table(st_ptrcmp, st_ptrhash);
+    if (ids == NULL) {
+	dd->errorCode = CUDD_MEMORY_OUT;
+	return(0);
+    }
+    n = 0;
+    for (i = dd->size; i >= 0; i--) {
+	subtable = i == dd->size ? &(dd->constants) : &(dd->subtables[i]);
+	nodelist = subtable->nodelist;
+	for (j = 0; j < subtable->slots; j++) {
+	    for (node = nodelist[j]; node != NULL && node != sentinel;
+		 node = node->next) {
+		if (node->ref == 0) continue;
+		memset(&rec, 0, sizeof(rec));
+		if (cuddIsConstant(node)) {
+		    rec.index = -1;
+		    rec.u.value = cuddV(node);
+		} else {
+		    if (!st_lookup_int(ids, cuddT(node), &idT) ||
+			!st_lookup_int(ids, Cudd_Regular(cuddE(node)), &idE))
+			goto failure;
+		    rec.index = (int) node->index;
+		    rec.u.kids.t = idT;
+		    rec.u.kids.e = (idE << 1) |
+			(Cudd_IsComplement(cuddE(node)) ? 1 : 0);
+		}
+		id = 0;
+		if (st_lookup_int(ckpt->ids, node, &id)) {
+		    old = &ckpt->entries[id];
+		    if (old->index != rec.index ||
+			(rec.index < 0 ? old->u.value != rec.u.value :
+			 (old->u.kids.t != rec.u.kids.t ||
+			  old->u.kids.e != rec.u.kids.e))) {
+			id = 0;
+		    }
+		}
+		if (id == 0) {
+		    if (!ddCheckpointReserve(ckpt, ckpt->nextId + 1)) {
+			dd->errorCode = CUDD_MEMORY_OUT;
+			goto failure;
+		    }
+		    id = ckpt->nextId++;
+		    ckpt->entries[id] = rec;
+		}
+		if (st_insert(ids, node, (void *) (ptrint) id) ==
+		    ST_OUT_OF_MEM) {
+		    dd->errorCode = CUDD_MEMORY_OUT;
+		    goto failure;
+		}
+		live[n] = node;
+		liveIds[n] = id;
+		n++;
+	    }
+	}
+    }
+    /* Forget the nodes freed since the previous checkpoint. */
+    st_free_table(ckpt->ids);
+    ckpt->ids = ids;
+    *nlive = n;
+    return(1);
+
+failure:
+    st_free_table(ids);
+    return(0);
+
+} /* end of ddCheckpointNumber */
+
+
+/**
+  @brief Writes one checkpoint to a file.
+
+  @details The header is in text form; the node records, from
+  firstNew on, and the roots are binary.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddCheckpointWrite(
+  DdManager * dd,
+  DdCheckpoint * ckpt,
+  FILE * fp,
+  char const * const * inames,
+  int firstNew,
+  int nroots,
+  int * roots)
+{
+    size_t n = (size_t) (ckpt->nextId - firstNew);
+    int i;
+
+    if (fprintf(fp, ".checkpoint %u\n.vars %d %d\n.order", ckpt->epoch,
+		dd->size, dd->sizeZ) == EOF) return(0);
+    for (i = 0; i < dd->size; i++) {
+	if (fprintf(fp, " %d", dd->invperm[i]) == EOF) return(0);
+    }
+    if (fprintf(fp, "\n.orderz") == EOF) return(0);
+    for (i = 0; i < dd->sizeZ; i++) {
+	if (fprintf(fp, " %d", dd->invpermZ[i]) == EOF) return(0);
+    }
+    /* Names are preceded by their lengths: they may contain blanks. */
+    if (fprintf(fp, "\n.names %d\n", inames != NULL) == EOF) return(0);
+    for (i = 0; inames != NULL && i < dd->size; i++) {
+	if (inames[i] == NULL) {
+	    if (fprintf(fp, "-1\n") == EOF) return(0);
+	} else if (fprintf(fp, "%d %s\n", (int) strlen(inames[i]),
+			   inames[i]) == EOF) return(0);
+    }
+    if (fprintf(fp, ".tree\n") == EOF ||
+	!ddCheckpointWriteTree(fp, dd->tree) ||
+	fprintf(fp, ".treez\n") == EOF ||
+	!ddCheckpointWriteTree(fp, dd->treeZ)) return(0);
+    if (fprintf(fp, ".nodes %d\n", (int) n) == EOF ||
+	fwrite(ckpt->entries + firstNew, sizeof(DdCheckpointEntry), n, fp)
+	!= n) return(0);
+    if (fprintf(fp, ".roots %d\n", nroots) == EOF ||
+	fwrite(roots, sizeof(int), (size_t) (2 * nroots), fp) !=
+	(size_t) (2 * nroots)) return(0);
+    if (fprintf(fp, ".end\n") == EOF) return(0);
+    return(1);
+
+} /* end of ddCheckpointWrite */
+
+
+/**
+  @brief Writes a variable group tree in preorder.
+
+  @details Each node is written on a line as 1 followed by its low,
+  size, flags, index and number of children.  An empty tree is written
+  as a line with a single 0.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddCheckpointWriteTree(
+  FILE * fp,
+  MtrNode * node)
+{
+    MtrNode *child;
+    int nchildren;
+
+    if (node == NULL) {
+	return(fprintf(fp, "0\n") != EOF);
+    }
+    nchildren = 0;
+    for (child = node->child; child != NULL; child = child->younger) {
+	nchildren++;
+    }
+    if (fprintf(fp, "1 %u %u %u %u %d\n", (unsigned) node->low,
+		(unsigned) node->size, (unsigned) node->flags,
+		(unsigned) node->index, nchildren) == EOF) return(0);
+    for (child = node->child; child != NULL; child = child->younger) {
+	if (!ddCheckpointWriteTree(fp, child)) return(0);
+    }
+    return(1);
+
+} /* end of ddCheckpointWriteTree */
+
+
+/**
+  @brief Reads a variable group tree written by ddCheckpointWriteTree.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect The tree (NULL if empty) is returned in node.
+
+*/
+static int
+ddCheckpointReadTree(
+  FILE * fp,
+  MtrNode ** node)
+{
+    MtrNode *child;
+    unsigned int low, size, flags, index;
+    int present, nchildren, i;
+
+    *node = NULL;
+    if (fscanf(fp, "%d", &present) != 1) return(0);
+    if (present == 0) return(1);
+    if (fscanf(fp, "%u %u %u %u %d", &low, &size, &flags, &index,
+	       &nchildren) != 5 || nchildren < 0) return(0);
+    *node = Mtr_AllocNode();
+    if (*node == NULL) return(0);
+    (*node)->low = (MtrHalfWord) low;
+    (*node)->size = (MtrHalfWord) size;
+    (*node)->flags = (MtrHalfWord) flags;
+    (*node)->index = (MtrHalfWord) index;
+    (*node)->parent = (*node)->child = NULL;
+    (*node)->elder = (*node)->younger = NULL;
+    for (i = 0; i < nchildren; i++) {
+	if (!ddCheckpointReadTree(fp, &child) || child == NULL) {
+	    if (child != NULL) Mtr_FreeTree(child);
+	    Mtr_FreeTree(*node);
+	    *node = NULL;
+	    return(0);
+	}
+	Mtr_MakeLastChild(*node, child);
+    }
+    return(1);
+
+} /* end of ddCheckpointReadTree */
+
+
+/**
+  @brief Reads one checkpoint from a file.
+
+  @details Reads the header and the roots into hdr and skips the node
+  records, whose position and number are returned in offset and
+  count.
+
+  @return 1 if a complete checkpoint was read; 0 at the end of the
+  file; -1 if the checkpoint is incomplete or malformed.
+
+  @sideeffect None
+
+*/
+static int
+ddCheckpointReadEpoch(
+  FILE * fp,
+  DdCheckpointHeader * hdr,
+  long * offset,
+  int * count)
+{
+    int hasNames, len, i, c;
+
+    if ((c = getc(fp)) == EOF) return(0);
+    (void) ungetc(c, fp);
+
+    if (fscanf(fp, ".checkpoint %u .vars %d %d .order", &hdr->epoch,
+	       &hdr->size, &hdr->sizeZ) != 3 || hdr->size < 0 ||
+	hdr->sizeZ < 0) return(-1);
+    hdr->invperm = ALLOC(int, hdr->size + 1);
+    hdr->invpermZ = ALLOC(int, hdr->sizeZ + 1);
+    if (hdr->invperm == NULL || hdr->invpermZ == NULL) return(-1);
+    for (i = 0; i < hdr->size; i++) {
+	if (fscanf(fp, "%d", &hdr->invperm[i]) != 1) return(-1);
+    }
+    if (fscanf(fp, " .orderz") == EOF) return(-1);
+    for (i = 0; i < hdr->sizeZ; i++) {
+	if (fscanf(fp, "%d", &hdr->invpermZ[i]) != 1) return(-1);
+    }
+    if (fscanf(fp, " .names %d", &hasNames) != 1) return(-1);
+    if (hasNames) {
+	hdr->names = ALLOC(char *, hdr->size + 1);
+	if (hdr->names == NULL) return(-1);
+	for (i = 0; i < hdr->size; i++) hdr->names[i] = NULL;
+	for (i = 0; i < hdr->size; i++) {
+	    if (fscanf(fp, "%d", &len) != 1) return(-1);
+	    if (len < 0) continue;
+	    if (getc(fp) != ' ') return(-1);
+	    hdr->names[i] = ALLOC(char, len + 1);
+	    if (hdr->names[i] == NULL ||
+		fread(hdr->names[i], 1, (size_t) len, fp) != (size_t) len)
+		return(-1);
+	    hdr->names[i][len] = '\0';
+	}
+    }
+    if (fscanf(fp, " .tree") == EOF || !ddCheckpointReadTree(fp, &hdr->tree))
+	return(-1);
+    if (fscanf(fp, " .treez") == EOF ||
+	!ddCheckpointReadTree(fp, &hdr->treeZ)) return(-1);
+
+    /* Node records: exactly one newline precedes the binary data. */
+    if (fscanf(fp, " .nodes %d", count) != 1 || *count < 0 ||
+	getc(fp) != '\n') return(-1);
+    *offset = ftell(fp);
+    if (*offset < 0 ||
+	fseek(fp, (long) *count * (long) sizeof(DdCheckpointEntry),
+	      SEEK_CUR) != 0) return(-1);
+
+    if (fscanf(fp, ".roots %d", &hdr->nroots) != 1 || hdr->nroots < 0 ||
+	getc(fp) != '\n') return(-1);
+    hdr->roots = ALLOC(int, 2 * hdr->nroots + 1);
+    if (hdr->roots == NULL ||
+	fread(hdr->roots, sizeof(int), (size_t) (2 * hdr->nroots), fp) !=
+	(size_t) (2 * hdr->nroots)) return(-1);
+    if (fscanf(fp, ".end") == EOF || getc(fp) != '\n') return(-1);
+    return(1);
+
+} /* end of ddCheckpointReadEpoch */
+
+
+/**
+  @brief Frees the contents of a checkpoint header.
+
+  @sideeffect The header is cleared.
+
+*/
+static void
+ddCheckpointFreeHeader(
+  DdCheckpointHeader * hdr)
+{
+    int i;
+
+    if (hdr->invperm != NULL) FREE(hdr->invperm);
+    if (hdr->invpermZ != NULL) FREE(hdr->invpermZ);
+    if (hdr->names != NULL) {
+	for (i = 0; i < hdr->size; i++) {
+	    if (hdr->names[i] != NULL) FREE(hdr->names[i]);
+	}
+	FREE(hdr->names);
+    }
+    if (hdr->tree != NULL) Mtr_FreeTree(hdr->tree);
+    if (hdr->treeZ != NULL) Mtr_FreeTree(hdr->treeZ);
+    if (hdr->roots != NULL) FREE(hdr->roots);
+    memset(hdr, 0, sizeof(*hdr));
+
+} /* end of ddCheckpointFreeHeader */
+
+
+/**
+  @brief Reads one record of an order database.
+
+  @return 1 if a record was read; 0 at the end of the file; -1 if the
+  record is malformed or memory is insufficient.
+
+  @sideeffect The record is returned in rec and must be freed with
+  ddOrderFree.
+
+*/
+static int
+ddOrderRead(
+  FILE * fp,
+  DdOrderRecord * rec)
+{
+    char name[DD_ORDER_MAX_NAME + 1];
+    int level, index;
+
+    rec->size = 0;
+    rec->invperm = NULL;
+    rec->names = NULL;
+    rec->tree = NULL;
+    if (fscanf(fp, " .order %d", &rec->size) != 1) {
+	return(feof(fp) ? 0 : -1);
+    }
+    if (rec->size < 0) return(-1);
+    rec->invperm = ALLOC(int, rec->size + 1);
+    rec->names = ALLOC(char *, rec->size + 1);
+    if (rec->invperm == NULL || rec->names == NULL) goto failure;
+    for (level = 0; level < rec->size; level++) rec->names[level] = NULL;
+    for (level = 0; level < rec->size; level++) {
+	if (fscanf(fp, "%d %1023s", &index, name) != 2 || index < 0)
+	    goto failure;
+	rec->invperm[level] = index;
+	if (strcmp(name, "*") != 0) {
+	    rec->names[level] = util_strsav(name);
+	    if (rec->names[level] == NULL) goto failure;
+	}
+    }
+    if (fscanf(fp, " .tree") == EOF || !ddCheckpointReadTree(fp, &rec->tree)
+	|| fscanf(fp, " .end") == EOF) goto failure;
+    return(1);
+
+failure:
+    ddOrderFree(rec);
+    return(-1);
+
+} /* end of ddOrderRead */
+
+
+/**
+  @brief Frees the contents of a record of an order database.
+
+  @sideeffect None
+
+*/
+static void
+ddOrderFree(
+  DdOrderRecord * rec)
+{
+    int level;
+
+    if (rec->names != NULL) {
+	for (level = 0; level < rec->size; level++) {
+	    if (rec->names[level] != NULL) FREE(rec->names[level]);
+	}
+	FREE(rec->names);
+    }
+    if (rec->invperm != NULL) FREE(rec->invperm);
+    if (rec->tree != NULL) Mtr_FreeTree(rec->tree);
+    rec->size = 0;
+    rec->invperm = NULL;
+    rec->names = NULL;
+    rec->tree = NULL;
+
+} /* end of ddOrderFree */
+
+
+/**
+  @brief Returns the signature of a variable name.
+
+  @details The signature keeps the letters and digits of the name,
+  with the letters in lower case.
+
+  @return a newly allocated string if successful; NULL otherwise.
+
+  @sideeffect None
+
+*/
+static char *
+ddOrderSignature(
+  char const * name)
+{
+    char *sig;
+    int i, j;
+
+    sig = ALLOC(char, strlen(name) + 1);
+    if (sig == NULL) return(NULL);
+    for (i = j = 0; name[i] != '\0'; i++) {
+	if (isalnum((unsigned char) name[i])) {
+	    sig[j++] = (char) tolower((unsigned char) name[i]);
+	}
+    }
+    sig[j] = '\0';
+    return(sig);
+
+} /* end of ddOrderSignature */
+
+
+/**
+  @brief Matches the variables of a saved order to those of a manager.
+
+  @details A saved variable is matched by name if possible, then by
+  the signature of its name, and then, if neither it nor the variable
+  of the manager with the same index have names, by index.  Each
+  variable of the manager is matched at most once.
+
+  @return the number of matched variables.
+
+  @sideeffect The index in the manager of the variable at each saved
+  level, or -1, is returned in map.  Overwrites used.
+
+*/
+static int
+ddOrderMatch(
+  DdManager * dd,
+  DdOrderRecord * rec,
+  char const * const * varnames,
+  st_table * exact,
+  st_table * loose,
+  int * used,
+  int * map)
+{
+    char *sig;
+    void *value;
+    int level, index, count;
+
+    for (index = 0; index < dd->size; index++) used[index] = 0;
+    count = 0;
+    for (level = 0; level < rec->size; level++) {
+	map[level] = -1;
+	if (exact != NULL && rec->names[level] != NULL &&
+	    st_lookup(exact, rec->names[level], &value)) {
+	    index = (int) (ptrint) value;
+	    if (!used[index]) {
+		map[level] = index;
+		used[index] = 1;
+		count++;
+	    }
+	}
+    }
+    for (level = 0; level < rec->size; level++) {
+	if (map[level] >= 0 || rec->names[level] == NULL) continue;
+	if (loose == NULL) continue;
+	sig = ddOrderSignature(rec->names[level]);
+	if (sig == NULL) continue;
+	if (st_lookup(loose, sig, &value)) {
+	    index = (int) (ptrint) value;
+	    if (index >= 0 && !used[index]) {
+		map[level] = index;
+		used[index] = 1;
+		count++;
+	    }
+	}
+	FREE(sig);
+    }
+    for (level = 0; level < rec->size; level++) {
+	if (map[level] >= 0 || rec->names[level] != NULL) continue;
+	index = rec->invperm[level];
+	if (index >= dd->size || used[index]) continue;
+	if (varnames != NULL && varnames[index] != NULL &&
+	    *varnames[index] != '\0') continue;
+	map[level] = index;
+	used[index] = 1;
+	count++;
+    }
+    return(count);
+
+} /* end of ddOrderMatch */
+
+
+/**
+  @brief Renumbers a saved group tree for the variables of a manager.
+
+  @details The low field of each node holds the saved level of its
+  first variable, and is replaced by the index of the matching
+  variable, as Cudd_SetTree expects.  Assumes that all saved variables
+  were matched.
+
+  @sideeffect None
+
+  @see Cudd_SetTree
+
+*/
+static void
+ddOrderTranslateTree(
+  MtrNode * node,
+  int * map,
+  int  size)
+{
+    MtrNode *child;
+
+    if ((int) node->low < size) {
+	node->low = (MtrHalfWord) map[node->low];
+    }
+    for (child = node->child; child != NULL; child = child->younger) {
+	ddOrderTranslateTree(child, map, size);
+    }
+
+} /* end of ddOrderTranslateTree */
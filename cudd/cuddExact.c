@@ -46,18 +46,99 @@
 #include "util.h"
 #include "cuddInt.h"
 
+#ifdef DD_USE_THREADS
+#include <pthread.h>
+#endif
+
 /*---------------------------------------------------------------------------*/
 /* Constant declarations                                                     */
 /*---------------------------------------------------------------------------*/
 
+/** Largest range of levels whose subsets fit in a mask. */
+#define DD_EXACT_MAX_VARS 64
+
+/** Fraction of the remaining memory budget granted to the frontiers. */
+#define DD_EXACT_FRONTIER_SHARE 4
+
+/** Minimum number of entries of a frontier. */
+#define DD_EXACT_MIN_FRONTIER 1024
+
 /*---------------------------------------------------------------------------*/
-/* Stucture declarations                                                     */
+/* Type declarations                                                         */
 /*---------------------------------------------------------------------------*/
 
+typedef struct ExactFrontier ExactFrontier_t;
+typedef struct ExactShared ExactShared_t;
+typedef struct ExactWorker ExactWorker_t;
+
 /*---------------------------------------------------------------------------*/
-/* Type declarations                                                         */
+/* Stucture declarations                                                     */
 /*---------------------------------------------------------------------------*/
 
+/**
+ * @brief Subsets of one size and the cheapest order found for each.
+ *
+ * @details An order is stored with one byte per level, holding the
+ * slot of the variable at that level; a slot is the position of the
+ * variable in the order at the start of the exact reordering.  The
+ * subset of bottom variables an entry stands for is kept as a bit
+ * mask over the slots, and is hashed to find the entry of a subset
+ * in constant time.  The entries are kept in the order in which
+ * their subsets were first found.
+ */
+struct ExactFrontier {
+    int size;			/**< number of levels of an order */
+    int n;			/**< number of entries */
+    int capacity;		/**< number of entries allocated */
+    int maxEntries;		/**< entries allowed by the memory budget */
+    int truncated;		/**< entries were dropped for lack of room */
+    uint64_t *masks;		/**< subset of each entry */
+    int *costs;			/**< cost of each entry */
+    int *tops;			/**< nodes at the top level of each subset */
+    unsigned char *orders;	/**< order of each entry */
+    int *chain;			/**< next entry in the same bucket */
+    int *buckets;		/**< first entry of each bucket */
+    int shift;			/**< 64 - log2 of the number of buckets */
+};
+
+/**
+ * @brief State shared by the threads expanding one frontier.
+ */
+struct ExactShared {
+#ifdef DD_USE_THREADS
+    pthread_mutex_t lock;	/**< protects next, upperBound, bestOrder */
+#endif
+    ExactFrontier_t *old;	/**< subsets of size k-1 */
+    int next;			/**< next entry of old to be expanded */
+    int upperBound;		/**< size of the best order so far */
+    DdHalfWord *bestOrder;	/**< best order so far */
+    DdHalfWord *symmInfo;	/**< symmetry groups */
+    DdHalfWord *slotVar;	/**< variable index of each slot */
+    int *varSlot;		/**< slot of each variable index */
+    int roots;			/**< roots between lower and upper */
+    int lower;			/**< lower level to be reordered */
+    int upper;			/**< upper level to be reordered */
+    int level;			/**< offset of the top bottom variable */
+    int zdd;			/**< 1 if the %ZDD variables are reordered */
+};
+
+/**
+ * @brief State of one thread expanding a frontier.
+ */
+struct ExactWorker {
+    DdManager *table;		/**< the heap or a copy of it */
+    ExactShared_t *shared;	/**< state shared by all threads */
+    ExactFrontier_t *dest;	/**< where the subsets of size k go */
+    ExactFrontier_t local;	/**< frontier of this thread */
+    DdHalfWord *order;		/**< order being expanded */
+    unsigned char *slots;	/**< order in the form stored by a frontier */
+    int result;			/**< 1 if successful; 0 otherwise */
+#ifdef DD_USE_THREADS
+    pthread_t thread;		/**< thread running this worker */
+    int started;		/**< the thread was created */
+#endif
+};
+
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -66,26 +147,47 @@
 /* Macro declarations                                                        */
 /*---------------------------------------------------------------------------*/
 
+/** Bucket of a subset in a frontier. */
+#define exactHash(mask,shift) \
+    ((int) (((mask) * UINT64_C(0x9E3779B97F4A7C15)) >> (shift)))
+
+#ifdef DD_USE_THREADS
+#define exactLock(s) (void) pthread_mutex_lock(&(s)->lock)
+#define exactUnlock(s) (void) pthread_mutex_unlock(&(s)->lock)
+#else
+#define exactLock(s) (void) (s)
+#define exactUnlock(s) (void) (s)
+#endif
+
 /** \cond */
 
 /*---------------------------------------------------------------------------*/
 /* Static function prototypes                                                */
 /*---------------------------------------------------------------------------*/
 
+static int ddExact (DdManager *table, int lower, int upper, int zdd);
 static int getMaxBinomial (int n);
-static DdHalfWord ** getMatrix (int rows, int cols);
-static void freeMatrix (DdHalfWord **matrix);
-static int getLevelKeys (DdManager *table, int l);
-static int ddShuffle (DdManager *table, DdHalfWord *permutation, int lower, int upper);
-static int ddSiftUp (DdManager *table, int x, int xLow);
-static int updateUB (DdManager *table, int oldBound, DdHalfWord *bestOrder, int lower, int upper);
+static int exactFrontierInit (ExactFrontier_t *frontier, int size, int maxEntries);
+static void exactFrontierQuit (ExactFrontier_t *frontier);
+static void exactFrontierClear (ExactFrontier_t *frontier);
+static int exactFrontierUpdate (ExactFrontier_t *frontier, uint64_t mask, unsigned char const *order, int cost, int top);
+static int exactFrontierRehash (ExactFrontier_t *frontier, int shift);
+static int exactFrontierTruncate (ExactFrontier_t *frontier);
+static int exactCostCompare (void const *a, void const *b);
+static void * ddExactExpand (void *arg);
+static int ddExactExpandSubset (ExactWorker_t *worker, int entry);
+static int getLevelKeys (DdManager *table, int l, int zdd);
+static int isLevelUnused (DdManager *table, int l, int zdd);
+static int ddShuffle (DdManager *table, DdHalfWord *permutation, int lower, int upper, int zdd);
+static int ddSiftUp (DdManager *table, int x, int xLow, int zdd);
+static void updateUB (ExactWorker_t *worker);
 static int ddCountRoots (DdManager *table, int lower, int upper);
 static void ddClearGlobal (DdManager *table, int lower, int maxlevel);
-static int computeLB (DdManager *table, DdHalfWord *order, int roots, int cost, int lower, int upper, int level);
-static int updateEntry (DdManager *table, DdHalfWord *order, int level, int cost, DdHalfWord **orders, int *costs, int subsets, char *mask, int lower, int upper);
+static int computeLB (DdManager *table, DdHalfWord *order, int roots, int cost, int top, int lower, int upper, int level, int zdd);
+static int updateEntry (ExactWorker_t *worker, int cost, int top);
 static void pushDown (DdHalfWord *order, int j, int level);
-static DdHalfWord * initSymmInfo (DdManager *table, int lower, int upper);
-static int checkSymmInfo (DdManager *table, DdHalfWord *symmInfo, int index, int level);
+static DdHalfWord * initSymmInfo (DdManager *table, int lower, int upper, int zdd);
+static int checkSymmInfo (DdManager *table, DdHalfWord *symmInfo, int index, int level, int zdd);
 
 /** \endcond */
 
@@ -103,55 +205,120 @@ static int checkSymmInfo (DdManager *table, DdHalfWord *symmInfo, int index, int
   @brief Exact variable ordering algorithm.
 
   @details Finds an optimum order for the variables between lower and
-  upper.
+  upper.  The subsets of bottom variables of each size form a
+  frontier, which is expanded into the frontier of the next size.
+  When more than one reordering thread is allowed, the subsets of a
+  frontier are expanded concurrently, each thread in its own copy of
+  the heap.  The frontiers may take a fixed share of the memory left
+  to the manager.  If a frontier outgrows that share, its costlier
+  half is dropped; the result is then the best order found, which may
+  not be optimum.
 
   @return 1 if successful; 0 otherwise.
 
   @sideeffect None
 
+  @see Cudd_SetReorderingThreads
+
 */
 int
 cuddExact(
   DdManager * table,
   int  lower,
   int  upper)
+{
+    return(ddExact(table,lower,upper,0));
+
+} /* end of cuddExact */
+
+
+/**
+  @brief Exact variable ordering algorithm for ZDDs.
+
+  @details Finds an optimum order for the %ZDD variables between lower
+  and upper.  The search is the same as that of cuddExact, except that
+  it always runs in the heap itself, because the copies used by the
+  other threads only hold BDDs, and that the lower bound only accounts
+  for the support of the subset.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+  @see cuddExact
+
+*/
+int
+cuddZddExact(
+  DdManager * table,
+  int  lower,
+  int  upper)
+{
+    return(ddExact(table,lower,upper,1));
+
+} /* end of cuddZddExact */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+
+/**
+  @brief Exact variable ordering shared by the %BDD and %ZDD variants.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+  @see cuddExact cuddZddExact
+
+*/
+static int
+ddExact(
+  DdManager * table,
+  int  lower,
+  int  upper,
+  int  zdd)
 {
     int k, i, j;
-    int maxBinomial, oldSubsets, newSubsets;
+    int maxBinomial, maxEntries;
     int subsetCost;
     int size;			/* number of variables to be reordered */
-    int unused, nvars, level, result;
-    int upperBound, lowerBound, cost;
-    int roots;
-    char *mask = NULL;
-    DdHalfWord  *symmInfo = NULL;
-    DdHalfWord **newOrder = NULL;
-    DdHalfWord **oldOrder = NULL;
-    int *newCost = NULL;
-    int *oldCost = NULL;
-    DdHalfWord **tmpOrder;
-    int *tmpCost;
-    DdHalfWord *bestOrder = NULL;
-    DdHalfWord *order;
+    int unused, nvars, result;
+    int nworkers;
+    size_t budget, entryBytes;
+    ExactFrontier_t frontiers[2];
+    ExactFrontier_t *oldFrontier, *newFrontier, *tmpFrontier;
+    ExactShared_t shared;
+    ExactWorker_t *workers = NULL;
 #ifdef DD_STATS
     int  ddTotalSubsets;
 #endif
 
     /* Restrict the range to be reordered by excluding unused variables
     ** at the two ends. */
-    while (table->subtables[lower].keys == 1 &&
-	   table->vars[table->invperm[lower]]->ref == 1 &&
-	   lower < upper)
+    while (isLevelUnused(table,lower,zdd) && lower < upper)
 	lower++;
-    while (table->subtables[upper].keys == 1 &&
-	   table->vars[table->invperm[upper]]->ref == 1 &&
-	   lower < upper)
+    while (isLevelUnused(table,upper,zdd) && lower < upper)
 	upper--;
     if (lower == upper) return(1); /* trivial problem */
 
+    memset(frontiers, 0, sizeof(frontiers));
+    shared.bestOrder = NULL;
+    shared.symmInfo = NULL;
+    shared.slotVar = NULL;
+    shared.varSlot = NULL;
+#ifdef DD_USE_THREADS
+    (void) pthread_mutex_init(&shared.lock, NULL);
+#endif
+
     /* Apply symmetric sifting to get a good upper bound and to extract
     ** symmetry information. */
-    result = cuddSymmSiftingConv(table,lower,upper);
+    if (zdd)
+	result = cuddZddSymmSiftingConv(table,lower,upper);
+    else
+	result = cuddSymmSiftingConv(table,lower,upper);
     if (result == 0) goto cuddExactOutOfMem;
 
 #ifdef DD_STATS
@@ -161,59 +328,104 @@ cuddExact(
 #endif
 
     /* Initialization. */
-    nvars = table->size;
+    nvars = zdd ? table->sizeZ : table->size;
     size = upper - lower + 1;
     /* Count unused variable among those to be reordered.  This is only
     ** used to compute maxBinomial. */
     unused = 0;
     for (i = lower + 1; i < upper; i++) {
-	if (table->subtables[i].keys == 1 &&
-	    table->vars[table->invperm[i]]->ref == 1)
+	if (isLevelUnused(table,i,zdd))
 	    unused++;
     }
 
     /* Find the maximum number of subsets we may have to store. */
     maxBinomial = getMaxBinomial(size - unused);
-    if (maxBinomial == -1) goto cuddExactOutOfMem;
-
-    newOrder = getMatrix(maxBinomial, size);
-    if (newOrder == NULL) goto cuddExactOutOfMem;
-
-    newCost = ALLOC(int, maxBinomial);
-    if (newCost == NULL) goto cuddExactOutOfMem;
+    if (maxBinomial == -1 || size > DD_EXACT_MAX_VARS)
+	goto cuddExactOutOfMem;
 
-    oldOrder = getMatrix(maxBinomial, size);
-    if (oldOrder == NULL) goto cuddExactOutOfMem;
+    shared.bestOrder = ALLOC(DdHalfWord, size);
+    if (shared.bestOrder == NULL) goto cuddExactOutOfMem;
 
-    oldCost = ALLOC(int, maxBinomial);
-    if (oldCost == NULL) goto cuddExactOutOfMem;
+    shared.slotVar = ALLOC(DdHalfWord, size);
+    if (shared.slotVar == NULL) goto cuddExactOutOfMem;
 
-    bestOrder = ALLOC(DdHalfWord, size);
-    if (bestOrder == NULL) goto cuddExactOutOfMem;
+    shared.varSlot = ALLOC(int, nvars);
+    if (shared.varSlot == NULL) goto cuddExactOutOfMem;
 
-    mask = ALLOC(char, nvars);
-    if (mask == NULL) goto cuddExactOutOfMem;
+    shared.symmInfo = initSymmInfo(table, lower, upper, zdd);
+    if (shared.symmInfo == NULL) goto cuddExactOutOfMem;
 
-    symmInfo = initSymmInfo(table, lower, upper);
-    if (symmInfo == NULL) goto cuddExactOutOfMem;
+    shared.roots = zdd ? 0 : ddCountRoots(table, lower, upper);
+    shared.lower = lower;
+    shared.upper = upper;
+    shared.zdd = zdd;
 
-    roots = ddCountRoots(table, lower, upper);
+    /* The heap itself is the first worker; the others work on copies. */
+    nworkers = 1;
+#ifdef DD_USE_THREADS
+    if (!zdd) nworkers = table->reordThreads;
+#endif
+    workers = ALLOC(ExactWorker_t, nworkers);
+    if (workers == NULL) goto cuddExactOutOfMem;
+    memset(workers, 0, sizeof(ExactWorker_t) * (size_t) nworkers);
+    for (k = 0; k < nworkers; k++) {
+	workers[k].shared = &shared;
+	workers[k].order = ALLOC(DdHalfWord, size);
+	workers[k].slots = ALLOC(unsigned char, size);
+	if (workers[k].order == NULL || workers[k].slots == NULL) {
+	    nworkers = k + 1;
+	    goto cuddExactOutOfMem;
+	}
+	if (k == 0) {
+	    workers[k].table = table;
+	} else {
+	    workers[k].table = cuddReorderCopy(table);
+	    if (workers[k].table == NULL) {
+		FREE(workers[k].order);
+		FREE(workers[k].slots);
+		break;
+	    }
+	}
+    }
+    nworkers = k;
+
+    /* Size the frontiers: two shared ones, plus one for each copy. */
+    budget = table->maxmem > table->memused ?
+	(table->maxmem - table->memused) / DD_EXACT_FRONTIER_SHARE : 0;
+    entryBytes = sizeof(uint64_t) + 4 * sizeof(int) + (size_t) size;
+    budget /= entryBytes * (size_t) (nworkers + 1);
+    maxEntries = budget < (size_t) maxBinomial ? (int) budget : maxBinomial;
+    if (maxEntries < DD_EXACT_MIN_FRONTIER) maxEntries = DD_EXACT_MIN_FRONTIER;
+
+    if (!exactFrontierInit(&frontiers[0], size, maxEntries) ||
+	!exactFrontierInit(&frontiers[1], size, maxEntries))
+	goto cuddExactOutOfMem;
+    for (k = 1; k < nworkers; k++) {
+	if (!exactFrontierInit(&workers[k].local, size, maxEntries))
+	    goto cuddExactOutOfMem;
+    }
+    oldFrontier = &frontiers[0];
+    newFrontier = &frontiers[1];
 
-    /* Initialize the old order matrix for the empty subset and the best
+    /* Initialize the old frontier for the empty subset and the best
     ** order to the current order. The cost for the empty subset includes
     ** the cost of the levels between upper and the constants. These levels
     ** are not going to change. Hence, we count them only once.
     */
-    oldSubsets = 1;
     for (i = 0; i < size; i++) {
-	oldOrder[0][i] = bestOrder[i] = (DdHalfWord) table->invperm[i+lower];
+	j = zdd ? table->invpermZ[i+lower] : table->invperm[i+lower];
+	shared.bestOrder[i] = shared.slotVar[i] = (DdHalfWord) j;
+	shared.varSlot[j] = i;
+	workers[0].slots[i] = (unsigned char) i;
     }
-    subsetCost = (int) table->constants.keys;
+    subsetCost = zdd ? 0 : (int) table->constants.keys;
     for (i = upper + 1; i < nvars; i++)
-	subsetCost += getLevelKeys(table,i);
-    oldCost[0] = subsetCost;
-    /* The upper bound is initialized to the current size of the BDDs. */
-    upperBound = (int) (table->keys - table->isolated);
+	subsetCost += getLevelKeys(table,i,zdd);
+    if (!exactFrontierUpdate(oldFrontier, 0, workers[0].slots, subsetCost, 0))
+	goto cuddExactOutOfMem;
+    /* The upper bound is initialized to the current size of the DDs. */
+    shared.upperBound = zdd ? (int) table->keysZ :
+	(int) (table->keys - table->isolated);
 
     /* Now consider subsets of increasing size. */
     for (k = 1; k <= size; k++) {
@@ -221,52 +433,57 @@ cuddExact(
 	(void) fprintf(table->out,"Processing subsets of size %d\n", k);
 	fflush(table->out);
 #endif
-	newSubsets = 0;
-	level = size - k;		/* offset of first bottom variable */
-
-	for (i = 0; i < oldSubsets; i++) { /* for each subset of size k-1 */
-	    order = oldOrder[i];
-	    cost = oldCost[i];
-	    lowerBound = computeLB(table, order, roots, cost, lower, upper,
-				   level);
-	    if (lowerBound >= upperBound)
-		continue;
-	    /* Impose new order. */
-	    result = ddShuffle(table, order, lower, upper);
-	    if (result == 0) goto cuddExactOutOfMem;
-	    upperBound = updateUB(table,upperBound,bestOrder,lower,upper);
-	    /* For each top bottom variable. */
-	    for (j = level; j >= 0; j--) {
-		/* Skip unused variables. */
-		if (table->subtables[j+lower-1].keys == 1 &&
-		    table->vars[table->invperm[j+lower-1]]->ref == 1) continue;
-		/* Find cost under this order. */
-		subsetCost = cost + getLevelKeys(table, lower + level);
-		newSubsets = updateEntry(table, order, level, subsetCost,
-					 newOrder, newCost, newSubsets, mask,
-					 lower, upper);
-		if (j == 0)
-		    break;
-		if (checkSymmInfo(table, symmInfo, (int) order[j-1], level) == 0)
-		    continue;
-		pushDown(order,j-1,level);
-		/* Impose new order. */
-		result = ddShuffle(table, order, lower, upper);
-		if (result == 0) goto cuddExactOutOfMem;
-		upperBound = updateUB(table,upperBound,bestOrder,lower,upper);
-	    } /* for each bottom variable */
-	} /* for each subset of size k */
+	exactFrontierClear(newFrontier);
+	shared.old = oldFrontier;
+	shared.next = 0;
+	shared.level = size - k;	/* offset of first bottom variable */
+
+	workers[0].dest = newFrontier;
+	for (i = 1; i < nworkers; i++) {
+	    exactFrontierClear(&workers[i].local);
+	    workers[i].dest = &workers[i].local;
+#ifdef DD_USE_THREADS
+	    workers[i].started = pthread_create(&workers[i].thread, NULL,
+						ddExactExpand, &workers[i]) == 0;
+#endif
+	}
+	(void) ddExactExpand(&workers[0]);
+	result = workers[0].result;
+	for (i = 1; i < nworkers; i++) {
+#ifdef DD_USE_THREADS
+	    if (workers[i].started) {
+		(void) pthread_join(workers[i].thread, NULL);
+	    } else {
+		(void) ddExactExpand(&workers[i]);
+	    }
+#endif
+	    if (!workers[i].result) result = 0;
+	}
+	if (result == 0) goto cuddExactOutOfMem;
+
+	/* Merge the subsets found by the copies. */
+	for (i = 1; i < nworkers; i++) {
+	    ExactFrontier_t *local = &workers[i].local;
+	    for (j = 0; j < local->n; j++) {
+		if (!exactFrontierUpdate(newFrontier, local->masks[j],
+					 local->orders + (size_t) j * size,
+					 local->costs[j], local->tops[j]))
+		    goto cuddExactOutOfMem;
+	    }
+	    newFrontier->truncated |= local->truncated;
+	}
 
 	/* New orders become old orders in preparation for next iteration. */
-	tmpOrder = oldOrder; tmpCost = oldCost;
-	oldOrder = newOrder; oldCost = newCost;
-	newOrder = tmpOrder; newCost = tmpCost;
+	tmpFrontier = oldFrontier;
+	oldFrontier = newFrontier;
+	newFrontier = tmpFrontier;
 #ifdef DD_STATS
-	ddTotalSubsets += newSubsets;
+	ddTotalSubsets += oldFrontier->n;
+	if (oldFrontier->truncated)
+	    (void) fprintf(table->out,"Frontier of size %d truncated\n", k);
 #endif
-	oldSubsets = newSubsets;
     }
-    result = ddShuffle(table, bestOrder, lower, upper);
+    result = ddShuffle(table, shared.bestOrder, lower, upper, zdd);
     if (result == 0) goto cuddExactOutOfMem;
 #ifdef DD_STATS
 #ifdef DD_VERBOSE
@@ -278,28 +495,36 @@ cuddExact(
 		   table->totalShuffles);
 #endif
 
-    freeMatrix(newOrder);
-    freeMatrix(oldOrder);
-    FREE(bestOrder);
-    FREE(oldCost);
-    FREE(newCost);
-    FREE(symmInfo);
-    FREE(mask);
-    return(1);
+    result = 1;
+    goto cuddExactCleanup;
 
 cuddExactOutOfMem:
-
-    if (newOrder != NULL) freeMatrix(newOrder);
-    if (oldOrder != NULL) freeMatrix(oldOrder);
-    if (bestOrder != NULL) FREE(bestOrder);
-    if (oldCost != NULL) FREE(oldCost);
-    if (newCost != NULL) FREE(newCost);
-    if (symmInfo != NULL) FREE(symmInfo);
-    if (mask != NULL) FREE(mask);
     table->errorCode = CUDD_MEMORY_OUT;
-    return(0);
+    result = 0;
+
+cuddExactCleanup:
+    if (workers != NULL) {
+	for (k = 0; k < nworkers; k++) {
+	    if (k > 0 && workers[k].table != NULL)
+		cuddReorderCopyFree(table, workers[k].table);
+	    exactFrontierQuit(&workers[k].local);
+	    if (workers[k].order != NULL) FREE(workers[k].order);
+	    if (workers[k].slots != NULL) FREE(workers[k].slots);
+	}
+	FREE(workers);
+    }
+    exactFrontierQuit(&frontiers[0]);
+    exactFrontierQuit(&frontiers[1]);
+    if (shared.bestOrder != NULL) FREE(shared.bestOrder);
+    if (shared.slotVar != NULL) FREE(shared.slotVar);
+    if (shared.varSlot != NULL) FREE(shared.varSlot);
+    if (shared.symmInfo != NULL) FREE(shared.symmInfo);
+#ifdef DD_USE_THREADS
+    (void) pthread_mutex_destroy(&shared.lock);
+#endif
+    return(result);
 
-} /* end of cuddExact */
+} /* end of ddExact */
 
 
 /**
@@ -391,62 +616,387 @@ gcd(
 
 
 /**
-  @brief Allocates a two-dimensional matrix of ints.
+  @brief Initializes a frontier.
+
+  @details The frontier starts small and grows on demand up to
+  maxEntries entries.  The frontier must be released with
+  exactFrontierQuit also when initialization fails.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+  @see exactFrontierQuit
+
+*/
+static int
+exactFrontierInit(
+  ExactFrontier_t * frontier,
+  int  size,
+  int  maxEntries)
+{
+    frontier->size = size;
+    frontier->n = 0;
+    frontier->maxEntries = maxEntries;
+    frontier->capacity = maxEntries < 256 ? maxEntries : 256;
+    frontier->truncated = 0;
+    frontier->masks = ALLOC(uint64_t, frontier->capacity);
+    frontier->costs = ALLOC(int, frontier->capacity);
+    frontier->tops = ALLOC(int, frontier->capacity);
+    frontier->orders = ALLOC(unsigned char,
+			     (size_t) frontier->capacity * (size_t) size);
+    frontier->chain = ALLOC(int, frontier->capacity);
+    frontier->buckets = NULL;
+    if (frontier->masks == NULL || frontier->costs == NULL ||
+	frontier->tops == NULL || frontier->orders == NULL || frontier->chain == NULL)
+	return(0);
+    return(exactFrontierRehash(frontier, 64 - 8));
+
+} /* end of exactFrontierInit */
 
-  @return the pointer to the matrix if successful; NULL otherwise.
+
+/**
+  @brief Releases the memory of a frontier.
 
   @sideeffect None
 
-  @see freeMatrix
+  @see exactFrontierInit
 
 */
-static DdHalfWord **
-getMatrix(
-  int  rows /* number of rows */,
-  int  cols /* number of columns */)
+static void
+exactFrontierQuit(
+  ExactFrontier_t * frontier)
+{
+    if (frontier->masks != NULL) FREE(frontier->masks);
+    if (frontier->costs != NULL) FREE(frontier->costs);
+    if (frontier->tops != NULL) FREE(frontier->tops);
+    if (frontier->orders != NULL) FREE(frontier->orders);
+    if (frontier->chain != NULL) FREE(frontier->chain);
+    if (frontier->buckets != NULL) FREE(frontier->buckets);
+
+} /* end of exactFrontierQuit */
+
+
+/**
+  @brief Removes all entries from a frontier.
+
+  @details The memory of the frontier is kept for reuse.
+
+  @sideeffect None
+
+*/
+static void
+exactFrontierClear(
+  ExactFrontier_t * frontier)
 {
-    DdHalfWord **matrix;
     int i;
+    int nbuckets = 1 << (64 - frontier->shift);
+
+    for (i = 0; i < nbuckets; i++)
+	frontier->buckets[i] = -1;
+    frontier->n = 0;
+    frontier->truncated = 0;
+
+} /* end of exactFrontierClear */
 
-    if (cols*rows == 0) return(NULL);
-    matrix = ALLOC(DdHalfWord *, rows);
-    if (matrix == NULL) return(NULL);
-    matrix[0] = ALLOC(DdHalfWord, cols*rows);
-    if (matrix[0] == NULL) {
-	FREE(matrix);
-	return(NULL);
+
+/**
+  @brief Updates the entry of a subset in a frontier.
+
+  @details Finds the subset, if it exists.  If the new order for the
+  subset has lower cost, or if the subset did not exist, it stores the
+  new order and cost.  If a new subset finds the frontier full, the
+  costlier half of the frontier is dropped first.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+exactFrontierUpdate(
+  ExactFrontier_t * frontier,
+  uint64_t  mask,
+  unsigned char const * order,
+  int  cost,
+  int  top)
+{
+    int i, capacity;
+    size_t size = (size_t) frontier->size;
+    uint64_t *masks;
+    int *costs, *tops, *chain;
+    unsigned char *orders;
+
+    for (i = frontier->buckets[exactHash(mask, frontier->shift)];
+	 i != -1; i = frontier->chain[i]) {
+	if (frontier->masks[i] == mask) {
+	    if (cost < frontier->costs[i]) {	/* replace */
+		memcpy(frontier->orders + (size_t) i * size, order, size);
+		frontier->costs[i] = cost;
+		frontier->tops[i] = top;
+	    }
+	    return(1);
+	}
     }
-    for (i = 1; i < rows; i++) {
-	matrix[i] = matrix[i-1] + cols;
+
+    /* Add. */
+    if (frontier->n == frontier->capacity) {
+	if (frontier->capacity < frontier->maxEntries) {
+	    capacity = frontier->capacity <= frontier->maxEntries / 2 ?
+		frontier->capacity * 2 : frontier->maxEntries;
+	    masks = REALLOC(uint64_t, frontier->masks, capacity);
+	    if (masks == NULL) return(0);
+	    frontier->masks = masks;
+	    costs = REALLOC(int, frontier->costs, capacity);
+	    if (costs == NULL) return(0);
+	    frontier->costs = costs;
+	    tops = REALLOC(int, frontier->tops, capacity);
+	    if (tops == NULL) return(0);
+	    frontier->tops = tops;
+	    chain = REALLOC(int, frontier->chain, capacity);
+	    if (chain == NULL) return(0);
+	    frontier->chain = chain;
+	    orders = REALLOC(unsigned char, frontier->orders,
+			     (size_t) capacity * size);
+	    if (orders == NULL) return(0);
+	    frontier->orders = orders;
+	    frontier->capacity = capacity;
+	} else if (!exactFrontierTruncate(frontier)) {
+	    return(0);
+	}
+    }
+    i = frontier->n++;
+    frontier->masks[i] = mask;
+    frontier->costs[i] = cost;
+    frontier->tops[i] = top;
+    memcpy(frontier->orders + (size_t) i * size, order, size);
+    if (frontier->n > 1 << (64 - frontier->shift))
+	return(exactFrontierRehash(frontier, frontier->shift - 1));
+    frontier->chain[i] = frontier->buckets[exactHash(mask, frontier->shift)];
+    frontier->buckets[exactHash(mask, frontier->shift)] = i;
+    return(1);
+
+} /* end of exactFrontierUpdate */
+
+
+/**
+  @brief Rebuilds the hash table of a frontier.
+
+  @details The new table has <code>2^(64-shift)</code> buckets.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+exactFrontierRehash(
+  ExactFrontier_t * frontier,
+  int  shift)
+{
+    int i, b;
+    int nbuckets = 1 << (64 - shift);
+
+    if (frontier->buckets != NULL) FREE(frontier->buckets);
+    frontier->buckets = ALLOC(int, nbuckets);
+    if (frontier->buckets == NULL) return(0);
+    frontier->shift = shift;
+    for (i = 0; i < nbuckets; i++)
+	frontier->buckets[i] = -1;
+    for (i = 0; i < frontier->n; i++) {
+	b = exactHash(frontier->masks[i], shift);
+	frontier->chain[i] = frontier->buckets[b];
+	frontier->buckets[b] = i;
+    }
+    return(1);
+
+} /* end of exactFrontierRehash */
+
+
+/**
+  @brief Drops the costlier half of a frontier.
+
+  @details The entries that are kept retain their relative order.
+  Once a subset is dropped, the optimality of the result is no longer
+  guaranteed.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+exactFrontierTruncate(
+  ExactFrontier_t * frontier)
+{
+    int i, j, threshold, ties;
+    int keep = frontier->n / 2;
+    size_t size = (size_t) frontier->size;
+    int *sorted;
+
+    sorted = ALLOC(int, frontier->n);
+    if (sorted == NULL) return(0);
+    memcpy(sorted, frontier->costs, sizeof(int) * (size_t) frontier->n);
+    qsort(sorted, (size_t) frontier->n, sizeof(int), exactCostCompare);
+    threshold = sorted[keep];
+    for (ties = keep; ties > 0 && sorted[ties-1] == threshold; ties--);
+    ties = keep - ties;		/* entries at the threshold to keep */
+    FREE(sorted);
+
+    for (i = j = 0; i < frontier->n; i++) {
+	if (frontier->costs[i] > threshold) continue;
+	if (frontier->costs[i] == threshold && ties-- <= 0) continue;
+	if (i != j) {
+	    frontier->masks[j] = frontier->masks[i];
+	    frontier->costs[j] = frontier->costs[i];
+	    frontier->tops[j] = frontier->tops[i];
+	    memcpy(frontier->orders + (size_t) j * size,
+		   frontier->orders + (size_t) i * size, size);
+	}
+	j++;
     }
-    return(matrix);
+    frontier->n = j;
+    frontier->truncated = 1;
+    return(exactFrontierRehash(frontier, frontier->shift));
 
-} /* end of getMatrix */
+} /* end of exactFrontierTruncate */
 
 
 /**
-  @brief Frees a two-dimensional matrix allocated by getMatrix.
+  @brief Comparison function used by qsort to sort costs.
 
   @sideeffect None
 
-  @see getMatrix
+*/
+static int
+exactCostCompare(
+  void const * a,
+  void const * b)
+{
+    int ca = *(int const *) a;
+    int cb = *(int const *) b;
+
+    return((ca > cb) - (ca < cb));
+
+} /* end of exactCostCompare */
+
+
+/**
+  @brief Expands the subsets of a frontier.
+
+  @details Takes the subsets of the old frontier one at a time, until
+  none is left, and expands each of them.  This is the body of each
+  thread taking part in the exact reordering.
+
+  @return NULL.
+
+  @sideeffect The result field of the worker is set.
 
 */
-static void
-freeMatrix(
-  DdHalfWord ** matrix)
+static void *
+ddExactExpand(
+  void * arg)
 {
-    FREE(matrix[0]);
-    FREE(matrix);
-    return;
+    ExactWorker_t *worker = (ExactWorker_t *) arg;
+    ExactShared_t *shared = worker->shared;
+    int entry;
+
+    worker->result = 1;
+    for (;;) {
+	exactLock(shared);
+	entry = shared->next++;
+	exactUnlock(shared);
+	if (entry >= shared->old->n) break;
+	if (!ddExactExpandSubset(worker, entry)) {
+	    worker->result = 0;
+	    /* Make the other threads stop. */
+	    exactLock(shared);
+	    shared->next = shared->old->n;
+	    exactUnlock(shared);
+	    break;
+	}
+    }
+    return(NULL);
 
-} /* end of freeMatrix */
+} /* end of ddExactExpand */
+
+
+/**
+  @brief Expands one subset of a frontier.
+
+  @details Each variable not in the subset in turn is placed just
+  above the subset, and the order of the resulting subset is recorded
+  in the frontier of the worker.  Nothing is done if the lower bound
+  for the subset is not less than the upper bound.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect The heap of the worker is reordered.
+
+*/
+static int
+ddExactExpandSubset(
+  ExactWorker_t * worker,
+  int  entry)
+{
+    DdManager *table = worker->table;
+    ExactShared_t *shared = worker->shared;
+    DdHalfWord *order = worker->order;
+    int lower = shared->lower;
+    int upper = shared->upper;
+    int level = shared->level;
+    int size = upper - lower + 1;
+    unsigned char const *slots =
+	shared->old->orders + (size_t) entry * (size_t) size;
+    int i, j, cost, subsetCost, lowerBound, upperBound, result;
+
+    for (i = 0; i < size; i++)
+	order[i] = shared->slotVar[slots[i]];
+    cost = shared->old->costs[entry];
+    lowerBound = computeLB(table, order, shared->roots, cost,
+			   shared->old->tops[entry], lower, upper, level,
+			   shared->zdd);
+    exactLock(shared);
+    upperBound = shared->upperBound;
+    exactUnlock(shared);
+    if (lowerBound >= upperBound)
+	return(1);
+    /* Impose new order. */
+    result = ddShuffle(table, order, lower, upper, shared->zdd);
+    if (result == 0) return(0);
+    updateUB(worker);
+    /* For each top bottom variable. */
+    for (j = level; j >= 0; j--) {
+	/* Skip unused variables.  There is no level above level 0. */
+	if (j + lower > 0 && isLevelUnused(table, j+lower-1, shared->zdd))
+	    continue;
+	/* Find cost under this order. */
+	subsetCost = cost + getLevelKeys(table, lower + level, shared->zdd);
+	if (!updateEntry(worker, subsetCost,
+			 shared->zdd ? (int) table->subtableZ[lower + level].keys :
+			 (int) table->subtables[lower + level].keys))
+	    return(0);
+	if (j == 0)
+	    break;
+	if (checkSymmInfo(table, shared->symmInfo, (int) order[j-1], level,
+			  shared->zdd) == 0)
+	    continue;
+	pushDown(order,j-1,level);
+	/* Impose new order. */
+	result = ddShuffle(table, order, lower, upper, shared->zdd);
+	if (result == 0) return(0);
+	updateUB(worker);
+    } /* for each bottom variable */
+    return(1);
+
+} /* end of ddExactExpandSubset */
 
 
 /**
   @brief Returns the number of nodes at one level of a unique table.
 
-  @details The projection function, if isolated, is not counted.
+  @details The projection function, if isolated, is not counted.  For
+  ZDDs all the nodes at the level are counted.
 
   @sideeffect None
 
@@ -454,11 +1004,13 @@ freeMatrix(
 static int
 getLevelKeys(
   DdManager * table,
-  int  l)
+  int  l,
+  int  zdd)
 {
     int isolated;
     int x;        /* x is an index */
 
+    if (zdd) return((int) table->subtableZ[l].keys);
     x = table->invperm[l];
     isolated = table->vars[x]->ref == 1;
 
@@ -467,6 +1019,28 @@ getLevelKeys(
 } /* end of getLevelKeys */
 
 
+/**
+  @brief Returns 1 if the variable at a level labels no node.
+
+  @details For BDDs, the level must only hold the isolated projection
+  function; for ZDDs, it must only hold the node of the universe.
+
+  @sideeffect None
+
+*/
+static int
+isLevelUnused(
+  DdManager * table,
+  int  l,
+  int  zdd)
+{
+    if (zdd) return(table->subtableZ[l].keys == 1);
+    return(table->subtables[l].keys == 1 &&
+	   table->vars[table->invperm[l]]->ref == 1);
+
+} /* end of isLevelUnused */
+
+
 /**
   @brief Reorders variables according to a given permutation.
 
@@ -486,7 +1060,8 @@ ddShuffle(
   DdManager * table,
   DdHalfWord * permutation,
   int  lower,
-  int  upper)
+  int  upper,
+  int  zdd)
 {
     DdHalfWord	index;
     int		level;
@@ -516,8 +1091,8 @@ ddShuffle(
 
     for (level = 0; level <= upper - lower; level++) {
 	index = permutation[level];
-	position = table->perm[index];
-	result = ddSiftUp(table,position,level+lower);
+	position = zdd ? table->permZ[index] : table->perm[index];
+	result = ddSiftUp(table,position,level+lower,zdd);
 	if (!result) return(0);
     }
 
@@ -557,19 +1132,20 @@ static int
 ddSiftUp(
   DdManager * table,
   int  x,
-  int  xLow)
+  int  xLow,
+  int  zdd)
 {
     int        y;
     int        size;
 
-    y = cuddNextLow(table,x);
+    y = zdd ? cuddZddNextLow(table,x) : cuddNextLow(table,x);
     while (y >= xLow) {
-	size = cuddSwapInPlace(table,y,x);
+	size = zdd ? cuddZddSwapInPlace(table,y,x) : cuddSwapInPlace(table,y,x);
 	if (size == 0) {
 	    return(0);
 	}
 	x = y;
-	y = cuddNextLow(table,x);
+	y = zdd ? cuddZddNextLow(table,x) : cuddNextLow(table,x);
     }
     return(1);
 
@@ -579,33 +1155,33 @@ ddSiftUp(
 /**
   @brief Updates the upper bound and saves the best order seen so far.
 
-  @return the current value of the upper bound.
+  @details The bound and the order are shared by all workers.
 
   @sideeffect None
 
 */
-static int
+static void
 updateUB(
-  DdManager * table,
-  int  oldBound,
-  DdHalfWord * bestOrder,
-  int  lower,
-  int  upper)
+  ExactWorker_t * worker)
 {
+    DdManager *table = worker->table;
+    ExactShared_t *shared = worker->shared;
     int i;
-    int newBound = (int) (table->keys - table->isolated);
+    int newBound = shared->zdd ? (int) table->keysZ :
+	(int) (table->keys - table->isolated);
 
-    if (newBound < oldBound) {
+    exactLock(shared);
+    if (newBound < shared->upperBound) {
 #ifdef DD_STATS
 	(void) fprintf(table->out,"New upper bound = %d\n", newBound);
 	fflush(table->out);
 #endif
-	for (i = lower; i <= upper; i++)
-	    bestOrder[i-lower] = (DdHalfWord) table->invperm[i];
-	return(newBound);
-    } else {
-	return(oldBound);
+	shared->upperBound = newBound;
+	for (i = shared->lower; i <= shared->upper; i++)
+	    shared->bestOrder[i-shared->lower] = (DdHalfWord)
+		(shared->zdd ? table->invpermZ[i] : table->invperm[i]);
     }
+    exactUnlock(shared);
 
 } /* end of updateUB */
 
@@ -730,6 +1306,10 @@ ddClearGlobal(
   <li> variable in the support of the roots in the upper part of the
        %BDD subjected to reordering.
   </ul>
+  Only quantities that do not depend on the current order of the heap
+  are used, so that the bound is valid whichever order the heap (or
+  the copy of the heap of a thread) is in.  For ZDDs only the first
+  two factors and the support are used.
 
   @sideeffect None
 
@@ -740,9 +1320,11 @@ computeLB(
   DdHalfWord * order		/**< optimal order for the subset */,
   int  roots			/**< roots between lower and upper */,
   int  cost			/**< minimum cost for the subset */,
+  int  top			/**< nodes at the top level of the subset */,
   int  lower			/**< lower level to be reordered */,
   int  upper			/**< upper level to be reordered */,
-  int  level			/**< offset for the current top bottom var */
+  int  level			/**< offset for the current top bottom var */,
+  int  zdd			/**< 1 for ZDDs; 0 for BDDs */
   )
 {
     int i;
@@ -756,26 +1338,32 @@ computeLB(
     ** Add their sizes to the lower bound.
     */
     for (i = 0; i < lower; i++) {
-	lb += getLevelKeys(table,i);
+	lb += getLevelKeys(table,i,zdd);
     }
     /* If a variable is in the support, then there is going
     ** to be at least one node labeled by that variable.
     */
     for (i = lower; i <= lower+level; i++) {
-	support = table->subtables[i].keys > 1 ||
-	    table->vars[order[i-lower]]->ref > 1;
+	if (zdd) {
+	    support = table->subtableZ[table->permZ[order[i-lower]]].keys > 1;
+	} else {
+	    support = table->subtables[table->perm[order[i-lower]]].keys > 1 ||
+		table->vars[order[i-lower]]->ref > 1;
+	}
 	lb1 += support;
     }
+    if (zdd) return(lb + lb1);
 
     /* Estimate the number of nodes required to connect the roots to
     ** the nodes in the bottom part. */
     if (lower+level+1 < table->size) {
-	if (lower+level < upper)
+	if (lower+level < upper) {
 	    ref = table->vars[order[level+1]]->ref;
-	else
+	} else {
 	    ref = table->vars[table->invperm[upper+1]]->ref;
-	lb2 = (int) table->subtables[lower+level+1].keys -
-            (ref > (DdHalfWord) 1) - roots;
+	    top = (int) table->subtables[upper+1].keys;
+	}
+	lb2 = top - (ref > (DdHalfWord) 1) - roots;
     } else {
 	lb2 = 0;
     }
@@ -790,54 +1378,32 @@ computeLB(
 /**
   @brief Updates entry for a subset.
 
-  @details Finds the subset, if it exists.  If the new order for the
-  subset has lower cost, or if the subset did not exist, it stores the
-  new order and cost.
+  @details Records the current order of the worker for the subset of
+  its bottom variables in the frontier of the worker.
 
-  @return the number of subsets currently in the table.
+  @return 1 if successful; 0 otherwise.
 
   @sideeffect None
 
 */
 static int
 updateEntry(
-  DdManager * table,
-  DdHalfWord * order,
-  int  level,
+  ExactWorker_t * worker,
   int  cost,
-  DdHalfWord ** orders,
-  int * costs,
-  int  subsets,
-  char * mask,
-  int  lower,
-  int  upper)
+  int  top)
 {
-    int i, j;
-    int size = upper - lower + 1;
+    ExactShared_t *shared = worker->shared;
+    int i;
+    int size = shared->upper - shared->lower + 1;
+    uint64_t mask = 0;
 
     /* Build a mask that says what variables are in this subset. */
-    for (i = lower; i <= upper; i++)
-	mask[table->invperm[i]] = 0;
-    for (i = level; i < size; i++)
-	mask[order[i]] = 1;
-
-    /* Check each subset until a match is found or all subsets are examined. */
-    for (i = 0; i < subsets; i++) {
-	DdHalfWord *subset = orders[i];
-	for (j = level; j < size; j++) {
-	    if (mask[subset[j]] == 0)
-		break;
-	}
-	if (j == size)		/* no mismatches: success */
-	    break;
-    }
-    if (i == subsets || cost < costs[i]) {		/* add or replace */
-	for (j = 0; j < size; j++)
-	    orders[i][j] = order[j];
-	costs[i] = cost;
-	subsets += (i == subsets);
+    for (i = 0; i < size; i++) {
+	worker->slots[i] = (unsigned char) shared->varSlot[worker->order[i]];
+	if (i >= shared->level)
+	    mask |= (uint64_t) 1 << worker->slots[i];
     }
-    return(subsets);
+    return(exactFrontierUpdate(worker->dest, mask, worker->slots, cost, top));
 
 } /* end of updateEntry */
 
@@ -889,18 +1455,21 @@ static DdHalfWord *
 initSymmInfo(
   DdManager * table,
   int  lower,
-  int  upper)
+  int  upper,
+  int  zdd)
 {
     int level, index, next, nextindex;
+    int *invperm = zdd ? table->invpermZ : table->invperm;
+    DdSubtable *subtables = zdd ? table->subtableZ : table->subtables;
     DdHalfWord *symmInfo;
 
-    symmInfo =  ALLOC(DdHalfWord, table->size);
+    symmInfo =  ALLOC(DdHalfWord, zdd ? table->sizeZ : table->size);
     if (symmInfo == NULL) return(NULL);
 
     for (level = lower; level <= upper; level++) {
-	index = table->invperm[level];
-	next =  (int) table->subtables[level].next;
-	nextindex = table->invperm[next];
+	index = invperm[level];
+	next =  (int) subtables[level].next;
+	nextindex = invperm[next];
 	symmInfo[index] = (DdHalfWord) nextindex;
     }
     return(symmInfo);
@@ -925,13 +1494,15 @@ checkSymmInfo(
   DdManager * table,
   DdHalfWord * symmInfo,
   int  index,
-  int  level)
+  int  level,
+  int  zdd)
 {
     int i;
+    int *perm = zdd ? table->permZ : table->perm;
 
     i = (int) symmInfo[index];
     while (i != index) {
-	if (index < i && table->perm[i] <= level)
+	if (index < i && perm[i] <= level)
 	    return(0);
 	i = (int) symmInfo[i];
     }
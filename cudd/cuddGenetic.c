@@ -63,6 +63,10 @@
 #include "util.h"
 #include "cuddInt.h"
 
+#ifdef DD_USE_THREADS
+#include <pthread.h>
+#endif
+
 /*---------------------------------------------------------------------------*/
 /* Constant declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -72,6 +76,8 @@
 /*---------------------------------------------------------------------------*/
 
 typedef struct GeneticInfo GeneticInfo_t;
+typedef struct GeneticWork GeneticWork_t;
+typedef struct GeneticWorker GeneticWorker_t;
 
 /*---------------------------------------------------------------------------*/
 /* Stucture declarations                                                     */
@@ -101,6 +107,35 @@ struct GeneticInfo {
                          ** the largest number of nodes in the %DD */
     int result;		/**< result */
     int cross;		/**< the number of crossovers to perform */
+    int batch;		/**< crossovers whose children are evaluated
+                         ** together */
+    int zdd;		/**< 1 if the %ZDD variables are reordered */
+    int ncopies;	/**< number of copies of the heap */
+    DdManager **copies;	/**< copies of the heap for parallel evaluation */
+};
+
+/**
+ * @brief Individuals to be evaluated in parallel.
+ */
+struct GeneticWork {
+#ifdef DD_USE_THREADS
+    pthread_mutex_t lock;	/**< protects next */
+#endif
+    int *rows;		/**< individuals to be built */
+    int nrows;		/**< number of individuals to be built */
+    int next;		/**< next entry of rows to be taken */
+};
+
+/**
+ * @brief State of one thread evaluating individuals.
+ */
+struct GeneticWorker {
+    DdManager *dd;	/**< copy of the heap on which orders are built */
+    GeneticInfo_t info;	/**< private copy of the shared information */
+    GeneticWork_t *work; /**< individuals to be evaluated */
+    int lower;		/**< lowest level to be reordered */
+    int upper;		/**< highest level to be reordered */
+    int result;		/**< 1 if all individuals were built */
 };
 
 /*---------------------------------------------------------------------------*/
@@ -124,8 +159,11 @@ struct GeneticInfo {
 /* Static function prototypes                                                */
 /*---------------------------------------------------------------------------*/
 
+static int ddGa (DdManager *table, int lower, int upper, int zdd);
 static int make_random (DdManager *table, int lower, GeneticInfo_t * info);
-static int sift_up (DdManager *table, int x, int x_low);
+static int sift_up (DdManager *table, int x, int x_low, int zdd);
+static int ddGaSift (DdManager *table, int lower, int upper, GeneticInfo_t * info);
+static int ddGaSize (DdManager *table, GeneticInfo_t * info);
 static int build_dd (DdManager *table, int num, int lower, int upper, GeneticInfo_t * info);
 static int largest (GeneticInfo_t * info);
 static int rand_int (DdManager * dd, int a);
@@ -137,6 +175,11 @@ static double find_average_fitness (GeneticInfo_t * info);
 #endif
 static int PMX (DdManager * dd, int maxvar, GeneticInfo_t * info);
 static int roulette (DdManager *dd, int *p1, int *p2, GeneticInfo_t * info);
+static int ddGaEvaluate (DdManager *table, int first, int last, int lower, int upper, GeneticInfo_t *info);
+#ifdef DD_USE_THREADS
+static void * ddGaWorker (void *arg);
+#endif
+static void ddGaFreeCopies (DdManager *table, GeneticInfo_t *info);
 
 /** \endcond */
 
@@ -155,6 +198,13 @@ static int roulette (DdManager *dd, int *p1, int *p2, GeneticInfo_t * info);
   @details The two children of a crossover will be stored in
   storedd[popsize] and storedd[popsize+1] --- the last two slots in the
   storedd array.  (This will make comparisons and replacement easy.)
+  If more than one thread is allowed, the initial population is built
+  in parallel on copies of the heap, and the children of as many
+  crossovers as there are pairs of threads are built together, before
+  they are considered for the population in turn.  Only the final
+  order is built in the heap itself.
+
+  @see Cudd_SetReorderingThreads
 
   @return 1 in case of success; 0 otherwise.
 
@@ -167,16 +217,72 @@ cuddGa(
   int  lower /**< lowest level to be reordered */,
   int  upper /**< highest level to be reorderded */)
 {
-    int 	i,n,m;		/* dummy/loop vars */
+    return(ddGa(table,lower,upper,0));
+
+} /* end of cuddGa */
+
+
+/**
+  @brief Genetic algorithm for %ZDD reordering.
+
+  @details Same as cuddGa, except that the orders are built on the
+  %ZDD variables.  All orders are built in the heap itself, because
+  the copies used for parallel evaluation only hold BDDs.
+
+  @return 1 in case of success; 0 otherwise.
+
+  @sideeffect None
+
+  @see cuddGa
+
+*/
+int
+cuddZddGa(
+  DdManager * table /**< manager */,
+  int  lower /**< lowest level to be reordered */,
+  int  upper /**< highest level to be reorderded */)
+{
+    return(ddGa(table,lower,upper,1));
+
+} /* end of cuddZddGa */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/**
+  @brief Genetic algorithm shared by the %BDD and %ZDD variants.
+
+  @return 1 in case of success; 0 otherwise.
+
+  @sideeffect None
+
+  @see cuddGa cuddZddGa
+
+*/
+static int
+ddGa(
+  DdManager * table /**< manager */,
+  int  lower /**< lowest level to be reordered */,
+  int  upper /**< highest level to be reorderded */,
+  int  zdd /**< 1 for ZDDs; 0 for BDDs */)
+{
+    int 	i,n,m,b;	/* dummy/loop vars */
+    int		nb;		/* crossovers in the current batch */
     int		index;
 #ifdef DD_STATS
     double	average_fitness;
 #endif
     int		small;		/* index of smallest DD in population */
+    int		*invperm;
     GeneticInfo_t info;
 
+    info.zdd = zdd;
+    invperm = zdd ? table->invpermZ : table->invperm;
+
     /* Do an initial sifting to produce at least one reasonable individual. */
-    if (!cuddSifting(table,lower,upper)) return(0);
+    if (!ddGaSift(table,lower,upper,&info)) return(0);
 
     /* Get the initial values. */
     info.numvars = upper - lower + 1; /* number of variables to be reordered */
@@ -190,10 +296,37 @@ cuddGa(
     }
     if (info.popsize < 4) info.popsize = 4;	/* enforce minimum population size */
 
+    /* Make one copy of the heap per thread.  If no copy can be made,
+    ** the orders are built in the heap. */
+    info.batch = 1;
+    info.ncopies = 0;
+    info.copies = NULL;
+#ifdef DD_USE_THREADS
+    if (table->reordThreads > 1 && !zdd) {
+	info.copies = ALLOC(DdManager *, table->reordThreads);
+	if (info.copies == NULL) {
+	    table->errorCode = CUDD_MEMORY_OUT;
+	    return(0);
+	}
+	while (info.ncopies < table->reordThreads) {
+	    info.copies[info.ncopies] = cuddReorderCopy(table);
+	    if (info.copies[info.ncopies] == NULL) break;
+	    info.ncopies++;
+	}
+	if (info.ncopies == 0) {
+	    FREE(info.copies);
+	    info.copies = NULL;
+	} else {
+	    info.batch = (info.ncopies + 1) / 2;
+	}
+    }
+#endif
+
     /* Allocate population table. */
-    info.storedd = ALLOC(int,(info.popsize+2)*(info.numvars+1));
+    info.storedd = ALLOC(int,(info.popsize+2*info.batch)*(info.numvars+1));
     if (info.storedd == NULL) {
 	table->errorCode = CUDD_MEMORY_OUT;
+	ddGaFreeCopies(table,&info);
 	return(0);
     }
 
@@ -209,6 +342,7 @@ cuddGa(
     if (info.repeat == NULL) {
 	table->errorCode = CUDD_MEMORY_OUT;
 	FREE(info.storedd);
+	ddGaFreeCopies(table,&info);
 	return(0);
     }
     for (i = 0; i < info.popsize; i++) {
@@ -220,28 +354,29 @@ cuddGa(
 	table->errorCode = CUDD_MEMORY_OUT;
 	FREE(info.storedd);
 	FREE(info.repeat);
+	ddGaFreeCopies(table,&info);
 	return(0);
     }
 
     /* Copy the current DD and its size to the population table. */
     for (i = 0; i < info.numvars; i++) {
-	STOREDD(&info,0,i) = table->invperm[i+lower]; /* order of initial DD */
+	STOREDD(&info,0,i) = invperm[i+lower]; /* order of initial DD */
     }
-    STOREDD(&info,0,info.numvars) =
-        (int) (table->keys - table->isolated); /* size of initial DD */
+    STOREDD(&info,0,info.numvars) = ddGaSize(table,&info); /* size of initial DD */
 
     /* Store the initial order in the computed table. */
     if (st_insert(info.computed,info.storedd,(void *) 0) == ST_OUT_OF_MEM) {
 	FREE(info.storedd);
 	FREE(info.repeat);
 	st_free_table(info.computed);
+	ddGaFreeCopies(table,&info);
 	return(0);
     }
     info.repeat[0]++;
 
     /* Insert the reverse order as second element of the population. */
     for (i = 0; i < info.numvars; i++) {
-	STOREDD(&info,1,info.numvars-1-i) = table->invperm[i+lower]; /* reverse order */
+	STOREDD(&info,1,info.numvars-1-i) = invperm[i+lower]; /* reverse order */
     }
 
     /* Now create the random orders. make_random fills the population
@@ -254,14 +389,27 @@ cuddGa(
 	FREE(info.storedd);
 	FREE(info.repeat);
 	st_free_table(info.computed);
+	ddGaFreeCopies(table,&info);
+	return(0);
+    }
+    if (!ddGaEvaluate(table,1,info.popsize-1,lower,upper,&info)) {
+	FREE(info.storedd);
+	FREE(info.repeat);
+	st_free_table(info.computed);
+	ddGaFreeCopies(table,&info);
 	return(0);
     }
     for (i = 1; i < info.popsize; i++) {
-	info.result = build_dd(table,i,lower,upper,&info);	/* build and sift order */
+	if (info.ncopies == 0) {
+	    info.result = build_dd(table,i,lower,upper,&info);	/* build and sift order */
+	} else {
+	    info.result = 1;	/* already built */
+	}
 	if (!info.result) {
 	    FREE(info.storedd);
 	    FREE(info.repeat);
 	    st_free_table(info.computed);
+	    ddGaFreeCopies(table,&info);
 	    return(0);
 	}
 	if (st_lookup_int(info.computed,&STOREDD(&info,i,0),&index)) {
@@ -272,6 +420,7 @@ cuddGa(
 		FREE(info.storedd);
 		FREE(info.repeat);
 		st_free_table(info.computed);
+		ddGaFreeCopies(table,&info);
 		return(0);
 	    }
 	    info.repeat[i]++;
@@ -312,23 +461,45 @@ cuddGa(
     }
 
     /* Perform the crossovers to get the best order. */
-    for (m = 0; m < info.cross; m++) {
-	if (!PMX(table, table->size, &info)) {	/* perform one crossover */
-	    table->errorCode = CUDD_MEMORY_OUT;
+    for (m = 0; m < info.cross; m += nb) {
+	nb = info.cross - m < info.batch ? info.cross - m : info.batch;
+	for (b = nb - 1; b >= 0; b--) {
+	    if (!PMX(table, zdd ? table->sizeZ : table->size, &info)) {	/* perform one crossover */
+		table->errorCode = CUDD_MEMORY_OUT;
+		FREE(info.storedd);
+		FREE(info.repeat);
+		st_free_table(info.computed);
+		ddGaFreeCopies(table,&info);
+		return(0);
+	    }
+	    /* Move the children of all but the last crossover of the
+	    ** batch out of the way of the next one. */
+	    for (n = 0; b > 0 && n < 2 * (info.numvars + 1); n++) {
+		STOREDD(&info,info.popsize+2*b,n) = STOREDD(&info,info.popsize,n);
+	    }
+	}
+	if (!ddGaEvaluate(table,info.popsize,info.popsize+2*nb-1,lower,upper,
+			  &info)) {
 	    FREE(info.storedd);
 	    FREE(info.repeat);
 	    st_free_table(info.computed);
+	    ddGaFreeCopies(table,&info);
 	    return(0);
 	}
-	/* The offsprings are left in the last two entries of the
+	/* The offsprings are left in the last entries of the
 	** population table. These are now considered in turn.
 	*/
-	for (i = info.popsize; i <= info.popsize+1; i++) {
-	    info.result = build_dd(table,i,lower,upper,&info); /* build and sift child */
+	for (i = info.popsize; i < info.popsize+2*nb; i++) {
+	    if (info.ncopies == 0) {
+		info.result = build_dd(table,i,lower,upper,&info); /* build and sift child */
+	    } else {
+		info.result = 1;	/* already built */
+	    }
 	    if (!info.result) {
 		FREE(info.storedd);
 		FREE(info.repeat);
 		st_free_table(info.computed);
+		ddGaFreeCopies(table,&info);
 		return(0);
 	    }
 	    info.large = largest(&info); /* find the largest DD in population */
@@ -348,6 +519,7 @@ cuddGa(
 		    FREE(info.storedd);
 		    FREE(info.repeat);
 		    st_free_table(info.computed);
+		    ddGaFreeCopies(table,&info);
 		    return(0);
 		}
 		info.repeat[index]--;
@@ -358,6 +530,7 @@ cuddGa(
 			FREE(info.storedd);
 			FREE(info.repeat);
 			st_free_table(info.computed);
+			ddGaFreeCopies(table,&info);
 			return(0);
 		    }
 		}
@@ -376,6 +549,7 @@ cuddGa(
 			FREE(info.storedd);
 			FREE(info.repeat);
 			st_free_table(info.computed);
+			ddGaFreeCopies(table,&info);
 			return(0);
 		    }
 		    info.repeat[info.large]++;
@@ -398,18 +572,15 @@ cuddGa(
     /* Clean up, build the result DD, and return. */
     st_free_table(info.computed);
     info.computed = NULL;
+    ddGaFreeCopies(table,&info);
     info.result = build_dd(table,small,lower,upper,&info);
     FREE(info.storedd);
     FREE(info.repeat);
     return(info.result);
 
-} /* end of cuddGa */
+} /* end of ddGa */
 
 
-/*---------------------------------------------------------------------------*/
-/* Definition of static functions                                            */
-/*---------------------------------------------------------------------------*/
-
 /**
   @brief Generates the random sequences for the initial population.
 
@@ -457,7 +628,8 @@ make_random(
 		next = rand_int(table,info->numvars-1);
 	    } while (used[next] != 0);
 	    used[next] = 1;
-	    STOREDD(info,i,j) = table->invperm[next+lower];
+	    STOREDD(info,i,j) = info->zdd ? table->invpermZ[next+lower] :
+		table->invperm[next+lower];
        	}
 #if 0
 #ifdef DD_STATS
@@ -490,19 +662,20 @@ static int
 sift_up(
   DdManager * table,
   int  x,
-  int  x_low)
+  int  x_low,
+  int  zdd)
 {
     int        y;
     int        size;
 
-    y = cuddNextLow(table,x);
+    y = zdd ? cuddZddNextLow(table,x) : cuddNextLow(table,x);
     while (y >= x_low) {
-	size = cuddSwapInPlace(table,y,x);
+	size = zdd ? cuddZddSwapInPlace(table,y,x) : cuddSwapInPlace(table,y,x);
 	if (size == 0) {
 	    return(0);
 	}
 	x = y;
-	y = cuddNextLow(table,x);
+	y = zdd ? cuddZddNextLow(table,x) : cuddNextLow(table,x);
     }
     return(1);
 
@@ -556,10 +729,10 @@ build_dd(
     */
     for (j = 0; j < info->numvars; j++) {
 	i = STOREDD(info,num,j);
-	position = table->perm[i];
-	info->result = sift_up(table,position,j+lower);
+	position = info->zdd ? table->permZ[i] : table->perm[i];
+	info->result = sift_up(table,position,j+lower,info->zdd);
 	if (!info->result) return(0);
-	size = (int) (table->keys - table->isolated);
+	size = ddGaSize(table,info);
 	if (size > limit) break;
     }
 
@@ -567,19 +740,63 @@ build_dd(
 #ifdef DD_STATS
     (void) fprintf(table->out,"\n");
 #endif
-    info->result = cuddSifting(table,lower,upper);
+    info->result = ddGaSift(table,lower,upper,info);
     if (!info->result) return(0);
 
     /* Copy order and size to table. */
     for (j = 0; j < info->numvars; j++) {
-	STOREDD(info,num,j) = table->invperm[lower+j];
+	STOREDD(info,num,j) = info->zdd ? table->invpermZ[lower+j] :
+	    table->invperm[lower+j];
     }
-    STOREDD(info,num,info->numvars) = (int) (table->keys - table->isolated); /* size of new DD */
+    STOREDD(info,num,info->numvars) = ddGaSize(table,info); /* size of new DD */
     return(1);
 
 } /* end of build_dd */
 
 
+/**
+  @brief Sifts the variables between lower and upper.
+
+  @details Calls the sifting procedure of the kind of diagram being
+  reordered.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddGaSift(
+  DdManager * table,
+  int  lower,
+  int  upper,
+  GeneticInfo_t * info)
+{
+    if (info->zdd)
+	return(cuddZddSifting(table,lower,upper));
+    return(cuddSifting(table,lower,upper));
+
+} /* end of ddGaSift */
+
+
+/**
+  @brief Returns the number of live nodes of the diagrams being reordered.
+
+  @sideeffect None
+
+*/
+static int
+ddGaSize(
+  DdManager * table,
+  GeneticInfo_t * info)
+{
+    if (info->zdd)
+	return((int) table->keysZ);
+    return((int) (table->keys - table->isolated));
+
+} /* end of ddGaSize */
+
+
 /**
   @brief Finds the largest %DD in the population.
 
@@ -902,3 +1119,161 @@ roulette(
     return(1);
 
 } /* end of roulette */
+
+
+/**
+  @brief Builds in parallel the individuals in a range of the
+  population table.
+
+  @details Does nothing unless there are copies of the heap.  An
+  individual whose order is already in the computed table gets the
+  size from there; the others are built and sifted by one thread per
+  copy of the heap, each taking the next individual not yet taken.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect The orders and sizes of the individuals are updated.
+
+  @see build_dd
+
+*/
+static int
+ddGaEvaluate(
+  DdManager * table,
+  int  first,
+  int  last,
+  int  lower,
+  int  upper,
+  GeneticInfo_t * info)
+{
+#ifdef DD_USE_THREADS
+    GeneticWork_t work;
+    GeneticWorker_t *workers;
+    pthread_t *threads;
+    int *started;
+    int i, k, index, result;
+
+    if (info->ncopies == 0) return(1);
+    work.rows = ALLOC(int, last - first + 1);
+    workers = ALLOC(GeneticWorker_t, info->ncopies);
+    threads = ALLOC(pthread_t, info->ncopies);
+    started = ALLOC(int, info->ncopies);
+    if (work.rows == NULL || workers == NULL || threads == NULL ||
+	started == NULL || pthread_mutex_init(&work.lock, NULL) != 0) {
+	table->errorCode = CUDD_MEMORY_OUT;
+	if (work.rows != NULL) FREE(work.rows);
+	if (workers != NULL) FREE(workers);
+	if (threads != NULL) FREE(threads);
+	if (started != NULL) FREE(started);
+	return(0);
+    }
+    work.nrows = 0;
+    work.next = 0;
+    for (i = first; i <= last; i++) {
+	if (info->computed &&
+	    st_lookup_int(info->computed,&STOREDD(info,i,0),&index)) {
+	    STOREDD(info,i,info->numvars) = STOREDD(info,index,info->numvars);
+	} else {
+	    work.rows[work.nrows++] = i;
+	}
+    }
+
+    for (k = 0; k < info->ncopies; k++) {
+	workers[k].dd = info->copies[k];
+	workers[k].info = *info;
+	workers[k].info.computed = NULL;
+	workers[k].work = &work;
+	workers[k].lower = lower;
+	workers[k].upper = upper;
+	workers[k].result = 1;
+	started[k] = pthread_create(&threads[k], NULL, ddGaWorker,
+				    &workers[k]) == 0;
+    }
+    result = 1;
+    for (k = 0; k < info->ncopies; k++) {
+	if (started[k]) {
+	    (void) pthread_join(threads[k], NULL);
+	} else {
+	    /* Do the work of the thread that could not be started. */
+	    (void) ddGaWorker(&workers[k]);
+	}
+	if (workers[k].result == 0) {
+	    result = 0;
+	    if (workers[k].dd->errorCode != CUDD_NO_ERROR) {
+		table->errorCode = workers[k].dd->errorCode;
+	    }
+	}
+    }
+    (void) pthread_mutex_destroy(&work.lock);
+    FREE(work.rows);
+    FREE(workers);
+    FREE(threads);
+    FREE(started);
+    return(result);
+#else
+    (void) table; (void) first; (void) last;
+    (void) lower; (void) upper; (void) info;
+    return(1);
+#endif
+
+} /* end of ddGaEvaluate */
+
+
+#ifdef DD_USE_THREADS
+/**
+  @brief Builds individuals on a copy of the heap until none is left.
+
+  @details This is the body of the threads started by ddGaEvaluate.
+
+  @return NULL.
+
+  @sideeffect The result field of the worker is cleared in case of
+  failure.
+
+*/
+static void *
+ddGaWorker(
+  void * arg)
+{
+    GeneticWorker_t *worker = (GeneticWorker_t *) arg;
+    GeneticWork_t *work = worker->work;
+    int row;
+
+    for (;;) {
+	(void) pthread_mutex_lock(&work->lock);
+	row = work->next < work->nrows ? work->rows[work->next++] : -1;
+	(void) pthread_mutex_unlock(&work->lock);
+	if (row < 0) break;
+	if (!build_dd(worker->dd,row,worker->lower,worker->upper,
+		      &worker->info)) {
+	    worker->result = 0;
+	    break;
+	}
+    }
+    return(NULL);
+
+} /* end of ddGaWorker */
+#endif
+
+
+/**
+  @brief Frees the copies of the heap used by the genetic algorithm.
+
+  @sideeffect None
+
+*/
+static void
+ddGaFreeCopies(
+  DdManager * table,
+  GeneticInfo_t * info)
+{
+    int k;
+
+    for (k = 0; k < info->ncopies; k++) {
+	cuddReorderCopyFree(table, info->copies[k]);
+    }
+    if (info->copies != NULL) FREE(info->copies);
+    info->ncopies = 0;
+    info->copies = NULL;
+
+} /* end of ddGaFreeCopies */
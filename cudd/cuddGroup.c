@@ -417,7 +417,8 @@ ddReorderChildren(
 	    do {
 		initialSize = table->keys - table->isolated;
 		result = cuddSifting(table,lower,upper);
-		if (initialSize <= table->keys - table->isolated)
+		if (initialSize <= table->keys - table->isolated ||
+		    table->reordInterrupted)
 		    break;
 #ifdef DD_STATS
 		else
@@ -512,6 +513,9 @@ ddReorderChildren(
 	    result = ddGroupSifting(table,lower,upper,ddVarGroupCheck,
 				    DD_LAZY_SIFT);
 	    break;
+	case CUDD_REORDER_SIFT_INCREMENTAL:
+	    result = cuddIncrementalSifting(table,lower,upper);
+	    break;
 	default:
 	    return(0);
 	}
@@ -664,6 +668,7 @@ ddGroupSifting(
     int		*sifted;
     int		merged;
     int		dissolve;
+    DdReorderEvent event;
 #ifdef DD_STATS
     unsigned	previousSize;
 #endif
@@ -705,7 +710,11 @@ ddGroupSifting(
 
     /* Now sift. */
     for (i = 0; i < ddMin(table->siftMaxVar,classes); i++) {
-	if (table->ddTotalNumberSwapping >= table->siftMaxSwap)
+	if (table->ddTotalNumberSwapping >= table->siftMaxSwap) {
+	    table->telemetry.cutSwap += ddMin(table->siftMaxVar,classes) - i;
+	    break;
+	}
+	if (cuddReorderExpired(table))
 	    break;
         if (util_cpu_time() - table->startTime + table->reordTime
             > table->timeLimit) {
@@ -731,6 +740,7 @@ ddGroupSifting(
 	/* x is bottom of group */
 	assert((unsigned) x >= table->subtables[x].next);
 #endif
+	cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_SIFT,x);
 	if ((unsigned) x == table->subtables[x].next) {
 	    dissolve = 1;
 	    result = ddGroupSiftingAux(table,x,lower,upper,checkFunction,
@@ -740,6 +750,7 @@ ddGroupSifting(
 	    result = ddGroupSiftingAux(table,x,lower,upper,ddNoCheck,lazyFlag);
 	}
 	if (!result) goto ddGroupSiftingOutOfMem;
+	cuddReorderEventEnd(table,&event);
 
 	/* check for aggregation */
 	merged = 0;
@@ -1190,8 +1201,10 @@ ddGroupSiftingUp(
                 (void) fprintf(table->out,
                                "ddGroupSiftingUp (2 single groups):\n");
 #endif
-	    if ((double) size > (double) limitSize * table->maxGrowth)
+	    if ((double) size > (double) limitSize * table->maxGrowth) {
+		table->telemetry.cutGrowth++;
 		return(1);
+	    }
 	    if (size < limitSize) limitSize = size;
 	} else { /* Group move */
 	    size = ddGroupMove(table,x,y,moves);
@@ -1206,8 +1219,10 @@ ddGroupSiftingUp(
 		}
 		z = table->subtables[z].next;
 	    } while (z != (int) (*moves)->y);
-	    if ((double) size > (double) limitSize * table->maxGrowth)
+	    if ((double) size > (double) limitSize * table->maxGrowth) {
+		table->telemetry.cutGrowth++;
 		return(1);
+	    }
 	    if (size < limitSize) limitSize = size;
 	}
 	y = gxtop;
@@ -1354,8 +1369,10 @@ ddGroupSiftingDown(
                 (void) fprintf(table->out,
                                "ddGroupSiftingDown (2 single groups):\n");
 #endif
-	    if ((double) size > (double) limitSize * table->maxGrowth)
+	    if ((double) size > (double) limitSize * table->maxGrowth) {
+		table->telemetry.cutGrowth++;
 		return(1);
+	    }
 	    if (size < limitSize) limitSize = size;
 
 	} else { /* Group move */
@@ -1372,8 +1389,10 @@ ddGroupSiftingDown(
 	    } while (z <= gybot);
 	    size = ddGroupMove(table,x,y,moves);
 	    if (size == 0) goto ddGroupSiftingDownOutOfMem;
-	    if ((double) size > (double) limitSize * table->maxGrowth)
+	    if ((double) size > (double) limitSize * table->maxGrowth) {
+		table->telemetry.cutGrowth++;
 		return(1);
+	    }
 	    if (size < limitSize) limitSize = size;
 
 	    /* Update upper bound on node decrease: second phase. */
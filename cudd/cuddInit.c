@@ -76,6 +76,10 @@
 /* Static function prototypes                                                */
 /*---------------------------------------------------------------------------*/
 
+static DdManager * ddInitManager(unsigned int numVars, unsigned int numVarsZ, unsigned int numSlots, unsigned int cacheSize, size_t maxMemory);
+static int ddCloneSettings(DdManager *clone, DdManager *dd);
+static int ddCloneSubtable(DdManager *clone, DdSubtable *to, DdSubtable *from);
+
 /** \endcond */
 
 
@@ -107,33 +111,11 @@ Cudd_Init(
   size_t maxMemory /**< target maximum memory occupation */)
 {
     DdManager *unique;
-    int i,result;
+    int i;
     DdNode *one, *zero;
-    unsigned int maxCacheSize;
-    unsigned int looseUpTo;
-    extern DD_OOMFP MMoutOfMemory;
-    DD_OOMFP saveHandler;
 
-    if (maxMemory == 0) {
-	maxMemory = getSoftDataLimit();
-    }
-    looseUpTo = (unsigned int) ((maxMemory / sizeof(DdNode)) /
-				DD_MAX_LOOSE_FRACTION);
-    unique = cuddInitTable(numVars,numVarsZ,numSlots,looseUpTo);
+    unique = ddInitManager(numVars,numVarsZ,numSlots,cacheSize,maxMemory);
     if (unique == NULL) return(NULL);
-    unique->maxmem = (size_t) maxMemory / 10 * 9;
-    maxCacheSize = (unsigned int) ((maxMemory / sizeof(DdCache)) /
-				   DD_MAX_CACHE_FRACTION);
-    result = cuddInitCache(unique,cacheSize,maxCacheSize);
-    if (result == 0) return(NULL);
-
-    saveHandler = MMoutOfMemory;
-    MMoutOfMemory = unique->outOfMemCallback;
-    unique->stash = ALLOC(char,(maxMemory / DD_STASH_FRACTION) + 4);
-    MMoutOfMemory = saveHandler;
-    if (unique->stash == NULL) {
-	(void) fprintf(unique->err,"Unable to set aside memory\n");
-    }
 
     /* Initialize constants. */
     unique->one = cuddUniqueConst(unique,1.0);
@@ -176,6 +158,7 @@ Cudd_Init(
 	cuddZddInitUniv(unique);
 
     unique->memused += sizeof(DdNode *) * unique->maxSize;
+    cuddReorderTriggerReset(unique);
 
     return(unique);
 
@@ -202,6 +185,250 @@ Cudd_Quit(
 } /* end of Cudd_Quit */
 
 
+/**
+  @brief Makes an independent copy of a manager.
+
+  @details The copy has the same variables, orders, group trees and
+  variable map as the original, the same nodes with the same reference
+  counts, and the same parameters, but for the hooks, the callbacks,
+  the time limit and the spill file.  The nodes are copied in bulk
+  and laid out level by level in new blocks; each unique subtable
+  keeps its size.  If copyCache is nonzero, the entries of the computed table
+  are carried over as well; otherwise the copy starts with an empty
+  computed table of the same size.  The copied entries of commutative
+  operations whose operands are laid out in the other order in the copy
+  are not found there.
+  <p>
+  For i = 0,...,n-1, images[i] is set to the copy of roots[i].  The
+  images are not referenced again: each inherits the references of its
+  root, which should be released in the copy as they are in the
+  original.  Since the copy shares no data with the original, the two
+  may be used by different threads, as long as each manager is used by
+  one thread at a time.
+
+  @return a pointer to the copy if successful; NULL otherwise.
+
+  @sideeffect The death row of dd is emptied.
+
+  @see Cudd_Init Cudd_Quit Cudd_bddTransfer
+
+*/
+DdManager *
+Cudd_CloneManager(
+  DdManager * dd /**< manager to copy */,
+  DdNode * const * roots /**< nodes of dd to be mapped (may be NULL if n is 0) */,
+  DdNode ** images /**< receives the copies of the roots */,
+  int  n /**< number of roots */,
+  int  copyCache /**< nonzero to copy the computed table */)
+{
+    DdManager *clone;
+    DdNodePtr *nodes = NULL, *saved = NULL, *blocks = NULL, *univ = NULL;
+    DdNodePtr *mem;
+    DdNode *f, *g, *sentinel = &(dd->sentinel);
+    DdInteract *from = &(dd->interact);
+    DdInteract *to;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+    ptruint offset;
+    int i, j, k, total, nblocks, nconst, nbdd;
+
+#ifndef DD_NO_DEATH_ROW
+    cuddClearDeathRow(dd);
+#endif
+    clone = ddInitManager((unsigned int) dd->size, (unsigned int) dd->sizeZ,
+			  dd->initSlots, dd->cacheSlots,
+			  dd->maxmem / 9 * 10);
+    if (clone == NULL) {
+	dd->errorCode = CUDD_MEMORY_OUT;
+	return(NULL);
+    }
+    to = &(clone->interact);
+    if (!ddCloneSettings(clone, dd)) goto failure;
+
+    /* Get all the memory before touching the original. */
+    if (!ddCloneSubtable(clone, &(clone->constants), &(dd->constants)))
+	goto failure;
+    for (i = 0; i < dd->size; i++) {
+	if (!ddCloneSubtable(clone, &(clone->subtables[i]),
+			     &(dd->subtables[i])))
+	    goto failure;
+    }
+    for (i = 0; i < dd->sizeZ; i++) {
+	if (!ddCloneSubtable(clone, &(clone->subtableZ[i]),
+			     &(dd->subtableZ[i])))
+	    goto failure;
+    }
+    total = (int) dd->constants.keys;
+    for (i = 0; i < dd->size; i++) total += (int) dd->subtables[i].keys;
+    for (i = 0; i < dd->sizeZ; i++) total += (int) dd->subtableZ[i].keys;
+    nblocks = (total + DD_MEM_CHUNK - 1) / DD_MEM_CHUNK;
+    saveHandler = MMoutOfMemory;
+    MMoutOfMemory = dd->outOfMemCallback;
+    nodes = ALLOC(DdNodePtr,total);
+    saved = ALLOC(DdNodePtr,total);
+    blocks = ALLOC(DdNodePtr,nblocks);
+    clone->vars = ALLOC(DdNodePtr,clone->maxSize);
+    if (dd->univ != NULL) univ = ALLOC(DdNodePtr,dd->sizeZ);
+    MMoutOfMemory = saveHandler;
+    if (nodes == NULL || saved == NULL || blocks == NULL ||
+	clone->vars == NULL || (dd->univ != NULL && univ == NULL))
+	goto failure;
+    clone->memused += sizeof(DdNode *) * clone->maxSize;
+    for (i = 0; i < nblocks; i++) {
+	saveHandler = MMoutOfMemory;
+	MMoutOfMemory = dd->outOfMemCallback;
+	mem = cuddAllocNodeBlock(clone);
+	MMoutOfMemory = saveHandler;
+	if (mem == NULL) goto failure;
+	mem[0] = (DdNodePtr) clone->memoryList;
+	clone->memoryList = mem;
+	offset = (ptruint) mem & (sizeof(DdNode) - 1);
+	mem += (sizeof(DdNode) - offset) / sizeof(DdNodePtr);
+	blocks[i] = (DdNode *) mem;
+    }
+    if (!cuddCopyInteract(clone, dd)) goto failure;
+    if (to->valid && from->logSize > 0) {
+	saveHandler = MMoutOfMemory;
+	MMoutOfMemory = dd->outOfMemCallback;
+	to->log = ALLOC(DdNodePtr,from->logCapacity);
+	MMoutOfMemory = saveHandler;
+	if (to->log == NULL) goto failure;
+	to->logCapacity = from->logCapacity;
+    }
+
+    /* List the nodes: the constants, then the BDD levels, then the ZDD
+    ** levels. */
+    k = 0;
+    for (j = 0; j < (int) dd->constants.slots; j++) {
+	for (f = dd->constants.nodelist[j]; f != NULL; f = f->next)
+	    nodes[k++] = f;
+    }
+    for (i = 0; i < dd->size; i++) {
+	for (j = 0; j < (int) dd->subtables[i].slots; j++) {
+	    for (f = dd->subtables[i].nodelist[j]; f != sentinel; f = f->next)
+		nodes[k++] = f;
+	}
+    }
+    nbdd = k;
+    for (i = 0; i < dd->sizeZ; i++) {
+	for (j = 0; j < (int) dd->subtableZ[i].slots; j++) {
+	    for (f = dd->subtableZ[i].nodelist[j]; f != NULL; f = f->next)
+		nodes[k++] = f;
+	}
+    }
+#ifdef DD_DEBUG
+    assert(k == total);
+#endif
+
+    /* Copy the nodes, and leave in the next field of each original a
+    ** pointer to its copy.  Nothing can fail from here on. */
+    for (i = 0; i < total; i++) {
+	f = nodes[i];
+	g = &(blocks[i / DD_MEM_CHUNK][i % DD_MEM_CHUNK]);
+	*g = *f;
+	saved[i] = f->next;
+	f->next = g;
+    }
+    for (i = total; i < nblocks * DD_MEM_CHUNK; i++) {
+	g = &(blocks[i / DD_MEM_CHUNK][i % DD_MEM_CHUNK]);
+	g->ref = 0;
+	g->next = clone->nextFree;
+	clone->nextFree = g;
+    }
+
+    /* Translate the arcs and the collision lists of the constants,
+    ** whose positions do not depend on addresses. */
+    nconst = (int) dd->constants.keys;
+    for (i = 0; i < total; i++) {
+	g = nodes[i]->next;
+	if (i < nconst) {
+	    g->next = saved[i] == NULL ? NULL : saved[i]->next;
+	    continue;
+	}
+	cuddT(g) = cuddT(g)->next;
+	f = cuddE(g);
+	cuddE(g) = Cudd_NotCond(Cudd_Regular(f)->next, Cudd_IsComplement(f));
+    }
+    for (j = 0; j < (int) dd->constants.slots; j++) {
+	f = dd->constants.nodelist[j];
+	clone->constants.nodelist[j] = f == NULL ? NULL : f->next;
+    }
+
+    /* The other nodes are hashed again. */
+    for (i = 0; i < clone->size; i++) {
+	for (j = 0; j < (int) clone->subtables[i].slots; j++)
+	    clone->subtables[i].nodelist[j] = &(clone->sentinel);
+    }
+    for (i = 0; i < clone->sizeZ; i++) {
+	for (j = 0; j < (int) clone->subtableZ[i].slots; j++)
+	    clone->subtableZ[i].nodelist[j] = NULL;
+    }
+    for (i = total - 1; i >= nconst; i--) {
+	cuddLinkNode(clone, nodes[i]->next, i >= nbdd);
+    }
+
+    /* Translate the other pointers to nodes. */
+    clone->one = dd->one->next;
+    clone->zero = dd->zero->next;
+    clone->plusinfinity = dd->plusinfinity->next;
+    clone->minusinfinity = dd->minusinfinity->next;
+    clone->background = dd->background->next;
+    for (i = 0; i < dd->size; i++) {
+	clone->vars[i] = dd->vars[i]->next;
+    }
+    if (univ != NULL) {
+	for (i = 0; i < dd->sizeZ; i++) {
+	    univ[i] = dd->univ[i]->next;
+	}
+	clone->univ = univ;
+    }
+    if (to->log != NULL) {
+	for (i = 0; (size_t) i < from->logSize; i++) {
+	    to->log[i] = from->log[i]->next;
+	}
+	to->logSize = from->logSize;
+	to->logged = from->logged;
+	to->logging = from->logging;
+    }
+    for (i = 0; i < n; i++) {
+	f = roots[i];
+	images[i] = Cudd_NotCond(Cudd_Regular(f)->next, Cudd_IsComplement(f));
+    }
+    if (copyCache && clone->cacheSlots == dd->cacheSlots &&
+	dd->cacheFilter == NULL && dd->cacheLimbo == NULL) {
+	cuddCacheRelocate(clone, dd);
+	clone->cacheHits = dd->cacheHits;
+	clone->cacheMisses = dd->cacheMisses;
+    }
+
+    /* Restore the collision lists of the original. */
+    for (i = 0; i < total; i++) {
+	nodes[i]->next = saved[i];
+    }
+    FREE(nodes);
+    FREE(saved);
+    FREE(blocks);
+
+    clone->keys = dd->keys;
+    clone->keysZ = dd->keysZ;
+    clone->dead = dd->dead;
+    clone->deadZ = dd->deadZ;
+    clone->isolated = dd->isolated;
+    clone->originalSize = dd->originalSize;
+    return(clone);
+
+failure:
+    if (nodes != NULL) FREE(nodes);
+    if (saved != NULL) FREE(saved);
+    if (blocks != NULL) FREE(blocks);
+    if (univ != NULL) FREE(univ);
+    Cudd_Quit(clone);
+    dd->errorCode = CUDD_MEMORY_OUT;
+    return(NULL);
+
+} /* end of Cudd_CloneManager */
+
+
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -279,3 +506,256 @@ cuddZddFreeUniv(
 /* Definition of static functions                                            */
 /*---------------------------------------------------------------------------*/
 
+
+/**
+  @brief Creates a manager with empty unique tables.
+
+  @details Allocates the unique table, the cache and the memory
+  reserve.  The constants and the projection functions are left to
+  the caller.
+
+  @return a pointer to the manager if successful; NULL otherwise.
+
+  @sideeffect None
+
+  @see Cudd_Init Cudd_CloneManager
+
+*/
+static DdManager *
+ddInitManager(
+  unsigned int numVars,
+  unsigned int numVarsZ,
+  unsigned int numSlots,
+  unsigned int cacheSize,
+  size_t maxMemory)
+{
+    DdManager *unique;
+    int result;
+    unsigned int maxCacheSize;
+    unsigned int looseUpTo;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+
+    if (maxMemory == 0) {
+	maxMemory = getSoftDataLimit();
+    }
+    looseUpTo = (unsigned int) ((maxMemory / sizeof(DdNode)) /
+				DD_MAX_LOOSE_FRACTION);
+    unique = cuddInitTable(numVars,numVarsZ,numSlots,looseUpTo);
+    if (unique == NULL) return(NULL);
+    unique->maxmem = (size_t) maxMemory / 10 * 9;
+    maxCacheSize = (unsigned int) ((maxMemory / sizeof(DdCache)) /
+				   DD_MAX_CACHE_FRACTION);
+    result = cuddInitCache(unique,cacheSize,maxCacheSize);
+    if (result == 0) return(NULL);
+
+    saveHandler = MMoutOfMemory;
+    MMoutOfMemory = unique->outOfMemCallback;
+    unique->stash = ALLOC(char,(maxMemory / DD_STASH_FRACTION) + 4);
+    MMoutOfMemory = saveHandler;
+    if (unique->stash == NULL) {
+	(void) fprintf(unique->err,"Unable to set aside memory\n");
+    } else {
+	unique->stashSize = (maxMemory / DD_STASH_FRACTION) + 4;
+    }
+
+    return(unique);
+
+} /* end of ddInitManager */
+
+
+/**
+  @brief Copies the orders and the parameters of a manager.
+
+  @details Copies the variable orders, the variable map, the group
+  trees, the information kept between reorderings, the state of the
+  random number generator, and the parameters that are not tied to
+  the application: hooks, callbacks, time limit and spill file are
+  left at their defaults.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+  @see Cudd_CloneManager
+
+*/
+static int
+ddCloneSettings(
+  DdManager * clone,
+  DdManager * dd)
+{
+    int i;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+#ifndef DD_NO_DEATH_ROW
+    DdNodePtr *newRow;
+#endif
+
+    for (i = 0; i < dd->size; i++) {
+	clone->perm[i] = dd->perm[i];
+	clone->invperm[i] = dd->invperm[i];
+	clone->subtables[i].next = dd->subtables[i].next;
+	clone->subtables[i].bindVar = dd->subtables[i].bindVar;
+	clone->subtables[i].varType = dd->subtables[i].varType;
+	clone->subtables[i].pairIndex = dd->subtables[i].pairIndex;
+	clone->subtables[i].varHandled = dd->subtables[i].varHandled;
+	clone->subtables[i].varToBeGrouped = dd->subtables[i].varToBeGrouped;
+    }
+    for (i = 0; i < dd->sizeZ; i++) {
+	clone->permZ[i] = dd->permZ[i];
+	clone->invpermZ[i] = dd->invpermZ[i];
+	clone->subtableZ[i].next = dd->subtableZ[i].next;
+    }
+
+    saveHandler = MMoutOfMemory;
+    MMoutOfMemory = dd->outOfMemCallback;
+    if (dd->map != NULL) {
+	clone->map = ALLOC(int,clone->maxSize);
+	if (clone->map == NULL) goto failure;
+	for (i = 0; i < dd->size; i++) clone->map[i] = dd->map[i];
+	clone->memused += sizeof(int) * clone->maxSize;
+    }
+    if (dd->tree != NULL) {
+	clone->tree = Mtr_CopyTree(dd->tree, 1);
+	if (clone->tree == NULL) goto failure;
+    }
+    if (dd->treeZ != NULL) {
+	clone->treeZ = Mtr_CopyTree(dd->treeZ, 1);
+	if (clone->treeZ == NULL) goto failure;
+    }
+    if (dd->reordKeys != NULL) {
+	clone->reordKeys = ALLOC(unsigned int,dd->reordKeysSize);
+	if (clone->reordKeys == NULL) goto failure;
+	for (i = 0; i < dd->reordKeysSize; i++)
+	    clone->reordKeys[i] = dd->reordKeys[i];
+	clone->reordKeysSize = dd->reordKeysSize;
+    }
+    if (dd->siftPending != NULL && dd->siftNPending > 0) {
+	clone->siftPending = ALLOC(int,dd->siftNPending);
+	if (clone->siftPending == NULL) goto failure;
+	for (i = 0; i < dd->siftNPending; i++)
+	    clone->siftPending[i] = dd->siftPending[i];
+	clone->siftNPending = dd->siftNPending;
+    }
+    MMoutOfMemory = saveHandler;
+
+    clone->cuddRand = dd->cuddRand;
+    clone->cuddRand2 = dd->cuddRand2;
+    clone->shuffleSelect = dd->shuffleSelect;
+    for (i = 0; i < STAB_SIZE; i++)
+	clone->shuffleTable[i] = dd->shuffleTable[i];
+
+    clone->minHit = dd->minHit;
+    clone->cacheSlack = dd->cacheSlack;
+    clone->maxCacheHard = dd->maxCacheHard;
+    clone->maxLive = dd->maxLive;
+    clone->minDead = dd->minDead;
+    clone->gcEnabled = dd->gcEnabled;
+    clone->gcFrac = dd->gcFrac;
+    clone->looseUpTo = dd->looseUpTo;
+    clone->maxmem = dd->maxmem;
+    clone->maxmemhard = dd->maxmemhard;
+    clone->releaseFrac = dd->releaseFrac;
+    clone->epsilon = dd->epsilon;
+    clone->reorderings = dd->reorderings;
+    clone->maxReorderings = dd->maxReorderings;
+    clone->siftMaxVar = dd->siftMaxVar;
+    clone->siftMaxSwap = dd->siftMaxSwap;
+    clone->siftTight = dd->siftTight;
+    clone->siftWindow = dd->siftWindow;
+    clone->autoCompact = dd->autoCompact;
+    clone->reordDeadline = dd->reordDeadline;
+    clone->reordMaxSwaps = dd->reordMaxSwaps;
+    clone->reordCycle = dd->reordCycle;
+    clone->maxGrowth = dd->maxGrowth;
+    clone->maxGrowthAlt = dd->maxGrowthAlt;
+    clone->autoDyn = dd->autoDyn;
+    clone->autoDynZ = dd->autoDynZ;
+    clone->autoMethod = dd->autoMethod;
+    clone->autoMethodZ = dd->autoMethodZ;
+    clone->realign = dd->realign;
+    clone->realignZ = dd->realignZ;
+    clone->nextDyn = dd->nextDyn;
+    clone->countDead = dd->countDead;
+    clone->groupcheck = dd->groupcheck;
+    clone->recomb = dd->recomb;
+    clone->symmviolation = dd->symmviolation;
+    clone->arcviolation = dd->arcviolation;
+    clone->populationSize = dd->populationSize;
+    clone->numberXovers = dd->numberXovers;
+    clone->reordThreads = dd->reordThreads;
+    clone->randomizeOrder = dd->randomizeOrder;
+    clone->out = dd->out;
+    clone->err = dd->err;
+    cuddReorderTriggerReset(clone);
+#ifndef DD_NO_DEATH_ROW
+    /* The death row of the original may have been shrunk when automatic
+    ** reordering was enabled. */
+    if (dd->deathRowDepth < clone->deathRowDepth) {
+	/* On failure the old row is still owned by the copy, which the
+	** caller frees. */
+	newRow = REALLOC(DdNodePtr, clone->deathRow, dd->deathRowDepth);
+	if (newRow == NULL) return(0);
+	clone->memused -= (clone->deathRowDepth - dd->deathRowDepth) *
+	    sizeof(DdNodePtr);
+	clone->deathRow = newRow;
+	clone->deathRowDepth = dd->deathRowDepth;
+	clone->deadMask = clone->deathRowDepth - 1;
+    }
+#endif
+
+    return(1);
+
+failure:
+    MMoutOfMemory = saveHandler;
+    return(0);
+
+} /* end of ddCloneSettings */
+
+
+/**
+  @brief Gives a subtable of the copy the size of the original.
+
+  @details Copies the counts of the subtable; the collision lists are
+  filled in later by Cudd_CloneManager.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect The memory accounted to clone changes with the size of
+  the subtable.
+
+  @see Cudd_CloneManager
+
+*/
+static int
+ddCloneSubtable(
+  DdManager * clone,
+  DdSubtable * to,
+  DdSubtable * from)
+{
+    DdNodePtr *nodelist;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+
+    if (to->slots != from->slots) {
+	saveHandler = MMoutOfMemory;
+	MMoutOfMemory = clone->outOfMemCallback;
+	nodelist = ALLOC(DdNodePtr,from->slots);
+	MMoutOfMemory = saveHandler;
+	if (nodelist == NULL) return(0);
+	FREE(to->nodelist);
+	to->nodelist = nodelist;
+	clone->slots = clone->slots - to->slots + from->slots;
+	clone->memused = clone->memused - to->slots * sizeof(DdNodePtr) +
+	    from->slots * sizeof(DdNodePtr);
+    }
+    to->shift = from->shift;
+    to->slots = from->slots;
+    to->keys = from->keys;
+    to->maxKeys = from->maxKeys;
+    to->dead = from->dead;
+    return(1);
+
+} /* end of ddCloneSubtable */
+
@@ -53,6 +53,9 @@
 
 #include <math.h>
 #include "config.h"
+#if HAVE_UNISTD_H == 1
+#include <unistd.h>
+#endif
 #include "st.h"
 #include "mtr.h"
 #include "epd.h"
@@ -89,6 +92,22 @@
 
 #define DD_NON_CONSTANT		((DdNode *) 1)	/* for Cudd_bddIteConstant */
 
+/* Code that uses POSIX threads (to decode or search in parallel; the
+** manager itself is never shared between threads) is compiled only if
+** DD_USE_THREADS is defined.  configure defines it in config.h when it
+** finds the flags (PTHREAD_CFLAGS and PTHREAD_LIBS) to build threaded
+** code, unless --disable-threads is given.
+*/
+
+/* Node blocks may be kept in memory-mapped files (Cudd_EnableSpill) only
+** if DD_USE_MMAP is defined.  This happens when the platform supports
+** mapped files, unless DD_NO_MMAP is defined.
+*/
+#if !defined(DD_NO_MMAP) && defined(_POSIX_MAPPED_FILES) && \
+    _POSIX_MAPPED_FILES > 0
+#define DD_USE_MMAP
+#endif
+
 /* Unique table and cache management constants. */
 #define DD_MAX_SUBTABLE_DENSITY 4	/* tells when to resize a subtable */
 /* gc when this percent are dead (measured w.r.t. slots, not keys)
@@ -109,10 +128,12 @@
 #define DD_STASH_FRACTION	64 /* 1 / (fraction of memory set
 				      aside for emergencies) */
 #define DD_MAX_CACHE_TO_SLOTS_RATIO 4 /* used to limit the cache size */
+#define DD_MIN_CACHE_SLOTS	1024	/* cache is not shrunk below this */
 
 /* Variable ordering default parameter values. */
 #define DD_SIFT_MAX_VAR		1000
 #define DD_SIFT_MAX_SWAPS	2000000
+#define DD_SIFT_WINDOW		16	/* half width for incremental sifting */
 #define DD_DEFAULT_RECOMB	0
 #define DD_MAX_REORDER_GROWTH	1.2
 #define DD_FIRST_REORDER	4004	/* 4 for the constants */
@@ -157,6 +178,7 @@
 #define DD_BDD_MAX_EXP_TAG			0x8a
 #define DD_VARS_SYMM_BEFORE_TAG			0x8e
 #define DD_VARS_SYMM_BETWEEN_TAG		0xa2
+#define DD_SHUFFLE_ITE_TAG			0xa6
 
 /* Generator constants. */
 #define CUDD_GEN_CUBES 0
@@ -238,6 +260,12 @@ typedef struct DdLocalCacheItem DdLocalCacheItem;
 typedef struct DdLocalCache DdLocalCache;
 typedef struct DdHashItem DdHashItem;
 typedef struct DdHashTable DdHashTable;
+typedef struct DdCheckpointEntry DdCheckpointEntry;
+typedef struct DdCheckpoint DdCheckpoint;
+typedef struct DdSpill DdSpill;
+typedef struct DdInteractList DdInteractList;
+typedef struct DdInteract DdInteract;
+typedef struct DdReorderTelemetry DdReorderTelemetry;
 typedef struct Move Move;
 typedef struct IndexKey IndexKey;
 typedef struct DdQueueItem DdQueueItem;
@@ -362,6 +390,128 @@ struct DdHashTable {
     DdManager *manager;		/**< %DD manager */
 };
 
+/**
+ *  @brief Node record of a checkpoint.
+ *
+ *  @details Node records are written to checkpoint files as they are
+ *  laid out in memory.  Node ids start at 1.
+ *
+ *  @see Cudd_Checkpoint
+ */
+struct DdCheckpointEntry {
+    int index;			/**< variable index; -1 for a constant */
+    union {
+	struct {
+	    int t;		/**< id of the then child */
+	    int e;		/**< id of the else child times 2, plus 1 if
+				 ** the else arc is complemented */
+	} kids;
+	CUDD_VALUE_TYPE value;	/**< value of a constant */
+    } u;
+};
+
+/**
+ *  @brief State kept by the manager between checkpoints.
+ *
+ *  @details Maps the nodes written to the last checkpoint file to
+ *  their ids, so that the next checkpoint to the same file only needs
+ *  to append the nodes created since.  The map only holds the nodes
+ *  that were live at the last checkpoint; the records of all the ids
+ *  in the file are kept.
+ *
+ *  @see Cudd_Checkpoint
+ */
+struct DdCheckpoint {
+    char *path;			/**< file of the checkpoints */
+    unsigned int epoch;		/**< number of the last checkpoint */
+    int nextId;			/**< first unused node id */
+    int capacity;		/**< number of slots in entries */
+    DdCheckpointEntry *entries;	/**< node records indexed by id */
+    st_table *ids;		/**< maps live nodes to ids */
+    int size;			/**< number of variables at last checkpoint */
+    int *invperm;		/**< order at last checkpoint */
+};
+
+/**
+ *  @brief File-backed storage of node blocks.
+ *
+ *  @details The node blocks are carved from segments of a file mapped
+ *  in shared mode, so that the operating system may write them back
+ *  to the file instead of keeping them in memory.  The blocks are
+ *  aligned on page boundaries; blocks given back are kept on a free
+ *  list linked through their first word.
+ *
+ *  @see Cudd_EnableSpill
+ */
+struct DdSpill {
+    int fd;			/**< descriptor of the (unlinked) file */
+    size_t pageSize;		/**< bytes of a page */
+    size_t blockSize;		/**< bytes of a block, rounded to pages */
+    size_t segmentSize;		/**< bytes of a segment */
+    char **segments;		/**< base addresses of the segments */
+    int nsegments;		/**< number of segments mapped */
+    int maxSegments;		/**< number of entries of segments */
+    size_t carved;		/**< blocks carved from the last segment */
+    DdNodePtr *freeBlocks;	/**< blocks given back */
+    size_t blocks;		/**< blocks in use */
+};
+
+/**
+ *  @brief Variables that interact with one variable.
+ */
+struct DdInteractList {
+    DdHalfWord *nbr;		/**< interacting variables in increasing order */
+    int n;			/**< number of entries */
+    int capacity;		/**< number of entries allocated */
+};
+
+/**
+ *  @brief Variable interaction matrix.
+ *
+ *  @details The matrix is either a packed array of bits or a list of
+ *  interacting variables per variable.  It is kept between reorderings,
+ *  and the nodes created in the meantime are logged.
+ *
+ *  @see cuddInitInteract
+ */
+struct DdInteract {
+    int size;			/**< number of variables covered */
+    ptruint *matrix;		/**< upper triangle of the matrix, or NULL */
+    DdInteractList *lists;	/**< interacting variables, or NULL */
+    size_t entries;		/**< total length of the lists */
+    int valid;			/**< the matrix covers all nodes but those logged */
+    int logging;		/**< new nodes are logged */
+    DdNodePtr *log;		/**< nodes created since the last update */
+    size_t logSize;		/**< number of logged nodes */
+    size_t logCapacity;		/**< number of entries allocated for log */
+    size_t logged;		/**< nodes logged since the last computation */
+};
+
+/**
+ *  @brief Reordering telemetry.
+ *
+ *  @details Totals accumulated over all reorderings, and the callback
+ *  that receives the individual events.
+ *
+ *  @see Cudd_SetReorderingTelemetry Cudd_PrintReorderingSummary
+ */
+struct DdReorderTelemetry {
+    DD_RECFP callback;		/**< receives each event, if not NULL */
+    void *arg;			/**< last argument passed to callback */
+    unsigned long sifted;	/**< variables sifted */
+    double swaps;		/**< swaps performed while sifting them */
+    double moved;		/**< total distance of their moves */
+    double removed;		/**< nodes removed by sifting them */
+    unsigned long siftTime;	/**< time spent sifting them (ms) */
+    unsigned long cutGrowth;	/**< sifting directions cut by maxGrowth */
+    unsigned long cutSwap;	/**< variables not sifted because of siftMaxSwap */
+    unsigned long gcs;		/**< garbage collections while reordering */
+    double reclaimed;		/**< nodes they reclaimed */
+    unsigned long gcTime;	/**< time they took (ms) */
+    unsigned long flushes;	/**< cache flushes for reordering */
+    unsigned long flushTime;	/**< time they took (ms) */
+};
+
 /**
  *  @brief Computed table.
  */
@@ -414,6 +564,10 @@ struct DdManager {
     double minHit;		/**< hit percentage above which to resize */
     int cacheSlack;		/**< slots still available for resizing */
     unsigned int maxCacheHard;	/**< hard limit for cache size */
+    int preserveCache;		/**< keep valid entries across reordering */
+    ptruint *cacheFilter;	/**< nodes seen in the cache during reordering */
+    int cacheFilterShift;	/**< shift value for the filter hash function */
+    DdNode *cacheLimbo;		/**< freed nodes still seen in the cache */
     /* Unique Table */
     int size;			/**< number of unique subtables */
     int sizeZ;			/**< for %ZDD */
@@ -448,12 +602,15 @@ struct DdManager {
     unsigned int isolated;	/**< isolated projection functions */
     unsigned int originalSize;	/**< used by lazy sifting */
     int linearSize;		/**< number of rows and columns of linear */
-    ptruint *interact;		/**< interacting variable matrix */
+    DdInteract interact;	/**< interacting variable matrix */
     ptruint *linear;		/**< linear transform matrix */
     /* Memory Management */
     DdNode **memoryList;	/**< memory manager for symbol table */
     DdNode *nextFree;		/**< list of free nodes */
+    unsigned int nodeBlocks;	/**< node blocks in memoryList */
+    unsigned int peakNodeBlocks; /**< maximum of nodeBlocks */
     char *stash;		/**< memory reserve */
+    size_t stashSize;		/**< size of the memory reserve */
 #ifndef DD_NO_DEATH_ROW
     DdNode **deathRow;		/**< queue for dereferencing */
     int deathRowDepth;		/**< number of slots in the queue */
@@ -468,8 +625,23 @@ struct DdManager {
     unsigned int maxReorderings;/**< maximum number of calls to Cudd_ReduceHeap */
     int siftMaxVar;		/**< maximum number of vars sifted */
     int siftMaxSwap;		/**< maximum number of swaps per sifting */
+    int siftTight;		/**< sift with tighter bounds, by benefit */
+    int siftWindow;		/**< half width of incremental sifting range */
+    unsigned int *reordKeys;	/**< subtable keys by index after last reordering */
+    int reordKeysSize;		/**< number of entries in reordKeys */
+    int autoCompact;		/**< compact the heap after reordering */
     int ddTotalNumberSwapping;  /**< number of %BDD/%ADD swaps completed */
     int zddTotalNumberSwapping; /**< number of %ZDD swaps completed */
+    unsigned long reordDeadline;/**< real time allowed per reordering (ms) */
+    int reordMaxSwaps;		/**< swaps allowed per reordering */
+    long reordStart;		/**< real time at start of reordering */
+    int reordInterrupted;	/**< reordering stopped by its budget */
+    int siftedVars;		/**< variables sifted by last reordering */
+    int *siftPending;		/**< variables not sifted by last reordering */
+    int siftNPending;		/**< number of entries in siftPending */
+    int *siftSkipped;		/**< variables not sifted by this reordering */
+    int siftNSkipped;		/**< number of entries in siftSkipped */
+    int siftRan;		/**< a sifting pass ran in this reordering */
     int reordCycle;		/**< how often to apply alternate threshold */
     double maxGrowth;		/**< maximum growth during reordering */
     double maxGrowthAlt;	/**< alternate maximum growth for reordering */
@@ -489,13 +661,30 @@ struct DdManager {
     int arcviolation;		/**< used during group sifting */
     int populationSize;		/**< population size for GA */
     int	numberXovers;		/**< number of crossovers for GA */
+    int reordThreads;		/**< threads used by GA and annealing */
     unsigned int randomizeOrder; /**< perturb the next reordering threshold */
+    DD_RTFP reordTrigger;	/**< decides whether to reorder at nextDyn */
+    void *rtArg;		/**< second argument passed to reordTrigger */
+    double trigLookups;		/**< cache lookups at start of window */
+    double trigHits;		/**< cache hits at start of window */
+    unsigned int trigKeys;	/**< live nodes at start of window */
+    unsigned long trigTime;	/**< CPU time at start of window */
+    double trigHitRate;		/**< hit rate of previous window (< 0: none) */
+    double trigThroughput;	/**< throughput of previous window */
+    double trigGrowth;		/**< growth of previous window */
+    double reordPayoff;		/**< average fraction of nodes removed */
+    double reordCost;		/**< average duration of reordering (ms) */
+    unsigned long reordEnd;	/**< CPU time at end of last reordering */
+    DdReorderTelemetry telemetry; /**< reordering events and totals */
     DdLocalCache *localCaches;	/**< local caches currently in existence */
+    size_t hashMemused;		/**< memory of the hash tables in existence */
     void *hooks;		/**< application-specific field (used by vis) */
     DdHook *preGCHook;		/**< hooks to be called before GC */
     DdHook *postGCHook;		/**< hooks to be called after GC */
     DdHook *preReorderingHook;	/**< hooks to be called before reordering */
     DdHook *postReorderingHook;	/**< hooks to be called after reordering */
+    DdCheckpoint *checkpoint;	/**< state of incremental checkpoints */
+    DdSpill *spill;		/**< file-backed node storage (or NULL) */
     FILE *out;			/**< stdout for this manager */
     FILE *err;			/**< stderr for this manager */
     Cudd_ErrorType errorCode;	/**< info on last error */
@@ -506,10 +695,15 @@ struct DdManager {
     DD_OOMFP outOfMemCallback;	/**< out-of-memory callback */
     DD_TOHFP timeoutHandler;	/**< timeout handler */
     void * tohArg;		/**< second argument passed to timeout handler */
+    DD_MPHFP pressureHandler;	/**< memory pressure handler */
+    void * mphArg;		/**< second argument passed to pressure handler */
+    size_t pressureMark;	/**< memory in use that triggers the next relief */
     /* Statistical counters. */
     size_t memused;		/**< total memory allocated for the manager */
     size_t maxmem;		/**< target maximum memory */
     size_t maxmemhard;		/**< hard limit for maximum memory */
+    double releaseFrac;		/**< occupancy below which free blocks go */
+    unsigned long releasedBlocks; /**< node blocks released by GC */
     int garbageCollections;	/**< number of garbage collections */
     unsigned long GCTime;	/**< total time spent in garbage collection */
     unsigned long reordTime;	/**< total time spent in reordering */
@@ -630,6 +824,28 @@ struct DdLevelQueue {
     (node)->next = (unique)->nextFree; \
     (unique)->nextFree = node;
 
+/**
+  @brief Frees a node that has died during reordering.
+
+  @details If the cache is preserved across reordering, a node that
+  may appear in the cache is set aside until the cache has been
+  cleaned, so that its memory is not recycled while cache entries
+  still point to it.  Otherwise, the node is added to the free list.
+
+  @sideeffect None
+
+  @see cuddDeallocNode cuddCacheRetireNode
+
+*/
+#define cuddReorderDeallocNode(unique,node) \
+    do {                                                                \
+	if ((unique)->cacheFilter != NULL) {                            \
+	    cuddCacheRetireNode(unique,node);                           \
+	} else {                                                        \
+	    cuddDeallocNode(unique,node);                               \
+	}                                                               \
+    } while (0)
+
 /**
   @brief Adds node to the head of the free list.
 
@@ -1081,6 +1297,7 @@ extern DdNode * cuddBddIntersectRecur(DdManager *dd, DdNode *f, DdNode *g);
 extern DdNode * cuddBddAndRecur(DdManager *manager, DdNode *f, DdNode *g);
 extern DdNode * cuddBddXorRecur(DdManager *manager, DdNode *f, DdNode *g);
 extern DdNode * cuddBddTransfer(DdManager *ddS, DdManager *ddD, DdNode *f);
+extern int cuddBddTransferVector(DdManager *ddS, DdManager *ddD, DdNode * const *F, DdNode **G, int n);
 extern DdNode * cuddAddBddDoPattern(DdManager *dd, DdNode *f);
 extern int cuddInitCache(DdManager *unique, unsigned int cacheSize, unsigned int maxCacheSize);
 extern void cuddCacheInsert(DdManager *table, ptruint op, DdNode *f, DdNode *g, DdNode *h, DdNode *data);
@@ -1095,11 +1312,22 @@ extern DdNode * cuddCacheLookup1Zdd(DdManager *table, DdNode * (*)(DdManager *,
 extern DdNode * cuddConstantLookup(DdManager *table, ptruint op, DdNode *f, DdNode *g, DdNode *h);
 extern int cuddCacheProfile(DdManager *table, FILE *fp);
 extern void cuddCacheResize(DdManager *table);
+extern int cuddCacheShrink(DdManager *table, int hard);
 extern void cuddCacheFlush(DdManager *table);
+extern void cuddCacheRelocate(DdManager *table, DdManager *source);
+extern void cuddCacheClearDead(DdManager *table);
+extern void cuddCacheKeepStart(DdManager *table);
+extern void cuddCacheRetireNode(DdManager *table, DdNode *node);
+extern void cuddCacheKeepEnd(DdManager *table);
 extern int cuddComputeFloorLog2(unsigned int value);
 extern int cuddHeapProfile(DdManager *dd);
 extern void cuddPrintNode(DdNode *f, FILE *fp);
 extern void cuddPrintVarGroups(DdManager * dd, MtrNode * root, int zdd, int silent);
+extern void cuddFreeCheckpoint(DdManager *dd);
+extern DdNodePtr * cuddAllocNodeBlock(DdManager *unique);
+extern void cuddFreeNodeBlock(DdManager *unique, DdNodePtr *block);
+extern int cuddSpillOwns(DdManager *unique, DdNodePtr *block);
+extern void cuddFreeSpill(DdManager *unique);
 extern DdNode * cuddBddClippingAnd(DdManager *dd, DdNode *f, DdNode *g, int maxDepth, int direction);
 extern DdNode * cuddBddClippingAndAbstract(DdManager *dd, DdNode *f, DdNode *g, DdNode *cube, int maxDepth, int direction);
 extern void cuddGetBranches(DdNode *g, DdNode **g1, DdNode **g0);
@@ -1107,6 +1335,7 @@ extern DdNode * cuddCofactorRecur(DdManager *dd, DdNode *f, DdNode *g);
 extern DdNode * cuddBddComposeRecur(DdManager *dd, DdNode *f, DdNode *g, DdNode *proj);
 extern DdNode * cuddAddComposeRecur(DdManager *dd, DdNode *f, DdNode *g, DdNode *proj);
 extern int cuddExact(DdManager *table, int lower, int upper);
+extern int cuddZddExact(DdManager *table, int lower, int upper);
 extern DdNode * cuddBddConstrainRecur(DdManager *dd, DdNode *f, DdNode *c);
 extern DdNode * cuddBddRestrictRecur(DdManager *dd, DdNode *f, DdNode *c);
 extern DdNode * cuddBddNPAndRecur(DdManager *dd, DdNode *f, DdNode *c);
@@ -1114,12 +1343,21 @@ extern DdNode * cuddAddConstrainRecur(DdManager *dd, DdNode *f, DdNode *c);
 extern DdNode * cuddAddRestrictRecur(DdManager *dd, DdNode *f, DdNode *c);
 extern DdNode * cuddBddLICompaction(DdManager *dd, DdNode *f, DdNode *c);
 extern int cuddGa(DdManager *table, int lower, int upper);
+extern int cuddZddGa(DdManager *table, int lower, int upper);
 extern int cuddTreeSifting(DdManager *table, Cudd_ReorderingType method);
 extern int cuddZddInitUniv(DdManager *zdd);
 extern void cuddZddFreeUniv(DdManager *zdd);
-extern void cuddSetInteract(DdManager *table, int x, int y);
+extern int cuddSetInteract(DdManager *table, int x, int y);
 extern int cuddTestInteract(DdManager *table, int x, int y);
+extern int cuddReadInteractList(DdManager *table, int x, DdHalfWord const **nbr);
+extern int cuddMergeInteract(DdManager *table, int x, int y);
 extern int cuddInitInteract(DdManager *table);
+extern void cuddResumeInteract(DdManager *table);
+extern int cuddCopyInteract(DdManager *dest, DdManager *source);
+extern void cuddLogInteract(DdManager *table, DdNode *f);
+extern void cuddPruneInteract(DdManager *table);
+extern void cuddFreeInteract(DdManager *table);
+extern size_t cuddInteractMemory(DdManager *table);
 extern DdLocalCache * cuddLocalCacheInit(DdManager *manager, unsigned int keySize, unsigned int cacheSize, unsigned int maxCacheSize);
 extern void cuddLocalCacheQuit(DdLocalCache *cache);
 extern void cuddLocalCacheInsert(DdLocalCache *cache, DdNodePtr *key, DdNode *value);
@@ -1151,7 +1389,7 @@ extern void * cuddLevelQueueEnqueue(DdLevelQueue *queue, void *key, int level);
 extern void cuddLevelQueueDequeue(DdLevelQueue *queue, int level);
 extern int cuddLinearAndSifting(DdManager *table, int lower, int upper);
 extern int cuddLinearInPlace(DdManager * table, int  x, int  y);
-extern void cuddUpdateInteractionMatrix(DdManager * table, int  xindex, int  yindex);
+extern int cuddUpdateInteractionMatrix(DdManager * table, int  xindex, int  yindex);
 extern int cuddInitLinear(DdManager *table);
 extern int cuddResizeLinear(DdManager *table);
 extern DdNode * cuddBddLiteralSetIntersectionRecur(DdManager *dd, DdNode *f, DdNode *g);
@@ -1163,6 +1401,14 @@ extern void cuddClearDeathRow(DdManager *table);
 extern void cuddShrinkDeathRow(DdManager *table);
 extern DdNode * cuddDynamicAllocNode(DdManager *table);
 extern int cuddSifting(DdManager *table, int lower, int upper);
+extern int cuddIncrementalSifting(DdManager *table, int lower, int upper);
+extern int cuddReorderExpired(DdManager *table);
+extern DdManager * cuddReorderCopy(DdManager *table);
+extern void cuddReorderCopyFree(DdManager *table, DdManager *copy);
+extern int cuddReorderTrigger(DdManager *table);
+extern void cuddReorderTriggerReset(DdManager *table);
+extern void cuddReorderEventBegin(DdManager *table, DdReorderEvent *event, Cudd_ReorderEventType type, int x);
+extern void cuddReorderEventEnd(DdManager *table, DdReorderEvent *event);
 extern int cuddSwapping(DdManager *table, int lower, int upper, Cudd_ReorderingType heuristic);
 extern int cuddNextHigh(DdManager *table, int x);
 extern int cuddNextLow(DdManager *table, int x);
@@ -1180,6 +1426,7 @@ extern int cuddSymmCheck(DdManager *table, int x, int y);
 extern int cuddSymmSifting(DdManager *table, int lower, int upper);
 extern int cuddSymmSiftingConv(DdManager *table, int lower, int upper);
 extern DdNode * cuddAllocNode(DdManager *unique);
+extern void cuddLinkNode(DdManager *unique, DdNode *f, int zdd);
 extern DdManager * cuddInitTable(unsigned int numVars, unsigned int numVarsZ, unsigned int numSlots, unsigned int looseUpTo);
 extern void cuddFreeTable(DdManager *unique);
 extern int cuddGarbageCollect(DdManager *unique, int clearCache);
@@ -1190,6 +1437,7 @@ extern DdNode * cuddUniqueInterIVO(DdManager *unique, int index, DdNode *T, DdNo
 extern DdNode * cuddUniqueInterZdd(DdManager *unique, int index, DdNode *T, DdNode *E);
 extern DdNode * cuddUniqueConst(DdManager *unique, CUDD_VALUE_TYPE value);
 extern void cuddRehash(DdManager *unique, int i);
+extern unsigned int cuddReserveSubtable(DdManager *unique, int i, unsigned int amount);
 extern void cuddShrinkSubtable(DdManager *unique, int i);
 extern int cuddInsertSubtables(DdManager *unique, int n, int level);
 extern int cuddDestroySubtables(DdManager *unique, int n);
@@ -1215,6 +1463,7 @@ extern int cuddZddGetPosVarIndex(DdManager * dd, int index);
 extern int cuddZddGetNegVarIndex(DdManager * dd, int index);
 extern int cuddZddGetPosVarLevel(DdManager * dd, int index);
 extern int cuddZddGetNegVarLevel(DdManager * dd, int index);
+extern int cuddZddAnnealing(DdManager *table, int lower, int upper);
 extern int cuddZddTreeSifting(DdManager *table, Cudd_ReorderingType method);
 extern DdNode * cuddZddIsop(DdManager *dd, DdNode *L, DdNode *U, DdNode **zdd_I);
 extern DdNode * cuddBddIsop(DdManager *dd, DdNode *L, DdNode *U);
@@ -1239,6 +1488,7 @@ extern int cuddZddSymmCheck(DdManager *table, int x, int y);
 extern int cuddZddSymmSifting(DdManager *table, int lower, int upper);
 extern int cuddZddSymmSiftingConv(DdManager *table, int lower, int upper);
 extern int cuddZddP(DdManager *zdd, DdNode *f);
+extern int cuddZddWindowReorder(DdManager *table, int low, int high, Cudd_ReorderingType submethod);
 
 #ifdef __cplusplus
 } /* end of extern "C" */
@@ -16,9 +16,20 @@
   aggregation checks in symmetric and group sifting.<p>
   The computation of the interaction matrix is done with a series of
   depth-first searches. The searches start from those nodes that have
-  only external references. The matrix is stored as a packed array of
-  bits; since it is symmetric, only the upper triangle is kept in
-  memory.  As a final remark, we note that there may be variables that
+  only external references. The matrix is stored either as a packed
+  array of bits, of which only the upper triangle is kept in memory
+  since the matrix is symmetric, or, when few pairs of variables
+  interact, as a sorted list of interacting variables for each
+  variable.  The lists are used until they would take more memory than
+  the array of bits.<p>
+  The matrix is kept between reorderings.  The nodes created in the
+  meantime are logged, and only the searches that start from them are
+  repeated when reordering starts again.  Since reordering preserves
+  the functions of the nodes, the supports of the other nodes have not
+  changed.  Interactions that only involved nodes freed since are not
+  removed; to keep the matrix from drifting too far from the truth, it
+  is recomputed from scratch once many nodes have been created.<p>
+  As a final remark, we note that there may be variables that
   do interact, but that for a given variable order have no arc
   connecting their layers when they are adjacent.  For instance, in
   ite(a,b,c) with the order a<b<c, b and c interact, but are not
@@ -77,6 +88,16 @@
 #define LOGBPL 5
 #endif
 
+/** The log of new nodes may hold up to this fraction of the nodes. */
+#define DD_INTERACT_LOG_RATIO 2
+
+/** Minimum number of entries of the log of new nodes. */
+#define DD_INTERACT_MIN_LOG 1024
+
+/** The matrix is recomputed when this many times the live nodes
+ ** have been created since it was last computed. */
+#define DD_INTERACT_TURNOVER 4
+
 /*---------------------------------------------------------------------------*/
 /* Stucture declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -96,16 +117,31 @@
 /* Macro declarations                                                        */
 /*---------------------------------------------------------------------------*/
 
+/** Position of the bit of pair (x,y), with x < y, in a matrix for n
+ ** variables. */
+#define ddInteractPosn(n,x,y) \
+    (((((((ptruint) (n)) << 1) - (x) - 3) * (x)) >> 1) + (y) - 1)
+
 /** \cond */
 
 /*---------------------------------------------------------------------------*/
 /* Static function prototypes                                                */
 /*---------------------------------------------------------------------------*/
 
-static void ddSuppInteract (DdNode *f, char *support);
+static int ddListSearch (DdInteractList *list, DdHalfWord y);
+static int ddListInsert (DdManager *table, int x, int y);
+static int ddListMerge (DdManager *table, int x, int *support, int k);
+static int ddInteractToMatrix (DdManager *table);
+static int ddInteractResize (DdManager *table);
+static void ddInteractClear (DdManager *table);
+static int ddInteractBuild (DdManager *table);
+static int ddInteractUpdate (DdManager *table);
+static void ddSuppInteract (DdNode *f, char *support, int *list, int *k);
 static void ddClearLocal (DdNode *f);
-static void ddUpdateInteract (DdManager *table, char *support);
+static int ddUpdateInteract (DdManager *table, char *support, int *list, int k);
+static int ddIndexCompare (void const *a, void const *b);
 static void ddClearGlobal (DdManager *table);
+static void ddClearReached (DdNode *f);
 
 /** \endcond */
 
@@ -124,12 +160,14 @@ static void ddClearGlobal (DdManager *table);
   @brief Set interaction matrix entries.
 
   @details Given a pair of variables 0 <= x < y < table->size,
-  sets the corresponding bit of the interaction matrix to 1.
+  sets the corresponding entry of the interaction matrix to 1.
+
+  @return 1 if successful; 0 otherwise.
 
   @sideeffect None
 
 */
-void
+int
 cuddSetInteract(
   DdManager * table,
   int  x,
@@ -139,14 +177,21 @@ cuddSetInteract(
 
 #ifdef DD_DEBUG
     assert(x < y);
-    assert(y < table->size);
+    assert(y < table->interact.size);
     assert(x >= 0);
 #endif
 
-    posn = (((((ptruint)table->size << 1) - x - 3) * x) >> 1) + y - 1;
+    if (table->interact.matrix == NULL) {
+	if (ddListInsert(table,x,y) && ddListInsert(table,y,x))
+	    return(1);
+	table->interact.valid = 0;
+	return(0);
+    }
+    posn = ddInteractPosn(table->interact.size,x,y);
     word = posn >> LOGBPL;
     bit = posn & (BPL-1);
-    table->interact[word] |= ((ptruint) 1) << bit;
+    table->interact.matrix[word] |= ((ptruint) 1) << bit;
+    return(1);
 
 } /* end of cuddSetInteract */
 
@@ -155,8 +200,8 @@ cuddSetInteract(
   @brief Test interaction matrix entries.
 
   @details Given a pair of variables 0 <= x < y < table->size,
-  tests whether the corresponding bit of the interaction matrix is 1.
-  Returns the value of the bit.
+  tests whether the corresponding entry of the interaction matrix
+  is 1.  Returns the value of the entry.
 
   @sideeffect None
 
@@ -169,6 +214,7 @@ cuddTestInteract(
 {
   ptruint posn, word, bit;
   int result;
+  DdInteractList *lx, *ly;
 
     if (x > y) {
 	int tmp = x;
@@ -177,74 +223,711 @@ cuddTestInteract(
     }
 #ifdef DD_DEBUG
     assert(x < y);
-    assert(y < table->size);
+    assert(y < table->interact.size);
     assert(x >= 0);
 #endif
 
-    posn = (((((ptruint)table->size << 1) - x - 3) * x) >> 1) + y - 1;
+    if (table->interact.matrix == NULL) {
+	/* Look for each variable in the shorter list of the other. */
+	lx = &(table->interact.lists[x]);
+	ly = &(table->interact.lists[y]);
+	if (lx->n > ly->n) {
+	    posn = (ptruint) ddListSearch(ly, (DdHalfWord) x);
+	    return(posn < (ptruint) ly->n && ly->nbr[posn] == (DdHalfWord) x);
+	}
+	posn = (ptruint) ddListSearch(lx, (DdHalfWord) y);
+	return(posn < (ptruint) lx->n && lx->nbr[posn] == (DdHalfWord) y);
+    }
+    posn = ddInteractPosn(table->interact.size,x,y);
     word = posn >> LOGBPL;
     bit = posn & (BPL-1);
-    result = (table->interact[word] >> bit) & (ptruint) 1;
+    result = (table->interact.matrix[word] >> bit) & (ptruint) 1;
     return(result);
 
 } /* end of cuddTestInteract */
 
 
 /**
-  @brief Initializes the interaction matrix.
+  @brief Returns the variables that interact with a given one.
+
+  @details Only available when the interaction matrix is kept as
+  lists, which is the case for large numbers of variables.  Lets the
+  caller visit the variables interacting with x in time proportional
+  to their number instead of to the number of variables.
+
+  @return the number of variables interacting with x and sets nbr to
+  their indices in increasing order; -1 if the matrix is packed.
+
+  @sideeffect None
+
+  @see cuddTestInteract
+
+*/
+int
+cuddReadInteractList(
+  DdManager * table,
+  int  x,
+  DdHalfWord const ** nbr)
+{
+    if (table->interact.matrix != NULL || table->interact.lists == NULL)
+	return(-1);
+#ifdef DD_DEBUG
+    assert(x >= 0 && x < table->interact.size);
+#endif
+    *nbr = table->interact.lists[x].nbr;
+    return(table->interact.lists[x].n);
+
+} /* end of cuddReadInteractList */
+
+
+/**
+  @brief Makes a variable interact with those that interact with
+  another.
+
+  @details Sets to 1 the entries (x,i) of the interaction matrix for
+  all variables i other than x such that entry (y,i) is 1.  Used when a
+  linear transformation replaces x with the exclusive or of x and y.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+int
+cuddMergeInteract(
+  DdManager * table,
+  int  x,
+  int  y)
+{
+    int i, j;
+    DdInteractList *ly;
+
+    if (table->interact.matrix == NULL) {
+	/* The list of y is not changed by the insertions. */
+	ly = &(table->interact.lists[y]);
+	for (j = 0; j < ly->n; j++) {
+	    i = (int) ly->nbr[j];
+	    if (i == x) continue;
+	    if (!cuddSetInteract(table, i < x ? i : x, i < x ? x : i))
+		return(0);
+	}
+	return(1);
+    }
+    for (i = 0; i < y; i++) {
+	if (i != x && cuddTestInteract(table,i,y)) {
+	    if (i < x) {
+		(void) cuddSetInteract(table,i,x);
+	    } else {
+		(void) cuddSetInteract(table,x,i);
+	    }
+	}
+    }
+    for (i = y+1; i < table->interact.size; i++) {
+	if (i != x && cuddTestInteract(table,y,i)) {
+	    if (i < x) {
+		(void) cuddSetInteract(table,i,x);
+	    } else {
+		(void) cuddSetInteract(table,x,i);
+	    }
+	}
+    }
+    return(1);
+
+} /* end of cuddMergeInteract */
+
+
+/**
+  @brief Brings the interaction matrix up to date.
 
-  @details The interaction matrix is implemented as a bit vector
-  storing the upper triangle of the symmetric interaction matrix. The
-  bit vector is kept in an array of ptruints. The computation is based
-  on a series of depth-first searches, one for each root of the
-  DAG. Two flags are needed: The local visited flag uses the LSB of
-  the then pointer. The global visited flag uses the LSB of the next
-  pointer.
+  @details Called at the start of reordering, after garbage
+  collection.  If the matrix was kept from the last reordering, only
+  the nodes created since are searched; otherwise the matrix is
+  computed from scratch.  The computation is based on a series of
+  depth-first searches, one for each root of the DAG. Two flags are
+  needed: The local visited flag uses the LSB of the then pointer. The
+  global visited flag uses the LSB of the next pointer.  The logging
+  of new nodes is suspended until cuddResumeInteract is called.
 
   @return 1 if successful; 0 otherwise.
 
   @sideeffect None
 
+  @see cuddResumeInteract
+
 */
 int
 cuddInitInteract(
   DdManager * table)
 {
-    unsigned int i;
-    int j;
-    ptruint words;
-    ptruint *interact;
+    DdInteract *inter = &(table->interact);
+    int result = 0;
+
+    /* If the last reordering did not resume logging, nodes may have
+    ** been created that were not logged. */
+    if (inter->valid && inter->logging &&
+	inter->logged <= DD_INTERACT_TURNOVER * (size_t) table->keys) {
+	result = ddInteractResize(table) && ddInteractUpdate(table);
+    }
+    if (result == 0) {
+	result = ddInteractBuild(table);
+    }
+    inter->logSize = 0;
+    inter->logging = 0;
+    inter->valid = result;
+    return(result);
+
+} /* end of cuddInitInteract */
+
+
+/**
+  @brief Resumes the logging of new nodes at the end of reordering.
+
+  @sideeffect None
+
+  @see cuddInitInteract
+
+*/
+void
+cuddResumeInteract(
+  DdManager * table)
+{
+    if (table->interact.valid)
+	table->interact.logging = 1;
+
+} /* end of cuddResumeInteract */
+
+
+/**
+  @brief Copies the interaction matrix of a manager to another.
+
+  @details The destination must have the same variables and the same
+  functions as the source, as the copies made by cuddReorderCopy do,
+  so that it need not compute its matrix anew.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect The previous matrix of the destination is freed.
+
+*/
+int
+cuddCopyInteract(
+  DdManager * dest,
+  DdManager * source)
+{
+    DdInteract *from = &(source->interact);
+    DdInteract *to = &(dest->interact);
+    ptruint words, i;
+    int x;
+
+    ddInteractClear(dest);
+    if (!from->valid) return(1);
+    to->size = from->size;
+    if (from->matrix != NULL) {
+	words = (((ptruint) from->size * (from->size-1)) >> (1 + LOGBPL)) + 1;
+	to->matrix = ALLOC(ptruint,words);
+	if (to->matrix == NULL) {
+	    dest->errorCode = CUDD_MEMORY_OUT;
+	    return(0);
+	}
+	for (i = 0; i < words; i++) {
+	    to->matrix[i] = from->matrix[i];
+	}
+    } else {
+	to->lists = ALLOC(DdInteractList, from->size > 0 ? from->size : 1);
+	if (to->lists == NULL) {
+	    dest->errorCode = CUDD_MEMORY_OUT;
+	    return(0);
+	}
+	memset(to->lists, 0, sizeof(DdInteractList) * (size_t) from->size);
+	for (x = 0; x < from->size; x++) {
+	    DdInteractList *l = &(from->lists[x]);
+	    if (l->n == 0) continue;
+	    to->lists[x].nbr = ALLOC(DdHalfWord, l->n);
+	    if (to->lists[x].nbr == NULL) {
+		dest->errorCode = CUDD_MEMORY_OUT;
+		ddInteractClear(dest);
+		return(0);
+	    }
+	    memcpy(to->lists[x].nbr, l->nbr, sizeof(DdHalfWord) * (size_t) l->n);
+	    to->lists[x].n = to->lists[x].capacity = l->n;
+	}
+	to->entries = from->entries;
+    }
+    to->valid = 1;
+    to->logging = 1;
+    return(1);
+
+} /* end of cuddCopyInteract */
+
+
+/**
+  @brief Logs a node just created.
+
+  @details Called by cuddUniqueInter while logging is on.  If the log
+  cannot grow, it is dropped, and the interaction matrix will be
+  computed from scratch at the next reordering.
+
+  @sideeffect None
+
+  @see cuddPruneInteract
+
+*/
+void
+cuddLogInteract(
+  DdManager * table,
+  DdNode * f)
+{
+    DdInteract *inter = &(table->interact);
+    DdNodePtr *log;
+    size_t limit, capacity;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+
+    if (inter->logSize == inter->logCapacity) {
+	limit = (size_t) table->keys / DD_INTERACT_LOG_RATIO +
+	    DD_INTERACT_MIN_LOG;
+	capacity = inter->logCapacity == 0 ? DD_INTERACT_MIN_LOG :
+	    inter->logCapacity << 1;
+	if (capacity > limit) capacity = limit;
+	log = NULL;
+	if (capacity > inter->logCapacity) {
+	    saveHandler = MMoutOfMemory;
+	    MMoutOfMemory = table->outOfMemCallback;
+	    log = REALLOC(DdNodePtr, inter->log, capacity);
+	    MMoutOfMemory = saveHandler;
+	}
+	if (log == NULL) {
+	    if (inter->log != NULL) FREE(inter->log);
+	    inter->logSize = inter->logCapacity = 0;
+	    inter->valid = inter->logging = 0;
+	    return;
+	}
+	inter->log = log;
+	inter->logCapacity = capacity;
+    }
+    inter->log[inter->logSize++] = f;
+    inter->logged++;
+
+} /* end of cuddLogInteract */
+
+
+/**
+  @brief Removes the dead nodes from the log of new nodes.
+
+  @details Called by the garbage collector before the dead nodes are
+  freed.
+
+  @sideeffect None
+
+  @see cuddLogInteract
+
+*/
+void
+cuddPruneInteract(
+  DdManager * table)
+{
+    DdInteract *inter = &(table->interact);
+    size_t i, j;
+
+    for (i = j = 0; i < inter->logSize; i++) {
+	if (inter->log[i]->ref != 0)
+	    inter->log[j++] = inter->log[i];
+    }
+    inter->logSize = j;
+
+} /* end of cuddPruneInteract */
+
+
+/**
+  @brief Frees the interaction matrix and the log of new nodes.
+
+  @sideeffect None
+
+*/
+void
+cuddFreeInteract(
+  DdManager * table)
+{
+    ddInteractClear(table);
+    if (table->interact.log != NULL) FREE(table->interact.log);
+    table->interact.logSize = table->interact.logCapacity = 0;
+
+} /* end of cuddFreeInteract */
+
+
+/**
+  @brief Computes the memory taken by the interaction matrix.
+
+  @return the number of bytes allocated for the matrix or the lists
+  of interacting variables, and for the log of new nodes.
+
+  @sideeffect None
+
+  @see Cudd_ReadMemoryBreakdown
+
+*/
+size_t
+cuddInteractMemory(
+  DdManager * table)
+{
+    DdInteract *inter = &(table->interact);
+    ptruint n = (ptruint) inter->size;
+    size_t bytes = inter->logCapacity * sizeof(DdNodePtr);
+    int x;
+
+    if (inter->matrix != NULL) {
+	bytes += (((n * (n-1)) >> (1 + LOGBPL)) + 1) * sizeof(ptruint);
+    } else if (inter->lists != NULL) {
+	bytes += (n > 0 ? n : 1) * sizeof(DdInteractList);
+	for (x = 0; x < inter->size; x++) {
+	    bytes += (size_t) inter->lists[x].capacity * sizeof(DdHalfWord);
+	}
+    }
+    return(bytes);
+
+} /* end of cuddInteractMemory */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+
+/**
+  @brief Finds the position of a variable in a sorted list.
+
+  @return the position of the first entry not less than y.
+
+  @sideeffect None
+
+*/
+static int
+ddListSearch(
+  DdInteractList * list,
+  DdHalfWord  y)
+{
+    int low = 0;
+    int high = list->n;
+    int mid;
+
+    while (low < high) {
+	mid = (low + high) >> 1;
+	if (list->nbr[mid] < y) {
+	    low = mid + 1;
+	} else {
+	    high = mid;
+	}
+    }
+    return(low);
+
+} /* end of ddListSearch */
+
+
+/**
+  @brief Inserts y in the list of x unless it is already there.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddListInsert(
+  DdManager * table,
+  int  x,
+  int  y)
+{
+    DdInteractList *list = &(table->interact.lists[x]);
+    DdHalfWord *nbr;
+    int posn, capacity;
+
+    posn = ddListSearch(list, (DdHalfWord) y);
+    if (posn < list->n && list->nbr[posn] == (DdHalfWord) y)
+	return(1);
+    if (list->n == list->capacity) {
+	capacity = list->capacity < 4 ? 4 : list->capacity << 1;
+	nbr = REALLOC(DdHalfWord, list->nbr, capacity);
+	if (nbr == NULL) {
+	    table->errorCode = CUDD_MEMORY_OUT;
+	    return(0);
+	}
+	list->nbr = nbr;
+	list->capacity = capacity;
+    }
+    memmove(list->nbr + posn + 1, list->nbr + posn,
+	    sizeof(DdHalfWord) * (size_t) (list->n - posn));
+    list->nbr[posn] = (DdHalfWord) y;
+    list->n++;
+    table->interact.entries++;
+    return(1);
+
+} /* end of ddListInsert */
+
+
+/**
+  @brief Adds the variables of a sorted support to the list of x.
+
+  @details x itself, if in the support, is not added.  The missing
+  variables are counted first, so that the common case in which they
+  are all present already costs no allocation.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddListMerge(
+  DdManager * table,
+  int  x,
+  int * support,
+  int  k)
+{
+    DdInteractList *list = &(table->interact.lists[x]);
+    DdHalfWord *nbr;
+    int i, j, w, missing, capacity;
+
+    /* Count the variables of the support missing from the list. */
+    missing = 0;
+    for (i = j = 0; j < k; j++) {
+	if (support[j] == x) continue;
+	while (i < list->n && list->nbr[i] < (DdHalfWord) support[j]) i++;
+	if (i == list->n || list->nbr[i] != (DdHalfWord) support[j])
+	    missing++;
+    }
+    if (missing == 0) return(1);
+
+    if (list->n + missing > list->capacity) {
+	capacity = list->capacity << 1;
+	if (capacity < list->n + missing) capacity = list->n + missing;
+	nbr = REALLOC(DdHalfWord, list->nbr, capacity);
+	if (nbr == NULL) {
+	    table->errorCode = CUDD_MEMORY_OUT;
+	    return(0);
+	}
+	list->nbr = nbr;
+	list->capacity = capacity;
+    }
+
+    /* Merge from the back so that no entry is overwritten before it
+    ** is moved. */
+    i = list->n - 1;
+    j = k - 1;
+    w = list->n + missing - 1;
+    while (j >= 0) {
+	DdHalfWord v = (DdHalfWord) support[j];
+	if (support[j] == x) {
+	    j--;
+	} else if (i >= 0 && list->nbr[i] > v) {
+	    list->nbr[w--] = list->nbr[i--];
+	} else if (i >= 0 && list->nbr[i] == v) {
+	    list->nbr[w--] = list->nbr[i--];
+	    j--;
+	} else {
+	    list->nbr[w--] = v;
+	    j--;
+	}
+    }
+    list->n += missing;
+    table->interact.entries += (size_t) missing;
+    return(1);
+
+} /* end of ddListMerge */
+
+
+/**
+  @brief Replaces the lists of interacting variables with the matrix
+  of bits.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddInteractToMatrix(
+  DdManager * table)
+{
+    DdInteract *inter = &(table->interact);
+    ptruint n = (ptruint) inter->size;
+    ptruint words, i, posn;
+    ptruint *matrix;
+    int x, j;
+
+    words = ((n * (n-1)) >> (1 + LOGBPL)) + 1;
+    matrix = ALLOC(ptruint,words);
+    if (matrix == NULL) {
+	table->errorCode = CUDD_MEMORY_OUT;
+	return(0);
+    }
+    for (i = 0; i < words; i++) {
+	matrix[i] = 0;
+    }
+    for (x = 0; x < inter->size; x++) {
+	DdInteractList *list = &(inter->lists[x]);
+	for (j = 0; j < list->n; j++) {
+	    if ((int) list->nbr[j] <= x) continue;
+	    posn = ddInteractPosn(n,x,list->nbr[j]);
+	    matrix[posn >> LOGBPL] |= ((ptruint) 1) << (posn & (BPL-1));
+	}
+	if (list->nbr != NULL) FREE(list->nbr);
+    }
+    FREE(inter->lists);
+    inter->lists = NULL;
+    inter->entries = 0;
+    inter->matrix = matrix;
+    return(1);
+
+} /* end of ddInteractToMatrix */
+
+
+/**
+  @brief Extends the interaction matrix to the variables created since
+  it was computed.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddInteractResize(
+  DdManager * table)
+{
+    DdInteract *inter = &(table->interact);
+    ptruint oldn = (ptruint) inter->size;
+    ptruint n = (ptruint) table->size;
+    ptruint words, i, x, y, posn;
+    ptruint *matrix;
+    DdInteractList *lists;
+
+    if (n == oldn) return(1);
+    if (inter->matrix == NULL) {
+	lists = REALLOC(DdInteractList, inter->lists, n);
+	if (lists == NULL) {
+	    table->errorCode = CUDD_MEMORY_OUT;
+	    return(0);
+	}
+	memset(lists + oldn, 0, sizeof(DdInteractList) * (size_t) (n - oldn));
+	inter->lists = lists;
+	inter->size = (int) n;
+	return(1);
+    }
+
+    /* The position of a pair depends on the number of variables:
+    ** copy the pairs to a matrix for the new number. */
+    words = ((n * (n-1)) >> (1 + LOGBPL)) + 1;
+    matrix = ALLOC(ptruint,words);
+    if (matrix == NULL) {
+	table->errorCode = CUDD_MEMORY_OUT;
+	return(0);
+    }
+    for (i = 0; i < words; i++) {
+	matrix[i] = 0;
+    }
+    for (x = 0; x + 1 < oldn; x++) {
+	for (y = x + 1; y < oldn; y++) {
+	    posn = ddInteractPosn(oldn,x,y);
+	    if ((inter->matrix[posn >> LOGBPL] >> (posn & (BPL-1))) & 1) {
+		posn = ddInteractPosn(n,x,y);
+		matrix[posn >> LOGBPL] |= ((ptruint) 1) << (posn & (BPL-1));
+	    }
+	}
+    }
+    FREE(inter->matrix);
+    inter->matrix = matrix;
+    inter->size = (int) n;
+    return(1);
+
+} /* end of ddInteractResize */
+
+
+/**
+  @brief Frees the interaction matrix, leaving the log of new nodes
+  alone.
+
+  @sideeffect None
+
+*/
+static void
+ddInteractClear(
+  DdManager * table)
+{
+    DdInteract *inter = &(table->interact);
+    int x;
+
+    if (inter->matrix != NULL) {
+	FREE(inter->matrix);
+	inter->matrix = NULL;
+    }
+    if (inter->lists != NULL) {
+	for (x = 0; x < inter->size; x++) {
+	    if (inter->lists[x].nbr != NULL) FREE(inter->lists[x].nbr);
+	}
+	FREE(inter->lists);
+	inter->lists = NULL;
+    }
+    inter->size = 0;
+    inter->entries = 0;
+    inter->valid = 0;
+    inter->logging = 0;
+
+} /* end of ddInteractClear */
+
+
+/**
+  @brief Computes the interaction matrix from scratch.
+
+  @details The lists of interacting variables are used at first; they
+  are replaced by the matrix of bits if they grow larger than it.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddInteractBuild(
+  DdManager * table)
+{
+    DdInteract *inter = &(table->interact);
+    int i, j, k;
+    int *list;
     char *support;
     DdNode *f;
     DdNode *sentinel = &(table->sentinel);
     DdNodePtr *nodelist;
     int slots;
-    ptruint n = (ptruint) table->size;
+    int result = 1;
+    int n = table->size;
 
-    words = ((n * (n-1)) >> (1 + LOGBPL)) + 1;
-    table->interact = interact = ALLOC(ptruint,words);
-    if (interact == NULL) {
+    ddInteractClear(table);
+    inter->lists = ALLOC(DdInteractList, n > 0 ? n : 1);
+    if (inter->lists == NULL) {
 	table->errorCode = CUDD_MEMORY_OUT;
 	return(0);
     }
-    for (i = 0; i < words; i++) {
-	interact[i] = 0;
-    }
+    memset(inter->lists, 0, sizeof(DdInteractList) * (size_t) n);
+    inter->size = n;
+    inter->logged = 0;
 
-    support = ALLOC(char,n);
-    if (support == NULL) {
+    support = ALLOC(char, n > 0 ? n : 1);
+    list = ALLOC(int, n > 0 ? n : 1);
+    if (support == NULL || list == NULL) {
 	table->errorCode = CUDD_MEMORY_OUT;
-	FREE(interact);
+	if (support != NULL) FREE(support);
+	if (list != NULL) FREE(list);
+	ddInteractClear(table);
 	return(0);
     }
     for (i = 0; i < n; i++) {
         support[i] = 0;
     }
 
-    for (i = 0; i < n; i++) {
+    for (i = 0; i < n && result; i++) {
 	nodelist = table->subtables[i].nodelist;
 	slots = table->subtables[i].slots;
-	for (j = 0; j < slots; j++) {
+	for (j = 0; j < slots && result; j++) {
 	    f = nodelist[j];
 	    while (f != sentinel) {
 		/* A node is a root of the DAG if it cannot be
@@ -254,9 +937,13 @@ cuddInitInteract(
 		** search from it.
 		*/
 		if (!Cudd_IsComplement(f->next)) {
-		    ddSuppInteract(f,support);
+		    k = 0;
+		    ddSuppInteract(f,support,list,&k);
 		    ddClearLocal(f);
-		    ddUpdateInteract(table,support);
+		    if (!ddUpdateInteract(table,support,list,k)) {
+			result = 0;
+			break;
+		    }
 		}
 		f = Cudd_Regular(f->next);
 	    }
@@ -265,14 +952,91 @@ cuddInitInteract(
     ddClearGlobal(table);
 
     FREE(support);
-    return(1);
+    FREE(list);
+    if (result == 0) ddInteractClear(table);
+    return(result);
 
-} /* end of cuddInitInteract */
+} /* end of ddInteractBuild */
 
 
-/*---------------------------------------------------------------------------*/
-/* Definition of static functions                                            */
-/*---------------------------------------------------------------------------*/
+/**
+  @brief Adds to the interaction matrix the supports of the nodes
+  created since it was last brought up to date.
+
+  @details The new nodes are visited from the top level down, so that
+  a new node reached from another need not be searched again.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddInteractUpdate(
+  DdManager * table)
+{
+    DdInteract *inter = &(table->interact);
+    size_t m = inter->logSize;
+    size_t i;
+    int j, k;
+    int n = table->size;
+    int *count, *list;
+    char *support;
+    DdNodePtr *order;
+    int result = 1;
+
+    if (m == 0) return(1);
+    count = ALLOC(int, n + 1);
+    order = ALLOC(DdNodePtr, m);
+    support = ALLOC(char, n);
+    list = ALLOC(int, n);
+    if (count == NULL || order == NULL || support == NULL || list == NULL) {
+	table->errorCode = CUDD_MEMORY_OUT;
+	if (count != NULL) FREE(count);
+	if (order != NULL) FREE(order);
+	if (support != NULL) FREE(support);
+	if (list != NULL) FREE(list);
+	return(0);
+    }
+
+    /* Sort the new nodes by level. */
+    for (j = 0; j <= n; j++) {
+	count[j] = 0;
+    }
+    for (i = 0; i < m; i++) {
+	count[table->perm[inter->log[i]->index] + 1]++;
+    }
+    for (j = 0; j < n; j++) {
+	count[j+1] += count[j];
+    }
+    for (i = 0; i < m; i++) {
+	order[count[table->perm[inter->log[i]->index]]++] = inter->log[i];
+    }
+
+    for (j = 0; j < n; j++) {
+        support[j] = 0;
+    }
+    for (i = 0; i < m; i++) {
+	if (Cudd_IsComplement(order[i]->next)) continue;
+	k = 0;
+	ddSuppInteract(order[i],support,list,&k);
+	ddClearLocal(order[i]);
+	if (!ddUpdateInteract(table,support,list,k)) {
+	    result = 0;
+	    break;
+	}
+    }
+    for (i = 0; i < m; i++) {
+	ddClearReached(order[i]);
+    }
+
+    FREE(count);
+    FREE(order);
+    FREE(support);
+    FREE(list);
+    return(result);
+
+} /* end of ddInteractUpdate */
 
 
 /**
@@ -281,21 +1045,27 @@ cuddInitInteract(
   @details Performs a DFS from f. Uses the LSB of the then pointer
   as visited flag.
 
-  @sideeffect Accumulates in support the variables on which f depends.
+  @sideeffect Accumulates in support the variables on which f
+  depends, and appends them to list.
 
 */
 static void
 ddSuppInteract(
   DdNode * f,
-  char * support)
+  char * support,
+  int * list,
+  int * k)
 {
     if (cuddIsConstant(f) || Cudd_IsComplement(cuddT(f))) {
 	return;
     }
 
-    support[f->index] = 1;
-    ddSuppInteract(cuddT(f),support);
-    ddSuppInteract(Cudd_Regular(cuddE(f)),support);
+    if (support[f->index] == 0) {
+	support[f->index] = 1;
+	list[(*k)++] = (int) f->index;
+    }
+    ddSuppInteract(cuddT(f),support,list,k);
+    ddSuppInteract(Cudd_Regular(cuddE(f)),support,list,k);
     /* mark as visited */
     cuddT(f) = Cudd_Complement(cuddT(f));
     f->next = Cudd_Complement(f->next);
@@ -330,35 +1100,74 @@ ddClearLocal(
   @brief Marks as interacting all pairs of variables that appear in
   support.
 
-  @details If support[i == support[j] == 1, sets the (i,j) entry
-  of the interaction matrix to 1.]
+  @details The k variables of the support are in list.  Sets the
+  (i,j) entry of the interaction matrix to 1 for each pair of them.
+  Switches from the lists of interacting variables to the matrix of
+  bits when the latter becomes smaller.
+
+  @return 1 if successful; 0 otherwise.
 
   @sideeffect Clears support.
 
 */
-static void
+static int
 ddUpdateInteract(
   DdManager * table,
-  char * support)
+  char * support,
+  int * list,
+  int  k)
 {
-    int i,j;
-    int n = table->size;
+    DdInteract *inter = &(table->interact);
+    int i, j;
+    ptruint n = (ptruint) inter->size;
+    ptruint words;
 
-    for (i = 0; i < n-1; i++) {
-	if (support[i] == 1) {
-            support[i] = 0;
-	    for (j = i+1; j < n; j++) {
-		if (support[j] == 1) {
-		    cuddSetInteract(table,i,j);
-		}
+    for (i = 0; i < k; i++) {
+	support[list[i]] = 0;
+    }
+    if (k < 2) return(1);
+    qsort(list, (size_t) k, sizeof(int), ddIndexCompare);
+
+    if (inter->matrix != NULL) {
+	for (i = 0; i < k-1; i++) {
+	    for (j = i+1; j < k; j++) {
+		(void) cuddSetInteract(table,list[i],list[j]);
 	    }
 	}
+	return(1);
     }
-    support[n-1] = 0;
+    for (i = 0; i < k; i++) {
+	if (!ddListMerge(table,list[i],list,k)) return(0);
+    }
+    words = ((n * (n-1)) >> (1 + LOGBPL)) + 1;
+    if (inter->entries * sizeof(DdHalfWord) + n * sizeof(DdInteractList) >
+	words * sizeof(ptruint)) {
+	return(ddInteractToMatrix(table));
+    }
+    return(1);
 
 } /* end of ddUpdateInteract */
 
 
+/**
+  @brief Comparison function for sorting variable indices.
+
+  @sideeffect None
+
+*/
+static int
+ddIndexCompare(
+  void const * a,
+  void const * b)
+{
+    int x = *(int const *) a;
+    int y = *(int const *) b;
+
+    return((x > y) - (x < y));
+
+} /* end of ddIndexCompare */
+
+
 /**
   @brief Scans the %DD and clears the LSB of the next pointers.
 
@@ -393,3 +1202,26 @@ ddClearGlobal(
 
 } /* end of ddClearGlobal */
 
+
+/**
+  @brief Clears the LSB of the next pointers of the nodes reached from
+  f.
+
+  @details Used instead of ddClearGlobal when only the nodes created
+  since the last reordering were searched.
+
+  @sideeffect None
+
+*/
+static void
+ddClearReached(
+  DdNode * f)
+{
+    if (cuddIsConstant(f) || !Cudd_IsComplement(f->next)) {
+	return;
+    }
+    f->next = Cudd_Regular(f->next);
+    ddClearReached(cuddT(f));
+    ddClearReached(Cudd_Regular(cuddE(f)));
+
+} /* end of ddClearReached */
@@ -519,6 +519,8 @@ cuddHashTableInit(
     memset(hash->bucket, 0, hash->numBuckets * sizeof(DdHashItem *));
     hash->size = 0;
     hash->maxsize = hash->numBuckets * DD_MAX_HASHTABLE_DENSITY;
+    manager->hashMemused += sizeof(DdHashTable) +
+	hash->numBuckets * sizeof(DdHashItem *);
     return(hash);
 
 } /* end of cuddHashTableInit */
@@ -556,9 +558,12 @@ cuddHashTableQuit(
     while (memlist != NULL) {
 	nextmem = (DdHashItem **) memlist[0];
 	FREE(memlist);
+	hash->manager->hashMemused -= (DD_MEM_CHUNK + 1) * hash->itemsize;
 	memlist = nextmem;
     }
 
+    hash->manager->hashMemused -= sizeof(DdHashTable) +
+	hash->numBuckets * sizeof(DdHashItem *);
     FREE(hash->bucket);
     FREE(hash);
 
@@ -588,9 +593,12 @@ cuddHashTableGenericQuit(
     while (memlist != NULL) {
 	nextmem = (DdHashItem **) memlist[0];
 	FREE(memlist);
+	hash->manager->hashMemused -= (DD_MEM_CHUNK + 1) * hash->itemsize;
 	memlist = nextmem;
     }
 
+    hash->manager->hashMemused -= sizeof(DdHashTable) +
+	hash->numBuckets * sizeof(DdHashItem *);
     FREE(hash->bucket);
     FREE(hash);
 
@@ -1386,6 +1394,8 @@ cuddHashTableResize(
 	}
     }
     FREE(oldBuckets);
+    hash->manager->hashMemused += (numBuckets - oldNumBuckets) *
+	sizeof(DdHashItem *);
     return(1);
 
 } /* end of cuddHashTableResize */
@@ -1443,6 +1453,7 @@ cuddHashTableAlloc(
 
 	mem[0] = (DdHashItem *) hash->memoryList;
 	hash->memoryList = mem;
+	hash->manager->hashMemused += (DD_MEM_CHUNK + 1) * itemsize;
 
 	thisOne = (DdHashItem *) ((char *) mem + itemsize);
 	hash->nextFree = thisOne;
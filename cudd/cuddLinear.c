@@ -200,6 +200,7 @@ cuddLinearAndSifting(
     int		size;
     int		x;
     int		result;
+    DdReorderEvent event;
 #ifdef DD_STATS
     int		previousSize;
 #endif
@@ -251,8 +252,10 @@ cuddLinearAndSifting(
 #ifdef DD_STATS
 	previousSize = (int) (table->keys - table->isolated);
 #endif
+	cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_SIFT,x);
 	result = ddLinearAndSiftingAux(table,x,lower,upper);
 	if (!result) goto cuddLinearAndSiftingOutOfMem;
+	cuddReorderEventEnd(table,&event);
 #ifdef DD_STATS
 	if (table->keys < (unsigned) previousSize + table->isolated) {
 	    (void) fprintf(table->out,"-");
@@ -655,34 +658,18 @@ cuddLinearOutOfMem:
 /**
   @brief Updates the interaction matrix.
 
+  @return 1 if successful; 0 otherwise.
+
   @sideeffect none
 
 */
-void
+int
 cuddUpdateInteractionMatrix(
   DdManager * table,
   int  xindex,
   int  yindex)
 {
-    int i;
-    for (i = 0; i < yindex; i++) {
-	if (i != xindex && cuddTestInteract(table,i,yindex)) {
-	    if (i < xindex) {
-		cuddSetInteract(table,i,xindex);
-	    } else {
-		cuddSetInteract(table,xindex,i);
-	    }
-	}
-    }
-    for (i = yindex+1; i < table->size; i++) {
-	if (i != xindex && cuddTestInteract(table,yindex,i)) {
-	    if (i < xindex) {
-		cuddSetInteract(table,i,xindex);
-	    } else {
-		cuddSetInteract(table,xindex,i);
-	    }
-	}
-    }
+    return(cuddMergeInteract(table,xindex,yindex));
 
 } /* end of cuddUpdateInteractionMatrix */
 
@@ -1024,7 +1011,8 @@ ddLinearAndSiftingUp(
 	} else if (cuddTestInteract(table,xindex,yindex)) {
 	    size = newsize;
 	    move->flags = CUDD_LINEAR_TRANSFORM_MOVE;
-	    cuddUpdateInteractionMatrix(table,xindex,yindex);
+	    if (!cuddUpdateInteractionMatrix(table,xindex,yindex))
+		goto ddLinearAndSiftingUpOutOfMem;
 	}
 	move->size = size;
 	/* Update the lower bound. */
@@ -1032,7 +1020,10 @@ ddLinearAndSiftingUp(
 	    isolated = table->vars[xindex]->ref == 1;
 	    L += (int) table->subtables[y].keys - isolated;
 	}
-	if ((double) size > (double) limitSize * table->maxGrowth) break;
+	if ((double) size > (double) limitSize * table->maxGrowth) {
+	    table->telemetry.cutGrowth++;
+	    break;
+	}
 	if (size < limitSize) limitSize = size;
 	y = x;
 	x = cuddNextLow(table,y);
@@ -1140,10 +1131,14 @@ ddLinearAndSiftingDown(
 	} else if (cuddTestInteract(table,xindex,yindex)) {
 	    size = newsize;
 	    move->flags = CUDD_LINEAR_TRANSFORM_MOVE;
-	    cuddUpdateInteractionMatrix(table,xindex,yindex);
+	    if (!cuddUpdateInteractionMatrix(table,xindex,yindex))
+		goto ddLinearAndSiftingDownOutOfMem;
 	}
 	move->size = size;
-	if ((double) size > (double) limitSize * table->maxGrowth) break;
+	if ((double) size > (double) limitSize * table->maxGrowth) {
+	    table->telemetry.cutGrowth++;
+	    break;
+	}
 	if (size < limitSize) limitSize = size;
 	x = y;
 	y = cuddNextHigh(table,x);
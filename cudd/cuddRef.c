@@ -649,6 +649,8 @@ cuddShrinkDeathRow(
 	    Cudd_IterDerefBdd(table,table->deathRow[i]);
 	    table->deathRow[i] = NULL;
 	}
+	table->memused -= (table->deathRowDepth - table->deathRowDepth / 4) *
+	    sizeof(DdNodePtr);
 	table->deathRowDepth /= 4;
 	table->deadMask = table->deathRowDepth - 1;
 	if ((unsigned) table->nextDead > table->deadMask) {
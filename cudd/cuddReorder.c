@@ -51,6 +51,42 @@
 /* Constant declarations                                                     */
 /*---------------------------------------------------------------------------*/
 
+/**
+ ** Cudd_ShuffleHeap rebuilds the diagrams instead of swapping adjacent
+ ** variables when the number of swaps exceeds this many per variable.
+ */
+#define DD_SHUFFLE_REBUILD_RATIO 2
+
+/**
+ ** Weight of the most recent reordering in the running averages of
+ ** payoff and cost.
+ */
+#define DD_TRIGGER_WEIGHT 0.5
+
+/**
+ ** Cudd_AdaptiveReorderingTrigger reorders if the cache hit rate drops
+ ** below this fraction of that of the previous window...
+ */
+#define DD_TRIGGER_HIT_DROP 0.8
+
+/**
+ ** ... or if the throughput drops below this fraction of that of the
+ ** previous window...
+ */
+#define DD_TRIGGER_SLOWDOWN 0.5
+
+/**
+ ** ... or if the nodes grow this many times faster than in the
+ ** previous window.
+ */
+#define DD_TRIGGER_SPEEDUP 2.0
+
+/**
+ ** Incremental sifting sifts the variables that grew most since the
+ ** last reordering until they account for this fraction of the growth.
+ */
+#define DD_INCR_SIFT_FRACTION 0.75
+
 /*---------------------------------------------------------------------------*/
 /* Stucture declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -79,9 +115,23 @@ static int ddSiftingAux (DdManager *table, int x, int xLow, int xHigh);
 static Move * ddSiftingUp (DdManager *table, int y, int xLow);
 static Move * ddSiftingDown (DdManager *table, int x, int xHigh);
 static int ddSiftingBackward (DdManager *table, int size, Move *moves);
-static int ddReorderPreprocess (DdManager *table);
+static int ddSiftingRollback (DdManager *table, int size, Move *first, Move *second);
+static int ddSiftingPendingFirst (DdManager *table, IndexKey *var, int size);
+static int ddSiftingRecordSkipped (DdManager *table, IndexKey *var, int from, int to, int lower, int upper);
+static int ddSiftingVanish (DdManager *table, int level);
+static int ddSiftingInteractSum (DdManager *table, int x, int low, int high, int *count);
+static int ddSiftingPotential (DdManager *table, int x, int lower, int upper);
+static int ddReorderPreprocess (DdManager *table, int keepCache);
 static int ddReorderPostprocess (DdManager *table);
+static void ddReorderRecordKeys (DdManager *table);
 static int ddShuffle (DdManager *table, int *permutation);
+static double ddShuffleInversions (DdManager *table, int *permutation);
+static int ddShuffleRebuild (DdManager *table, int *permutation);
+static DdNode * ddShuffleImage (DdManager *scratch, DdNode *f);
+static DdNode * ddShuffleSource (DdManager *table, DdManager *scratch, DdNode *g);
+static void ddShuffleHoldConstants (DdManager *table, int hold);
+static void ddShuffleLink (DdNodePtr *nodelist, int shift, DdNode *f);
+static DdNode * ddShuffleIteRecur (DdManager *dd, DdNode *v, DdNode *t, DdNode *e);
 static int ddSiftUp (DdManager *table, int x, int xLow);
 static void bddFixTree (DdManager *table, MtrNode *treenode);
 static int ddUpdateMtrTree (DdManager *table, MtrNode *treenode, int *perm, int *invperm);
@@ -108,19 +158,25 @@ static int ddCheckPermuation (DdManager *table, MtrNode *treenode, int *perm, in
   <li>Simulated Annealing
   <li>Genetic Algorithm
   <li>Dynamic Programming (exact)
+  <li>Incremental Sifting
   </ul>
   For sifting, symmetric sifting, group sifting, and window
   permutation it is possible to request reordering to convergence.<p>
   The core of all methods is the reordering procedure
   cuddSwapInPlace() which swaps two adjacent variables and is based
-  on Rudell's paper.
+  on Rudell's paper.<p>
+  If a budget is set with Cudd_SetReorderingDeadline or
+  Cudd_SetReorderingMaxSwaps, reordering stops when it is exhausted,
+  leaving each variable being sifted at the best position seen so far.
+  The variables that sifting did not reach are sifted first by the
+  next reordering.
 
   @return 1 in case of success; 0 otherwise. In the case of symmetric
   sifting (with and without convergence) returns 1 plus the number of
   symmetric variables, in case of success.
 
   @sideeffect Changes the variable order for all diagrams and clears
-  the cache.
+  the cache, unless it is preserved.
 
 */
 int
@@ -132,6 +188,8 @@ Cudd_ReduceHeap(
     DdHook *hook;
     int	result;
     unsigned int nextDyn;
+    unsigned int beforeSize, afterSize;
+    double payoff;
 #ifdef DD_STATS
     unsigned int initialSize;
     unsigned int finalSize;
@@ -164,12 +222,22 @@ Cudd_ReduceHeap(
 	hook = hook->next;
     }
 
-    if (!ddReorderPreprocess(table)) return(0);
+    /* The deadline also covers the preprocessing. */
+    table->reordStart = util_wall_time();
+
+    /* Linear transformations change the functions of the nodes. */
+    if (!ddReorderPreprocess(table, heuristic != CUDD_REORDER_LINEAR &&
+			     heuristic != CUDD_REORDER_LINEAR_CONVERGE))
+	return(0);
     table->ddTotalNumberSwapping = 0;
+    table->reordInterrupted = 0;
+    table->siftedVars = 0;
+    table->siftRan = 0;
 
     if (table->keys > table->peakLiveNodes) {
 	table->peakLiveNodes = table->keys;
     }
+    beforeSize = table->keys - table->isolated;
 #ifdef DD_STATS
     initialSize = (int) (table->keys - table->isolated);
     table->totalNISwaps = 0;
@@ -185,6 +253,7 @@ Cudd_ReduceHeap(
     case CUDD_REORDER_SYMM_SIFT_CONV:
     case CUDD_REORDER_GROUP_SIFT:
     case CUDD_REORDER_GROUP_SIFT_CONV:
+    case CUDD_REORDER_SIFT_INCREMENTAL:
 	(void) fprintf(table->out,"#:I_SIFTING ");
 	break;
     case CUDD_REORDER_WINDOW2:
@@ -209,6 +278,7 @@ Cudd_ReduceHeap(
 	(void) fprintf(table->out,"#:I_EXACT   ");
 	break;
     default:
+	cuddCacheKeepEnd(table);
 	return(0);
     }
     (void) fprintf(table->out,"%8d: initial size",initialSize);
@@ -224,6 +294,16 @@ Cudd_ReduceHeap(
 	result = cuddTreeSifting(table,heuristic);
     }
 
+    /* The variables left out by this reordering go first next time.
+    ** If no sifting pass ran, the pending ones are still pending. */
+    if (table->siftRan) {
+	if (table->siftPending != NULL) FREE(table->siftPending);
+	table->siftPending = table->siftSkipped;
+	table->siftNPending = table->siftNSkipped;
+	table->siftSkipped = NULL;
+	table->siftNSkipped = 0;
+    }
+
 #ifdef DD_STATS
     (void) fprintf(table->out,"\n");
     finalSize = (int) (table->keys - table->isolated);
@@ -236,8 +316,10 @@ Cudd_ReduceHeap(
                    table->totalNISwaps);
 #endif
 
-    if (result == 0)
+    if (result == 0) {
+	cuddCacheKeepEnd(table);
 	return(0);
+    }
 
     if (!ddReorderPostprocess(table))
 	return(0);
@@ -247,6 +329,9 @@ Cudd_ReduceHeap(
 	    return(0);
     }
 
+    if (table->autoCompact)
+	(void) Cudd_Compact(table);
+
     nextDyn = (table->keys - table->constants.keys + 1) *
 	      DD_DYN_RATIO + table->constants.keys;
     if (table->reorderings < 20 || nextDyn > table->nextDyn)
@@ -268,6 +353,19 @@ Cudd_ReduceHeap(
     /* Update cumulative reordering time. */
     table->reordTime += util_cpu_time() - localTime;
 
+    /* Record how much this reordering paid off and what it cost. */
+    afterSize = table->keys - table->isolated;
+    payoff = afterSize < beforeSize ?
+	(double) (beforeSize - afterSize) / (double) beforeSize : 0.0;
+    table->reordPayoff = DD_TRIGGER_WEIGHT * payoff +
+	(1.0 - DD_TRIGGER_WEIGHT) * table->reordPayoff;
+    table->reordEnd = util_cpu_time();
+    table->reordCost =
+	DD_TRIGGER_WEIGHT * (double) (table->reordEnd - localTime) +
+	(1.0 - DD_TRIGGER_WEIGHT) * table->reordCost;
+    cuddReorderTriggerReset(table);
+    table->trigHitRate = -1.0;
+
     return(result);
 
 } /* end of Cudd_ReduceHeap */
@@ -279,12 +377,16 @@ Cudd_ReduceHeap(
   @details The i-th entry of the permutation array contains the index
   of the variable that should be brought to the i-th level.  The size
   of the array should be equal or greater to the number of variables
-  currently in use.
+  currently in use.  Orders that are close to the current one are
+  reached by swapping adjacent variables; for the others, the diagrams
+  are rebuilt level by level in the new order, at a cost proportional
+  to their size before and after, independently of how far the new
+  order is.
 
   @return 1 in case of success; 0 otherwise.
 
   @sideeffect Changes the variable order for all diagrams and clears
-  the cache.
+  the cache, unless it is preserved.
 
   @see Cudd_ReduceHeap
 
@@ -310,7 +412,7 @@ Cudd_ShuffleHeap(
     if (identity == 1) {
 	return(1);
     }
-    if (!ddReorderPreprocess(table)) return(0);
+    if (!ddReorderPreprocess(table,1)) return(0);
     if (table->keys > table->peakLiveNodes) {
 	table->peakLiveNodes = table->keys;
     }
@@ -320,15 +422,27 @@ Cudd_ShuffleHeap(
 	perm[permutation[i]] = i;
     if (!ddCheckPermuation(table,table->tree,perm,permutation)) {
 	FREE(perm);
+	cuddCacheKeepEnd(table);
 	return(0);
     }
     if (!ddUpdateMtrTree(table,table->tree,perm,permutation)) {
 	FREE(perm);
+	cuddCacheKeepEnd(table);
 	return(0);
     }
     FREE(perm);
 
-    result = ddShuffle(table,permutation);
+    /* Far-away orders are reached faster by rebuilding the diagrams.
+    ** If the rebuild runs out of memory, the heap is left unchanged and
+    ** we fall back on swapping. */
+    result = 0;
+    if (ddShuffleInversions(table,permutation) >
+	DD_SHUFFLE_REBUILD_RATIO * (double) table->size) {
+	result = ddShuffleRebuild(table,permutation);
+    }
+    if (result == 0) {
+	result = ddShuffle(table,permutation);
+    }
 
     if (!ddReorderPostprocess(table)) return(0);
 
@@ -337,6 +451,53 @@ Cudd_ShuffleHeap(
 } /* end of Cudd_ShuffleHeap */
 
 
+/**
+  @brief Reordering trigger that reorders only when it is likely to
+  pay off.
+
+  @details Meant to be installed with Cudd_SetReorderingTrigger.
+  Reordering goes ahead if, compared to the window that ended at the
+  previous consultation, the cache hit rate has dropped, the
+  throughput has dropped, or the nodes grow much faster; these are
+  signs that the order has become a problem.  Otherwise, reordering
+  goes ahead only if the average fraction of nodes that reorderings
+  removed is at least the fraction of time they took.  The first
+  reordering always goes ahead.  The second argument is not used.
+
+  @return 1 to reorder; 0 to postpone reordering.
+
+  @sideeffect None
+
+  @see Cudd_SetReorderingTrigger Cudd_ReadRecentCacheHitRate
+  Cudd_ReadRecentThroughput Cudd_ReadRecentGrowth
+  Cudd_ReadReorderingPayoff Cudd_ReadReorderingCostShare
+
+*/
+int
+Cudd_AdaptiveReorderingTrigger(
+  DdManager * dd,
+  void * arg)
+{
+    (void) arg; /* avoid warning */
+
+    if (dd->reorderings == 0)
+	return(1);
+    if (dd->trigHitRate >= 0.0) {
+	if (Cudd_ReadRecentCacheHitRate(dd) <
+	    DD_TRIGGER_HIT_DROP * dd->trigHitRate)
+	    return(1);
+	if (Cudd_ReadRecentThroughput(dd) <
+	    DD_TRIGGER_SLOWDOWN * dd->trigThroughput)
+	    return(1);
+	if (dd->trigGrowth > 0.0 &&
+	    Cudd_ReadRecentGrowth(dd) > DD_TRIGGER_SPEEDUP * dd->trigGrowth)
+	    return(1);
+    }
+    return(Cudd_ReadReorderingPayoff(dd) >= Cudd_ReadReorderingCostShare(dd));
+
+} /* end of Cudd_AdaptiveReorderingTrigger */
+
+
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -371,7 +532,7 @@ cuddDynamicAllocNode(
 	/* Try to allocate a new block. */
 	saveHandler = MMoutOfMemory;
 	MMoutOfMemory = table->outOfMemCallback;
-	mem = (DdNodePtr *) ALLOC(DdNode, DD_MEM_CHUNK + 1);
+	mem = cuddAllocNodeBlock(table);
 	MMoutOfMemory = saveHandler;
 	if (mem == NULL && table->stash != NULL) {
 	    FREE(table->stash);
@@ -382,7 +543,7 @@ cuddDynamicAllocNode(
 	    for (i = 0; i < table->size; i++) {
 		table->subtables[i].maxKeys <<= 2;
 	    }
-	    mem = (DdNodePtr *) ALLOC(DdNode,DD_MEM_CHUNK + 1);
+	    mem = cuddAllocNodeBlock(table);
 	}
 	if (mem == NULL) {
 	    /* Out of luck. Call the default handler to do
@@ -400,7 +561,6 @@ cuddDynamicAllocNode(
 	    return(NULL);
 	} else {	/* successful allocation; slice memory */
 	    size_t offset;
-	    table->memused += (DD_MEM_CHUNK + 1) * sizeof(DdNode);
 	    mem[0] = (DdNode *) table->memoryList;
 	    table->memoryList = mem;
 
@@ -447,11 +607,16 @@ cuddDynamicAllocNode(
     <li> Select the best permutation.
     <li> Repeat 3 and 4 for all variables.
     </ol>
+  If tight sifting is enabled, the variables are instead ordered by
+  the largest decrease in size that the lower bounds allow, and those
+  that cannot decrease the size are not sifted.
 
   @return 1 if successful; 0 otherwise.
 
   @sideeffect None
 
+  @see Cudd_SetTightSifting
+
 */
 int
 cuddSifting(
@@ -464,11 +629,14 @@ cuddSifting(
     int	size;
     int	x;
     int	result;
+    int	nsift;
+    DdReorderEvent event;
 #ifdef DD_STATS
     int	previousSize;
 #endif
 
     size = table->size;
+    table->siftRan = 1;
 
     /* Find order in which to sift variables. */
     var = ALLOC(IndexKey,size);
@@ -480,15 +648,32 @@ cuddSifting(
     for (i = 0; i < size; i++) {
 	x = table->perm[i];
 	var[i].index = i;
-	var[i].keys = table->subtables[x].keys;
+	if (table->siftTight) {
+	    var[i].keys = ddSiftingPotential(table,x,lower,upper);
+	} else {
+	    var[i].keys = table->subtables[x].keys;
+	}
     }
 
     util_qsort(var,size,sizeof(IndexKey),ddUniqueCompare);
 
+    /* Sift first the variables left out by an interrupted reordering. */
+    if (table->siftNPending > 0) {
+	if (!ddSiftingPendingFirst(table,var,size)) goto cuddSiftingOutOfMem;
+    }
+
     /* Now sift. */
-    for (i = 0; i < ddMin(table->siftMaxVar,size); i++) {
-	if (table->ddTotalNumberSwapping >= table->siftMaxSwap)
+    nsift = ddMin(table->siftMaxVar,size);
+    for (i = 0; i < nsift; i++) {
+	if (table->ddTotalNumberSwapping >= table->siftMaxSwap) {
+	    table->telemetry.cutSwap += nsift - i;
+	    break;
+	}
+	if (cuddReorderExpired(table)) {
+	    if (!ddSiftingRecordSkipped(table,var,i,nsift,lower,upper))
+		goto cuddSiftingOutOfMem;
 	    break;
+	}
         if (util_cpu_time() - table->startTime + table->reordTime
             > table->timeLimit) {
             table->autoDyn = 0; /* prevent further reordering */
@@ -503,11 +688,23 @@ cuddSifting(
 
 	if (x < lower || x > upper || table->subtables[x].bindVar == 1)
 	    continue;
+	/* The earlier moves may have changed the potential. */
+	if (table->siftTight && ddSiftingPotential(table,x,lower,upper) == 0)
+	    continue;
 #ifdef DD_STATS
 	previousSize = (int) (table->keys - table->isolated);
 #endif
+	cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_SIFT,x);
 	result = ddSiftingAux(table, x, lower, upper);
 	if (!result) goto cuddSiftingOutOfMem;
+	cuddReorderEventEnd(table,&event);
+	if (table->reordInterrupted) {
+	    /* This variable did not explore its whole range either. */
+	    if (!ddSiftingRecordSkipped(table,var,i,nsift,lower,upper))
+		goto cuddSiftingOutOfMem;
+	    break;
+	}
+	table->siftedVars++;
 #ifdef DD_STATS
 	if (table->keys < (unsigned) previousSize + table->isolated) {
 	    (void) fprintf(table->out,"-");
@@ -534,6 +731,499 @@ cuddSiftingOutOfMem:
 } /* end of cuddSifting */
 
 
+/**
+  @brief Sifts the variables that grew most since the last reordering.
+
+  @details After a growth spike usually only a few subtables have
+  grown.  This procedure compares the number of nodes at each level
+  between lower and upper with the number recorded for the same
+  variable at the end of the last reordering, and sifts the variables
+  whose subtables grew, largest growth first, until they account for
+  DD_INCR_SIFT_FRACTION of the total growth or siftMaxVar variables
+  have been sifted.  Each variable is only moved within siftWindow
+  levels of its position, so that the cost of the reordering is
+  proportional to the damage to be repaired rather than to the number
+  of variables.  Variables created since the last reordering count as
+  having grown from nothing.  The variables left out by an interrupted
+  reordering are kept for the next full sifting.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+  @see cuddSifting Cudd_SetIncrementalSiftWindow
+
+*/
+int
+cuddIncrementalSifting(
+  DdManager * table,
+  int  lower,
+  int  upper)
+{
+    int	i;
+    IndexKey *var;
+    int	n;
+    int	x;
+    int	index;
+    int	result;
+    int	nsift;
+    int	xLow, xHigh;
+    unsigned int keys, old;
+    double total, covered;
+    DdReorderEvent event;
+
+    table->siftRan = 1;
+
+    /* Do not lose track of the variables left out by an interrupted
+    ** reordering: they are recorded again for the next one. */
+    if (table->siftNPending > 0) {
+	var = ALLOC(IndexKey,table->siftNPending);
+	if (var == NULL) {
+	    table->errorCode = CUDD_MEMORY_OUT;
+	    return(0);
+	}
+	for (i = 0; i < table->siftNPending; i++) {
+	    var[i].index = table->siftPending[i];
+	    var[i].keys = 0;
+	}
+	n = table->siftNPending;
+	FREE(table->siftPending);
+	table->siftNPending = 0;
+	result = ddSiftingRecordSkipped(table,var,0,n,0,table->size-1);
+	FREE(var);
+	if (!result) return(0);
+    }
+
+    var = ALLOC(IndexKey,upper - lower + 1);
+    if (var == NULL) {
+	table->errorCode = CUDD_MEMORY_OUT;
+	return(0);
+    }
+
+    /* Collect the variables that grew. */
+    n = 0;
+    total = 0.0;
+    for (x = lower; x <= upper; x++) {
+	index = table->invperm[x];
+	keys = table->subtables[x].keys;
+	old = index < table->reordKeysSize ? table->reordKeys[index] : 0;
+	if (keys > old) {
+	    var[n].index = index;
+	    var[n].keys = (int) (keys - old);
+	    total += (double) (keys - old);
+	    n++;
+	}
+    }
+    util_qsort(var,n,sizeof(IndexKey),ddUniqueCompare);
+
+    /* Keep the largest ones. */
+    nsift = 0;
+    covered = 0.0;
+    while (nsift < n && nsift < table->siftMaxVar &&
+	   covered < DD_INCR_SIFT_FRACTION * total) {
+	covered += (double) var[nsift].keys;
+	nsift++;
+    }
+
+    for (i = 0; i < nsift; i++) {
+	if (table->ddTotalNumberSwapping >= table->siftMaxSwap) {
+	    table->telemetry.cutSwap += nsift - i;
+	    break;
+	}
+	if (cuddReorderExpired(table)) {
+	    if (!ddSiftingRecordSkipped(table,var,i,nsift,lower,upper))
+		goto cuddIncrementalSiftingOutOfMem;
+	    break;
+	}
+        if (util_cpu_time() - table->startTime + table->reordTime
+            > table->timeLimit) {
+            table->autoDyn = 0; /* prevent further reordering */
+            break;
+        }
+        if (table->terminationCallback != NULL &&
+            table->terminationCallback(table->tcbArg)) {
+            table->autoDyn = 0; /* prevent further reordering */
+            break;
+        }
+	x = table->perm[var[i].index];
+	if (table->subtables[x].bindVar == 1)
+	    continue;
+	xLow = lower;
+	xHigh = upper;
+	if (table->siftWindow > 0) {
+	    xLow = ddMax(lower, x - table->siftWindow);
+	    xHigh = ddMin(upper, x + table->siftWindow);
+	}
+	cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_SIFT,x);
+	result = ddSiftingAux(table, x, xLow, xHigh);
+	if (!result) goto cuddIncrementalSiftingOutOfMem;
+	cuddReorderEventEnd(table,&event);
+	if (table->reordInterrupted) {
+	    if (!ddSiftingRecordSkipped(table,var,i,nsift,lower,upper))
+		goto cuddIncrementalSiftingOutOfMem;
+	    break;
+	}
+	table->siftedVars++;
+#ifdef DD_STATS
+	(void) fprintf(table->out,".");
+	fflush(table->out);
+#endif
+    }
+
+    FREE(var);
+
+    return(1);
+
+cuddIncrementalSiftingOutOfMem:
+
+    FREE(var);
+
+    return(0);
+
+} /* end of cuddIncrementalSifting */
+
+
+/**
+  @brief Checks whether the budget of the current reordering is
+  exhausted.
+
+  @details The budget is given by the real time allowed for a call to
+  Cudd_ReduceHeap and by the number of swaps it may perform.  Once
+  the budget is found exhausted, this function keeps returning 1 until
+  the next reordering starts.
+
+  @return 1 if reordering should stop; 0 otherwise.
+
+  @sideeffect Sets the reordInterrupted flag of the manager.
+
+  @see Cudd_SetReorderingDeadline Cudd_SetReorderingMaxSwaps
+
+*/
+int
+cuddReorderExpired(
+  DdManager * table)
+{
+    if (table->reordInterrupted) return(1);
+    if (table->reordMaxSwaps > 0 &&
+	table->ddTotalNumberSwapping >= table->reordMaxSwaps) {
+	table->reordInterrupted = 1;
+    } else if (table->reordDeadline > 0 &&
+	       (unsigned long) (util_wall_time() - table->reordStart) >=
+	       table->reordDeadline) {
+	table->reordInterrupted = 1;
+    }
+    return(table->reordInterrupted);
+
+} /* end of cuddReorderExpired */
+
+
+/**
+  @brief Makes a copy of a heap on which a reordering algorithm can
+  run independently.
+
+  @details The copy has the same variables in the same order and the
+  same nodes with the same reference counts, so that sizes measured in
+  the copy are those the heap would have in the same order.  The
+  parameters that govern sifting and what is left of the limits of the
+  current reordering are copied as well, and the copy is prepared for
+  reordering.  Since the copy shares nothing with the heap, it can be
+  used by another thread.  Assumes that there are no dead nodes.
+
+  @return the copy if successful; NULL otherwise.
+
+  @sideeffect None
+
+  @see cuddReorderCopyFree
+
+*/
+DdManager *
+cuddReorderCopy(
+  DdManager * table)
+{
+    DdManager *copy;
+    st_table *image;
+    DdNodePtr *nodelist;
+    DdNode *sentinel = &(table->sentinel);
+    DdNode *f, *g, *T, *E;
+    void *value;
+    int level, i;
+
+    copy = Cudd_Init((unsigned int) table->size, 0, table->initSlots,
+		     CUDD_CACHE_SLOTS, 0);
+    if (copy == NULL) return(NULL);
+    image = st_init_table(st_ptrcmp, st_ptrhash);
+    if (image == NULL) goto failure;
+    if (!Cudd_ShuffleHeap(copy, table->invperm)) goto failure;
+    copy->siftMaxVar = table->siftMaxVar;
+    copy->siftMaxSwap = table->siftMaxSwap;
+    copy->maxGrowth = table->maxGrowth;
+    copy->ddTotalNumberSwapping = 0;
+    if (table->reordMaxSwaps > 0) {
+	copy->reordMaxSwaps = table->reordMaxSwaps -
+	    table->ddTotalNumberSwapping;
+	if (copy->reordMaxSwaps < 1) copy->reordMaxSwaps = 1;
+    }
+    copy->reordDeadline = table->reordDeadline;
+    copy->reordStart = table->reordStart;
+
+    /* Copy the nodes from the bottom up.  Garbage collection is kept
+    ** off until the reference counts are set. */
+    copy->gcEnabled = 0;
+    nodelist = table->constants.nodelist;
+    for (i = 0; i < (int) table->constants.slots; i++) {
+	for (f = nodelist[i]; f != NULL; f = f->next) {
+	    g = cuddUniqueConst(copy, cuddV(f));
+	    if (g == NULL) goto failure;
+	    if (st_insert(image, f, g) == ST_OUT_OF_MEM) goto failure;
+	}
+    }
+    for (level = table->size - 1; level >= 0; level--) {
+	nodelist = table->subtables[level].nodelist;
+	for (i = 0; i < (int) table->subtables[level].slots; i++) {
+	    for (f = nodelist[i]; f != sentinel; f = f->next) {
+		if (!st_lookup(image, cuddT(f), &value)) goto failure;
+		T = (DdNode *) value;
+		if (!st_lookup(image, Cudd_Regular(cuddE(f)), &value))
+		    goto failure;
+		E = Cudd_NotCond((DdNode *) value, Cudd_IsComplement(cuddE(f)));
+		g = cuddUniqueInter(copy, (int) f->index, T, E);
+		if (g == NULL) goto failure;
+		if (st_insert(image, f, g) == ST_OUT_OF_MEM) goto failure;
+	    }
+	}
+    }
+
+    /* Each copy now has as many internal references as the original;
+    ** give it the external ones as well. */
+    nodelist = table->constants.nodelist;
+    for (i = 0; i < (int) table->constants.slots; i++) {
+	for (f = nodelist[i]; f != NULL; f = f->next) {
+	    (void) st_lookup(image, f, &value);
+	    ((DdNode *) value)->ref = f->ref;
+	}
+    }
+    for (level = 0; level < table->size; level++) {
+	nodelist = table->subtables[level].nodelist;
+	for (i = 0; i < (int) table->subtables[level].slots; i++) {
+	    for (f = nodelist[i]; f != sentinel; f = f->next) {
+		(void) st_lookup(image, f, &value);
+		((DdNode *) value)->ref = f->ref;
+	    }
+	}
+    }
+    st_free_table(image);
+    image = NULL;
+    copy->gcEnabled = 1;
+    /* The copy has the same functions, hence the same interactions. */
+    if (!cuddCopyInteract(copy, table)) goto failure;
+    if (!ddReorderPreprocess(copy,0)) goto failure;
+#ifdef DD_DEBUG
+    assert(copy->keys == table->keys && copy->isolated == table->isolated);
+#endif
+    return(copy);
+
+failure:
+    if (copy->errorCode == CUDD_MEMORY_OUT) {
+	table->errorCode = CUDD_MEMORY_OUT;
+    }
+    if (image != NULL) st_free_table(image);
+    Cudd_Quit(copy);
+    return(NULL);
+
+} /* end of cuddReorderCopy */
+
+
+/**
+  @brief Frees a copy of a heap made by cuddReorderCopy.
+
+  @details The swaps performed in the copy are added to those of the
+  heap, and an interruption of the reordering in the copy interrupts
+  the reordering of the heap.
+
+  @sideeffect None
+
+  @see cuddReorderCopy
+
+*/
+void
+cuddReorderCopyFree(
+  DdManager * table,
+  DdManager * copy)
+{
+    table->ddTotalNumberSwapping += copy->ddTotalNumberSwapping;
+    if (copy->reordInterrupted) table->reordInterrupted = 1;
+    (void) ddReorderPostprocess(copy);
+    Cudd_Quit(copy);
+
+} /* end of cuddReorderCopyFree */
+
+
+/**
+  @brief Consults the reordering trigger.
+
+  @details Called when the number of nodes reaches the threshold for
+  dynamic reordering.  If there is no trigger, reordering goes ahead.
+  If the trigger postpones reordering, the threshold is raised as if
+  reordering had taken place.  Either way, the measurement window of
+  the signals available to the trigger is restarted.
+
+  @return 1 if reordering should take place; 0 otherwise.
+
+  @sideeffect May change the threshold for dynamic reordering.
+
+  @see Cudd_SetReorderingTrigger
+
+*/
+int
+cuddReorderTrigger(
+  DdManager * table)
+{
+    int reorder;
+
+    if (table->reordTrigger == NULL)
+	return(1);
+    reorder = table->reordTrigger(table, table->rtArg);
+    if (!reorder) {
+	table->nextDyn = (table->keys - table->constants.keys + 1) *
+	    DD_DYN_RATIO + table->constants.keys;
+    }
+    table->trigHitRate = Cudd_ReadRecentCacheHitRate(table);
+    table->trigThroughput = Cudd_ReadRecentThroughput(table);
+    table->trigGrowth = Cudd_ReadRecentGrowth(table);
+    cuddReorderTriggerReset(table);
+    return(reorder);
+
+} /* end of cuddReorderTrigger */
+
+
+/**
+  @brief Starts a new measurement window for the reordering trigger.
+
+  @sideeffect None
+
+  @see cuddReorderTrigger
+
+*/
+void
+cuddReorderTriggerReset(
+  DdManager * table)
+{
+    table->trigLookups = Cudd_ReadCacheLookUps(table);
+    table->trigHits = Cudd_ReadCacheHits(table);
+    table->trigKeys = table->keys - table->dead;
+    table->trigTime = util_cpu_time();
+
+} /* end of cuddReorderTriggerReset */
+
+
+/**
+  @brief Starts recording a reordering event.
+
+  @details For sifting events, x is the level of the variable about
+  to be sifted; it is ignored otherwise.  The counters needed to
+  compute the event are saved in the fields of event, which
+  cuddReorderEventEnd turns into differences.
+
+  @sideeffect Initializes event.
+
+  @see cuddReorderEventEnd
+
+*/
+void
+cuddReorderEventBegin(
+  DdManager * table,
+  DdReorderEvent * event,
+  Cudd_ReorderEventType type,
+  int x)
+{
+    event->type = type;
+    event->cutByGrowth = (int) table->telemetry.cutGrowth;
+    switch (type) {
+    case CUDD_REORDER_EVENT_SIFT:
+	event->index = table->invperm[x];
+	event->startLevel = x;
+	event->swaps = table->ddTotalNumberSwapping;
+	event->sizeBefore = table->keys - table->isolated;
+	break;
+    case CUDD_REORDER_EVENT_ZDD_SIFT:
+	event->index = table->invpermZ[x];
+	event->startLevel = x;
+	event->swaps = table->zddTotalNumberSwapping;
+	event->sizeBefore = table->keysZ;
+	break;
+    default:
+	event->index = event->startLevel = -1;
+	event->swaps = 0;
+	event->sizeBefore = table->keys + table->keysZ;
+	break;
+    }
+    event->time = (unsigned long) util_cpu_time();
+
+} /* end of cuddReorderEventBegin */
+
+
+/**
+  @brief Completes a reordering event and reports it.
+
+  @details Adds the event to the totals of the manager and passes it
+  to the telemetry callback, if one is installed.
+
+  @sideeffect None
+
+  @see cuddReorderEventBegin Cudd_SetReorderingTelemetry
+
+*/
+void
+cuddReorderEventEnd(
+  DdManager * table,
+  DdReorderEvent * event)
+{
+    DdReorderTelemetry *tel = &(table->telemetry);
+
+    event->time = (unsigned long) util_cpu_time() - event->time;
+    event->cutByGrowth = (int) tel->cutGrowth - event->cutByGrowth;
+    switch (event->type) {
+    case CUDD_REORDER_EVENT_SIFT:
+	event->bestLevel = table->perm[event->index];
+	event->swaps = table->ddTotalNumberSwapping - event->swaps;
+	event->sizeAfter = table->keys - table->isolated;
+	break;
+    case CUDD_REORDER_EVENT_ZDD_SIFT:
+	event->bestLevel = table->permZ[event->index];
+	event->swaps = table->zddTotalNumberSwapping - event->swaps;
+	event->sizeAfter = table->keysZ;
+	break;
+    default:
+	event->bestLevel = -1;
+	event->sizeAfter = table->keys + table->keysZ;
+	break;
+    }
+    switch (event->type) {
+    case CUDD_REORDER_EVENT_SIFT:
+    case CUDD_REORDER_EVENT_ZDD_SIFT:
+	tel->sifted++;
+	tel->swaps += event->swaps;
+	tel->moved += abs(event->bestLevel - event->startLevel);
+	tel->removed += (double) event->sizeBefore - (double) event->sizeAfter;
+	tel->siftTime += event->time;
+	break;
+    case CUDD_REORDER_EVENT_GC:
+	tel->gcs++;
+	tel->reclaimed += (double) event->sizeBefore - (double) event->sizeAfter;
+	tel->gcTime += event->time;
+	break;
+    case CUDD_REORDER_EVENT_CACHE_FLUSH:
+	tel->flushes++;
+	tel->flushTime += event->time;
+	break;
+    }
+    if (tel->callback != NULL) {
+	tel->callback(table, event, tel->arg);
+    }
+
+} /* end of cuddReorderEventEnd */
+
+
 /**
   @brief Reorders variables by a sequence of (non-adjacent) swaps.
 
@@ -581,6 +1271,8 @@ cuddSwapping(
     for (i = 0; i < iterate; i++) {
 	if (table->ddTotalNumberSwapping >= table->siftMaxSwap)
 	    break;
+	if (cuddReorderExpired(table))
+	    break;
 	if (heuristic == CUDD_REORDER_RANDOM_PIVOT) {
 	    max = -1;
 	    for (j = lower; j <= upper; j++) {
@@ -1063,7 +1755,7 @@ cuddSwapInPlace(
 		    cuddSatDec(tmp->ref);
 		    tmp = Cudd_Regular(cuddE(f));
 		    cuddSatDec(tmp->ref);
-		    cuddDeallocNode(table,f);
+		    cuddReorderDeallocNode(table,f);
 		    newykeys--;
 		} else {
 		    *previousP = f;
@@ -1199,6 +1891,7 @@ cuddBddAlignToZdd(
     int M;			/* ratio of ZDD variables to BDD variables */
     int i;			/* loop index */
     int result;			/* return value */
+    DdReorderEvent event;	/* garbage collection record */
 
     /* We assume that a ratio of 0 is OK. */
     if (table->size == 0)
@@ -1224,7 +1917,9 @@ cuddBddAlignToZdd(
     /* Eliminate dead nodes. Do not scan the cache again, because we
     ** assume that Cudd_zddReduceHeap has already cleared it.
     */
+    cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_GC,0);
     cuddGarbageCollect(table,0);
+    cuddReorderEventEnd(table,&event);
 
     /* Initialize number of isolated projection functions. */
     table->isolated = 0;
@@ -1238,8 +1933,8 @@ cuddBddAlignToZdd(
 
     result = ddShuffle(table, invperm);
     FREE(invperm);
-    /* Free interaction matrix. */
-    FREE(table->interact);
+    /* Keep the interaction matrix for the next reordering. */
+    cuddResumeInteract(table);
     /* Fix the BDD variable group tree. */
     bddFixTree(table,table->tree);
     return(result);
@@ -1477,7 +2172,11 @@ ddSiftingAux(
 	moveUp = ddSiftingUp(table,x,xLow);
 	if (moveUp == (Move *) CUDD_OUT_OF_MEM) goto ddSiftingAuxOutOfMem;
 	/* Move backward and stop at best position */
-	result = ddSiftingBackward(table,initialSize,moveUp);
+	if (table->reordInterrupted) {
+	    result = ddSiftingRollback(table,initialSize,moveDown,moveUp);
+	} else {
+	    result = ddSiftingBackward(table,initialSize,moveUp);
+	}
 	if (!result) goto ddSiftingAuxOutOfMem;
 
     } else { /* must go up first: shorter */
@@ -1490,7 +2189,11 @@ ddSiftingAux(
 	moveDown = ddSiftingDown(table,x,xHigh);
 	if (moveDown == (Move *) CUDD_OUT_OF_MEM) goto ddSiftingAuxOutOfMem;
 	/* Move backward and stop at best position. */
-	result = ddSiftingBackward(table,initialSize,moveDown);
+	if (table->reordInterrupted) {
+	    result = ddSiftingRollback(table,initialSize,moveUp,moveDown);
+	} else {
+	    result = ddSiftingBackward(table,initialSize,moveDown);
+	}
 	if (!result) goto ddSiftingAuxOutOfMem;
     }
 
@@ -1531,8 +2234,9 @@ ddSiftingAuxOutOfMem:
 /**
   @brief Sifts a variable up.
 
-  @details Moves y up until either it reaches the bound (xLow) or the
-  size of the %DD heap increases too much.
+  @details Moves y up until either it reaches the bound (xLow), the
+  size of the %DD heap increases too much, or the reordering budget is
+  exhausted.
 
   @return the set of moves in case of success; NULL if memory is full.
 
@@ -1551,8 +2255,9 @@ ddSiftingUp(
     int		size;
     int		limitSize;
     int		xindex, yindex;
-    int		isolated;
+    int		S;	/* nodes above y that may vanish */
     int		L;	/* lower bound on DD size */
+    int		near;	/* levels above y interacting with y */
 #ifdef DD_DEBUG
     int checkL;
     int z;
@@ -1567,41 +2272,42 @@ ddSiftingUp(
     ** The part of the DD above y that does not interact with y will not
     ** change. The rest may vanish in the best case, except for
     ** the nodes at level xLow, which will not vanish, regardless.
+    ** (See ddSiftingVanish for tight sifting.)
     */
-    limitSize = L = (int) (table->keys - table->isolated);
-    for (x = xLow + 1; x < y; x++) {
-	xindex = table->invperm[x];
-	if (cuddTestInteract(table,xindex,yindex)) {
-	    isolated = table->vars[xindex]->ref == 1;
-	    L -= table->subtables[x].keys - isolated;
-	}
-    }
-    isolated = table->vars[yindex]->ref == 1;
-    L -= (int) table->subtables[y].keys - isolated;
+    limitSize = size = (int) (table->keys - table->isolated);
+    S = ddSiftingInteractSum(table,y,xLow + 1,y - 1,&near);
+    L = size - S - ddSiftingVanish(table,y);
+    /* With tight sifting, stop when only variables that do not
+    ** interact with y are left above it: moving y past them does not
+    ** change the size. */
+    if (xLow < y && cuddTestInteract(table,table->invperm[xLow],yindex))
+	near++;
+    if (!table->siftTight) near = 1;
 
     x = cuddNextLow(table,y);
-    while (x >= xLow && L <= limitSize) {
+    while (x >= xLow && L <= limitSize && near > 0) {
+	if (cuddReorderExpired(table)) break;
 	xindex = table->invperm[x];
 #ifdef DD_DEBUG
 	checkL = (int) (table->keys - table->isolated);
 	for (z = xLow + 1; z < y; z++) {
 	    zindex = table->invperm[z];
 	    if (cuddTestInteract(table,zindex,yindex)) {
-		isolated = table->vars[zindex]->ref == 1;
-		checkL -= (int) table->subtables[z].keys - isolated;
+		checkL -= ddSiftingVanish(table,z);
 	    }
 	}
-	isolated = table->vars[yindex]->ref == 1;
-	checkL -= (int) table->subtables[y].keys - isolated;
+	checkL -= ddSiftingVanish(table,y);
 	assert(L == checkL);
 #endif
+	/* The nodes of x no longer count once y has moved above it. */
+	if (cuddTestInteract(table,xindex,yindex)) {
+	    if (x > xLow) S -= ddSiftingVanish(table,x);
+	    if (table->siftTight) near--;
+	}
 	size = cuddSwapInPlace(table,x,y);
 	if (size == 0) goto ddSiftingUpOutOfMem;
 	/* Update the lower bound. */
-	if (cuddTestInteract(table,xindex,yindex)) {
-	    isolated = table->vars[xindex]->ref == 1;
-	    L += (int) table->subtables[y].keys - isolated;
-	}
+	L = size - S - ddSiftingVanish(table,x);
 	move = (Move *) cuddDynamicAllocNode(table);
 	if (move == NULL) goto ddSiftingUpOutOfMem;
 	move->x = x;
@@ -1609,7 +2315,10 @@ ddSiftingUp(
 	move->size = size;
 	move->next = moves;
 	moves = move;
-	if ((double) size > (double) limitSize * table->maxGrowth) break;
+	if ((double) size > (double) limitSize * table->maxGrowth) {
+	    table->telemetry.cutGrowth++;
+	    break;
+	}
 	if (size < limitSize) limitSize = size;
 	y = x;
 	x = cuddNextLow(table,y);
@@ -1630,8 +2339,9 @@ ddSiftingUpOutOfMem:
 /**
   @brief Sifts a variable down.
 
-  @details Moves x down until either it reaches the bound (xHigh) or
-  the size of the %DD heap increases too much.
+  @details Moves x down until either it reaches the bound (xHigh),
+  the size of the %DD heap increases too much, or the reordering budget
+  is exhausted.
 
   @return the set of moves in case of success; NULL if memory is full.
 
@@ -1651,7 +2361,6 @@ ddSiftingDown(
     int		R;	/* upper bound on node decrease */
     int		limitSize;
     int		xindex, yindex;
-    int		isolated;
 #ifdef DD_DEBUG
     int		checkR;
     int		z;
@@ -1662,24 +2371,17 @@ ddSiftingDown(
     /* Initialize R */
     xindex = table->invperm[x];
     limitSize = size = (int) (table->keys - table->isolated);
-    R = 0;
-    for (y = xHigh; y > x; y--) {
-	yindex = table->invperm[y];
-	if (cuddTestInteract(table,xindex,yindex)) {
-	    isolated = table->vars[yindex]->ref == 1;
-	    R += (int) table->subtables[y].keys - isolated;
-	}
-    }
+    R = ddSiftingInteractSum(table,x,x + 1,xHigh,NULL);
 
     y = cuddNextHigh(table,x);
     while (y <= xHigh && size - R < limitSize) {
+	if (cuddReorderExpired(table)) break;
 #ifdef DD_DEBUG
 	checkR = 0;
 	for (z = xHigh; z > x; z--) {
 	    zindex = table->invperm[z];
 	    if (cuddTestInteract(table,xindex,zindex)) {
-		isolated = table->vars[zindex]->ref == 1;
-		checkR += (int) table->subtables[z].keys - isolated;
+		checkR += ddSiftingVanish(table,z);
 	    }
 	}
 	assert(R == checkR);
@@ -1687,8 +2389,7 @@ ddSiftingDown(
 	/* Update upper bound on node decrease. */
 	yindex = table->invperm[y];
 	if (cuddTestInteract(table,xindex,yindex)) {
-	    isolated = table->vars[yindex]->ref == 1;
-	    R -= (int) table->subtables[y].keys - isolated;
+	    R -= ddSiftingVanish(table,y);
 	}
 	size = cuddSwapInPlace(table,x,y);
 	if (size == 0) goto ddSiftingDownOutOfMem;
@@ -1699,7 +2400,10 @@ ddSiftingDown(
 	move->size = size;
 	move->next = moves;
 	moves = move;
-	if ((double) size > (double) limitSize * table->maxGrowth) break;
+	if ((double) size > (double) limitSize * table->maxGrowth) {
+	    table->telemetry.cutGrowth++;
+	    break;
+	}
 	if (size < limitSize) limitSize = size;
 	x = y;
 	y = cuddNextHigh(table,x);
@@ -1755,13 +2459,290 @@ ddSiftingBackward(
 } /* end of ddSiftingBackward */
 
 
+/**
+  @brief Returns the number of nodes at a level that may vanish.
+
+  @details Isolated projection functions are not counted.  With tight
+  sifting, one node is also left for each variable that appears in the
+  %DD heap, because reordering does not change the support of the
+  functions.
+
+  @sideeffect None
+
+  @see ddSiftingInteractSum Cudd_SetTightSifting
+
+*/
+static int
+ddSiftingVanish(
+  DdManager * table,
+  int  level)
+{
+    int keys;
+
+    keys = (int) table->subtables[level].keys -
+	(table->vars[table->invperm[level]]->ref == 1);
+    if (table->siftTight && keys > 0) keys--;
+    return(keys);
+
+} /* end of ddSiftingVanish */
+
+
+/**
+  @brief Adds up the nodes that may vanish at the levels interacting
+  with x.
+
+  @details Considers the levels from low to high, x excluded.  When the
+  interaction matrix is kept as lists, and the variables interacting
+  with x are fewer than the levels, visits only those variables.  If
+  count is not NULL, the number of interacting levels is stored there.
+
+  @return the number of nodes.
+
+  @sideeffect None
+
+  @see ddSiftingVanish cuddReadInteractList
+
+*/
+static int
+ddSiftingInteractSum(
+  DdManager * table,
+  int  x,
+  int  low,
+  int  high,
+  int * count)
+{
+    DdHalfWord const *nbr;
+    int n, k, z, sum, levels;
+    int xindex = table->invperm[x];
+
+    sum = levels = 0;
+    n = high < low ? 0 : cuddReadInteractList(table,xindex,&nbr);
+    if (n >= 0 && n <= high - low) {
+	for (k = 0; k < n; k++) {
+	    z = table->perm[nbr[k]];
+	    if (z >= low && z <= high && z != x) {
+		sum += ddSiftingVanish(table,z);
+		levels++;
+	    }
+	}
+    } else {
+	for (z = low; z <= high; z++) {
+	    if (z != x && cuddTestInteract(table,xindex,table->invperm[z])) {
+		sum += ddSiftingVanish(table,z);
+		levels++;
+	    }
+	}
+    }
+    if (count != NULL) *count = levels;
+    return(sum);
+
+} /* end of ddSiftingInteractSum */
+
+
+/**
+  @brief Returns the largest decrease in size that sifting a variable
+  between lower and upper may achieve.
+
+  @details Takes the larger of the bounds used by ddSiftingUp and
+  ddSiftingDown.  If the result is 0, sifting the variable cannot
+  decrease the size of the %DD heap.
+
+  @sideeffect None
+
+  @see ddSiftingUp ddSiftingDown
+
+*/
+static int
+ddSiftingPotential(
+  DdManager * table,
+  int  x,
+  int  lower,
+  int  upper)
+{
+    int up, down, levels;
+
+    if (x < lower || x > upper) return(0);
+    /* Moving past variables that do not interact with x changes
+    ** nothing. */
+    up = ddSiftingInteractSum(table,x,lower + 1,x - 1,&levels) +
+	ddSiftingVanish(table,x);
+    if (lower < x &&
+	cuddTestInteract(table,table->invperm[lower],table->invperm[x]))
+	levels++;
+    if (levels == 0) up = 0;
+    down = ddSiftingInteractSum(table,x,x + 1,upper,NULL);
+    return(ddMax(up,down));
+
+} /* end of ddSiftingPotential */
+
+
+/**
+  @brief Returns the %DD heap to the best position seen by an
+  interrupted sifting of a variable.
+
+  @details The variable was moved in one direction (first) and then in
+  the other (second), but the second list of moves may not cover all
+  the positions visited by the first, because the reordering budget
+  was exhausted.  If the best position is on the second list, goes
+  back to it; otherwise undoes all the second moves and goes back
+  along the first list.
+
+  @return 1 in case of success; 0 otherwise.
+
+  @sideeffect None
+
+  @see ddSiftingBackward
+
+*/
+static int
+ddSiftingRollback(
+  DdManager * table,
+  int  size,
+  Move * first,
+  Move * second)
+{
+    Move *move;
+    int	minFirst, minSecond;
+    int	res;
+
+    minFirst = size;
+    for (move = first; move != NULL; move = move->next) {
+	if (move->size < minFirst) {
+	    minFirst = move->size;
+	}
+    }
+    if (second != NULL) {
+	minSecond = second->size;
+	for (move = second; move != NULL; move = move->next) {
+	    if (move->size < minSecond) {
+		minSecond = move->size;
+	    }
+	}
+	if (minSecond <= minFirst) {
+	    return(ddSiftingBackward(table,minSecond,second));
+	}
+    }
+
+    for (move = second; move != NULL; move = move->next) {
+	res = cuddSwapInPlace(table,(int)move->x,(int)move->y);
+	if (!res) return(0);
+    }
+
+    return(ddSiftingBackward(table,size,first));
+
+} /* end of ddSiftingRollback */
+
+
+/**
+  @brief Moves the variables left out by the last reordering to the
+  front of the sifting order.
+
+  @details The relative order of the variables is otherwise preserved.
+
+  @return 1 in case of success; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddSiftingPendingFirst(
+  DdManager * table,
+  IndexKey * var,
+  int  size)
+{
+    IndexKey *sorted;
+    char *pending;
+    int	i, j;
+
+    pending = ALLOC(char,size);
+    sorted = ALLOC(IndexKey,size);
+    if (pending == NULL || sorted == NULL) {
+	if (pending != NULL) FREE(pending);
+	if (sorted != NULL) FREE(sorted);
+	table->errorCode = CUDD_MEMORY_OUT;
+	return(0);
+    }
+    for (i = 0; i < size; i++) pending[i] = 0;
+    for (i = 0; i < table->siftNPending; i++) {
+	if (table->siftPending[i] < size) pending[table->siftPending[i]] = 1;
+    }
+    j = 0;
+    for (i = 0; i < size; i++) {
+	if (pending[var[i].index]) sorted[j++] = var[i];
+    }
+    for (i = 0; i < size; i++) {
+	if (!pending[var[i].index]) sorted[j++] = var[i];
+    }
+    for (i = 0; i < size; i++) var[i] = sorted[i];
+    FREE(pending);
+    FREE(sorted);
+
+    return(1);
+
+} /* end of ddSiftingPendingFirst */
+
+
+/**
+  @brief Records the variables that an interrupted sifting did not
+  reach.
+
+  @details Records the variables in positions from to to-1 of var
+  whose levels are between lower and upper, unless they are already
+  recorded.
+
+  @return 1 in case of success; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddSiftingRecordSkipped(
+  DdManager * table,
+  IndexKey * var,
+  int  from,
+  int  to,
+  int  lower,
+  int  upper)
+{
+    int *skipped;
+    char *recorded;
+    int	i, x;
+
+    skipped = REALLOC(int,table->siftSkipped,table->siftNSkipped + to - from);
+    recorded = ALLOC(char,table->size);
+    if (skipped == NULL || recorded == NULL) {
+	if (skipped != NULL) table->siftSkipped = skipped;
+	if (recorded != NULL) FREE(recorded);
+	table->errorCode = CUDD_MEMORY_OUT;
+	return(0);
+    }
+    table->siftSkipped = skipped;
+    for (i = 0; i < table->size; i++) recorded[i] = 0;
+    for (i = 0; i < table->siftNSkipped; i++) recorded[skipped[i]] = 1;
+    for (i = from; i < to; i++) {
+	x = table->perm[var[i].index];
+	if (x < lower || x > upper || table->subtables[x].bindVar == 1 ||
+	    recorded[var[i].index])
+	    continue;
+	skipped[table->siftNSkipped++] = var[i].index;
+	recorded[var[i].index] = 1;
+    }
+    FREE(recorded);
+
+    return(1);
+
+} /* end of ddSiftingRecordSkipped */
+
+
 /**
   @brief Prepares the %DD heap for dynamic reordering.
 
   @details Does garbage collection, to guarantee that there are no
   dead nodes; clears the cache, which is invalidated by dynamic
   reordering; initializes the number of isolated projection functions;
-  and initializes the interaction matrix.
+  and initializes the interaction matrix.  If keepCache is nonzero and
+  the manager preserves the cache, only the entries that refer to dead
+  nodes are cleared, and the cache is prepared to survive reordering.
 
   @return 1 in case of success; 0 otherwise.
 
@@ -1770,17 +2751,31 @@ ddSiftingBackward(
 */
 static int
 ddReorderPreprocess(
-  DdManager * table)
+  DdManager * table,
+  int keepCache)
 {
     int i;
     int res;
+    DdReorderEvent event;
+
+    /* The realignment of the other order is not covered by the filter. */
+    keepCache = keepCache && table->preserveCache &&
+	!table->realign && !table->realignZ;
 
     /* Clear the cache. */
-    cuddCacheFlush(table);
+    cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_CACHE_FLUSH,0);
+    if (keepCache) {
+	cuddCacheClearDead(table);
+    } else {
+	cuddCacheFlush(table);
+    }
     cuddLocalCacheClearAll(table);
+    cuddReorderEventEnd(table,&event);
 
     /* Eliminate dead nodes. Do not scan the cache again. */
+    cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_GC,0);
     cuddGarbageCollect(table,0);
+    cuddReorderEventEnd(table,&event);
 
     /* Initialize number of isolated projection functions. */
     table->isolated = 0;
@@ -1792,6 +2787,8 @@ ddReorderPreprocess(
     res = cuddInitInteract(table);
     if (res == 0) return(0);
 
+    if (keepCache) cuddCacheKeepStart(table);
+
     return(1);
 
 } /* end of ddReorderPreprocess */
@@ -1812,14 +2809,61 @@ ddReorderPostprocess(
     (void) fflush(table->out);
 #endif
 
-    /* Free interaction matrix. */
-    FREE(table->interact);
+    /* Keep the interaction matrix for the next reordering. */
+    cuddResumeInteract(table);
+
+    /* Drop the cache entries invalidated by reordering. */
+    cuddCacheKeepEnd(table);
+
+    /* Remember the sizes for incremental sifting. */
+    ddReorderRecordKeys(table);
 
     return(1);
 
 } /* end of ddReorderPostprocess */
 
 
+/**
+  @brief Records the number of nodes of each variable.
+
+  @details The numbers are used by incremental sifting to find the
+  variables that grew since.  If there is not enough memory, the
+  record is dropped, and all variables are treated as new.
+
+  @sideeffect None
+
+  @see cuddIncrementalSifting
+
+*/
+static void
+ddReorderRecordKeys(
+  DdManager * table)
+{
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+    unsigned int *keys;
+    int i;
+
+    if (table->reordKeysSize < table->size) {
+	saveHandler = MMoutOfMemory;
+	MMoutOfMemory = table->outOfMemCallback;
+	keys = REALLOC(unsigned int,table->reordKeys,table->size);
+	MMoutOfMemory = saveHandler;
+	if (keys == NULL) {
+	    if (table->reordKeys != NULL) FREE(table->reordKeys);
+	    table->reordKeysSize = 0;
+	    return;
+	}
+	table->reordKeys = keys;
+	table->reordKeysSize = table->size;
+    }
+    for (i = 0; i < table->size; i++) {
+	table->reordKeys[table->invperm[i]] = table->subtables[i].keys;
+    }
+
+} /* end of ddReorderRecordKeys */
+
+
 /**
   @brief Reorders variables according to a given permutation.
 
@@ -1899,6 +2943,552 @@ ddShuffle(
 } /* end of ddShuffle */
 
 
+/**
+  @brief Counts the swaps of adjacent variables needed to reach a
+  permutation.
+
+  @details The count is the number of pairs of variables whose
+  relative order differs between the current order and permutation.
+
+  @return the number of swaps if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static double
+ddShuffleInversions(
+  DdManager * table,
+  int * permutation)
+{
+    int *count;		/* Fenwick tree over the current levels */
+    double inversions;
+    int	size = table->size;
+    int	level, i, seen;
+
+    count = ALLOC(int, size + 1);
+    if (count == NULL) return(0.0);
+    for (i = 0; i <= size; i++) count[i] = 0;
+    inversions = 0.0;
+    for (level = 0; level < size; level++) {
+	/* Count the variables already placed that are currently above
+	** this one. */
+	seen = 0;
+	for (i = table->perm[permutation[level]] + 1; i > 0; i -= i & -i) {
+	    seen += count[i];
+	}
+	inversions += (double) (level - seen);
+	for (i = table->perm[permutation[level]] + 1; i <= size; i += i & -i) {
+	    count[i]++;
+	}
+    }
+    FREE(count);
+
+    return(inversions);
+
+} /* end of ddShuffleInversions */
+
+
+/**
+  @brief Brings the heap to a permutation by rebuilding the diagrams.
+
+  @details Builds the image of every live node in the new order in a
+  scratch manager, from the bottom of the current order up.  Then
+  transfers the result back, level by level, reusing the node of each
+  function for its new representation, so that pointers to nodes
+  remain valid, and allocating nodes for the new intermediate
+  functions.  While the images are built, the next field of each old
+  node points to its image; during the transfer, the next field of
+  each node of the scratch manager points to its new node.  Assumes
+  that there are no dead nodes.
+
+  @return 1 if successful; 0 if memory was insufficient, in which case
+  the heap is unchanged.
+
+  @sideeffect None
+
+  @see ddShuffle
+
+*/
+static int
+ddShuffleRebuild(
+  DdManager * table,
+  int * permutation)
+{
+    DdManager *scratch;
+    DdSubtable *subtables = NULL;
+    DdNodePtr **nodelists = NULL;
+    DdNodePtr *nodes = NULL;	/* old internal nodes, bottom up */
+    DdNodePtr *images = NULL;	/* live nodes of scratch, bottom up */
+    unsigned int *keys = NULL;
+    unsigned int *newSlots = NULL;
+    DdNode *sentinel = &(table->sentinel);
+    DdNode *ssentinel;
+    DdNode *f, *g, *T, *E, *fresh;
+    DdNodePtr *nodelist, *previousP;
+    unsigned int slots, oldInternal, newInternal, k;
+    int size = table->size;
+    int level, index, i, shift, nfresh, linked;
+
+    linked = 1;
+    slots = table->keys / ((unsigned int) size * DD_MAX_SUBTABLE_DENSITY);
+    scratch = Cudd_Init((unsigned int) size, 0,
+			ddMax(slots, CUDD_UNIQUE_SLOTS), CUDD_CACHE_SLOTS, 0);
+    if (scratch == NULL) return(0);
+    ssentinel = &(scratch->sentinel);
+
+    /* The scratch manager only has the projection functions, which do
+    ** not depend on their levels: move them to the target order. */
+    subtables = ALLOC(DdSubtable, size);
+    if (subtables == NULL) goto failure;
+    for (i = 0; i < size; i++) subtables[i] = scratch->subtables[i];
+    for (level = 0; level < size; level++) {
+	index = permutation[level];
+	scratch->subtables[level] = subtables[index];
+	scratch->perm[index] = level;
+	scratch->invperm[level] = index;
+    }
+
+    /* Copy the constants, which need no transfer, and list the old
+    ** nodes from the bottom up. */
+    nodelist = table->constants.nodelist;
+    for (i = 0; i < (int) table->constants.slots; i++) {
+	for (f = nodelist[i]; f != NULL; f = f->next) {
+	    g = cuddUniqueConst(scratch, cuddV(f));
+	    if (g == NULL) goto failure;
+	    cuddRef(g);
+	}
+    }
+    oldInternal = table->keys - table->constants.keys;
+    nodes = ALLOC(DdNodePtr, oldInternal + 1);
+    if (nodes == NULL) goto failure;
+    k = 0;
+    for (level = size - 1; level >= 0; level--) {
+	nodelist = table->subtables[level].nodelist;
+	for (i = 0; i < (int) table->subtables[level].slots; i++) {
+	    for (f = nodelist[i]; f != sentinel; f = f->next) {
+		nodes[k++] = f;
+	    }
+	}
+    }
+#ifdef DD_DEBUG
+    assert(k == oldInternal);
+#endif
+
+    /* Build the images. */
+    linked = 0;
+    for (k = 0; k < oldInternal; k++) {
+	f = nodes[k];
+	T = ddShuffleImage(scratch, cuddT(f));
+	E = ddShuffleImage(scratch, Cudd_Regular(cuddE(f)));
+	E = Cudd_NotCond(E, Cudd_IsComplement(cuddE(f)));
+	g = ddShuffleIteRecur(scratch, scratch->vars[f->index], T, E);
+	if (g == NULL) goto failure;
+	cuddRef(g);
+#ifdef DD_DEBUG
+	assert(!Cudd_IsComplement(g));
+#endif
+	f->next = g;
+    }
+
+    /* List the nodes of the new diagrams, size the new subtables, and
+    ** get the nodes for the functions that did not exist before. */
+    keys = ALLOC(unsigned int, size);
+    newSlots = ALLOC(unsigned int, size);
+    nodelists = ALLOC(DdNodePtr *, size);
+    if (keys == NULL || newSlots == NULL || nodelists == NULL) goto failure;
+    for (level = 0; level < size; level++) nodelists[level] = NULL;
+    newInternal = 0;
+    for (level = 0; level < size; level++) {
+	keys[level] = 0;
+	nodelist = scratch->subtables[level].nodelist;
+	for (i = 0; i < (int) scratch->subtables[level].slots; i++) {
+	    for (g = nodelist[i]; g != ssentinel; g = g->next) {
+		if (g->ref != 0) keys[level]++;
+	    }
+	}
+	newInternal += keys[level];
+	slots = table->initSlots;
+	while (slots < keys[level]) slots <<= 1;
+	nodelists[level] = ALLOC(DdNodePtr, slots);
+	if (nodelists[level] == NULL) goto failure;
+	newSlots[level] = slots;
+	for (i = 0; i < (int) slots; i++) nodelists[level][i] = sentinel;
+    }
+    images = ALLOC(DdNodePtr, newInternal + 1);
+    if (images == NULL) goto failure;
+    k = 0;
+    for (level = size - 1; level >= 0; level--) {
+	nodelist = scratch->subtables[level].nodelist;
+	for (i = 0; i < (int) scratch->subtables[level].slots; i++) {
+	    for (g = nodelist[i]; g != ssentinel; g = g->next) {
+		if (g->ref != 0) images[k++] = g;
+	    }
+	}
+    }
+    fresh = NULL;
+    for (nfresh = (int) (newInternal - oldInternal); nfresh > 0; nfresh--) {
+	f = cuddDynamicAllocNode(table);
+	if (f == NULL) {
+	    while (fresh != NULL) {
+		f = fresh->next;
+		cuddDeallocNode(table, fresh);
+		fresh = f;
+	    }
+	    goto failure;
+	}
+	f->next = fresh;
+	fresh = f;
+    }
+
+    /* From here on nothing can fail.  Point each image to the node
+    ** that will hold it, and leave in each old node only the
+    ** references that do not come from other nodes.  The constants
+    ** are held during the transfer, so that looking them up does not
+    ** reclaim them. */
+    ddShuffleHoldConstants(table, 1);
+    for (k = 0; k < newInternal; k++) {
+	images[k]->next = NULL;
+    }
+    for (k = 0; k < oldInternal; k++) {
+	f = nodes[k];
+	f->next->next = f;
+	cuddSatDec(cuddT(f)->ref);
+	cuddSatDec(Cudd_Regular(cuddE(f))->ref);
+    }
+
+    /* Transfer the scratch diagrams from the bottom up. */
+    k = 0;
+    for (level = size - 1; level >= 0; level--) {
+	shift = sizeof(int) * 8 - cuddComputeFloorLog2(newSlots[level]);
+	for (i = 0; i < (int) keys[level]; i++) {
+	    g = images[k++];
+	    f = g->next;
+	    if (f == NULL) {
+		f = fresh;
+		fresh = fresh->next;
+		f->ref = 0;
+		g->next = f;
+	    }
+	    T = ddShuffleSource(table, scratch, cuddT(g));
+	    E = ddShuffleSource(table, scratch, Cudd_Regular(cuddE(g)));
+	    E = Cudd_NotCond(E, Cudd_IsComplement(cuddE(g)));
+	    f->index = g->index;
+	    cuddT(f) = T;
+	    cuddE(f) = E;
+	    cuddSatInc(T->ref);
+	    cuddSatInc(Cudd_Regular(E)->ref);
+	    ddShuffleLink(nodelists[level], shift, f);
+	}
+    }
+    ddShuffleHoldConstants(table, 0);
+#ifdef DD_DEBUG
+    assert(fresh == NULL);
+#endif
+
+    /* Functions that were only needed in the old order are no longer
+    ** referenced: free them from the top down, as their children may
+    ** become unreferenced in turn. */
+    for (level = 0; level < size; level++) {
+	for (i = 0; i < (int) newSlots[level]; i++) {
+	    previousP = &(nodelists[level][i]);
+	    f = *previousP;
+	    while (f != sentinel) {
+		g = f->next;
+		if (f->ref == 0) {
+		    cuddSatDec(cuddT(f)->ref);
+		    cuddSatDec(Cudd_Regular(cuddE(f))->ref);
+		    cuddReorderDeallocNode(table,f);
+		    keys[level]--;
+		    newInternal--;
+		} else {
+		    *previousP = f;
+		    previousP = &(f->next);
+		}
+		f = g;
+	    }
+	    *previousP = sentinel;
+	}
+    }
+
+    /* Install the new subtables.  The variable attributes follow the
+    ** variables to their new levels. */
+    for (level = 0; level < size; level++) {
+	subtables[level] = table->subtables[level];
+    }
+    for (index = 0; index < size; index++) {
+	level = scratch->perm[index];
+	i = table->perm[index];
+	table->subtables[level].bindVar = subtables[i].bindVar;
+	table->subtables[level].varType = subtables[i].varType;
+	table->subtables[level].pairIndex = subtables[i].pairIndex;
+	table->subtables[level].varHandled = subtables[i].varHandled;
+	table->subtables[level].varToBeGrouped = subtables[i].varToBeGrouped;
+    }
+    for (level = 0; level < size; level++) {
+	slots = newSlots[level];
+	table->slots += slots - subtables[level].slots;
+	table->memused += ((int) slots - (int) subtables[level].slots) *
+	    sizeof(DdNodePtr);
+	FREE(subtables[level].nodelist);
+	table->subtables[level].nodelist = nodelists[level];
+	table->subtables[level].slots = slots;
+	table->subtables[level].shift =
+	    sizeof(int) * 8 - cuddComputeFloorLog2(slots);
+	table->subtables[level].keys = keys[level];
+	table->subtables[level].maxKeys = slots * DD_MAX_SUBTABLE_DENSITY;
+	table->subtables[level].dead = 0;
+	table->perm[scratch->invperm[level]] = level;
+	table->invperm[level] = scratch->invperm[level];
+    }
+    table->keys += newInternal - oldInternal;
+    table->minDead = (unsigned) (table->gcFrac * (double) table->slots);
+    table->cacheSlack = (int) ddMin(table->maxCacheHard,
+				     DD_MAX_CACHE_TO_SLOTS_RATIO * table->slots)
+	- 2 * (int) table->cacheSlots;
+
+    FREE(nodelists);
+    FREE(nodes);
+    FREE(images);
+    FREE(keys);
+    FREE(newSlots);
+    FREE(subtables);
+    Cudd_Quit(scratch);
+    return(1);
+
+failure:
+    if (!linked) {
+	/* Restore the collision lists of the old nodes. */
+	for (level = 0; level < size; level++) {
+	    nodelist = table->subtables[level].nodelist;
+	    for (i = 0; i < (int) table->subtables[level].slots; i++) {
+		nodelist[i] = sentinel;
+	    }
+	}
+	for (k = 0; k < oldInternal; k++) {
+	    f = nodes[k];
+	    level = table->perm[f->index];
+	    ddShuffleLink(table->subtables[level].nodelist,
+			  table->subtables[level].shift, f);
+	}
+    }
+    if (nodelists != NULL) {
+	for (level = 0; level < size; level++) {
+	    if (nodelists[level] != NULL) FREE(nodelists[level]);
+	}
+	FREE(nodelists);
+    }
+    if (nodes != NULL) FREE(nodes);
+    if (images != NULL) FREE(images);
+    if (keys != NULL) FREE(keys);
+    if (newSlots != NULL) FREE(newSlots);
+    if (subtables != NULL) FREE(subtables);
+    Cudd_Quit(scratch);
+    return(0);
+
+} /* end of ddShuffleRebuild */
+
+
+/**
+  @brief Returns the image in the scratch manager of a node of the
+  heap being rebuilt.
+
+  @details The image of an internal node is stored in its next field
+  by ddShuffleRebuild.  Constants are looked up by value.
+
+  @sideeffect None
+
+  @see ddShuffleSource
+
+*/
+static DdNode *
+ddShuffleImage(
+  DdManager * scratch,
+  DdNode * f)
+{
+    if (cuddIsConstant(f)) {
+	return(cuddUniqueConst(scratch, cuddV(f)));
+    }
+    return(f->next);
+
+} /* end of ddShuffleImage */
+
+
+/**
+  @brief Returns the node of the heap being rebuilt that holds a node
+  of the scratch manager.
+
+  @details The node is stored in the next field of the node of the
+  scratch manager by ddShuffleRebuild.  Constants are looked up by
+  value.
+
+  @sideeffect None
+
+  @see ddShuffleImage
+
+*/
+static DdNode *
+ddShuffleSource(
+  DdManager * table,
+  DdManager * scratch,
+  DdNode * g)
+{
+    if (g == DD_ONE(scratch)) {
+	return(DD_ONE(table));
+    } else if (cuddIsConstant(g)) {
+	return(cuddUniqueConst(table, cuddV(g)));
+    }
+    return(g->next);
+
+} /* end of ddShuffleSource */
+
+
+/**
+  @brief Adds or removes a reference to all the constants of a heap.
+
+  @sideeffect None
+
+  @see ddShuffleRebuild
+
+*/
+static void
+ddShuffleHoldConstants(
+  DdManager * table,
+  int  hold)
+{
+    DdNodePtr *nodelist = table->constants.nodelist;
+    DdNode *f;
+    unsigned int i;
+
+    for (i = 0; i < table->constants.slots; i++) {
+	for (f = nodelist[i]; f != NULL; f = f->next) {
+	    if (hold) {
+		cuddSatInc(f->ref);
+	    } else {
+		cuddSatDec(f->ref);
+	    }
+	}
+    }
+
+} /* end of ddShuffleHoldConstants */
+
+
+/**
+  @brief Links a node into a collision list of a subtable.
+
+  @details Keeps the list sorted as cuddUniqueInter does.
+
+  @sideeffect None
+
+*/
+static void
+ddShuffleLink(
+  DdNodePtr * nodelist,
+  int  shift,
+  DdNode * f)
+{
+    DdNodePtr *previousP;
+    DdNode *T = cuddT(f);
+    DdNode *E = cuddE(f);
+
+    previousP = &(nodelist[ddHash(T, E, shift)]);
+    while (T < cuddT(*previousP)) {
+	previousP = &((*previousP)->next);
+    }
+    while (T == cuddT(*previousP) && E < cuddE(*previousP)) {
+	previousP = &((*previousP)->next);
+    }
+    f->next = *previousP;
+    *previousP = f;
+
+} /* end of ddShuffleLink */
+
+
+/**
+  @brief Builds the diagram of "if v then t else e" in the order of
+  the manager.
+
+  @details Neither t nor e depends on v.  Works for both BDDs and
+  ADDs.  This is the recursive step of ddShuffleRebuild.
+
+  @return a pointer to the result if successful; NULL otherwise.
+
+  @sideeffect None
+
+*/
+static DdNode *
+ddShuffleIteRecur(
+  DdManager * dd,
+  DdNode * v,
+  DdNode * t,
+  DdNode * e)
+{
+    DdNode *res, *t1, *t0, *e1, *e0, *r1, *r0, *E;
+    int	comple, topt, tope, top, index;
+
+    statLine(dd);
+    if (t == e) return(t);
+
+    /* Normalize so that the then argument is regular. */
+    comple = Cudd_IsComplement(t);
+    if (comple) {
+	t = Cudd_Not(t);
+	e = Cudd_Not(e);
+    }
+    E = Cudd_Regular(e);
+    topt = cuddI(dd,t->index);
+    tope = cuddI(dd,E->index);
+    top = ddMin(topt,tope);
+    if ((int) dd->perm[v->index] < top) {
+	res = cuddUniqueInter(dd, (int) v->index, t, e);
+	if (res == NULL) return(NULL);
+	return(Cudd_NotCond(res,comple));
+    }
+
+    res = cuddCacheLookup(dd, DD_SHUFFLE_ITE_TAG, v, t, e);
+    if (res != NULL) return(Cudd_NotCond(res,comple));
+
+    index = dd->invperm[top];
+    if (topt == top) {
+	t1 = cuddT(t); t0 = cuddE(t);
+    } else {
+	t1 = t0 = t;
+    }
+    if (tope == top) {
+	e1 = Cudd_NotCond(cuddT(E),E != e);
+	e0 = Cudd_NotCond(cuddE(E),E != e);
+    } else {
+	e1 = e0 = e;
+    }
+
+    r1 = ddShuffleIteRecur(dd, v, t1, e1);
+    if (r1 == NULL) return(NULL);
+    cuddRef(r1);
+    r0 = ddShuffleIteRecur(dd, v, t0, e0);
+    if (r0 == NULL) {
+	Cudd_RecursiveDeref(dd, r1);
+	return(NULL);
+    }
+    cuddRef(r0);
+    if (r1 == r0) {
+	res = r1;
+    } else {
+	res = cuddUniqueInter(dd, index, r1, r0);
+	if (res == NULL) {
+	    Cudd_RecursiveDeref(dd, r1);
+	    Cudd_RecursiveDeref(dd, r0);
+	    return(NULL);
+	}
+    }
+    cuddDeref(r1);
+    cuddDeref(r0);
+
+    cuddCacheInsert(dd, DD_SHUFFLE_ITE_TAG, v, t, e, res);
+
+    return(Cudd_NotCond(res,comple));
+
+} /* end of ddShuffleIteRecur */
+
+
 /**
   @brief Moves one variable up.
 
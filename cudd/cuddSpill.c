@@ -0,0 +1,652 @@
+/**
+  @file
+
+  @ingroup cudd
+
+  @brief File-backed storage of node blocks.
+
+  @copyright@parblock
+  Copyright (c) 1995-2015, Regents of the University of Colorado
+
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+
+  Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  Neither the name of the University of Colorado nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+  @endparblock
+
+*/
+
+#include "util.h"
+#include "cuddInt.h"
+
+#ifdef DD_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/** Number of node blocks of a segment of the spill file. */
+#define DD_SPILL_SEGMENT_BLOCKS 256
+
+/*---------------------------------------------------------------------------*/
+/* Stucture declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+/** \cond */
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+#ifdef DD_USE_MMAP
+static DdNodePtr * ddSpillAllocBlock(DdSpill *spill);
+static int ddSpillMapSegment(DdSpill *spill);
+static size_t ddSpillBlockNumber(DdSpill *spill, DdNodePtr *block);
+static int ddSpillAddressCompare(void const *a, void const *b);
+static int ddSpillLowerBound(DdNodePtr *nodes, int n, DdNode *p);
+#endif
+
+/** \endcond */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/**
+  @brief Keeps the node blocks allocated from now on in a file.
+
+  @details The new blocks of nodes are carved from segments of the
+  file, mapped in shared mode.  The operating system may then write
+  the nodes back to the file when memory is short, instead of failing
+  the allocation; the blocks in the file are not charged to the memory
+  in use, so they do not count against the limit set with
+  Cudd_SetMaxMemory either.  The file is removed as soon as it is
+  created, and its space is reclaimed when the manager is quit.
+  <p>
+  The blocks allocated before the call stay in main memory until they
+  are released.  Cudd_Compact, which is best called when the manager
+  holds few nodes, or Cudd_SpillLevels move the nodes into the file.
+  Spilling is not supported on platforms without memory-mapped files.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect The file is created and removed.
+
+  @see Cudd_SpillLevels Cudd_ReadMemoryBreakdown
+
+*/
+int
+Cudd_EnableSpill(
+  DdManager * dd /**< manager */,
+  char const * path /**< name of the file to create */)
+{
+#ifdef DD_USE_MMAP
+    DdSpill *spill;
+    size_t bytes;
+    long pageSize;
+
+    if (dd->spill != NULL) return(0);
+    spill = ALLOC(DdSpill,1);
+    if (spill == NULL) {
+	dd->errorCode = CUDD_MEMORY_OUT;
+	return(0);
+    }
+    spill->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (spill->fd < 0) {
+	FREE(spill);
+	return(0);
+    }
+    (void) unlink(path);
+    /* Round the blocks to whole pages, so that each block may be paged
+    ** out on its own. */
+    pageSize = sysconf(_SC_PAGESIZE);
+    spill->pageSize = pageSize > 0 ? (size_t) pageSize : 4096;
+    bytes = (DD_MEM_CHUNK + 1) * sizeof(DdNode);
+    spill->blockSize = (bytes + spill->pageSize - 1) / spill->pageSize *
+	spill->pageSize;
+    spill->segmentSize = spill->blockSize * DD_SPILL_SEGMENT_BLOCKS;
+    spill->segments = NULL;
+    spill->nsegments = 0;
+    spill->maxSegments = 0;
+    spill->carved = 0;
+    spill->freeBlocks = NULL;
+    spill->blocks = 0;
+    dd->spill = spill;
+    return(1);
+#else
+    (void) dd;
+    (void) path;
+    return(0);
+#endif
+
+} /* end of Cudd_EnableSpill */
+
+
+/**
+  @brief Pages out the nodes at a range of levels.
+
+  @details Compacts the node memory, so that the nodes at the same
+  level share pages in the spill file, and then advises the operating
+  system that the pages of the file holding no live nodes but those at
+  the levels from low to high of the %BDD/%ADD order will not be
+  needed soon.  These pages are written to the file and dropped from
+  main memory; they are read back transparently when next accessed.
+  The levels outside the range stay resident, and so do the nodes that
+  Cudd_Compact cannot move.  Levels that are rarely touched by the
+  operations to come are good candidates: for instance, in image
+  computations with the present-state variables above the next-state
+  ones, the bottom levels of a large reached set.  Garbage collection
+  and reordering visit all nodes, and bring the pages back in.
+  <p>
+  Spilling only affects where the nodes are kept, never the results.
+
+  @return the number of pages advised out; 0 if spilling is not
+  enabled or if the range is empty.
+
+  @sideeffect Nodes are relocated as by Cudd_Compact.
+
+  @see Cudd_EnableSpill Cudd_Compact
+
+*/
+int
+Cudd_SpillLevels(
+  DdManager * dd /**< manager */,
+  int low /**< top level of the range */,
+  int high /**< bottom level of the range */)
+{
+#ifdef DD_USE_MMAP
+    DdSpill *spill = dd->spill;
+    DdNodePtr *cold, *memlist;
+    DdNode *list, *f, *sentinel = &(dd->sentinel);
+    DdSubtable *subtable;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+    char *out, *start;
+    int *live, *nodesOut;
+    size_t offset, perBlock, npages, base, b, e;
+    int advice, level, i, j, k, n, first, last, pagedOut;
+
+    if (spill == NULL) return(0);
+    if (low < 0) low = 0;
+    if (high >= dd->size) high = dd->size - 1;
+    if (low > high) return(0);
+
+    (void) Cudd_Compact(dd);
+
+    /* Sort the live nodes of the range by address. */
+    n = 0;
+    for (level = low; level <= high; level++) {
+	n += (int) dd->subtables[level].keys;
+    }
+    perBlock = spill->blockSize / spill->pageSize;
+    npages = (size_t) spill->nsegments * DD_SPILL_SEGMENT_BLOCKS * perBlock;
+    saveHandler = MMoutOfMemory;
+    MMoutOfMemory = dd->outOfMemCallback;
+    cold = ALLOC(DdNodePtr,n + 1);
+    out = ALLOC(char,npages + 1);
+    live = ALLOC(int,perBlock);
+    nodesOut = ALLOC(int,perBlock);
+    MMoutOfMemory = saveHandler;
+    if (cold == NULL || out == NULL || live == NULL || nodesOut == NULL) {
+	if (cold != NULL) FREE(cold);
+	if (out != NULL) FREE(out);
+	if (live != NULL) FREE(live);
+	if (nodesOut != NULL) FREE(nodesOut);
+	dd->errorCode = CUDD_MEMORY_OUT;
+	return(0);
+    }
+    n = 0;
+    for (level = low; level <= high; level++) {
+	subtable = &(dd->subtables[level]);
+	for (j = 0; j < (int) subtable->slots; j++) {
+	    for (f = subtable->nodelist[j]; f != sentinel; f = f->next) {
+		if (f->ref != 0) cold[n++] = f;
+	    }
+	}
+    }
+    qsort(cold, (size_t) n, sizeof(DdNodePtr), ddSpillAddressCompare);
+
+    /* Mark the pages whose live nodes, if any, are all in the range,
+    ** and the pages of the free blocks. */
+    memset(out, 0, npages);
+    for (memlist = dd->memoryList; memlist != NULL;
+	 memlist = (DdNodePtr *) memlist[0]) {
+	if (!cuddSpillOwns(dd,memlist)) continue;
+	offset = (size_t) memlist & (sizeof(DdNode) - 1);
+	list = (DdNode *) (memlist + (sizeof(DdNode) - offset) /
+			   sizeof(DdNodePtr));
+	for (i = 0; i < (int) perBlock; i++) live[i] = nodesOut[i] = 0;
+	for (k = 0; k < DD_MEM_CHUNK; k++) {
+	    if (list[k].ref != 0) {
+		live[((char *) &list[k] - (char *) memlist) /
+		     spill->pageSize]++;
+	    }
+	}
+	first = ddSpillLowerBound(cold, n, list);
+	last = ddSpillLowerBound(cold, n, list + DD_MEM_CHUNK);
+	for (k = first; k < last; k++) {
+	    nodesOut[((char *) cold[k] - (char *) memlist) /
+		     spill->pageSize]++;
+	}
+	base = ddSpillBlockNumber(spill,memlist) * perBlock;
+	for (i = 0; i < (int) perBlock; i++) {
+	    out[base + i] = live[i] == nodesOut[i];
+	}
+    }
+    for (memlist = spill->freeBlocks; memlist != NULL;
+	 memlist = (DdNodePtr *) memlist[0]) {
+	base = ddSpillBlockNumber(spill,memlist) * perBlock;
+	memset(out + base, 1, perBlock);
+    }
+    FREE(cold);
+    FREE(live);
+    FREE(nodesOut);
+
+    /* Advise whole runs of pages at once: the page cache may hold the
+    ** file in folios of several pages, which are only dropped when the
+    ** advice covers them entirely. */
+#ifdef MADV_PAGEOUT
+    advice = MADV_PAGEOUT;
+#else
+    advice = MADV_DONTNEED;
+#endif
+    pagedOut = 0;
+    for (b = 0; b < npages; b = e) {
+	if (!out[b]) {
+	    e = b + 1;
+	    continue;
+	}
+	for (e = b + 1; e < npages && out[e] &&
+		 e % (DD_SPILL_SEGMENT_BLOCKS * perBlock) != 0; e++);
+	start = spill->segments[b / (DD_SPILL_SEGMENT_BLOCKS * perBlock)] +
+	    (b % (DD_SPILL_SEGMENT_BLOCKS * perBlock)) * spill->pageSize;
+	/* A shared mapping keeps the contents: the pages are only
+	** written back to the file. */
+#ifndef MADV_PAGEOUT
+	(void) msync(start, (e - b) * spill->pageSize, MS_ASYNC);
+#endif
+	if (madvise(start, (e - b) * spill->pageSize, advice) == 0)
+	    pagedOut += (int) (e - b);
+    }
+    FREE(out);
+    return(pagedOut);
+#else
+    (void) dd;
+    (void) low;
+    (void) high;
+    return(0);
+#endif
+
+} /* end of Cudd_SpillLevels */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+
+/**
+  @brief Allocates a block of nodes.
+
+  @details The block comes from the spill file if there is one and it
+  can be extended; otherwise from main memory, in which case it is
+  charged to the memory in use.  Where anonymous mappings are
+  available, the blocks of main memory are mapped one by one rather
+  than taken from the heap, so that the pages of a released block go
+  back to the operating system at once.  The caller sets the
+  out-of-memory handler.  The block has room for DD_MEM_CHUNK + 1
+  nodes.
+
+  @return a pointer to the block if successful; NULL otherwise.
+
+  @sideeffect None
+
+  @see cuddFreeNodeBlock
+
+*/
+DdNodePtr *
+cuddAllocNodeBlock(
+  DdManager * unique)
+{
+    DdNodePtr *mem = NULL;
+#if defined(DD_USE_MMAP) && defined(MAP_ANONYMOUS)
+    extern DD_OOMFP MMoutOfMemory;
+#endif
+
+#ifdef DD_USE_MMAP
+    if (unique->spill != NULL) {
+	mem = ddSpillAllocBlock(unique->spill);
+    }
+#endif
+    if (mem == NULL) {
+#if defined(DD_USE_MMAP) && defined(MAP_ANONYMOUS)
+	mem = (DdNodePtr *) mmap(NULL, (DD_MEM_CHUNK + 1) * sizeof(DdNode),
+				 PROT_READ | PROT_WRITE,
+				 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mem == (DdNodePtr *) MAP_FAILED) {
+	    if (MMoutOfMemory != 0)
+		(*MMoutOfMemory)((DD_MEM_CHUNK + 1) * sizeof(DdNode));
+	    return(NULL);
+	}
+#else
+	mem = (DdNodePtr *) ALLOC(DdNode,DD_MEM_CHUNK + 1);
+	if (mem == NULL) return(NULL);
+#endif
+	unique->memused += (DD_MEM_CHUNK + 1) * sizeof(DdNode);
+    }
+    unique->nodeBlocks++;
+    if (unique->nodeBlocks > unique->peakNodeBlocks)
+	unique->peakNodeBlocks = unique->nodeBlocks;
+    return(mem);
+
+} /* end of cuddAllocNodeBlock */
+
+
+/**
+  @brief Frees a block of nodes allocated by cuddAllocNodeBlock.
+
+  @details The blocks of the spill file are kept for reuse; the others
+  are unmapped, or freed if they came from the heap.
+
+  @sideeffect None
+
+  @see cuddAllocNodeBlock
+
+*/
+void
+cuddFreeNodeBlock(
+  DdManager * unique,
+  DdNodePtr * block)
+{
+    unique->nodeBlocks--;
+    if (cuddSpillOwns(unique,block)) {
+	block[0] = (DdNodePtr) unique->spill->freeBlocks;
+	unique->spill->freeBlocks = block;
+	unique->spill->blocks--;
+	return;
+    }
+#if defined(DD_USE_MMAP) && defined(MAP_ANONYMOUS)
+    (void) munmap((void *) block, (DD_MEM_CHUNK + 1) * sizeof(DdNode));
+#else
+    FREE(block);
+#endif
+    unique->memused -= (DD_MEM_CHUNK + 1) * sizeof(DdNode);
+
+} /* end of cuddFreeNodeBlock */
+
+
+/**
+  @brief Tells whether a block of nodes lies in the spill file.
+
+  @return 1 if the block was carved from the spill file; 0 otherwise.
+
+  @sideeffect None
+
+*/
+int
+cuddSpillOwns(
+  DdManager * unique,
+  DdNodePtr * block)
+{
+    DdSpill *spill = unique->spill;
+    char *p = (char *) block;
+    int i;
+
+    if (spill == NULL) return(0);
+    for (i = 0; i < spill->nsegments; i++) {
+	if (p >= spill->segments[i] &&
+	    p < spill->segments[i] + spill->segmentSize)
+	    return(1);
+    }
+    return(0);
+
+} /* end of cuddSpillOwns */
+
+
+/**
+  @brief Unmaps and closes the spill file of a manager.
+
+  @details The nodes in the file must no longer be in use.
+
+  @sideeffect The space of the file is reclaimed.
+
+  @see Cudd_EnableSpill
+
+*/
+void
+cuddFreeSpill(
+  DdManager * unique)
+{
+#ifdef DD_USE_MMAP
+    DdSpill *spill = unique->spill;
+    int i;
+
+    if (spill == NULL) return;
+    for (i = 0; i < spill->nsegments; i++) {
+	(void) munmap(spill->segments[i], spill->segmentSize);
+    }
+    if (spill->segments != NULL) FREE(spill->segments);
+    (void) close(spill->fd);
+    FREE(spill);
+    unique->spill = NULL;
+#else
+    (void) unique;
+#endif
+
+} /* end of cuddFreeSpill */
+
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+#ifdef DD_USE_MMAP
+
+/**
+  @brief Allocates a block of nodes from the spill file.
+
+  @return a pointer to the block if successful; NULL otherwise.
+
+  @sideeffect The file may be extended by one segment.
+
+*/
+static DdNodePtr *
+ddSpillAllocBlock(
+  DdSpill * spill)
+{
+    DdNodePtr *mem;
+
+    if (spill->freeBlocks != NULL) {
+	mem = spill->freeBlocks;
+	spill->freeBlocks = (DdNodePtr *) mem[0];
+    } else {
+	if (spill->nsegments == 0 ||
+	    spill->carved == DD_SPILL_SEGMENT_BLOCKS) {
+	    if (!ddSpillMapSegment(spill)) return(NULL);
+	}
+	mem = (DdNodePtr *) (spill->segments[spill->nsegments - 1] +
+			     spill->carved * spill->blockSize);
+	spill->carved++;
+    }
+    spill->blocks++;
+    return(mem);
+
+} /* end of ddSpillAllocBlock */
+
+
+/**
+  @brief Extends the spill file by one segment and maps it.
+
+  @details The space of the segment is reserved on disk when the
+  platform allows it, so that a full disk makes the allocation fail
+  instead of the first write to the segment.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+*/
+static int
+ddSpillMapSegment(
+  DdSpill * spill)
+{
+    char **segments;
+    void *base;
+    off_t offset;
+    int maxSegments;
+
+    if (spill->nsegments == spill->maxSegments) {
+	maxSegments = spill->maxSegments == 0 ? 16 : 2 * spill->maxSegments;
+	segments = REALLOC(char *, spill->segments, maxSegments);
+	if (segments == NULL) return(0);
+	spill->segments = segments;
+	spill->maxSegments = maxSegments;
+    }
+    offset = (off_t) spill->nsegments * (off_t) spill->segmentSize;
+#if defined(_POSIX_ADVISORY_INFO) && _POSIX_ADVISORY_INFO > 0
+    if (posix_fallocate(spill->fd, offset, (off_t) spill->segmentSize) != 0)
+	return(0);
+#else
+    if (ftruncate(spill->fd, offset + (off_t) spill->segmentSize) != 0)
+	return(0);
+#endif
+    base = mmap(NULL, spill->segmentSize, PROT_READ | PROT_WRITE,
+		MAP_SHARED, spill->fd, offset);
+    if (base == MAP_FAILED) return(0);
+    spill->segments[spill->nsegments++] = (char *) base;
+    spill->carved = 0;
+    return(1);
+
+} /* end of ddSpillMapSegment */
+
+
+/**
+  @brief Returns the position of a block in the spill file.
+
+  @details The block must belong to the file.
+
+  @return the number of blocks of the file that precede the block.
+
+  @sideeffect None
+
+*/
+static size_t
+ddSpillBlockNumber(
+  DdSpill * spill,
+  DdNodePtr * block)
+{
+    char *p = (char *) block;
+    int i;
+
+    for (i = 0; i < spill->nsegments; i++) {
+	if (p >= spill->segments[i] &&
+	    p < spill->segments[i] + spill->segmentSize)
+	    break;
+    }
+    return((size_t) i * DD_SPILL_SEGMENT_BLOCKS +
+	   (size_t) (p - spill->segments[i]) / spill->blockSize);
+
+} /* end of ddSpillBlockNumber */
+
+
+/**
+  @brief Compares two nodes by address.
+
+  @details Used to sort the nodes with qsort.
+
+  @return -1, 0, or 1 as the first node precedes, is, or follows the
+  second.
+
+  @sideeffect None
+
+*/
+static int
+ddSpillAddressCompare(
+  void const * a,
+  void const * b)
+{
+    ptruint pa = (ptruint) *((DdNode * const *) a);
+    ptruint pb = (ptruint) *((DdNode * const *) b);
+
+    return(pa < pb ? -1 : pa > pb);
+
+} /* end of ddSpillAddressCompare */
+
+
+/**
+  @brief Finds the first node not below a given address.
+
+  @return the position of the first entry of the sorted array nodes
+  that is not below p; n if there is none.
+
+  @sideeffect None
+
+*/
+static int
+ddSpillLowerBound(
+  DdNodePtr * nodes,
+  int  n,
+  DdNode * p)
+{
+    int lo = 0, hi = n, mid;
+
+    while (lo < hi) {
+	mid = lo + (hi - lo) / 2;
+	if ((ptruint) nodes[mid] < (ptruint) p) {
+	    lo = mid + 1;
+	} else {
+	    hi = mid;
+	}
+    }
+    return(lo);
+
+} /* end of ddSpillLowerBound */
+
+#endif
@@ -293,6 +293,7 @@ cuddSymmSifting(
     int		result;
     int		symvars;
     int		symgroups;
+    DdReorderEvent event;
 #ifdef DD_STATS
     int		previousSize;
 #endif
@@ -320,7 +321,11 @@ cuddSymmSifting(
     }
 
     for (i = 0; i < ddMin(table->siftMaxVar,size); i++) {
-	if (table->ddTotalNumberSwapping >= table->siftMaxSwap)
+	if (table->ddTotalNumberSwapping >= table->siftMaxSwap) {
+	    table->telemetry.cutSwap += ddMin(table->siftMaxVar,size) - i;
+	    break;
+	}
+	if (cuddReorderExpired(table))
 	    break;
         if (util_cpu_time() - table->startTime > table->timeLimit) {
             table->autoDyn = 0; /* prevent further reordering */
@@ -337,8 +342,10 @@ cuddSymmSifting(
 #endif
 	if (x < lower || x > upper) continue;
 	if (table->subtables[x].next == (unsigned) x) {
+	    cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_SIFT,x);
 	    result = ddSymmSiftingAux(table,x,lower,upper);
 	    if (!result) goto ddSymmSiftingOutOfMem;
+	    cuddReorderEventEnd(table,&event);
 #ifdef DD_STATS
 	    if (table->keys < (unsigned) previousSize + table->isolated) {
 		(void) fprintf(table->out,"-");
@@ -412,6 +419,7 @@ cuddSymmSiftingConv(
     int		symgroups;
     int		classes;
     int		initialSize;
+    DdReorderEvent event;
 #ifdef DD_STATS
     int		previousSize;
 #endif
@@ -443,7 +451,11 @@ cuddSymmSiftingConv(
     }
 
     for (i = 0; i < ddMin(table->siftMaxVar, table->size); i++) {
-	if (table->ddTotalNumberSwapping >= table->siftMaxSwap)
+	if (table->ddTotalNumberSwapping >= table->siftMaxSwap) {
+	    table->telemetry.cutSwap += ddMin(table->siftMaxVar,table->size) - i;
+	    break;
+	}
+	if (cuddReorderExpired(table))
 	    break;
         if (util_cpu_time() - table->startTime > table->timeLimit) {
             table->autoDyn = 0; /* prevent further reordering */
@@ -461,8 +473,10 @@ cuddSymmSiftingConv(
 #ifdef DD_STATS
           previousSize = (int) (table->keys - table->isolated);
 #endif
+	    cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_SIFT,x);
 	    result = ddSymmSiftingAux(table,x,lower,upper);
 	    if (!result) goto ddSymmSiftingConvOutOfMem;
+	    cuddReorderEventEnd(table,&event);
 #ifdef DD_STATS
 	    if (table->keys < (unsigned) previousSize + table->isolated) {
 		(void) fprintf(table->out,"-");
@@ -501,7 +515,11 @@ cuddSymmSiftingConv(
 
 	/* Now sift. */
 	for (i = 0; i < ddMin(table->siftMaxVar,classes); i++) {
-	    if (table->ddTotalNumberSwapping >= table->siftMaxSwap)
+	    if (table->ddTotalNumberSwapping >= table->siftMaxSwap) {
+		table->telemetry.cutSwap += ddMin(table->siftMaxVar,classes) - i;
+		break;
+	    }
+	    if (cuddReorderExpired(table))
 		break;
             if (util_cpu_time() - table->startTime > table->timeLimit) {
               table->autoDyn = 0; /* prevent further reordering */
@@ -517,8 +535,10 @@ cuddSymmSiftingConv(
 #ifdef DD_STATS
               previousSize = (int) (table->keys - table->isolated);
 #endif
+		cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_SIFT,x);
 		result = ddSymmSiftingConvAux(table,x,lower,upper);
 		if (!result ) goto ddSymmSiftingConvOutOfMem;
+		cuddReorderEventEnd(table,&event);
 #ifdef DD_STATS
 		if (table->keys < (unsigned) previousSize + table->isolated) {
 		    (void) fprintf(table->out,"-");
@@ -1251,8 +1271,10 @@ ddSymmSiftingUp(
 	    move->size = size;
 	    move->next = moves;
 	    moves = move;
-	    if ((double) size > (double) limitSize * table->maxGrowth)
+	    if ((double) size > (double) limitSize * table->maxGrowth) {
+		table->telemetry.cutGrowth++;
 		return(moves);
+	    }
 	    if (size < limitSize) limitSize = size;
 	} else { /* Group move */
 	    size = ddSymmGroupMove(table,x,y,&moves);
@@ -1267,8 +1289,10 @@ ddSymmSiftingUp(
 		}
 		z = table->subtables[z].next;
 	    } while (z != (int) moves->y);
-	    if ((double) size > (double) limitSize * table->maxGrowth)
+	    if ((double) size > (double) limitSize * table->maxGrowth) {
+		table->telemetry.cutGrowth++;
 		return(moves);
+	    }
 	    if (size < limitSize) limitSize = size;
 	}
 	y = gxtop;
@@ -1382,8 +1406,10 @@ ddSymmSiftingDown(
 	    move->size = size;
 	    move->next = moves;
 	    moves = move;
-	    if ((double) size > (double) limitSize * table->maxGrowth)
+	    if ((double) size > (double) limitSize * table->maxGrowth) {
+		table->telemetry.cutGrowth++;
 		return(moves);
+	    }
 	    if (size < limitSize) limitSize = size;
 	} else { /* Group move */
 	    /* Update upper bound on node decrease: first phase. */
@@ -1399,8 +1425,10 @@ ddSymmSiftingDown(
 	    } while (z <= gybot);
 	    size = ddSymmGroupMove(table,x,y,&moves);
 	    if (size == 0) goto ddSymmSiftingDownOutOfMem;
-	    if ((double) size > (double) limitSize * table->maxGrowth)
+	    if ((double) size > (double) limitSize * table->maxGrowth) {
+		table->telemetry.cutGrowth++;
 		return(moves);
+	    }
 	    if (size < limitSize) limitSize = size;
 	    /* Update upper bound on node decrease: second phase. */
 	    gxtop = table->subtables[gybot].next;
@@ -110,8 +110,11 @@ typedef union hack {
 
 static void ddRehashZdd (DdManager *unique, int i);
 static int ddResizeTable (DdManager *unique, int index, int amount);
+static int ddGrowSubtables (DdManager *unique, int newsize);
 static int cuddFindParent (DdManager *table, DdNode *node);
 static void ddFixLimits (DdManager *unique);
+static void ddCompactVisit (DdNode *f, int *perm, DdNodePtr *order, int *cursor);
+static int ddRelieveMemoryPressure (DdManager *unique, int hard);
 #ifdef DD_RED_BLACK_FREE_LIST
 static void cuddOrderedInsert (DdNodePtr *root, DdNodePtr node);
 static DdNode * cuddOrderedThread (DdNode *root, DdNode *list);
@@ -202,6 +205,276 @@ Cudd_Reserve(
 } /* end of Cudd_Reserve */
 
 
+/**
+  @brief Moves the nodes to improve the locality of the heap.
+
+  @details After many reorderings and garbage collections, the nodes
+  of each variable are scattered over many blocks of memory.  This
+  function copies the nodes into new blocks, level by level from the
+  top, and within each level in the order in which a depth-first
+  traversal reaches them, so that the nodes that the recursive
+  procedures visit together are close to each other in memory.  The
+  unique table, the computed table, the log of the interaction matrix
+  and the state of the checkpoints are updated, and the blocks left
+  empty are released.  Dead nodes are collected first.  The entries
+  of the computed table for commutative operations whose operands
+  change order in memory are no longer found after the move.
+  <p>
+  The manager cannot update the pointers held by the application.
+  Therefore, a node referenced from outside the unique table, for
+  instance by the application or because it is a projection
+  function, stays where it is.  A pointer to a node that is only
+  referenced by its parents, like one obtained with Cudd_T or
+  Cudd_E, is not valid after compaction.  If there is not enough
+  memory for the new blocks, nothing is moved.
+
+  @return the number of nodes moved.
+
+  @sideeffect The nodes not referenced from outside the unique table
+  are moved.
+
+  @see Cudd_EnableCompaction
+
+*/
+int
+Cudd_Compact(
+  DdManager * unique)
+{
+    DdNode *sentinel = &(unique->sentinel);
+    DdNodePtr *nodes, *order, *blocks, *mem, *memlist, *next, *prev;
+    DdNode *f, *g, *list, *tail;
+    int *start, *cursor;
+    int nlevels, level, nblocks, b, i, j, k, n, moving;
+    size_t offset;
+    void *key, *id;
+    extern DD_OOMFP MMoutOfMemory;
+    DD_OOMFP saveHandler;
+
+    if (unique->dead + unique->deadZ > 0) {
+	/* The first call may only raise the threshold. */
+	(void) cuddGarbageCollect(unique,1);
+	if (unique->dead + unique->deadZ > 0)
+	    (void) cuddGarbageCollect(unique,1);
+	if (unique->dead + unique->deadZ > 0) return(0);
+    }
+
+    /* List the nodes level by level.  The ZDD levels follow the BDD
+    ** ones. */
+    nlevels = unique->size + unique->sizeZ;
+    n = 0;
+    for (i = 0; i < unique->size; i++) n += (int) unique->subtables[i].keys;
+    for (i = 0; i < unique->sizeZ; i++) n += (int) unique->subtableZ[i].keys;
+    if (n == 0) return(0);
+    saveHandler = MMoutOfMemory;
+    MMoutOfMemory = unique->outOfMemCallback;
+    nodes = ALLOC(DdNodePtr,n);
+    order = ALLOC(DdNodePtr,n);
+    start = ALLOC(int,nlevels + 1);
+    cursor = ALLOC(int,nlevels + 1);
+    MMoutOfMemory = saveHandler;
+    blocks = NULL;
+    if (nodes == NULL || order == NULL || start == NULL || cursor == NULL)
+	goto cleanup;
+    k = 0;
+    for (level = 0; level < nlevels; level++) {
+	DdSubtable *subtable = level < unique->size ?
+	    &(unique->subtables[level]) :
+	    &(unique->subtableZ[level - unique->size]);
+	start[level] = k;
+	for (j = 0; j < (int) subtable->slots; j++) {
+	    for (f = subtable->nodelist[j]; f != NULL && f != sentinel;
+		 f = f->next) {
+		nodes[k++] = f;
+	    }
+	}
+    }
+    start[nlevels] = k;
+
+    /* Subtract the references due to the parents: the nodes left with
+    ** none are those that can move. */
+    for (i = 0; i < n; i++) {
+	f = nodes[i];
+	cuddSatDec(cuddT(f)->ref);
+	cuddSatDec(Cudd_Regular(cuddE(f))->ref);
+    }
+    moving = 0;
+    for (i = 0; i < n; i++) {
+	moving += nodes[i]->ref == 0;
+    }
+
+    /* Get the new blocks. */
+    nblocks = (moving + DD_MEM_CHUNK - 1) / DD_MEM_CHUNK;
+    if (nblocks == 0 || (unique->spill == NULL &&
+	unique->memused + (unsigned long) nblocks *
+	(DD_MEM_CHUNK + 1) * sizeof(DdNode) > unique->maxmemhard)) {
+	goto restore;
+    }
+    saveHandler = MMoutOfMemory;
+    MMoutOfMemory = unique->outOfMemCallback;
+    blocks = ALLOC(DdNodePtr,nblocks);
+    if (blocks != NULL) {
+	for (b = 0; b < nblocks; b++) {
+	    blocks[b] = (DdNodePtr) cuddAllocNodeBlock(unique);
+	    if (blocks[b] == NULL) break;
+	}
+    }
+    MMoutOfMemory = saveHandler;
+    if (blocks == NULL || b < nblocks) {
+	if (blocks != NULL) {
+	    while (b > 0) cuddFreeNodeBlock(unique,(DdNodePtr *) blocks[--b]);
+	    FREE(blocks);
+	    blocks = NULL;
+	}
+	goto restore;
+    }
+
+    /* Nothing can fail from here on.  Find the new order, using the
+    ** next fields to mark the visited nodes. */
+    for (i = 0; i < n; i++) {
+	nodes[i]->next = NULL;
+    }
+    for (level = 0; level < nlevels; level++) {
+	cursor[level] = start[level];
+    }
+    for (i = 0; i < n; i++) {
+	if (i < start[unique->size]) {
+	    ddCompactVisit(nodes[i],unique->perm,order,cursor);
+	} else {
+	    ddCompactVisit(nodes[i],unique->permZ,order,
+			   cursor + unique->size);
+	}
+    }
+
+    /* Copy the nodes that can move, and leave in the next field of
+    ** each old node a pointer to its new location. */
+    b = 0;
+    k = DD_MEM_CHUNK;
+    list = NULL;
+    for (i = 0; i < n; i++) {
+	f = order[i];
+	if (f->ref != 0) {
+	    f->next = f;
+	    continue;
+	}
+	if (k == DD_MEM_CHUNK) {
+	    mem = (DdNodePtr *) blocks[b++];
+	    mem[0] = (DdNodePtr) unique->memoryList;
+	    unique->memoryList = mem;
+	    offset = (size_t) mem & (sizeof(DdNode) - 1);
+	    mem += (sizeof(DdNode) - offset) / sizeof(DdNodePtr);
+	    list = (DdNode *) mem;
+	    for (k = 0; k < DD_MEM_CHUNK; k++) list[k].ref = 0;
+	    k = 0;
+	}
+	g = &list[k++];
+	*g = *f;
+	f->next = g;
+	if (unique->checkpoint != NULL) {
+	    key = f;
+	    if (st_delete(unique->checkpoint->ids, &key, &id))
+		(void) st_insert(unique->checkpoint->ids, g, id);
+	}
+    }
+
+    /* Redirect the arcs and restore the reference counts. */
+    for (i = 0; i < n; i++) {
+	g = order[i]->next;
+	f = cuddT(g);
+	if (!cuddIsConstant(f)) cuddT(g) = f->next;
+	f = Cudd_Regular(cuddE(g));
+	if (!cuddIsConstant(f))
+	    cuddE(g) = Cudd_NotCond(f->next,Cudd_IsComplement(cuddE(g)));
+    }
+    for (i = 0; i < n; i++) {
+	g = order[i]->next;
+	cuddSatInc(cuddT(g)->ref);
+	cuddSatInc(Cudd_Regular(cuddE(g))->ref);
+    }
+    cuddCacheRelocate(unique,unique);
+    cuddLocalCacheClearAll(unique);
+    /* The nodes of the ZDD universe below the top are only referenced
+    ** by their parents. */
+    for (i = 0; i < unique->size; i++) {
+	unique->vars[i] = unique->vars[i]->next;
+    }
+    for (i = 0; i < unique->sizeZ; i++) {
+	unique->univ[i] = unique->univ[i]->next;
+    }
+    for (i = 0; (size_t) i < unique->interact.logSize; i++) {
+	unique->interact.log[i] = unique->interact.log[i]->next;
+    }
+
+    /* Rebuild the collision lists. */
+    for (i = 0; i < unique->size; i++) {
+	for (j = 0; j < (int) unique->subtables[i].slots; j++)
+	    unique->subtables[i].nodelist[j] = sentinel;
+    }
+    for (i = 0; i < unique->sizeZ; i++) {
+	for (j = 0; j < (int) unique->subtableZ[i].slots; j++)
+	    unique->subtableZ[i].nodelist[j] = NULL;
+    }
+    for (i = n - 1; i >= 0; i--) {
+	cuddLinkNode(unique,order[i]->next,i >= start[unique->size]);
+    }
+
+    /* Release the blocks left empty, and thread the free nodes of the
+    ** others in address order. */
+    prev = NULL;
+    tail = NULL;
+    unique->nextFree = NULL;
+    for (memlist = unique->memoryList; memlist != NULL; memlist = next) {
+	next = (DdNodePtr *) memlist[0];
+	offset = (size_t) memlist & (sizeof(DdNode) - 1);
+	list = (DdNode *) (memlist + (sizeof(DdNode) - offset) /
+			   sizeof(DdNodePtr));
+	for (k = 0; k < DD_MEM_CHUNK; k++) {
+	    if (list[k].ref != 0) break;
+	}
+	if (k == DD_MEM_CHUNK) {
+	    if (prev == NULL) {
+		unique->memoryList = next;
+	    } else {
+		prev[0] = (DdNodePtr) next;
+	    }
+	    cuddFreeNodeBlock(unique,memlist);
+	    continue;
+	}
+	for (k = 0; k < DD_MEM_CHUNK; k++) {
+	    if (list[k].ref != 0) continue;
+	    if (tail == NULL) {
+		unique->nextFree = &list[k];
+	    } else {
+		tail->next = &list[k];
+	    }
+	    tail = &list[k];
+	}
+	prev = memlist;
+    }
+    if (tail != NULL) tail->next = NULL;
+    FREE(blocks);
+    FREE(nodes);
+    FREE(order);
+    FREE(start);
+    FREE(cursor);
+
+    return(moving);
+
+restore:
+    for (i = 0; i < n; i++) {
+	f = nodes[i];
+	cuddSatInc(cuddT(f)->ref);
+	cuddSatInc(Cudd_Regular(cuddE(f))->ref);
+    }
+cleanup:
+    if (nodes != NULL) FREE(nodes);
+    if (order != NULL) FREE(order);
+    if (start != NULL) FREE(start);
+    if (cursor != NULL) FREE(cursor);
+    return(0);
+
+} /* end of Cudd_Compact */
+
+
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -251,15 +524,23 @@ cuddAllocNode(
 	    (void) cuddGarbageCollect(unique,1);
 	    mem = NULL;
 	}
+	if (unique->nextFree == NULL && unique->memused > unique->maxmem &&
+	    unique->memused >= unique->pressureMark) {
+	    /* Past the target: try to make room before growing, but
+	    ** not again until memory has grown by another 1/16. */
+	    (void) ddRelieveMemoryPressure(unique,0);
+	    unique->pressureMark = unique->memused + unique->memused / 16;
+	}
+	if (unique->nextFree == NULL && unique->memused > unique->maxmemhard &&
+	    !ddRelieveMemoryPressure(unique,1) && unique->nextFree == NULL) {
+	    unique->errorCode = CUDD_MAX_MEM_EXCEEDED;
+	    return(NULL);
+	}
 	if (unique->nextFree == NULL) {
-	    if (unique->memused > unique->maxmemhard) {
-		unique->errorCode = CUDD_MAX_MEM_EXCEEDED;
-		return(NULL);
-	    }
 	    /* Try to allocate a new block. */
 	    saveHandler = MMoutOfMemory;
 	    MMoutOfMemory = unique->outOfMemCallback;
-	    mem = (DdNodePtr *) ALLOC(DdNode,DD_MEM_CHUNK + 1);
+	    mem = cuddAllocNodeBlock(unique);
 	    MMoutOfMemory = saveHandler;
 	    if (mem == NULL) {
 		/* No more memory: Try collecting garbage. If this succeeds,
@@ -275,7 +556,7 @@ cuddAllocNode(
 			/* Inhibit resizing of tables. */
 			cuddSlowTableGrowth(unique);
 			/* Now try again. */
-			mem = (DdNodePtr *) ALLOC(DdNode,DD_MEM_CHUNK + 1);
+			mem = cuddAllocNodeBlock(unique);
 		    }
 		    if (mem == NULL) {
 			/* Out of luck. Call the default handler to do
@@ -296,7 +577,6 @@ cuddAllocNode(
 	    }
 	    if (mem != NULL) {	/* successful allocation; slice memory */
 		ptruint offset;
-		unique->memused += (DD_MEM_CHUNK + 1) * sizeof(DdNode);
 		mem[0] = (DdNodePtr) unique->memoryList;
 		unique->memoryList = mem;
 
@@ -328,6 +608,51 @@ cuddAllocNode(
 } /* end of cuddAllocNode */
 
 
+/**
+  @brief Links a node into the collision list of its subtable.
+
+  @details The lists of the BDD subtables are kept sorted as
+  cuddUniqueInter does; a %ZDD node is added at the front of its list.
+  Used to rebuild the lists after the nodes have been moved; the
+  counts of the subtable are not changed.
+
+  @sideeffect None
+
+  @see Cudd_Compact Cudd_CloneManager
+
+*/
+void
+cuddLinkNode(
+  DdManager * unique,
+  DdNode * f,
+  int  zdd)
+{
+    DdSubtable *subtable;
+    DdNodePtr *previousP;
+    DdNode *T = cuddT(f);
+    DdNode *E = cuddE(f);
+
+    if (zdd) {
+	subtable = &(unique->subtableZ[unique->permZ[f->index]]);
+	previousP = &(subtable->nodelist[ddHash(T, E, subtable->shift)]);
+	f->next = *previousP;
+	*previousP = f;
+	return;
+    }
+    subtable = &(unique->subtables[unique->perm[f->index]]);
+    previousP = &(subtable->nodelist[ddHash(T, E, subtable->shift)]);
+    while (T < cuddT(*previousP)) {
+	previousP = &((*previousP)->next);
+    }
+    while (T == cuddT(*previousP) && E < cuddE(*previousP)) {
+	previousP = &((*previousP)->next);
+    }
+    f->next = *previousP;
+    *previousP = f;
+
+} /* end of cuddLinkNode */
+
+
 /**
   @brief Creates and initializes the unique table.
 
@@ -567,6 +892,8 @@ cuddInitTable(
 
     unique->memoryList = NULL;
     unique->nextFree = NULL;
+    unique->nodeBlocks = 0;
+    unique->peakNodeBlocks = 0;
 
     unique->memused = sizeof(DdManager) + (unique->maxSize + unique->maxSizeZ)
 	* (sizeof(DdSubtable) + 2 * sizeof(int)) + (numVars + 1) *
@@ -582,6 +909,21 @@ cuddInitTable(
     unique->maxReorderings = ~0;
     unique->siftMaxVar = DD_SIFT_MAX_VAR;
     unique->siftMaxSwap = DD_SIFT_MAX_SWAPS;
+    unique->siftTight = 0;
+    unique->siftWindow = DD_SIFT_WINDOW;
+    unique->reordKeys = NULL;
+    unique->reordKeysSize = 0;
+    unique->autoCompact = 0;
+    unique->reordDeadline = 0;	/* no budget */
+    unique->reordMaxSwaps = 0;
+    unique->reordStart = 0;
+    unique->reordInterrupted = 0;
+    unique->siftedVars = 0;
+    unique->siftPending = NULL;
+    unique->siftNPending = 0;
+    unique->siftSkipped = NULL;
+    unique->siftNSkipped = 0;
+    unique->siftRan = 0;
     unique->maxGrowth = DD_MAX_REORDER_GROWTH;
     unique->maxGrowthAlt = 2.0 * DD_MAX_REORDER_GROWTH;
     unique->reordCycle = 0;	/* do not use alternate threshold */
@@ -595,22 +937,42 @@ cuddInitTable(
     unique->countDead = ~0;
     unique->tree = NULL;
     unique->treeZ = NULL;
+    unique->checkpoint = NULL;
+    unique->spill = NULL;
     unique->groupcheck = CUDD_GROUP_CHECK7;
     unique->recomb = DD_DEFAULT_RECOMB;
     unique->symmviolation = 0;
     unique->arcviolation = 0;
     unique->populationSize = 0;
     unique->numberXovers = 0;
+    unique->reordThreads = 1;
     unique->randomizeOrder = 0;
+    unique->reordTrigger = NULL;
+    unique->rtArg = NULL;
+    unique->reordPayoff = 1.0;	/* optimistic until proved otherwise */
+    unique->reordCost = 0.0;
+    unique->reordEnd = util_cpu_time();
+    unique->trigHitRate = -1.0;	/* no previous window */
+    unique->trigThroughput = 0.0;
+    unique->trigGrowth = 0.0;
     unique->linear = NULL;
     unique->originalSize = 0;
     unique->linearSize = 0;
+    memset(&(unique->interact), 0, sizeof(DdInteract));
+    unique->preserveCache = 0;
+    unique->cacheFilter = NULL;
+    unique->cacheFilterShift = 0;
+    unique->cacheLimbo = NULL;
+    memset(&(unique->telemetry), 0, sizeof(DdReorderTelemetry));
 
     /* Initialize ZDD universe. */
     unique->univ = (DdNodePtr *)NULL;
 
     /* Initialize auxiliary fields. */
     unique->localCaches = NULL;
+    unique->hashMemused = 0;
+    unique->stash = NULL;
+    unique->stashSize = 0;
     unique->preGCHook = NULL;
     unique->postGCHook = NULL;
     unique->preReorderingHook = NULL;
@@ -624,9 +986,14 @@ cuddInitTable(
     unique->tcbArg = NULL;
     unique->outOfMemCallback = Cudd_OutOfMem;
     unique->timeoutHandler = NULL;
+    unique->pressureHandler = NULL;
+    unique->mphArg = NULL;
+    unique->pressureMark = 0;
 
     /* Initialize statistical counters. */
     unique->maxmemhard = ~ (size_t) 0;
+    unique->releaseFrac = 0.0;
+    unique->releasedBlocks = 0;
     unique->garbageCollections = 0;
     unique->GCTime = 0;
     unique->reordTime = 0;
@@ -676,9 +1043,10 @@ cuddFreeTable(
     if (unique->univ != NULL) cuddZddFreeUniv(unique);
     while (memlist != NULL) {
 	next = (DdNodePtr *) memlist[0];	/* link to next block */
-	FREE(memlist);
+	cuddFreeNodeBlock(unique,memlist);
 	memlist = next;
     }
+    cuddFreeSpill(unique);
     unique->nextFree = NULL;
     unique->memoryList = NULL;
 
@@ -692,6 +1060,7 @@ cuddFreeTable(
     FREE(unique->subtables);
     FREE(unique->subtableZ);
     FREE(unique->acache);
+    if (unique->cacheFilter != NULL) FREE(unique->cacheFilter);
     FREE(unique->perm);
     FREE(unique->permZ);
     FREE(unique->invperm);
@@ -704,7 +1073,12 @@ cuddFreeTable(
 #endif
     if (unique->tree != NULL) Mtr_FreeTree(unique->tree);
     if (unique->treeZ != NULL) Mtr_FreeTree(unique->treeZ);
+    cuddFreeCheckpoint(unique);
+    if (unique->siftPending != NULL) FREE(unique->siftPending);
+    if (unique->siftSkipped != NULL) FREE(unique->siftSkipped);
+    if (unique->reordKeys != NULL) FREE(unique->reordKeys);
     if (unique->linear != NULL) FREE(unique->linear);
+    cuddFreeInteract(unique);
     while (unique->preGCHook != NULL)
 	Cudd_RemoveHook(unique,unique->preGCHook->f,CUDD_PRE_GC_HOOK);
     while (unique->postGCHook != NULL)
@@ -726,6 +1100,10 @@ cuddFreeTable(
   @details If clearCache is 0, the cache is not cleared. This should
   only be specified if the cache has been cleared right before calling
   cuddGarbageCollect. (As in the case of dynamic reordering.)
+  When a release threshold has been set with
+  Cudd_SetMemoryReleaseThreshold and the cache is cleared, the node
+  blocks left without live nodes are freed as long as the occupancy of
+  the remaining blocks stays at or above the threshold.
 
   @return the total number of deleted nodes.
 
@@ -738,11 +1116,9 @@ cuddGarbageCollect(
   int clearCache)
 {
     DdHook	*hook;
-    DdCache	*cache = unique->cache;
     DdNode	*sentinel = &(unique->sentinel);
     DdNodePtr	*nodelist;
     int		i, j, deleted, totalDeleted, totalDeletedZ;
-    DdCache	*c;
     DdNode	*node,*next;
     DdNodePtr	*lastP;
     int		slots;
@@ -751,9 +1127,10 @@ cuddGarbageCollect(
 #ifdef DD_RED_BLACK_FREE_LIST
     DdNodePtr	tree;
 #else
-    DdNodePtr *memListTrav, *nxtNode;
-    DdNode *downTrav, *sentry;
-    int k;
+    DdNodePtr *memListTrav, *nxtNode, *prevBlock;
+    DdNode *downTrav, *sentry, *chunkStart;
+    int k, nfree;
+    double excess;
 #endif
 #endif
 
@@ -811,23 +1188,14 @@ cuddGarbageCollect(
 
     /* Remove references to garbage collected nodes from the cache. */
     if (clearCache) {
-	slots = unique->cacheSlots;
-	for (i = 0; i < slots; i++) {
-	    c = &cache[i];
-	    if (c->data != NULL) {
-		if (cuddClean(c->f)->ref == 0 ||
-		cuddClean(c->g)->ref == 0 ||
-		(((ptruint)c->f & 0x2) && Cudd_Regular(c->h)->ref == 0) ||
-		(c->data != DD_NON_CONSTANT &&
-		Cudd_Regular(c->data)->ref == 0)) {
-		    c->data = NULL;
-		    unique->cachedeletions++;
-		}
-	    }
-	}
+	cuddCacheClearDead(unique);
 	cuddLocalCacheClearDead(unique);
     }
 
+    /* The dead nodes must not outlive their entries in the log of the
+    ** interaction matrix. */
+    cuddPruneInteract(unique);
+
     /* Now return dead nodes to free list. Count them for sanity check. */
     totalDeleted = 0;
 #ifndef DD_UNSORTED_FREE_LIST
@@ -968,17 +1336,36 @@ cuddGarbageCollect(
 #ifdef DD_RED_BLACK_FREE_LIST
     unique->nextFree = cuddOrderedThread(tree,unique->nextFree);
 #else
+    /* Number of free slots that may be released with their blocks
+    ** while keeping the occupancy of the node memory at or above the
+    ** release threshold.  Nothing may be released while the cache or
+    ** the nodes in limbo may still point to freed nodes. */
+    excess = 0.0;
+    if (clearCache && unique->releaseFrac > 0.0 &&
+	unique->cacheFilter == NULL) {
+	excess = - (double) (unique->keys + unique->keysZ) /
+	    unique->releaseFrac;
+	for (memListTrav = unique->memoryList; memListTrav != NULL;
+	     memListTrav = (DdNodePtr *) memListTrav[0]) {
+	    excess += (double) DD_MEM_CHUNK;
+	}
+    }
     memListTrav = unique->memoryList;
-    sentry = NULL;
+    prevBlock = NULL;
+    unique->nextFree = sentry = NULL;
     while (memListTrav != NULL) {
 	ptruint offset;
+	DdNodePtr *block = memListTrav;
 	nxtNode = (DdNodePtr *)memListTrav[0];
 	offset = (ptruint) memListTrav & (sizeof(DdNode) - 1);
 	memListTrav += (sizeof(DdNode) - offset) / sizeof(DdNodePtr);
 	downTrav = (DdNode *)memListTrav;
+	chunkStart = sentry;
+	nfree = 0;
 	k = 0;
 	do {
 	    if (downTrav[k].ref == 0) {
+		nfree++;
 		if (sentry == NULL) {
 		    unique->nextFree = sentry = &downTrav[k];
 		} else {
@@ -988,9 +1375,24 @@ cuddGarbageCollect(
 		}
 	    }
 	} while (++k < DD_MEM_CHUNK);
+	if (nfree == DD_MEM_CHUNK && excess >= (double) DD_MEM_CHUNK) {
+	    /* Unthread the block and give it back. */
+	    sentry = chunkStart;
+	    if (sentry == NULL) unique->nextFree = NULL;
+	    if (prevBlock == NULL) {
+		unique->memoryList = nxtNode;
+	    } else {
+		prevBlock[0] = (DdNodePtr) nxtNode;
+	    }
+	    cuddFreeNodeBlock(unique,block);
+	    unique->releasedBlocks++;
+	    excess -= (double) DD_MEM_CHUNK;
+	} else {
+	    prevBlock = block;
+	}
 	memListTrav = nxtNode;
     }
-    sentry->next = NULL;
+    if (sentry != NULL) sentry->next = NULL;
 #endif
 #endif
 
@@ -1187,7 +1589,7 @@ cuddUniqueInter(
     /* countDead is 0 if deads should be counted and ~0 if they should not. */
     if (unique->autoDyn &&
         unique->keys - (unique->dead & unique->countDead) >= unique->nextDyn &&
-        unique->maxReorderings > 0) {
+        unique->maxReorderings > 0 && cuddReorderTrigger(unique)) {
         unsigned long cpuTime;
 #ifdef DD_DEBUG
 	retval = Cudd_DebugCheck(unique);
@@ -1303,6 +1705,7 @@ cuddUniqueInter(
     *previousP = looking;
     cuddSatInc(T->ref);		/* we know T is a regular pointer */
     cuddRef(E);
+    if (unique->interact.logging) cuddLogInteract(unique,looking);
 
 #ifdef DD_DEBUG
     cuddCheckCollisionOrdering(unique,level,pos);
@@ -1752,6 +2155,44 @@ cuddRehash(
 } /* end of cuddRehash */
 
 
+/**
+  @brief Grows a subtable in anticipation of a bulk insertion.
+
+  @details Doubles the number of slots of the subtable at level i
+  until it can accommodate <code>amount</code> additional nodes
+  without exceeding DD_MAX_SUBTABLE_DENSITY.  This lets callers that
+  know in advance how many nodes they are going to create at a level
+  (e.g., loaders of stored diagrams) avoid the repeated rehashing that
+  would otherwise be triggered by cuddUniqueInter.  Growth stops
+  early if cuddRehash declines to enlarge the table because of memory
+  limits.
+
+  @return the number of slots of the subtable after growing.
+
+  @sideeffect None
+
+  @see cuddRehash Cudd_Reserve
+
+*/
+unsigned int
+cuddReserveSubtable(
+  DdManager * unique,
+  int i,
+  unsigned int amount)
+{
+    DdSubtable *subtable = &(unique->subtables[i]);
+    unsigned int oldslots;
+
+    while (subtable->keys + amount > subtable->maxKeys) {
+	oldslots = subtable->slots;
+	cuddRehash(unique, i);
+	if (subtable->slots == oldslots) break;
+    }
+    return(subtable->slots);
+
+} /* end of cuddReserveSubtable */
+
+
 /**
   @brief Shrinks a subtable.
 
@@ -1844,13 +2285,17 @@ cuddShrinkSubtable(
   @brief Inserts n new subtables in a unique table at level.
 
   @details The number n should be positive, and level should be an
-  existing level.
+  existing level.  The subtable array grows geometrically, so that a
+  sequence of insertions takes amortized constant time for the
+  allocation.  The levels at and below the insertion point are moved
+  in one pass regardless of n; hence inserting many variables in a
+  single call is much cheaper than inserting them one at a time.
 
   @return 1 if successful; 0 otherwise.
 
   @sideeffect None
 
-  @see cuddDestroySubtables
+  @see cuddDestroySubtables Cudd_bddNewVarsAtLevel
 
 */
 int
@@ -1859,14 +2304,13 @@ cuddInsertSubtables(
   int  n,
   int  level)
 {
-    DdSubtable *newsubtables;
+    DdSubtable *subtables;
+    DdNodePtr **newnodelists;
     DdNodePtr *newnodelist;
-    DdNodePtr *newvars;
     DdNode *sentinel = &(unique->sentinel);
     int oldsize,newsize;
     int i,j,index,reorderSave;
     unsigned int numSlots = unique->initSlots;
-    int *newperm, *newinvperm, *newmap = NULL;
     DdNode *one, *zero;
 
 #ifdef DD_DEBUG
@@ -1874,219 +2318,73 @@ cuddInsertSubtables(
 #endif
 
     oldsize = unique->size;
-    /* Easy case: there is still room in the current table. */
-    if (oldsize + n <= unique->maxSize) {
-	/* Shift the tables at and below level. */
-	for (i = oldsize - 1; i >= level; i--) {
-	    unique->subtables[i+n].slots    = unique->subtables[i].slots;
-	    unique->subtables[i+n].shift    = unique->subtables[i].shift;
-	    unique->subtables[i+n].keys     = unique->subtables[i].keys;
-	    unique->subtables[i+n].maxKeys  = unique->subtables[i].maxKeys;
-	    unique->subtables[i+n].dead     = unique->subtables[i].dead;
-            unique->subtables[i+n].next     = i+n;
-	    unique->subtables[i+n].nodelist = unique->subtables[i].nodelist;
-	    unique->subtables[i+n].bindVar  = unique->subtables[i].bindVar;
-	    unique->subtables[i+n].varType  = unique->subtables[i].varType;
-	    unique->subtables[i+n].pairIndex  = unique->subtables[i].pairIndex;
-	    unique->subtables[i+n].varHandled = unique->subtables[i].varHandled;
-	    unique->subtables[i+n].varToBeGrouped =
-		unique->subtables[i].varToBeGrouped;
-
-	    index                           = unique->invperm[i];
-	    unique->invperm[i+n]            = index;
-	    unique->perm[index]            += n;
-	}
-	/* Create new subtables. */
-	for (i = 0; i < n; i++) {
-	    unique->subtables[level+i].slots = numSlots;
-	    unique->subtables[level+i].shift = sizeof(int) * 8 -
-		cuddComputeFloorLog2(numSlots);
-	    unique->subtables[level+i].keys = 0;
-	    unique->subtables[level+i].maxKeys = numSlots * DD_MAX_SUBTABLE_DENSITY;
-	    unique->subtables[level+i].dead = 0;
-            unique->subtables[level+i].next = level+i;
-	    unique->subtables[level+i].bindVar = 0;
-	    unique->subtables[level+i].varType = CUDD_VAR_PRIMARY_INPUT;
-	    unique->subtables[level+i].pairIndex = 0;
-	    unique->subtables[level+i].varHandled = 0;
-	    unique->subtables[level+i].varToBeGrouped = CUDD_LAZY_NONE;
-
-	    unique->perm[oldsize+i] = level + i;
-	    unique->invperm[level+i] = oldsize + i;
-	    newnodelist = unique->subtables[level+i].nodelist =
-		ALLOC(DdNodePtr, numSlots);
-	    if (newnodelist == NULL) {
-		unique->errorCode = CUDD_MEMORY_OUT;
-		return(0);
-	    }
-	    for (j = 0; (unsigned) j < numSlots; j++) {
-		newnodelist[j] = sentinel;
-	    }
-	}
-	if (unique->map != NULL) {
-	    for (i = 0; i < n; i++) {
-		unique->map[oldsize+i] = oldsize + i;
+    if (oldsize + n > unique->maxSize) {
+	/* The current table is too small: double its capacity, so that
+	** repeated insertions do not copy the arrays every time. */
+	newsize = ddMax(oldsize + n + DD_DEFAULT_RESIZE,
+			2 * unique->maxSize);
+	if (!ddGrowSubtables(unique,newsize)) return(0);
+    }
+
+    /* Allocate the hash tables of the new subtables before touching
+    ** the existing ones, so that failure leaves the table unchanged. */
+    newnodelists = ALLOC(DdNodePtr *, n);
+    if (newnodelists == NULL) {
+	unique->errorCode = CUDD_MEMORY_OUT;
+	return(0);
+    }
+    for (i = 0; i < n; i++) {
+	newnodelist = newnodelists[i] = ALLOC(DdNodePtr, numSlots);
+	if (newnodelist == NULL) {
+	    for (j = 0; j < i; j++) {
+		FREE(newnodelists[j]);
 	    }
-	}
-    } else {
-	/* The current table is too small: we need to allocate a new,
-	** larger one; move all old subtables, and initialize the new
-	** subtables.
-	*/
-	newsize = oldsize + n + DD_DEFAULT_RESIZE;
-#ifdef DD_VERBOSE
-	(void) fprintf(unique->err,
-		       "Increasing the table size from %d to %d\n",
-	    unique->maxSize, newsize);
-#endif
-	/* Allocate memory for new arrays (except nodelists). */
-	newsubtables = ALLOC(DdSubtable,newsize);
-	if (newsubtables == NULL) {
+	    FREE(newnodelists);
 	    unique->errorCode = CUDD_MEMORY_OUT;
 	    return(0);
 	}
-	newvars = ALLOC(DdNodePtr,newsize);
-	if (newvars == NULL) {
-	    unique->errorCode = CUDD_MEMORY_OUT;
-	    FREE(newsubtables);
-	    return(0);
-	}
-	newperm = ALLOC(int,newsize);
-	if (newperm == NULL) {
-	    unique->errorCode = CUDD_MEMORY_OUT;
-	    FREE(newsubtables);
-	    FREE(newvars);
-	    return(0);
-	}
-	newinvperm = ALLOC(int,newsize);
-	if (newinvperm == NULL) {
-	    unique->errorCode = CUDD_MEMORY_OUT;
-	    FREE(newsubtables);
-	    FREE(newvars);
-	    FREE(newperm);
-	    return(0);
+	for (j = 0; (unsigned) j < numSlots; j++) {
+	    newnodelist[j] = sentinel;
 	}
-	if (unique->map != NULL) {
-	    newmap = ALLOC(int,newsize);
-	    if (newmap == NULL) {
-		unique->errorCode = CUDD_MEMORY_OUT;
-		FREE(newsubtables);
-		FREE(newvars);
-		FREE(newperm);
-		FREE(newinvperm);
-		return(0);
-	    }
-	    unique->memused += (newsize - unique->maxSize) * sizeof(int);
-	}
-	unique->memused += (newsize - unique->maxSize) * ((numSlots+1) *
-	    sizeof(DdNode *) + 2 * sizeof(int) + sizeof(DdSubtable));
-	/* Copy levels before insertion points from old tables. */
-	for (i = 0; i < level; i++) {
-	    newsubtables[i].slots = unique->subtables[i].slots;
-	    newsubtables[i].shift = unique->subtables[i].shift;
-	    newsubtables[i].keys = unique->subtables[i].keys;
-	    newsubtables[i].maxKeys = unique->subtables[i].maxKeys;
-	    newsubtables[i].dead = unique->subtables[i].dead;
-            newsubtables[i].next = i;
-	    newsubtables[i].nodelist = unique->subtables[i].nodelist;
-	    newsubtables[i].bindVar = unique->subtables[i].bindVar;
-	    newsubtables[i].varType = unique->subtables[i].varType;
-	    newsubtables[i].pairIndex = unique->subtables[i].pairIndex;
-	    newsubtables[i].varHandled = unique->subtables[i].varHandled;
-	    newsubtables[i].varToBeGrouped = unique->subtables[i].varToBeGrouped;
-
-	    newvars[i] = unique->vars[i];
-	    newperm[i] = unique->perm[i];
-	    newinvperm[i] = unique->invperm[i];
-	}
-	/* Finish initializing permutation for new table to old one. */
-	for (i = level; i < oldsize; i++) {
-	    newperm[i] = unique->perm[i];
-	}
-	/* Initialize new levels. */
-	for (i = level; i < level + n; i++) {
-	    newsubtables[i].slots = numSlots;
-	    newsubtables[i].shift = sizeof(int) * 8 -
-		cuddComputeFloorLog2(numSlots);
-	    newsubtables[i].keys = 0;
-	    newsubtables[i].maxKeys = numSlots * DD_MAX_SUBTABLE_DENSITY;
-	    newsubtables[i].dead = 0;
-            newsubtables[i].next = i;
-	    newsubtables[i].bindVar = 0;
-	    newsubtables[i].varType = CUDD_VAR_PRIMARY_INPUT;
-	    newsubtables[i].pairIndex = 0;
-	    newsubtables[i].varHandled = 0;
-	    newsubtables[i].varToBeGrouped = CUDD_LAZY_NONE;
+    }
 
-	    newperm[oldsize + i - level] = i;
-	    newinvperm[i] = oldsize + i - level;
-	    newnodelist = newsubtables[i].nodelist = ALLOC(DdNodePtr, numSlots);
-	    if (newnodelist == NULL) {
-		/* We are going to leak some memory.  We should clean up. */
-		unique->errorCode = CUDD_MEMORY_OUT;
-		return(0);
-	    }
-	    for (j = 0; (unsigned) j < numSlots; j++) {
-		newnodelist[j] = sentinel;
-	    }
-	}
-	/* Copy the old tables for levels past the insertion point. */
-	for (i = level; i < oldsize; i++) {
-	    newsubtables[i+n].slots    = unique->subtables[i].slots;
-	    newsubtables[i+n].shift    = unique->subtables[i].shift;
-	    newsubtables[i+n].keys     = unique->subtables[i].keys;
-	    newsubtables[i+n].maxKeys  = unique->subtables[i].maxKeys;
-	    newsubtables[i+n].dead     = unique->subtables[i].dead;
-            newsubtables[i+n].next     = i+n;
-	    newsubtables[i+n].nodelist = unique->subtables[i].nodelist;
-	    newsubtables[i+n].bindVar  = unique->subtables[i].bindVar;
-	    newsubtables[i+n].varType  = unique->subtables[i].varType;
-	    newsubtables[i+n].pairIndex  = unique->subtables[i].pairIndex;
-	    newsubtables[i+n].varHandled  = unique->subtables[i].varHandled;
-	    newsubtables[i+n].varToBeGrouped  =
-		unique->subtables[i].varToBeGrouped;
-
-	    newvars[i]                 = unique->vars[i];
-	    index                      = unique->invperm[i];
-	    newinvperm[i+n]            = index;
-	    newperm[index]            += n;
-	}
-	/* Update the map. */
-	if (unique->map != NULL) {
-	    for (i = 0; i < oldsize; i++) {
-		newmap[i] = unique->map[i];
-	    }
-	    for (i = oldsize; i < oldsize + n; i++) {
-		newmap[i] = i;
-	    }
-	    FREE(unique->map);
-	    unique->map = newmap;
-	}
-	/* Install the new tables and free the old ones. */
-	FREE(unique->subtables);
-	unique->subtables = newsubtables;
-	unique->maxSize = newsize;
-	FREE(unique->vars);
-	unique->vars = newvars;
-	FREE(unique->perm);
-	unique->perm = newperm;
-	FREE(unique->invperm);
-	unique->invperm = newinvperm;
-	/* Update the stack for iterative procedures. */
-	if (newsize > unique->maxSizeZ) {
-	    FREE(unique->stack);
-	    unique->stack = ALLOC(DdNodePtr,newsize + 1);
-	    if (unique->stack == NULL) {
-		unique->errorCode = CUDD_MEMORY_OUT;
-		return(0);
-	    }
-	    unique->stack[0] = NULL; /* to suppress harmless UMR */
-	    unique->memused +=
-		(newsize - ddMax(unique->maxSize,unique->maxSizeZ))
-		* sizeof(DdNode *);
+    /* Shift the tables at and below level. */
+    subtables = unique->subtables;
+    for (i = oldsize - 1; i >= level; i--) {
+	subtables[i+n] = subtables[i];
+	subtables[i+n].next = i+n;
+	index = unique->invperm[i];
+	unique->invperm[i+n] = index;
+	unique->perm[index] = i+n;
+    }
+    /* Create new subtables. */
+    for (i = 0; i < n; i++) {
+	subtables[level+i].slots = numSlots;
+	subtables[level+i].shift = sizeof(int) * 8 -
+	    cuddComputeFloorLog2(numSlots);
+	subtables[level+i].keys = 0;
+	subtables[level+i].maxKeys = numSlots * DD_MAX_SUBTABLE_DENSITY;
+	subtables[level+i].dead = 0;
+	subtables[level+i].next = level+i;
+	subtables[level+i].nodelist = newnodelists[i];
+	subtables[level+i].bindVar = 0;
+	subtables[level+i].varType = CUDD_VAR_PRIMARY_INPUT;
+	subtables[level+i].pairIndex = 0;
+	subtables[level+i].varHandled = 0;
+	subtables[level+i].varToBeGrouped = CUDD_LAZY_NONE;
+
+	unique->perm[oldsize+i] = level + i;
+	unique->invperm[level+i] = oldsize + i;
+    }
+    FREE(newnodelists);
+    if (unique->map != NULL) {
+	for (i = 0; i < n; i++) {
+	    unique->map[oldsize+i] = oldsize + i;
 	}
     }
+
     /* Update manager parameters to account for the new subtables. */
+    unique->memused += (size_t) n * numSlots * sizeof(DdNodePtr);
     unique->slots += n * numSlots;
     ddFixLimits(unique);
     unique->size += n;
@@ -2107,37 +2405,24 @@ cuddInsertSubtables(
 	    /* Shift everything back so table remains coherent. */
 	    for (j = oldsize; j < i; j++) {
 		Cudd_IterDerefBdd(unique,unique->vars[j]);
+		subtables[unique->perm[j]].dead--;
+		unique->dead--;
+		unique->keys--;
 		cuddDeallocNode(unique,unique->vars[j]);
 		unique->vars[j] = NULL;
 	    }
+	    for (j = level; j < level + n; j++) {
+		FREE(subtables[j].nodelist);
+	    }
 	    for (j = level; j < oldsize; j++) {
-		unique->subtables[j].slots    = unique->subtables[j+n].slots;
-		unique->subtables[j].slots    = unique->subtables[j+n].slots;
-		unique->subtables[j].shift    = unique->subtables[j+n].shift;
-		unique->subtables[j].keys     = unique->subtables[j+n].keys;
-		unique->subtables[j].maxKeys  =
-		    unique->subtables[j+n].maxKeys;
-		unique->subtables[j].dead     = unique->subtables[j+n].dead;
-                unique->subtables[j].next     = j;
-		FREE(unique->subtables[j].nodelist);
-		unique->subtables[j].nodelist =
-		    unique->subtables[j+n].nodelist;
-		unique->subtables[j+n].nodelist = NULL;
-		unique->subtables[j].bindVar  =
-		    unique->subtables[j+n].bindVar;
-		unique->subtables[j].varType  =
-		    unique->subtables[j+n].varType;
-		unique->subtables[j].pairIndex =
-		    unique->subtables[j+n].pairIndex;
-		unique->subtables[j].varHandled =
-		    unique->subtables[j+n].varHandled;
-		unique->subtables[j].varToBeGrouped =
-		    unique->subtables[j+n].varToBeGrouped;
-		index                         = unique->invperm[j+n];
-		unique->invperm[j]            = index;
-		unique->perm[index]          -= n;
+		subtables[j] = subtables[j+n];
+		subtables[j].next = j;
+		index = unique->invperm[j+n];
+		unique->invperm[j] = index;
+		unique->perm[index] = j;
 	    }
 	    unique->size = oldsize;
+	    unique->memused -= (size_t) n * numSlots * sizeof(DdNodePtr);
 	    unique->slots -= n * numSlots;
 	    ddFixLimits(unique);
 	    (void) Cudd_DebugCheck(unique);
@@ -2818,6 +3103,97 @@ ddResizeTable(
 } /* end of ddResizeTable */
 
 
+/**
+  @brief Enlarges the arrays indexed by %BDD variables.
+
+  @details Reallocates the subtable array, the projection functions,
+  the permutations and the variable map so that they can hold newsize
+  variables.  No new variables are created.  The hash tables of the
+  subtables are not allocated here; hence the memory accounting
+  covers the arrays only.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+  @see cuddInsertSubtables ddResizeTable
+
+*/
+static int
+ddGrowSubtables(
+  DdManager * unique,
+  int newsize)
+{
+    DdSubtable *newsubtables;
+    DdNodePtr *newvars, *newstack = NULL;
+    int *newperm, *newinvperm, *newmap = NULL;
+    int oldsize = unique->size;
+    size_t oldstacksize, stacksize;
+
+#ifdef DD_VERBOSE
+    (void) fprintf(unique->err,
+		   "Increasing the table size from %d to %d\n",
+		   unique->maxSize, newsize);
+#endif
+    newsubtables = ALLOC(DdSubtable,newsize);
+    newvars = ALLOC(DdNodePtr,newsize);
+    newperm = ALLOC(int,newsize);
+    newinvperm = ALLOC(int,newsize);
+    if (unique->map != NULL) {
+	newmap = ALLOC(int,newsize);
+    }
+    oldstacksize = (size_t) ddMax(unique->maxSize,unique->maxSizeZ) + 1;
+    stacksize = (size_t) ddMax(newsize,unique->maxSizeZ) + 1;
+    if (stacksize > oldstacksize) {
+	newstack = ALLOC(DdNodePtr,stacksize);
+    }
+    if (newsubtables == NULL || newvars == NULL || newperm == NULL ||
+	newinvperm == NULL || (unique->map != NULL && newmap == NULL) ||
+	(stacksize > oldstacksize && newstack == NULL)) {
+	FREE(newsubtables);
+	FREE(newvars);
+	FREE(newperm);
+	FREE(newinvperm);
+	FREE(newmap);
+	FREE(newstack);
+	unique->errorCode = CUDD_MEMORY_OUT;
+	return(0);
+    }
+    memcpy(newsubtables, unique->subtables,
+	   (size_t) oldsize * sizeof(DdSubtable));
+    memcpy(newvars, unique->vars, (size_t) oldsize * sizeof(DdNodePtr));
+    memcpy(newperm, unique->perm, (size_t) oldsize * sizeof(int));
+    memcpy(newinvperm, unique->invperm, (size_t) oldsize * sizeof(int));
+    FREE(unique->subtables);
+    unique->subtables = newsubtables;
+    FREE(unique->vars);
+    unique->vars = newvars;
+    FREE(unique->perm);
+    unique->perm = newperm;
+    FREE(unique->invperm);
+    unique->invperm = newinvperm;
+    if (unique->map != NULL) {
+	memcpy(newmap, unique->map, (size_t) oldsize * sizeof(int));
+	FREE(unique->map);
+	unique->map = newmap;
+	unique->memused += (newsize - unique->maxSize) * sizeof(int);
+    }
+    if (newstack != NULL) {
+	/* The stack for iterative procedures holds no data between calls. */
+	FREE(unique->stack);
+	unique->stack = newstack;
+	unique->stack[0] = NULL; /* to suppress harmless UMR */
+	unique->memused += (stacksize - oldstacksize) * sizeof(DdNodePtr);
+    }
+    unique->memused += (newsize - unique->maxSize) *
+	(sizeof(DdNode *) + 2 * sizeof(int) + sizeof(DdSubtable));
+    unique->maxSize = newsize;
+
+    return(1);
+
+} /* end of ddGrowSubtables */
+
+
 /**
   @brief Searches the subtables above node for a parent.
 
@@ -2885,6 +3261,95 @@ ddFixLimits(
 } /* end of ddFixLimits */
 
 
+/**
+  @brief Lists the nodes of a diagram in depth-first order.
+
+  @details Appends each node not yet visited to the part of order
+  that belongs to its level.  The visited nodes are those whose next
+  field is not NULL.  This is the recursive step of Cudd_Compact.
+
+  @sideeffect The next fields of the visited nodes are changed.
+
+*/
+static void
+ddCompactVisit(
+  DdNode * f,
+  int * perm,
+  DdNodePtr * order,
+  int * cursor)
+{
+    if (cuddIsConstant(f) || f->next != NULL) return;
+    f->next = f;
+    order[cursor[perm[f->index]]++] = f;
+    ddCompactVisit(cuddT(f),perm,order,cursor);
+    ddCompactVisit(Cudd_Regular(cuddE(f)),perm,order,cursor);
+
+} /* end of ddCompactVisit */
+
+
+/**
+  @brief Makes room before a new block of nodes is allocated.
+
+  @details Empties the death row and collects garbage, releasing the
+  node blocks left empty; then halves the computed table, and the
+  %BDD subtables with fewer nodes than slots, until the memory in use
+  fits the limit.  If hard is nonzero, the limit is maxmemhard and the
+  memory pressure handler, if any, is called as a last resort;
+  otherwise the limit is the target maxmem.  Subtables are only shrunk
+  after a garbage collection, which tells the callers of cuddAllocNode
+  to look up their insertion point again.
+
+  @return 1 if the memory in use fits the limit; 0 otherwise.
+
+  @sideeffect May shrink the computed table, for good if hard is
+  nonzero.
+
+  @see cuddAllocNode Cudd_RegisterMemoryPressureHandler
+
+*/
+static int
+ddRelieveMemoryPressure(
+  DdManager * unique,
+  int hard)
+{
+    size_t limit = hard ? unique->maxmemhard : unique->maxmem;
+    int gcNumber = unique->garbageCollections;
+    double saveFrac = unique->releaseFrac;
+    unsigned int oldslots;
+    int i;
+
+    cuddShrinkDeathRow(unique);
+    unique->releaseFrac = 1.0;
+    (void) cuddGarbageCollect(unique,1);
+    unique->releaseFrac = saveFrac;
+
+    while (unique->memused > limit && cuddCacheShrink(unique,hard));
+
+    if (gcNumber != unique->garbageCollections) {
+	for (i = 0; i < unique->size && unique->memused > limit; i++) {
+	    DdSubtable *subtable = &(unique->subtables[i]);
+	    while (subtable->slots > unique->initSlots &&
+		   subtable->keys < subtable->slots) {
+		oldslots = subtable->slots;
+		cuddShrinkSubtable(unique,i);
+		if (subtable->slots == oldslots) break;
+	    }
+	}
+    }
+
+    if (unique->memused > limit && hard &&
+	unique->pressureHandler != NULL) {
+	unique->pressureHandler(unique,unique->mphArg);
+	unique->releaseFrac = 1.0;
+	(void) cuddGarbageCollect(unique,1);
+	unique->releaseFrac = saveFrac;
+    }
+
+    return(unique->memused <= limit);
+
+} /* end of ddRelieveMemoryPressure */
+
+
 #ifndef DD_UNSORTED_FREE_LIST
 #ifdef DD_RED_BLACK_FREE_LIST
 /**
@@ -3182,8 +3647,6 @@ cuddCheckCollisionOrdering(
 #endif
 
 
-
-
 /**
   @brief Reports problem in garbage collection.
 
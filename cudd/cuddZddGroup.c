@@ -457,6 +457,23 @@ zddReorderChildren(
 #endif
 	    } while (result != 0);
 	    break;
+	case CUDD_REORDER_WINDOW2:
+	case CUDD_REORDER_WINDOW3:
+	case CUDD_REORDER_WINDOW4:
+	case CUDD_REORDER_WINDOW2_CONV:
+	case CUDD_REORDER_WINDOW3_CONV:
+	case CUDD_REORDER_WINDOW4_CONV:
+	    result = cuddZddWindowReorder(table,lower,upper,method);
+	    break;
+	case CUDD_REORDER_ANNEALING:
+	    result = cuddZddAnnealing(table,lower,upper);
+	    break;
+	case CUDD_REORDER_GENETIC:
+	    result = cuddZddGa(table,lower,upper);
+	    break;
+	case CUDD_REORDER_EXACT:
+	    result = cuddZddExact(table,lower,upper);
+	    break;
 	default:
 	    return(0);
 	}
@@ -83,7 +83,7 @@ static int cuddZddSiftingAux (DdManager *table, int x, int x_low, int x_high);
 static Move * cuddZddSiftingUp (DdManager *table, int x, int x_low, int initial_size);
 static Move * cuddZddSiftingDown (DdManager *table, int x, int x_high, int initial_size);
 static int cuddZddSiftingBackward (DdManager *table, Move *moves, int size);
-static void zddReorderPreprocess (DdManager *table);
+static void zddReorderPreprocess (DdManager *table, int keepCache);
 static int zddReorderPostprocess (DdManager *table);
 static int zddShuffle (DdManager *table, int *permutation);
 static int zddSiftUp (DdManager *table, int x, int xLow);
@@ -106,10 +106,16 @@ static void zddFixTree (DdManager *table, MtrNode *treenode);
   <li>Swapping
   <li>Sifting
   <li>Symmetric Sifting
+  <li>Group Sifting
+  <li>Linear Sifting
+  <li>Window Permutation
+  <li>Simulated Annealing
+  <li>Genetic Algorithm
+  <li>Exact Reordering
   </ul>
 
-  For sifting and symmetric sifting it is possible to request reordering
-  to convergence.
+  For sifting, symmetric sifting, linear sifting and window permutation
+  it is possible to request reordering to convergence.
 
   The core of all methods is the reordering procedure
   cuddZddSwapInPlace() which swaps two adjacent variables.
@@ -120,7 +126,7 @@ static void zddFixTree (DdManager *table, MtrNode *treenode);
   symmetric variables, in case of success.
 
   @sideeffect Changes the variable order for all ZDDs and clears
-  the cache.
+  the cache, unless it is preserved.
 
 */
 int
@@ -164,8 +170,10 @@ Cudd_zddReduceHeap(
 	hook = hook->next;
     }
 
-    /* Clear the cache and collect garbage. */
-    zddReorderPreprocess(table);
+    /* Clear the cache and collect garbage.  Linear transformations
+    ** change the functions of the nodes. */
+    zddReorderPreprocess(table, heuristic != CUDD_REORDER_LINEAR &&
+			 heuristic != CUDD_REORDER_LINEAR_CONVERGE);
     table->zddTotalNumberSwapping = 0;
 
 #ifdef DD_STATS
@@ -186,8 +194,26 @@ Cudd_zddReduceHeap(
     case CUDD_REORDER_LINEAR_CONVERGE:
 	(void) fprintf(table->out,"#:I_LINSIFT ");
 	break;
+    case CUDD_REORDER_WINDOW2:
+    case CUDD_REORDER_WINDOW3:
+    case CUDD_REORDER_WINDOW4:
+    case CUDD_REORDER_WINDOW2_CONV:
+    case CUDD_REORDER_WINDOW3_CONV:
+    case CUDD_REORDER_WINDOW4_CONV:
+	(void) fprintf(table->out,"#:I_WINDOW  ");
+	break;
+    case CUDD_REORDER_ANNEALING:
+	(void) fprintf(table->out,"#:I_ANNEAL  ");
+	break;
+    case CUDD_REORDER_GENETIC:
+	(void) fprintf(table->out,"#:I_GENETIC ");
+	break;
+    case CUDD_REORDER_EXACT:
+	(void) fprintf(table->out,"#:I_EXACT   ");
+	break;
     default:
 	(void) fprintf(table->err,"Unsupported ZDD reordering method\n");
+	cuddCacheKeepEnd(table);
 	return(0);
     }
     (void) fprintf(table->out,"%8d: initial size",initialSize); 
@@ -205,8 +231,10 @@ Cudd_zddReduceHeap(
 		   table->zddTotalNumberSwapping);
 #endif
 
-    if (result == 0)
+    if (result == 0) {
+	cuddCacheKeepEnd(table);
 	return(0);
+    }
 
     if (!zddReorderPostprocess(table))
 	return(0);
@@ -216,6 +244,9 @@ Cudd_zddReduceHeap(
 	    return(0);
     }
 
+    if (table->autoCompact)
+	(void) Cudd_Compact(table);
+
     nextDyn = table->keysZ * DD_DYN_RATIO;
     if (table->reorderings < 20 || nextDyn > table->nextDyn)
 	table->nextDyn = nextDyn;
@@ -250,7 +281,7 @@ Cudd_zddReduceHeap(
   @return 1 in case of success; 0 otherwise.
 
   @sideeffect Changes the %ZDD variable order for all diagrams and clears
-  the cache.
+  the cache, unless it is preserved.
 
   @see Cudd_zddReduceHeap
 
@@ -263,7 +294,7 @@ Cudd_zddShuffleHeap(
 
     int	result;
 
-    zddReorderPreprocess(table);
+    zddReorderPreprocess(table,1);
 
     result = zddShuffle(table,permutation);
 
@@ -308,6 +339,7 @@ cuddZddAlignToBdd(
     int M;			/* ratio of ZDD variables to BDD variables */
     int i,j;			/* loop indices */
     int result;			/* return value */
+    DdReorderEvent event;	/* garbage collection record */
 
     /* We assume that a ratio of 0 is OK. */
     if (table->sizeZ == 0)
@@ -337,7 +369,9 @@ cuddZddAlignToBdd(
     /* Eliminate dead nodes. Do not scan the cache again, because we
     ** assume that Cudd_ReduceHeap has already cleared it.
     */
+    cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_GC,0);
     cuddGarbageCollect(table,0);
+    cuddReorderEventEnd(table,&event);
 
     result = zddShuffle(table, invpermZ);
     FREE(invpermZ);
@@ -623,7 +657,7 @@ cuddZddSwapInPlace(
 	    if (f->ref == 0) {
 		cuddSatDec(cuddT(f)->ref);
 		cuddSatDec(cuddE(f)->ref);
-		cuddDeallocNode(table, f);
+		cuddReorderDeallocNode(table, f);
 		newykeys--;
 	    } else {
 		*previousP = f;
@@ -812,6 +846,7 @@ cuddZddSifting(
     int	size;
     int	x;
     int	result;
+    DdReorderEvent event;
 #ifdef DD_STATS
     int	previousSize;
 #endif
@@ -835,8 +870,10 @@ cuddZddSifting(
 
     /* Now sift. */
     for (i = 0; i < ddMin(table->siftMaxVar, size); i++) {
-	if (table->zddTotalNumberSwapping >= table->siftMaxSwap)
+	if (table->zddTotalNumberSwapping >= table->siftMaxSwap) {
+	    table->telemetry.cutSwap += ddMin(table->siftMaxVar, size) - i;
 	    break;
+	}
         if (util_cpu_time() - table->startTime > table->timeLimit) {
             table->autoDynZ = 0; /* prevent further reordering */
             break;
@@ -851,9 +888,11 @@ cuddZddSifting(
 #ifdef DD_STATS
 	previousSize = table->keysZ;
 #endif
+	cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_ZDD_SIFT,x);
 	result = cuddZddSiftingAux(table, x, lower, upper);
 	if (!result)
 	    goto cuddZddSiftingOutOfMem;
+	cuddReorderEventEnd(table,&event);
 #ifdef DD_STATS
 	if (table->keysZ < (unsigned) previousSize) {
 	    (void) fprintf(table->out,"-");
@@ -1192,8 +1231,10 @@ cuddZddSiftingUp(
 	move->next = moves;
 	moves = move;
 
-	if ((double)size > (double)limit_size * table->maxGrowth)
+	if ((double)size > (double)limit_size * table->maxGrowth) {
+	    table->telemetry.cutGrowth++;
 	    break;
+	}
         if (size < limit_size)
 	    limit_size = size;
 
@@ -1253,8 +1294,10 @@ cuddZddSiftingDown(
 	move->next = moves;
 	moves = move;
 
-	if ((double)size > (double)limit_size * table->maxGrowth)
+	if ((double)size > (double)limit_size * table->maxGrowth) {
+	    table->telemetry.cutGrowth++;
 	    break;
+	}
         if (size < limit_size)
 	    limit_size = size;
 
@@ -1326,21 +1369,39 @@ cuddZddSiftingBackward(
 
   @details Does garbage collection, to guarantee that there are no
   dead nodes; and clears the cache, which is invalidated by dynamic
-  reordering.
+  reordering.  If keepCache is nonzero and the manager preserves the
+  cache, only the entries that refer to dead nodes are cleared, and
+  the cache is prepared to survive reordering.
 
   @sideeffect None
 
 */
 static void
 zddReorderPreprocess(
-  DdManager * table)
+  DdManager * table,
+  int keepCache)
 {
+    DdReorderEvent event;
+
+    /* The realignment of the other order is not covered by the filter. */
+    keepCache = keepCache && table->preserveCache &&
+	!table->realign && !table->realignZ;
 
     /* Clear the cache. */
-    cuddCacheFlush(table);
+    cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_CACHE_FLUSH,0);
+    if (keepCache) {
+	cuddCacheClearDead(table);
+    } else {
+	cuddCacheFlush(table);
+    }
+    cuddReorderEventEnd(table,&event);
 
     /* Eliminate dead nodes. Do not scan the cache again. */
+    cuddReorderEventBegin(table,&event,CUDD_REORDER_EVENT_GC,0);
     cuddGarbageCollect(table,0);
+    cuddReorderEventEnd(table,&event);
+
+    if (keepCache) cuddCacheKeepStart(table);
 
     return;
 
@@ -1374,6 +1435,9 @@ zddReorderPostprocess(
     (void) fflush(table->out);
 #endif
 
+    /* Drop the cache entries invalidated by reordering. */
+    cuddCacheKeepEnd(table);
+
     /* If we have very many reclaimed nodes, we do not want to shrink
     ** the subtables, because this will lead to more garbage
     ** collections. More garbage collections mean shorter mean life for
@@ -45,9 +45,34 @@
 
 #include "util.h"
 #include "epd.h"
-#include "cudd.h"
+#include "cuddInt.h"
 #include <setjmp.h>
 
+/**
+ * @brief Calls to a reordering trigger and the answer it gives.
+ */
+typedef struct TriggerLog {
+  int calls;       /**< calls to the trigger */
+  int answer;      /**< value returned by the trigger */
+} TriggerLog;
+
+/**
+ * @brief Reordering events received by a telemetry callback.
+ */
+typedef struct EventLog {
+  unsigned long count[4]; /**< events of each type */
+  int bad;                /**< events with inconsistent fields */
+} EventLog;
+
+/**
+ * @brief Functions that can be recomputed, given up under memory
+ * pressure.
+ */
+typedef struct Memo {
+  DdNode *f[16];   /**< remembered functions (NULL if given up) */
+  int calls;       /**< calls to the memory pressure handler */
+} Memo;
+
 /** \cond */
 static int testBdd(int verbosity);
 static int testAdd(int verbosity);
@@ -56,7 +81,37 @@ static int testApa(int verbosity);
 static int testCount(int verbosity);
 static int testLdbl(int verbosity);
 static int testTimeout(int verbosity);
+static int testCheckpoint(int verbosity);
+static int testReorderBudget(int verbosity);
+static int testShuffle(int verbosity);
+static int testOrderDatabase(int verbosity);
+static int testParallelReorder(int verbosity);
+static int testParallelExact(int verbosity);
+static int testReorderTrigger(int verbosity);
+static int testZddReorder(int verbosity);
+static int testSparseInteract(int verbosity);
+static int testNewVarsAtLevel(int verbosity);
+static int testTelemetry(int verbosity);
+static int testCachePreservation(int verbosity);
+static int testTightSifting(int verbosity);
+static int testIncrementalSifting(int verbosity);
+static int testCompact(int verbosity);
+static int testMemoryRelease(int verbosity);
+static int testMemoryBreakdown(int verbosity);
+static int testMemoryPressure(int verbosity);
+static int testSpill(int verbosity);
+static int testClone(int verbosity);
+static int testTransferVector(int verbosity);
 static void timeoutHandler(DdManager * dd, void * arg);
+static int logTrigger(DdManager * dd, void * arg);
+static void countEvent(DdManager * dd, DdReorderEvent const * event, void * arg);
+static int skipJson(char const ** s);
+static void pressureHandler(DdManager * dd, void * arg);
+static DdNode * randomFunction(DdManager * dd, int n, int ncubes, int width, unsigned int * seed);
+static char * truthTable(DdManager * dd, DdNode * f, int n);
+static int sameFunction(DdManager * dd, DdNode * f, int n, char const * table);
+static int checkManager(DdManager * dd, int verbosity);
+static char * readFile(char const * path, long * size);
 /** \endcond */
 
 /**
@@ -85,6 +140,48 @@ int main(int argc, char const * const * argv)
     return -1;
   if (testLdbl(verbosity) != 0)
     return -1;
+  if (testCheckpoint(verbosity) != 0)
+    return -1;
+  if (testReorderBudget(verbosity) != 0)
+    return -1;
+  if (testShuffle(verbosity) != 0)
+    return -1;
+  if (testOrderDatabase(verbosity) != 0)
+    return -1;
+  if (testParallelReorder(verbosity) != 0)
+    return -1;
+  if (testParallelExact(verbosity) != 0)
+    return -1;
+  if (testReorderTrigger(verbosity) != 0)
+    return -1;
+  if (testZddReorder(verbosity) != 0)
+    return -1;
+  if (testSparseInteract(verbosity) != 0)
+    return -1;
+  if (testNewVarsAtLevel(verbosity) != 0)
+    return -1;
+  if (testTelemetry(verbosity) != 0)
+    return -1;
+  if (testCachePreservation(verbosity) != 0)
+    return -1;
+  if (testTightSifting(verbosity) != 0)
+    return -1;
+  if (testIncrementalSifting(verbosity) != 0)
+    return -1;
+  if (testCompact(verbosity) != 0)
+    return -1;
+  if (testMemoryRelease(verbosity) != 0)
+    return -1;
+  if (testMemoryBreakdown(verbosity) != 0)
+    return -1;
+  if (testMemoryPressure(verbosity) != 0)
+    return -1;
+  if (testSpill(verbosity) != 0)
+    return -1;
+  if (testClone(verbosity) != 0)
+    return -1;
+  if (testTransferVector(verbosity) != 0)
+    return -1;
   if (testTimeout(verbosity) != 0)
     return -1;
   return 0;
@@ -430,149 +527,2316 @@ testLdbl(int verbosity)
 
 
 /**
- * @brief Basic test of timeout handler.
+ * @brief Test of checkpoint and restore.
  *
- * @details Sets a short timeout and then tries to build a function
- * with a large BDD.  Strives to avoid leaking nodes.
+ * @details Writes a checkpoint, adds a function and writes an
+ * incremental one, and restores both the whole file and a copy whose
+ * last checkpoint is cut short.
  *
  * @return 0 if successful; -1 otherwise.
  */
 static int
-testTimeout(int verbosity)
+testCheckpoint(int verbosity)
 {
-  DdManager *dd;
-  /* Declare these "volatile" to prevent clobbering by longjmp. */
-  DdNode * volatile f;
-  DdNode * volatile clause = NULL;
-  DdNode * var1, * var2;
-  int i, ret, count;
-  int const N = 20; /* half the number of variables in f */
-  unsigned long timeout = 100UL; /* in milliseconds */
-  jmp_buf timeoutEnv;
+  DdManager *dd, *restored;
+  DdNode *f[4];
+  DdNode **roots;
+  char *table[4];
+  char const *path = "extra_ckpt.tst";
+  char const *cut = "extra_cut.tst";
+  char *buf1, *buf2;
+  FILE *fp;
+  long size1, size2;
+  int i, j, k, nroots, found, ret;
+  unsigned int seed = 1;
+  int const N = 12; /* number of variables */
 
-  dd = Cudd_Init(0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
   if (!dd) {
     if (verbosity) {
       printf("initialization failed\n");
     }
     return -1;
   }
+  for (i = 0; i < 3; i++) {
+    f[i] = randomFunction(dd, N, 6, 4, &seed);
+    if (!f[i]) {
+      return -1;
+    }
+    table[i] = truthTable(dd, f[i], N);
+  }
+  if (!Cudd_Checkpoint(dd, path, NULL)) {
+    if (verbosity) {
+      printf("checkpoint failed\n");
+    }
+    return -1;
+  }
+  buf1 = readFile(path, &size1);
+  f[3] = Cudd_bddXor(dd, f[0], f[1]);
+  if (!f[3]) {
+    return -1;
+  }
+  Cudd_Ref(f[3]);
+  table[3] = truthTable(dd, f[3], N);
+  if (!Cudd_Checkpoint(dd, path, NULL)) {
+    if (verbosity) {
+      printf("incremental checkpoint failed\n");
+    }
+    return -1;
+  }
+  buf2 = readFile(path, &size2);
+  if (!buf1 || !buf2) {
+    return -1;
+  }
 
-  /* Set up timeout handling. */
-  if (setjmp(timeoutEnv) > 0) {
+  /* The second checkpoint only appends to the first one. */
+  if (size2 <= size1 || memcmp(buf1, buf2, (size_t) size1) != 0) {
     if (verbosity) {
-      printf("caught timeout\n");
+      printf("checkpoint is not incremental\n");
     }
-    /* The nodes of clause may be leaked if the timeout was
-     * detected while conjoining the clause to f.  We set
-     * clause to NULL when it's not in use to be able to
-     * detect this case.
-     */
-    if (clause)
-      Cudd_RecursiveDeref(dd, clause);
-    goto finally;
+    return -1;
   }
-  (void) Cudd_RegisterTimeoutHandler(dd, timeoutHandler, (void *) &timeoutEnv);
-  (void) Cudd_SetTimeLimit(dd, timeout);
 
-  /* Try to build function.  This is expected to run out of time. */
-  f = Cudd_ReadOne(dd);
-  Cudd_Ref(f);
-  for (i = 0; i < N; i++) {
-    DdNode * tmp;
-    var1 = Cudd_bddIthVar(dd, i);
-    if (!var1) {
-      if (verbosity) {
-        printf("computation failed\n");
+  /* Restore the whole file and then a copy without its last bytes. */
+  for (k = 0; k < 2; k++) {
+    int const expected = k == 0 ? 4 : 3;
+    if (k == 1) {
+      fp = fopen(cut, "wb");
+      if (!fp || fwrite(buf2, 1, (size_t) (size2 - 8), fp) !=
+          (size_t) (size2 - 8)) {
         return -1;
       }
+      fclose(fp);
     }
-    var2 = Cudd_bddIthVar(dd, i+N);
-    if (!var2) {
+    restored = Cudd_Restore(k == 0 ? path : cut, NULL, &roots, &nroots);
+    if (!restored || nroots != expected || Cudd_DebugCheck(restored) != 0) {
       if (verbosity) {
-        printf("computation failed\n");
-        return -1;
+        printf("restore %d failed\n", k);
+      }
+      return -1;
+    }
+    found = 0;
+    for (i = 0; i < expected; i++) {
+      for (j = 0; j < nroots; j++) {
+        /* Roots are restored as regular nodes. */
+        if (sameFunction(restored, roots[j], N, table[i]) ||
+            sameFunction(restored, Cudd_Not(roots[j]), N, table[i])) {
+          found++;
+          break;
+        }
       }
     }
-    clause = Cudd_bddOr(dd, var1, var2);
-    if (!clause) {
+    for (j = 0; j < nroots; j++) {
+      Cudd_RecursiveDeref(restored, roots[j]);
+    }
+    FREE(roots);
+    ret = Cudd_CheckZeroRef(restored);
+    Cudd_Quit(restored);
+    if (found != expected || ret != 0) {
       if (verbosity) {
-        printf("computation failed\n");
+        printf("restore %d: %d of %d functions, %d references\n",
+               k, found, expected, ret);
       }
       return -1;
     }
-    Cudd_Ref(clause);
-    tmp = Cudd_bddAnd(dd, f, clause);
-    if (!tmp) {
+  }
+  (void) remove(path);
+  (void) remove(cut);
+  FREE(buf1);
+  FREE(buf2);
+  if (verbosity) {
+    printf("checkpoint: restored 4 functions, 3 from truncated file\n");
+  }
+  for (i = 0; i < 4; i++) {
+    Cudd_RecursiveDeref(dd, f[i]);
+    FREE(table[i]);
+  }
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return ret;
+}
+
+/**
+ * @brief Test of the time and swap budgets of reordering.
+ *
+ * @details Sifting with a small swap budget must leave variables
+ * pending; a reordering that does not sift must keep them pending,
+ * and a full sifting must clear them.  The functions must survive.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testReorderBudget(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f[4];
+  char *table[4];
+  int i, pending, kept, interrupted, ret;
+  unsigned int seed = 2;
+  int const N = 14; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  for (i = 0; i < 4; i++) {
+    f[i] = randomFunction(dd, N, 12, 5, &seed);
+    if (!f[i]) {
+      return -1;
+    }
+    table[i] = truthTable(dd, f[i], N);
+  }
+
+  Cudd_SetReorderingMaxSwaps(dd, 20);
+  if (!Cudd_ReduceHeap(dd, CUDD_REORDER_SIFT, 0)) {
+    return -1;
+  }
+  interrupted = Cudd_ReadReorderingCoverage(dd, NULL, &pending);
+  if (!Cudd_ReduceHeap(dd, CUDD_REORDER_WINDOW2, 0)) {
+    return -1;
+  }
+  (void) Cudd_ReadReorderingCoverage(dd, NULL, &kept);
+  kept = pending > 0 && kept == pending;
+  Cudd_SetReorderingMaxSwaps(dd, 0);
+  if (!Cudd_ReduceHeap(dd, CUDD_REORDER_SIFT, 0)) {
+    return -1;
+  }
+  (void) Cudd_ReadReorderingCoverage(dd, NULL, &pending);
+
+  /* A deadline may or may not expire; the result must be the same. */
+  Cudd_SetReorderingDeadline(dd, 1);
+  if (Cudd_ReadReorderingDeadline(dd) != 1 ||
+      !Cudd_ReduceHeap(dd, CUDD_REORDER_SIFT_CONVERGE, 0)) {
+    return -1;
+  }
+  Cudd_SetReorderingDeadline(dd, 0);
+  for (i = 0; i < 4; i++) {
+    if (!sameFunction(dd, f[i], N, table[i])) {
       if (verbosity) {
-        printf("computation failed\n");
+        printf("reordering changed function %d\n", i);
       }
       return -1;
     }
-    Cudd_Ref(tmp);
-    Cudd_RecursiveDeref(dd, clause);
-    clause = NULL;
-    Cudd_RecursiveDeref(dd, f);
-    f = tmp;
   }
-  if (verbosity > 1) {
-    Cudd_bddPrintCover(dd, f, f);
+  if (verbosity) {
+    printf("budget: interrupted %d, pending kept %d, "
+           "pending after sifting %d\n", interrupted, kept, pending);
   }
+  for (i = 0; i < 4; i++) {
+    Cudd_RecursiveDeref(dd, f[i]);
+    FREE(table[i]);
+  }
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return (interrupted && kept && pending == 0) ? ret : -1;
+}
 
- finally:
-  if (verbosity) {
-    printf("so far");
-    Cudd_PrintSummary(dd, f, 2*N, 0);
+/**
+ * @brief Test of Cudd_ShuffleHeap.
+ *
+ * @details Rotates the order, which is done by swapping, and then
+ * reverses it, which is far enough to rebuild the diagrams.  A %BDD
+ * and an %ADD must keep their functions.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testShuffle(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f[4];
+  char *table[4];
+  int permutation[16];
+  int i, k, ret;
+  unsigned int seed = 3;
+  int const N = 16; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
   }
-  count = 0;
-  for (i = 0; i < N-1; i += 2) {
-    var1 = Cudd_bddIthVar(dd, i);
-    if (!var1) {
-      printf("computation failed\n");
+  for (i = 0; i < 3; i++) {
+    f[i] = randomFunction(dd, N, 10, 5, &seed);
+    if (!f[i]) {
       return -1;
     }
-    var2 = Cudd_bddIthVar(dd, i+1);
-    if (!var2) {
-      printf("computation failed\n");
+  }
+  f[3] = Cudd_BddToAdd(dd, f[2]);
+  if (!f[3]) {
+    return -1;
+  }
+  Cudd_Ref(f[3]);
+  for (i = 0; i < 4; i++) {
+    table[i] = truthTable(dd, f[i], N);
+  }
+  for (k = 0; k < 2; k++) {
+    for (i = 0; i < N; i++) {
+      permutation[i] = k == 0 ? (i + 1) % N : N - 1 - i;
+    }
+    if (!Cudd_ShuffleHeap(dd, permutation)) {
+      if (verbosity) {
+        printf("shuffle %d failed\n", k);
+      }
       return -1;
     }
-    clause = Cudd_bddOr(dd, var1, var2);
-    if (!clause) {
-      printf("computation failed\n");
+    for (i = 0; i < N; i++) {
+      if (Cudd_ReadInvPerm(dd, i) != permutation[i]) {
+        if (verbosity) {
+          printf("shuffle %d: wrong order\n", k);
+        }
+        return -1;
+      }
+    }
+    if (Cudd_DebugCheck(dd) != 0) {
       return -1;
     }
-    Cudd_Ref(clause);
-    if (Cudd_bddLeq(dd, f, clause)) {
-      count++;
+    for (i = 0; i < 4; i++) {
+      if (!sameFunction(dd, f[i], N, table[i])) {
+        if (verbosity) {
+          printf("shuffle %d changed function %d\n", k, i);
+        }
+        return -1;
+      }
     }
-    Cudd_RecursiveDeref(dd, clause);
   }
   if (verbosity) {
-    printf("f implies %d clauses\n", count);
+    printf("shuffle: rotated and reversed %d variables\n", N);
   }
-  Cudd_RecursiveDeref(dd, f);
-  ret = Cudd_CheckZeroRef(dd);
-  if (verbosity) {
-    Cudd_PrintInfo(dd, stdout);
-    if (ret != 0) {
-      printf("%d non-zero references\n", ret);
-    }
+  Cudd_RecursiveDeref(dd, f[3]);
+  for (i = 0; i < 3; i++) {
+    Cudd_RecursiveDeref(dd, f[i]);
+  }
+  for (i = 0; i < 4; i++) {
+    FREE(table[i]);
   }
+  ret = checkManager(dd, verbosity);
   Cudd_Quit(dd);
-  return 0;
+  return ret;
 }
 
 /**
- * @brief Timeout handler.
+ * @brief Test of the variable-order database.
+ *
+ * @details Saves the order of a manager and loads it into another
+ * one whose variables have differently spelled names, plus two
+ * variables that are not in the database and must stay where they
+ * are.
+ *
+ * @return 0 if successful; -1 otherwise.
  */
-static void
-timeoutHandler(DdManager * dd, void * arg)
+static int
+testOrderDatabase(int verbosity)
 {
-  jmp_buf * timeoutEnv = (jmp_buf *) arg;
-  /* Reset manager. */
-  Cudd_ClearErrorCode(dd);
-  Cudd_UnsetTimeLimit(dd);
-  Cudd_RegisterTimeoutHandler(dd, NULL, NULL);
+  DdManager *dd1, *dd2;
+  DdNode *f;
+  FILE *fp;
+  char *table;
+  char names1[8][8], names2[10][8];
+  char const *vn1[8], *vn2[10];
+  int permutation[8] = {5, 2, 7, 0, 3, 6, 1, 4};
+  int i, matched, ret;
+  unsigned int seed = 4;
 
-  longjmp(*timeoutEnv, 1);
+  dd1 = Cudd_Init(8, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  dd2 = Cudd_Init(10, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  fp = tmpfile();
+  if (!dd1 || !dd2 || !fp) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  for (i = 0; i < 10; i++) {
+    if (i < 8) {
+      sprintf(names1[i], "x[%d]", i);
+      sprintf(names2[i], "X_%d", i);
+      vn1[i] = names1[i];
+    } else {
+      sprintf(names2[i], "y%d", i);
+    }
+    vn2[i] = names2[i];
+  }
+  if (!Cudd_ShuffleHeap(dd1, permutation) ||
+      !Cudd_SaveOrder(dd1, fp, vn1)) {
+    return -1;
+  }
+  rewind(fp);
+  f = randomFunction(dd2, 10, 8, 4, &seed);
+  if (!f) {
+    return -1;
+  }
+  table = truthTable(dd2, f, 10);
+  if (!Cudd_LoadOrder(dd2, fp, vn2, &matched) || matched != 8) {
+    if (verbosity) {
+      printf("order not loaded\n");
+    }
+    return -1;
+  }
+  fclose(fp);
+  for (i = 0; i < 10; i++) {
+    if (Cudd_ReadPerm(dd2, i) != (i < 8 ? Cudd_ReadPerm(dd1, i) : i)) {
+      if (verbosity) {
+        printf("variable %d at level %d\n", i, Cudd_ReadPerm(dd2, i));
+      }
+      return -1;
+    }
+  }
+  if (!sameFunction(dd2, f, 10, table)) {
+    if (verbosity) {
+      printf("loading the order changed the function\n");
+    }
+    return -1;
+  }
+  if (verbosity) {
+    printf("order database: matched %d variables\n", matched);
+  }
+  Cudd_RecursiveDeref(dd2, f);
+  FREE(table);
+  ret = checkManager(dd2, verbosity);
+  Cudd_Quit(dd1);
+  Cudd_Quit(dd2);
+  return ret;
+}
+
+/**
+ * @brief Test of genetic and annealing reordering with several threads.
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testParallelReorder(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f[4];
+  char *table[4];
+  Cudd_ReorderingType methods[2] = {
+    CUDD_REORDER_GENETIC, CUDD_REORDER_ANNEALING
+  };
+  int i, k, ret;
+  unsigned int seed = 5;
+  int const N = 12; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  for (i = 0; i < 4; i++) {
+    f[i] = randomFunction(dd, N, 10, 4, &seed);
+    if (!f[i]) {
+      return -1;
+    }
+    table[i] = truthTable(dd, f[i], N);
+  }
+  Cudd_SetReorderingThreads(dd, 4);
+  for (k = 0; k < 2; k++) {
+    if (!Cudd_ReduceHeap(dd, methods[k], 0) || Cudd_DebugCheck(dd) != 0) {
+      if (verbosity) {
+        printf("reordering %d failed\n", k);
+      }
+      return -1;
+    }
+    for (i = 0; i < 4; i++) {
+      if (!sameFunction(dd, f[i], N, table[i])) {
+        if (verbosity) {
+          printf("reordering %d changed function %d\n", k, i);
+        }
+        return -1;
+      }
+    }
+  }
+  if (verbosity) {
+    printf("parallel reordering: genetic and annealing with %d threads\n",
+           Cudd_ReadReorderingThreads(dd));
+  }
+  for (i = 0; i < 4; i++) {
+    Cudd_RecursiveDeref(dd, f[i]);
+    FREE(table[i]);
+  }
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return ret;
+}
+
+/**
+ * @brief Test of exact reordering with several threads.
+ *
+ * @details The same functions are built in two managers, which are
+ * reordered exactly with one and with four threads.  Both must reach
+ * the same (minimum) size.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testParallelExact(int verbosity)
+{
+  DdManager *dd[2];
+  DdNode *f[2][3];
+  char *table[3];
+  long size[2];
+  int i, k, ret;
+  unsigned int seed;
+  int const N = 9; /* number of variables */
+
+  for (k = 0; k < 2; k++) {
+    dd[k] = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+    if (!dd[k]) {
+      if (verbosity) {
+        printf("initialization failed\n");
+      }
+      return -1;
+    }
+    seed = 6;
+    for (i = 0; i < 3; i++) {
+      f[k][i] = randomFunction(dd[k], N, 8, 4, &seed);
+      if (!f[k][i]) {
+        return -1;
+      }
+      if (k == 0) {
+        table[i] = truthTable(dd[k], f[k][i], N);
+      }
+    }
+    Cudd_SetReorderingThreads(dd[k], k == 0 ? 1 : 4);
+    if (!Cudd_ReduceHeap(dd[k], CUDD_REORDER_EXACT, 0) ||
+        Cudd_DebugCheck(dd[k]) != 0) {
+      if (verbosity) {
+        printf("exact reordering with %d threads failed\n",
+               Cudd_ReadReorderingThreads(dd[k]));
+      }
+      return -1;
+    }
+    for (i = 0; i < 3; i++) {
+      if (!sameFunction(dd[k], f[k][i], N, table[i])) {
+        if (verbosity) {
+          printf("exact reordering changed function %d\n", i);
+        }
+        return -1;
+      }
+    }
+    size[k] = Cudd_SharingSize(f[k], 3);
+  }
+  if (verbosity) {
+    printf("exact: %ld nodes with 1 thread, %ld with 4\n", size[0], size[1]);
+  }
+  ret = 0;
+  for (k = 0; k < 2; k++) {
+    for (i = 0; i < 3; i++) {
+      Cudd_RecursiveDeref(dd[k], f[k][i]);
+    }
+    if (checkManager(dd[k], verbosity) != 0) {
+      ret = -1;
+    }
+    Cudd_Quit(dd[k]);
+  }
+  for (i = 0; i < 3; i++) {
+    FREE(table[i]);
+  }
+  return size[0] == size[1] ? ret : -1;
+}
+
+/**
+ * @brief Test of the reordering trigger.
+ *
+ * @details Grows a function past the reordering threshold, first
+ * with a trigger that declines, then with one that accepts.  Then
+ * checks that the adaptive trigger lets the first reordering of a
+ * manager go ahead.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testReorderTrigger(int verbosity)
+{
+  DdManager *dd = NULL;
+  DdNode *f = NULL, *g, *tmp;
+  TriggerLog log;
+  unsigned int next, reorderings[3];
+  int i;
+  unsigned int seed = 23;
+  int const N = 16; /* number of variables */
+
+  for (i = 0; i < 3; i++) {
+    /* Decline, then accept, then let the adaptive trigger decide. */
+    if (i != 1) {
+      dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+      if (!dd) {
+        if (verbosity) {
+          printf("initialization failed\n");
+        }
+        return -1;
+      }
+      Cudd_AutodynEnable(dd, CUDD_REORDER_SIFT);
+      f = Cudd_ReadLogicZero(dd);
+      Cudd_Ref(f);
+    }
+    log.calls = 0;
+    log.answer = i;
+    if (i < 2) {
+      Cudd_SetReorderingTrigger(dd, logTrigger, &log);
+    } else {
+      Cudd_SetReorderingTrigger(dd, Cudd_AdaptiveReorderingTrigger, NULL);
+    }
+    next = Cudd_ReadNodeCount(dd) + 64;
+    Cudd_SetNextReordering(dd, next);
+    while (Cudd_ReadNextReordering(dd) == next) {
+      g = randomFunction(dd, N, 4, 5, &seed);
+      if (!g) {
+        return -1;
+      }
+      tmp = Cudd_bddOr(dd, f, g);
+      if (!tmp) {
+        return -1;
+      }
+      Cudd_Ref(tmp);
+      Cudd_RecursiveDeref(dd, g);
+      Cudd_RecursiveDeref(dd, f);
+      f = tmp;
+    }
+    reorderings[i] = Cudd_ReadReorderings(dd);
+    if (i < 2 && log.calls == 0) {
+      return -1;
+    }
+    if (i == 0 && Cudd_ReadNextReordering(dd) <= next) {
+      if (verbosity) {
+        printf("declined reordering did not raise the threshold\n");
+      }
+      return -1;
+    }
+    if (i != 0) {
+      Cudd_RecursiveDeref(dd, f);
+      if (checkManager(dd, verbosity) != 0) {
+        return -1;
+      }
+      Cudd_Quit(dd);
+    }
+  }
+  if (reorderings[0] != 0 || reorderings[1] != 1 || reorderings[2] != 1) {
+    if (verbosity) {
+      printf("reorderings %u %u %u\n", reorderings[0], reorderings[1],
+             reorderings[2]);
+    }
+    return -1;
+  }
+  if (verbosity) {
+    printf("reordering trigger: declined %u, accepted %u, adaptive %u\n",
+           reorderings[0], reorderings[1], reorderings[2]);
+  }
+  return 0;
+}
+
+/**
+ * @brief Test of window, annealing, genetic and exact reordering of
+ * ZDDs.
+ *
+ * @details The ZDDs are converted from BDDs, and converted back after
+ * each reordering, which must give the same BDDs.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testZddReorder(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f[3], *z[3], *g;
+  Cudd_ReorderingType methods[6] = {
+    CUDD_REORDER_WINDOW2, CUDD_REORDER_WINDOW3_CONV, CUDD_REORDER_WINDOW4,
+    CUDD_REORDER_ANNEALING, CUDD_REORDER_GENETIC, CUDD_REORDER_EXACT
+  };
+  int i, k, ret;
+  unsigned int seed = 7;
+  int const N = 8; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd || !Cudd_zddVarsFromBddVars(dd, 1)) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  for (i = 0; i < 3; i++) {
+    f[i] = randomFunction(dd, N, 8, 3, &seed);
+    if (!f[i]) {
+      return -1;
+    }
+    z[i] = Cudd_zddPortFromBdd(dd, f[i]);
+    if (!z[i]) {
+      return -1;
+    }
+    Cudd_Ref(z[i]);
+  }
+  for (k = 0; k < 6; k++) {
+    if (!Cudd_zddReduceHeap(dd, methods[k], 0) ||
+        Cudd_DebugCheck(dd) != 0) {
+      if (verbosity) {
+        printf("ZDD reordering %d failed\n", k);
+      }
+      return -1;
+    }
+    for (i = 0; i < 3; i++) {
+      g = Cudd_zddPortToBdd(dd, z[i]);
+      if (g != f[i]) {
+        if (verbosity) {
+          printf("ZDD reordering %d changed function %d\n", k, i);
+        }
+        return -1;
+      }
+    }
+  }
+  if (verbosity) {
+    printf("ZDD reordering: %d methods\n", k);
+  }
+  for (i = 0; i < 3; i++) {
+    Cudd_RecursiveDerefZdd(dd, z[i]);
+    Cudd_RecursiveDeref(dd, f[i]);
+  }
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return ret;
+}
+
+/**
+ * @brief Test of the interaction matrix kept as lists.
+ *
+ * @details With many variables and functions of few of them each, the
+ * matrix is kept as lists of interacting variables.  Reorders once,
+ * builds more functions, whose nodes are logged, and reorders again.
+ * Then every pair of variables in the support of a live function must
+ * interact, and a pair that only interacted through a function freed
+ * in between must still be there, because the second reordering only
+ * adds the logged nodes to the matrix.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testSparseInteract(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f[64], *g, *cube, *tmp, *var;
+  int *support;
+  int i, j, k, x, y, n;
+  int list[16];
+  unsigned int seed = 29;
+  int const N = 1024; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  /* The first and the last variable only interact through g. */
+  g = Cudd_bddAnd(dd, Cudd_bddIthVar(dd, 0), Cudd_bddIthVar(dd, N-1));
+  if (!g) {
+    return -1;
+  }
+  Cudd_Ref(g);
+  for (k = 0; k < 64; k++) {
+    /* Function k depends on variables 16k to 16k+15. */
+    f[k] = Cudd_ReadLogicZero(dd);
+    Cudd_Ref(f[k]);
+    for (i = 0; i < 3; i++) {
+      cube = Cudd_ReadOne(dd);
+      Cudd_Ref(cube);
+      for (j = 0; j < 4; j++) {
+        seed = seed * 1103515245U + 12345U;
+        var = Cudd_bddIthVar(dd, 16 * k + (int) ((seed >> 16) % 16U));
+        tmp = Cudd_bddAnd(dd, cube, Cudd_NotCond(var, (seed >> 8) & 1));
+        if (!tmp) {
+          return -1;
+        }
+        Cudd_Ref(tmp);
+        Cudd_RecursiveDeref(dd, cube);
+        cube = tmp;
+      }
+      tmp = Cudd_bddOr(dd, f[k], cube);
+      if (!tmp) {
+        return -1;
+      }
+      Cudd_Ref(tmp);
+      Cudd_RecursiveDeref(dd, cube);
+      Cudd_RecursiveDeref(dd, f[k]);
+      f[k] = tmp;
+    }
+    if (k == 31) {
+      if (!Cudd_ReduceHeap(dd, CUDD_REORDER_SIFT, 1)) {
+        return -1;
+      }
+      Cudd_RecursiveDeref(dd, g);
+    }
+  }
+  if (!Cudd_ReduceHeap(dd, CUDD_REORDER_SIFT, 1)) {
+    return -1;
+  }
+  if (dd->interact.lists == NULL || !dd->interact.valid) {
+    if (verbosity) {
+      printf("interaction matrix not kept as lists\n");
+    }
+    return -1;
+  }
+  for (k = 0; k < 64; k++) {
+    support = Cudd_SupportIndex(dd, f[k]);
+    if (!support) {
+      return -1;
+    }
+    for (x = 0, n = 0; x < N; x++) {
+      if (support[x]) {
+        list[n++] = x;
+      }
+    }
+    FREE(support);
+    for (x = 0; x < n; x++) {
+      for (y = x + 1; y < n; y++) {
+        if (!cuddTestInteract(dd, list[x], list[y])) {
+          if (verbosity) {
+            printf("variables %d and %d do not interact\n", list[x],
+                   list[y]);
+          }
+          return -1;
+        }
+      }
+    }
+  }
+  if (!cuddTestInteract(dd, 0, N-1)) {
+    if (verbosity) {
+      printf("interaction matrix computed from scratch\n");
+    }
+    return -1;
+  }
+  for (k = 0; k < 64; k++) {
+    Cudd_RecursiveDeref(dd, f[k]);
+  }
+  if (checkManager(dd, verbosity) != 0) {
+    return -1;
+  }
+  Cudd_Quit(dd);
+  if (verbosity) {
+    printf("sparse interaction: supports of %d functions found after %d "
+           "reorderings\n", k, 2);
+  }
+  return 0;
+}
+
+/**
+ * @brief Test of Cudd_bddNewVarsAtLevel.
+ *
+ * @details Inserts four variables in the middle of the order of a
+ * manager that already has a function, and checks the levels of all
+ * variables and the function, also when conjoined with a new variable.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testNewVarsAtLevel(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f, *g;
+  DdNode *vars[4];
+  char *table, *tableg;
+  long m;
+  int i, ret;
+  unsigned int seed = 8;
+  int const N = 8; /* number of variables before the insertion */
+  int const L = 3; /* level of the insertion */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  f = randomFunction(dd, N, 8, 4, &seed);
+  if (!f) {
+    return -1;
+  }
+  table = truthTable(dd, f, N);
+  if (!Cudd_bddNewVarsAtLevel(dd, 4, L, vars) || Cudd_ReadSize(dd) != N + 4) {
+    if (verbosity) {
+      printf("insertion failed\n");
+    }
+    return -1;
+  }
+  for (i = 0; i < N + 4; i++) {
+    int expected = i >= N ? L + i - N : (i < L ? i : i + 4);
+    if (Cudd_ReadPerm(dd, i) != expected ||
+        (i >= N && vars[i - N] != Cudd_bddIthVar(dd, i))) {
+      if (verbosity) {
+        printf("variable %d at level %d\n", i, Cudd_ReadPerm(dd, i));
+      }
+      return -1;
+    }
+  }
+  if (Cudd_DebugCheck(dd) != 0 || !sameFunction(dd, f, N, table)) {
+    if (verbosity) {
+      printf("insertion changed the function\n");
+    }
+    return -1;
+  }
+  g = Cudd_bddAnd(dd, f, vars[1]);
+  if (!g) {
+    return -1;
+  }
+  Cudd_Ref(g);
+  tableg = truthTable(dd, g, N + 4);
+  for (m = 0; m < (1L << (N + 4)); m++) {
+    if (tableg[m] != (table[m & ((1L << N) - 1)] && ((m >> (N + 1)) & 1))) {
+      if (verbosity) {
+        printf("wrong conjunction with a new variable\n");
+      }
+      return -1;
+    }
+  }
+  if (verbosity) {
+    printf("new variables: 4 at level %d of %d\n", L, N);
+  }
+  Cudd_RecursiveDeref(dd, g);
+  Cudd_RecursiveDeref(dd, f);
+  FREE(table);
+  FREE(tableg);
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return ret;
+}
+
+/**
+ * @brief Test of the reordering telemetry.
+ *
+ * @details Counts the events of sifting and of window reordering, which
+ * only reports the garbage collection and the cache flush that precede
+ * it, and compares the counts to the totals of the summary, which must
+ * parse as JSON.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testTelemetry(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f;
+  FILE *fp;
+  EventLog log;
+  char buf[2048];
+  char const *s;
+  unsigned long sifted, gcs, flushes;
+  size_t len;
+  int i;
+  unsigned int seed = 31;
+  int const N = 12; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  fp = tmpfile();
+  if (!dd || !fp) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  for (i = 0; i < 4; i++) {
+    log.count[i] = 0;
+  }
+  log.bad = 0;
+  Cudd_SetReorderingTelemetry(dd, countEvent, &log);
+  f = randomFunction(dd, N, 10, 4, &seed);
+  if (!f) {
+    return -1;
+  }
+  if (!Cudd_ReduceHeap(dd, CUDD_REORDER_SIFT, 1)) {
+    return -1;
+  }
+  sifted = log.count[CUDD_REORDER_EVENT_SIFT];
+  if (!Cudd_ReduceHeap(dd, CUDD_REORDER_WINDOW2, 1)) {
+    return -1;
+  }
+  if (log.bad || sifted == 0 ||
+      log.count[CUDD_REORDER_EVENT_SIFT] != sifted ||
+      log.count[CUDD_REORDER_EVENT_ZDD_SIFT] != 0 ||
+      log.count[CUDD_REORDER_EVENT_GC] < 2 ||
+      log.count[CUDD_REORDER_EVENT_CACHE_FLUSH] < 2) {
+    if (verbosity) {
+      printf("events %lu %lu %lu %lu, bad %d\n", log.count[0],
+             log.count[1], log.count[2], log.count[3], log.bad);
+    }
+    return -1;
+  }
+  if (!Cudd_PrintReorderingSummary(dd, fp)) {
+    return -1;
+  }
+  rewind(fp);
+  len = fread(buf, 1, sizeof(buf) - 1, fp);
+  fclose(fp);
+  buf[len] = '\0';
+  s = buf;
+  if (!skipJson(&s) || *s != '\0') {
+    if (verbosity) {
+      printf("summary does not parse:\n%s", buf);
+    }
+    return -1;
+  }
+  if (!(s = strstr(buf, "\"sifting\": {\"variables\":")) ||
+      sscanf(s, "\"sifting\": {\"variables\": %lu", &sifted) != 1 ||
+      !(s = strstr(buf, "\"gc\": {\"count\":")) ||
+      sscanf(s, "\"gc\": {\"count\": %lu", &gcs) != 1 ||
+      !(s = strstr(buf, "\"cacheFlush\": {\"count\":")) ||
+      sscanf(s, "\"cacheFlush\": {\"count\": %lu", &flushes) != 1) {
+    return -1;
+  }
+  if (sifted != log.count[CUDD_REORDER_EVENT_SIFT] ||
+      gcs != log.count[CUDD_REORDER_EVENT_GC] ||
+      flushes != log.count[CUDD_REORDER_EVENT_CACHE_FLUSH]) {
+    if (verbosity) {
+      printf("summary totals %lu %lu %lu\n", sifted, gcs, flushes);
+    }
+    return -1;
+  }
+  Cudd_SetReorderingTelemetry(dd, NULL, NULL);
+  Cudd_RecursiveDeref(dd, f);
+  if (checkManager(dd, verbosity) != 0) {
+    return -1;
+  }
+  Cudd_Quit(dd);
+  if (verbosity) {
+    printf("telemetry: sifting, garbage collection and cache flush events "
+           "match the summary\n");
+  }
+  return 0;
+}
+
+/**
+ * @brief Test of the preservation of the cache across reordering.
+ *
+ * @details Computes an exclusive or and a disjunction, frees the
+ * disjunction, and sifts.  The exclusive or must then be found in the
+ * cache, and the results computed after reordering, including those
+ * of linear sifting, which clears the cache, must be right.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testCachePreservation(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f, *g, *h, *tmp;
+  char *tablef, *tableg, *tableh, *tablet;
+  double hits, lookups;
+  long m;
+  int k, found, ret;
+  unsigned int seed = 9;
+  int const N = 14; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  Cudd_SetCachePreservation(dd, 1);
+  f = randomFunction(dd, N, 12, 4, &seed);
+  g = randomFunction(dd, N, 12, 4, &seed);
+  if (!f || !g) {
+    return -1;
+  }
+  h = Cudd_bddXor(dd, f, g);
+  tmp = Cudd_bddOr(dd, f, g);
+  if (!h || !tmp) {
+    return -1;
+  }
+  Cudd_Ref(h);
+  Cudd_Ref(tmp);
+  Cudd_RecursiveDeref(dd, tmp);
+  tablef = truthTable(dd, f, N);
+  tableg = truthTable(dd, g, N);
+  tableh = truthTable(dd, h, N);
+  found = 0;
+  for (k = 0; k < 2; k++) {
+    if (!Cudd_ReduceHeap(dd, k == 0 ? CUDD_REORDER_SIFT :
+                         CUDD_REORDER_LINEAR, 0) ||
+        Cudd_DebugCheck(dd) != 0) {
+      return -1;
+    }
+    hits = Cudd_ReadCacheHits(dd);
+    lookups = Cudd_ReadCacheLookUps(dd);
+    tmp = Cudd_bddXor(dd, f, g);
+    if (tmp != h) {
+      if (verbosity) {
+        printf("wrong exclusive or after reordering %d\n", k);
+      }
+      return -1;
+    }
+    if (k == 0) {
+      /* One look-up answers the whole exclusive or. */
+      found = Cudd_ReadCacheHits(dd) == hits + 1 &&
+        Cudd_ReadCacheLookUps(dd) == lookups + 1;
+    }
+    tmp = Cudd_bddOr(dd, f, g);
+    if (!tmp) {
+      return -1;
+    }
+    Cudd_Ref(tmp);
+    tablet = truthTable(dd, tmp, N);
+    for (m = 0; m < (1L << N); m++) {
+      if (tablet[m] != (tablef[m] || tableg[m])) {
+        if (verbosity) {
+          printf("wrong disjunction after reordering %d\n", k);
+        }
+        return -1;
+      }
+    }
+    FREE(tablet);
+    Cudd_RecursiveDeref(dd, tmp);
+    if (!sameFunction(dd, h, N, tableh)) {
+      return -1;
+    }
+  }
+  if (verbosity) {
+    printf("cache preservation: exclusive or found in cache %d\n", found);
+  }
+  Cudd_RecursiveDeref(dd, f);
+  Cudd_RecursiveDeref(dd, g);
+  Cudd_RecursiveDeref(dd, h);
+  FREE(tablef);
+  FREE(tableg);
+  FREE(tableh);
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return found ? ret : -1;
+}
+
+/**
+ * @brief Test of sifting with and without the tight bound.
+ *
+ * @details Sifts the same functions in two managers, one with tight
+ * sifting.  Both must preserve the functions and not increase their
+ * size, and neither may go below one node per variable of the
+ * support plus the constant, which is what the tight bound assumes.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testTightSifting(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f[8];
+  char *table[8];
+  int size[3];
+  int k, tight, bound;
+  unsigned int seed;
+  int const N = 14; /* number of variables */
+
+  for (tight = 0; tight < 2; tight++) {
+    dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+    if (!dd) {
+      if (verbosity) {
+        printf("initialization failed\n");
+      }
+      return -1;
+    }
+    Cudd_SetTightSifting(dd, tight);
+    seed = 37;
+    for (k = 0; k < 8; k++) {
+      f[k] = randomFunction(dd, N, 6, 4, &seed);
+      if (!f[k]) {
+        return -1;
+      }
+      table[k] = truthTable(dd, f[k], N);
+      if (!table[k]) {
+        return -1;
+      }
+    }
+    size[0] = Cudd_SharingSize(f, 8);
+    bound = Cudd_VectorSupportSize(dd, f, 8) + 1;
+    if (!Cudd_ReduceHeap(dd, CUDD_REORDER_SIFT, 1)) {
+      return -1;
+    }
+    size[1 + tight] = Cudd_SharingSize(f, 8);
+    if (size[1 + tight] > size[0] || size[1 + tight] < bound) {
+      if (verbosity) {
+        printf("%d nodes before sifting, %d after, bound %d\n", size[0],
+               size[1 + tight], bound);
+      }
+      return -1;
+    }
+    for (k = 0; k < 8; k++) {
+      if (!sameFunction(dd, f[k], N, table[k])) {
+        if (verbosity) {
+          printf("sifting changed function %d\n", k);
+        }
+        return -1;
+      }
+      FREE(table[k]);
+      Cudd_RecursiveDeref(dd, f[k]);
+    }
+    if (checkManager(dd, verbosity) != 0) {
+      return -1;
+    }
+    Cudd_Quit(dd);
+  }
+  if (verbosity) {
+    printf("tight sifting: %d nodes, %d after sifting, %d with tight "
+           "sifting\n", size[0], size[1], size[2]);
+  }
+  return 0;
+}
+
+/**
+ * @brief Test of incremental sifting.
+ *
+ * @details After a full sifting, new variables are added and a
+ * function that uses them is built.  Incremental sifting must then
+ * sift some of the variables that grew, and none once the manager
+ * stops growing.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testIncrementalSifting(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f, *g;
+  char *tablef, *tableg;
+  int k, sifted, grown, still, ret;
+  unsigned int seed = 10;
+  int const N = 8; /* number of variables in each half */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  f = randomFunction(dd, N, 10, 4, &seed);
+  if (!f || !Cudd_ReduceHeap(dd, CUDD_REORDER_SIFT, 0)) {
+    return -1;
+  }
+  /* The second half of the variables is created after sifting. */
+  if (!Cudd_bddNewVarsAtLevel(dd, N, N, NULL)) {
+    return -1;
+  }
+  g = randomFunction(dd, 2 * N, 16, 4, &seed);
+  if (!g) {
+    return -1;
+  }
+  tablef = truthTable(dd, f, 2 * N);
+  tableg = truthTable(dd, g, 2 * N);
+  grown = still = 0;
+  for (k = 0; k < 2; k++) {
+    if (!Cudd_ReduceHeap(dd, CUDD_REORDER_SIFT_INCREMENTAL, 0) ||
+        Cudd_DebugCheck(dd) != 0) {
+      return -1;
+    }
+    (void) Cudd_ReadReorderingCoverage(dd, &sifted, NULL);
+    if (k == 0) {
+      grown = sifted > 0 && sifted <= 2 * N;
+    } else {
+      still = sifted == 0;
+    }
+    if (!sameFunction(dd, f, 2 * N, tablef) ||
+        !sameFunction(dd, g, 2 * N, tableg)) {
+      if (verbosity) {
+        printf("incremental sifting changed a function\n");
+      }
+      return -1;
+    }
+  }
+  if (verbosity) {
+    printf("incremental sifting: after growth %d, without growth %d\n",
+           grown, still);
+  }
+  Cudd_RecursiveDeref(dd, f);
+  Cudd_RecursiveDeref(dd, g);
+  FREE(tablef);
+  FREE(tableg);
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return grown && still ? ret : -1;
+}
+
+/**
+ * @brief Test of Cudd_Compact.
+ *
+ * @details Scatters the nodes with reorderings, compacts the heap
+ * explicitly and then after a reordering, and keeps computing with
+ * the relocated nodes.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testCompact(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f[4], *g;
+  char *table[4];
+  long m;
+  int i, moved, ret;
+  unsigned int seed = 11;
+  int const N = 14; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  for (i = 0; i < 4; i++) {
+    f[i] = randomFunction(dd, N, 12, 4, &seed);
+    if (!f[i]) {
+      return -1;
+    }
+    table[i] = truthTable(dd, f[i], N);
+  }
+  if (!Cudd_ReduceHeap(dd, CUDD_REORDER_RANDOM, 0) ||
+      !Cudd_ReduceHeap(dd, CUDD_REORDER_SIFT, 0)) {
+    return -1;
+  }
+  moved = Cudd_Compact(dd);
+  if (moved <= 0 || Cudd_DebugCheck(dd) != 0) {
+    if (verbosity) {
+      printf("compaction failed\n");
+    }
+    return -1;
+  }
+  Cudd_EnableCompaction(dd);
+  if (!Cudd_CompactionEnabled(dd) ||
+      !Cudd_ReduceHeap(dd, CUDD_REORDER_WINDOW3, 0) ||
+      Cudd_DebugCheck(dd) != 0) {
+    return -1;
+  }
+  for (i = 0; i < 4; i++) {
+    if (!sameFunction(dd, f[i], N, table[i])) {
+      if (verbosity) {
+        printf("compaction changed function %d\n", i);
+      }
+      return -1;
+    }
+  }
+  /* The unique table must still find the relocated nodes. */
+  g = Cudd_bddAnd(dd, f[0], Cudd_Not(f[1]));
+  if (!g) {
+    return -1;
+  }
+  Cudd_Ref(g);
+  FREE(table[3]);
+  table[3] = truthTable(dd, g, N);
+  for (m = 0; m < (1L << N); m++) {
+    if (table[3][m] != (table[0][m] && !table[1][m])) {
+      if (verbosity) {
+        printf("wrong result after compaction\n");
+      }
+      return -1;
+    }
+  }
+  if (verbosity) {
+    printf("compaction: nodes moved %d\n", moved > 0);
+  }
+  Cudd_RecursiveDeref(dd, g);
+  for (i = 0; i < 4; i++) {
+    Cudd_RecursiveDeref(dd, f[i]);
+    FREE(table[i]);
+  }
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return ret;
+}
+
+/**
+ * @brief Test of the release of node memory.
+ *
+ * @details Builds and frees many functions with a release threshold
+ * and checks that the garbage collections that follow give back node
+ * blocks without disturbing the function that is kept.  The count of
+ * allocated nodes drops with the blocks, but not the peak count.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testMemoryRelease(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f, *g[16], *h;
+  char *table;
+  DdMemoryBreakdown info;
+  size_t peak;
+  long peakNodes;
+  int i, collections, ret;
+  unsigned int seed = 5;
+  int const N = 16; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  if (Cudd_SetMemoryReleaseThreshold(dd, 0.5) != 0.0 ||
+      Cudd_ReadMemoryReleaseThreshold(dd) != 0.5) {
+    return -1;
+  }
+  f = randomFunction(dd, N, 8, 4, &seed);
+  if (!f) {
+    return -1;
+  }
+  table = truthTable(dd, f, N);
+  for (i = 0; i < 16; i++) {
+    g[i] = randomFunction(dd, N, 64, 6, &seed);
+    if (!g[i]) {
+      return -1;
+    }
+  }
+  peak = Cudd_ReadMemoryInUse(dd);
+  peakNodes = Cudd_ReadPeakNodeCount(dd);
+  if (Cudd_ReadAllocatedNodeCount(dd) != peakNodes) {
+    return -1;
+  }
+  collections = Cudd_ReadGarbageCollections(dd);
+  for (i = 0; i < 16; i++) {
+    Cudd_RecursiveDeref(dd, g[i]);
+  }
+  /* Keep computing until a collection takes place. */
+  for (i = 0; i < 64 && Cudd_ReadGarbageCollections(dd) == collections; i++) {
+    h = randomFunction(dd, N, 4, 3, &seed);
+    if (!h) {
+      return -1;
+    }
+    Cudd_RecursiveDeref(dd, h);
+  }
+  Cudd_ReadMemoryBreakdown(dd, &info);
+  if (info.releasedArena == 0 || Cudd_ReadMemoryInUse(dd) >= peak ||
+      Cudd_ReadAllocatedNodeCount(dd) >= peakNodes) {
+    if (verbosity) {
+      printf("no node memory released\n");
+    }
+    return -1;
+  }
+  if (Cudd_ReadPeakNodeCount(dd) != peakNodes) {
+    if (verbosity) {
+      printf("peak node count dropped\n");
+    }
+    return -1;
+  }
+  if (!sameFunction(dd, f, N, table) || Cudd_DebugCheck(dd) != 0) {
+    if (verbosity) {
+      printf("release changed the kept function\n");
+    }
+    return -1;
+  }
+  if (verbosity) {
+    printf("memory release: released %d, in use dropped %d\n",
+           info.releasedArena > 0, Cudd_ReadMemoryInUse(dd) < peak);
+  }
+  Cudd_RecursiveDeref(dd, f);
+  FREE(table);
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return ret;
+}
+
+/**
+ * @brief Test of the memory breakdown.
+ *
+ * @details Before and after the tables grow, the parts charged to the
+ * memory in use must add up to it, and the computed and unique tables
+ * must take the memory of their slots.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testMemoryBreakdown(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f, *g, *tmp;
+  DdMemoryBreakdown info;
+  unsigned int slots[2], cacheSlots[2];
+  size_t charged;
+  int i, k;
+  unsigned int seed = 41;
+  int const N = 24; /* number of variables */
+
+  dd = Cudd_Init(N, 0, 256, 256, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  f = Cudd_ReadLogicZero(dd);
+  Cudd_Ref(f);
+  for (k = 0; k < 2; k++) {
+    if (k == 1) {
+      for (i = 0; i < 64; i++) {
+        g = randomFunction(dd, N, 4, 6, &seed);
+        if (!g) {
+          return -1;
+        }
+        tmp = Cudd_bddXor(dd, f, g);
+        if (!tmp) {
+          return -1;
+        }
+        Cudd_Ref(tmp);
+        Cudd_RecursiveDeref(dd, g);
+        Cudd_RecursiveDeref(dd, f);
+        f = tmp;
+      }
+    }
+    Cudd_ReadMemoryBreakdown(dd, &info);
+    slots[k] = Cudd_ReadSlots(dd);
+    cacheSlots[k] = Cudd_ReadCacheSlots(dd);
+    charged = info.nodeArena + info.uniqueTable + info.variables +
+      info.cache + info.localCaches + info.deathRow + info.linear;
+    if (charged + info.other != Cudd_ReadMemoryInUse(dd) ||
+        info.total != charged + info.other + info.spillArena +
+        info.hashTables + info.interaction + info.stash +
+        info.reordering) {
+      if (verbosity) {
+        printf("breakdown adds up to %lu of %lu bytes in use\n",
+               (unsigned long) (charged + info.other),
+               (unsigned long) Cudd_ReadMemoryInUse(dd));
+      }
+      return -1;
+    }
+    if (info.uniqueTable != slots[k] * sizeof(DdNodePtr) ||
+        info.cache != (cacheSlots[k] + 1) * sizeof(DdCache)) {
+      if (verbosity) {
+        printf("%lu bytes for %u unique slots, %lu for %u cache slots\n",
+               (unsigned long) info.uniqueTable, slots[k],
+               (unsigned long) info.cache, cacheSlots[k]);
+      }
+      return -1;
+    }
+  }
+  if (slots[1] <= slots[0] || cacheSlots[1] <= cacheSlots[0]) {
+    if (verbosity) {
+      printf("tables did not grow\n");
+    }
+    return -1;
+  }
+  Cudd_RecursiveDeref(dd, f);
+  if (checkManager(dd, verbosity) != 0) {
+    return -1;
+  }
+  Cudd_Quit(dd);
+  if (verbosity) {
+    printf("memory breakdown: adds up to the memory in use as the tables "
+           "grow\n");
+  }
+  return 0;
+}
+
+/**
+ * @brief Test of the memory pressure handler.
+ *
+ * @details Fills the memory up to a limit with functions that the
+ * handler gives up, and checks that the computations that follow
+ * succeed once the limit is reached.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testMemoryPressure(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f, *h[128];
+  char *table;
+  Memo memo;
+  DdMemoryBreakdown info;
+  size_t limit;
+  int i, n, ret;
+  unsigned int seed = 9;
+  int const N = 16; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, 1 << 12, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  f = randomFunction(dd, N, 8, 4, &seed);
+  if (!f) {
+    return -1;
+  }
+  table = truthTable(dd, f, N);
+  memo.calls = 0;
+  for (i = 0; i < 16; i++) {
+    memo.f[i] = randomFunction(dd, N, 64, 6, &seed);
+    if (!memo.f[i]) {
+      return -1;
+    }
+  }
+  /* Leave no room for the remembered functions, even after the
+  ** computed table has been shrunk. */
+  Cudd_ReadMemoryBreakdown(dd, &info);
+  limit = Cudd_ReadMemoryInUse(dd) - info.cache - info.nodeArena / 2;
+  (void) Cudd_SetMaxMemory(dd, limit);
+  Cudd_RegisterMemoryPressureHandler(dd, pressureHandler, &memo);
+  /* Keep the new results until the handler is called. */
+  for (n = 0; n < 128 && memo.calls == 0; n++) {
+    h[n] = randomFunction(dd, N, 64, 6, &seed);
+    if (!h[n]) {
+      if (verbosity) {
+        printf("computation failed with error %d\n",
+               (int) Cudd_ReadErrorCode(dd));
+      }
+      return -1;
+    }
+  }
+  if (memo.calls == 0) {
+    if (verbosity) {
+      printf("memory pressure handler not called\n");
+    }
+    return -1;
+  }
+  for (i = 0; i < 16; i++) {
+    if (memo.f[i] != NULL) {
+      return -1;
+    }
+  }
+  if (!sameFunction(dd, f, N, table) || Cudd_DebugCheck(dd) != 0) {
+    if (verbosity) {
+      printf("memory pressure changed the kept function\n");
+    }
+    return -1;
+  }
+  if (verbosity) {
+    printf("memory pressure: handler called %d\n", memo.calls > 0);
+  }
+  Cudd_RegisterMemoryPressureHandler(dd, NULL, NULL);
+  for (i = 0; i < n; i++) {
+    Cudd_RecursiveDeref(dd, h[i]);
+  }
+  Cudd_RecursiveDeref(dd, f);
+  FREE(table);
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return ret;
+}
+
+/**
+ * @brief Test of the spill file.
+ *
+ * @details Keeps the nodes in a spill file, pages out the bottom half
+ * of the order, and checks that the functions are unchanged and can
+ * still be operated on.  On platforms without memory-mapped files
+ * only the results are checked.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testSpill(int verbosity)
+{
+  DdManager *dd;
+  DdNode *f[4], *g;
+  char *table[4];
+  DdMemoryBreakdown info;
+  long m;
+  int i, enabled, pages, ret;
+  unsigned int seed = 13;
+  int const N = 16; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  enabled = Cudd_EnableSpill(dd, "extra_spill.tmp");
+  for (i = 0; i < 4; i++) {
+    f[i] = randomFunction(dd, N, 48, 5, &seed);
+    if (!f[i]) {
+      return -1;
+    }
+    table[i] = truthTable(dd, f[i], N);
+  }
+  pages = Cudd_SpillLevels(dd, N / 2, N - 1);
+  Cudd_ReadMemoryBreakdown(dd, &info);
+  if (enabled && (pages <= 0 || info.spillArena == 0)) {
+    if (verbosity) {
+      printf("nothing paged out\n");
+    }
+    return -1;
+  }
+  if (Cudd_DebugCheck(dd) != 0) {
+    return -1;
+  }
+  for (i = 0; i < 4; i++) {
+    if (!sameFunction(dd, f[i], N, table[i])) {
+      if (verbosity) {
+        printf("spilling changed function %d\n", i);
+      }
+      return -1;
+    }
+  }
+  g = Cudd_bddOr(dd, f[2], f[3]);
+  if (!g) {
+    return -1;
+  }
+  Cudd_Ref(g);
+  FREE(table[0]);
+  table[0] = truthTable(dd, g, N);
+  for (m = 0; m < (1L << N); m++) {
+    if (table[0][m] != (table[2][m] || table[3][m])) {
+      if (verbosity) {
+        printf("wrong result after spilling\n");
+      }
+      return -1;
+    }
+  }
+  if (verbosity) {
+    printf("spill: functions preserved after paging out levels %d to %d\n",
+           N / 2, N - 1);
+  }
+  Cudd_RecursiveDeref(dd, g);
+  for (i = 0; i < 4; i++) {
+    Cudd_RecursiveDeref(dd, f[i]);
+    FREE(table[i]);
+  }
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return ret;
+}
+
+/**
+ * @brief Test of Cudd_CloneManager.
+ *
+ * @details Copies a reordered manager with and without its computed
+ * table, and checks that the copies have the same order and functions
+ * and that only the copied computed table remembers a result computed
+ * in the original.  The reordering trigger of the original is not
+ * copied.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testClone(int verbosity)
+{
+  DdManager *dd, *clone;
+  DdNode *f[4], *images[4];
+  char *table[4];
+  double hits, lookups;
+  int i, leq, copyCache, found[2], ret;
+  unsigned int seed = 17;
+  int const N = 12; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  for (i = 0; i < 4; i++) {
+    f[i] = randomFunction(dd, N, 16, 4, &seed);
+    if (!f[i]) {
+      return -1;
+    }
+    table[i] = truthTable(dd, f[i], N);
+  }
+  if (!Cudd_ReduceHeap(dd, CUDD_REORDER_SIFT, 0)) {
+    return -1;
+  }
+  /* The containment check is only cached for shared operands.  Its
+  ** entry does not depend on the order of the operands in memory,
+  ** which changes in the copy. */
+  Cudd_Ref(f[0]);
+  leq = Cudd_bddLeq(dd, Cudd_Regular(f[0]), Cudd_Regular(f[1]));
+  Cudd_SetReorderingTrigger(dd, Cudd_AdaptiveReorderingTrigger, NULL);
+  for (copyCache = 0; copyCache < 2; copyCache++) {
+    clone = Cudd_CloneManager(dd, f, images, 4, copyCache);
+    if (!clone) {
+      if (verbosity) {
+        printf("cloning failed\n");
+      }
+      return -1;
+    }
+    if (Cudd_DebugCheck(clone) != 0) {
+      return -1;
+    }
+    if (Cudd_ReadReorderingTrigger(clone, NULL) != NULL) {
+      if (verbosity) {
+        printf("clone has the reordering trigger\n");
+      }
+      return -1;
+    }
+    for (i = 0; i < N; i++) {
+      if (Cudd_ReadPerm(clone, i) != Cudd_ReadPerm(dd, i)) {
+        if (verbosity) {
+          printf("clone has a different order\n");
+        }
+        return -1;
+      }
+    }
+    for (i = 0; i < 4; i++) {
+      if (!sameFunction(clone, images[i], N, table[i])) {
+        if (verbosity) {
+          printf("clone changed function %d\n", i);
+        }
+        return -1;
+      }
+    }
+    hits = Cudd_ReadCacheHits(clone);
+    lookups = Cudd_ReadCacheLookUps(clone);
+    if (Cudd_bddLeq(clone, Cudd_Regular(images[0]),
+                    Cudd_Regular(images[1])) != leq) {
+      return -1;
+    }
+    found[copyCache] = Cudd_ReadCacheHits(clone) - hits == 1.0 &&
+      Cudd_ReadCacheLookUps(clone) - lookups == 1.0;
+    Cudd_RecursiveDeref(clone, images[0]);
+    for (i = 0; i < 4; i++) {
+      Cudd_RecursiveDeref(clone, images[i]);
+    }
+    ret = checkManager(clone, verbosity);
+    Cudd_Quit(clone);
+    if (ret != 0) {
+      return -1;
+    }
+  }
+  if (found[0] || !found[1]) {
+    if (verbosity) {
+      printf("computed table %s\n", found[0] ? "copied" : "not copied");
+    }
+    return -1;
+  }
+  if (verbosity) {
+    printf("clone: without cache %d, with cache %d\n", found[0], found[1]);
+  }
+  Cudd_RecursiveDeref(dd, f[0]);
+  for (i = 0; i < 4; i++) {
+    Cudd_RecursiveDeref(dd, f[i]);
+    FREE(table[i]);
+  }
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return ret;
+}
+
+/**
+ * @brief Test of Cudd_bddTransferVector.
+ *
+ * @details Transfers functions that share nodes to a manager with the
+ * same order and to one with the reverse order, compares the results
+ * with those of Cudd_bddTransfer, and brings them back to the source.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testTransferVector(int verbosity)
+{
+  DdManager *dd, *dest[2];
+  DdNode *f[5], *g[5], *back[5], *h;
+  char *table[5];
+  int perm[12];
+  int i, j, ret;
+  unsigned int seed = 21;
+  int const N = 12; /* number of variables */
+
+  dd = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+  for (i = 0; i < 4; i++) {
+    f[i] = randomFunction(dd, N, 16, 4, &seed);
+    if (!f[i]) {
+      return -1;
+    }
+  }
+  /* Share nodes with the other functions. */
+  f[4] = Cudd_bddAnd(dd, f[0], Cudd_Not(f[1]));
+  if (!f[4]) {
+    return -1;
+  }
+  Cudd_Ref(f[4]);
+  for (i = 0; i < 5; i++) {
+    table[i] = truthTable(dd, f[i], N);
+  }
+  for (i = 0; i < N; i++) {
+    perm[i] = N - 1 - i;
+  }
+  for (j = 0; j < 2; j++) {
+    dest[j] = Cudd_Init(N, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+    if (!dest[j]) {
+      return -1;
+    }
+    if (j == 1 && !Cudd_ShuffleHeap(dest[j], perm)) {
+      return -1;
+    }
+    if (!Cudd_bddTransferVector(dd, dest[j], f, g, 5)) {
+      if (verbosity) {
+        printf("transfer failed\n");
+      }
+      return -1;
+    }
+    for (i = 0; i < 5; i++) {
+      if (!sameFunction(dest[j], g[i], N, table[i])) {
+        if (verbosity) {
+          printf("transfer changed function %d\n", i);
+        }
+        return -1;
+      }
+      h = Cudd_bddTransfer(dd, dest[j], f[i]);
+      if (h != g[i]) {
+        return -1;
+      }
+    }
+    if (!Cudd_bddTransferVector(dest[j], dd, g, back, 5)) {
+      return -1;
+    }
+    for (i = 0; i < 5; i++) {
+      if (back[i] != f[i]) {
+        if (verbosity) {
+          printf("function %d not restored\n", i);
+        }
+        return -1;
+      }
+      Cudd_RecursiveDeref(dd, back[i]);
+      Cudd_RecursiveDeref(dest[j], g[i]);
+    }
+    ret = checkManager(dest[j], verbosity);
+    Cudd_Quit(dest[j]);
+    if (ret != 0) {
+      return -1;
+    }
+  }
+  if (verbosity) {
+    printf("transfer: 5 functions to the same and the reverse order\n");
+  }
+  for (i = 0; i < 5; i++) {
+    Cudd_RecursiveDeref(dd, f[i]);
+    FREE(table[i]);
+  }
+  ret = checkManager(dd, verbosity);
+  Cudd_Quit(dd);
+  return ret;
+}
+
+/**
+ * @brief Basic test of timeout handler.
+ *
+ * @details Sets a short timeout and then tries to build a function
+ * with a large BDD.  Strives to avoid leaking nodes.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+testTimeout(int verbosity)
+{
+  DdManager *dd;
+  /* Declare these "volatile" to prevent clobbering by longjmp. */
+  DdNode * volatile f;
+  DdNode * volatile clause = NULL;
+  DdNode * var1, * var2;
+  int i, ret, count;
+  int const N = 20; /* half the number of variables in f */
+  unsigned long timeout = 100UL; /* in milliseconds */
+  jmp_buf timeoutEnv;
+
+  dd = Cudd_Init(0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  if (!dd) {
+    if (verbosity) {
+      printf("initialization failed\n");
+    }
+    return -1;
+  }
+
+  /* Set up timeout handling. */
+  if (setjmp(timeoutEnv) > 0) {
+    if (verbosity) {
+      printf("caught timeout\n");
+    }
+    /* The nodes of clause may be leaked if the timeout was
+     * detected while conjoining the clause to f.  We set
+     * clause to NULL when it's not in use to be able to
+     * detect this case.
+     */
+    if (clause)
+      Cudd_RecursiveDeref(dd, clause);
+    goto finally;
+  }
+  (void) Cudd_RegisterTimeoutHandler(dd, timeoutHandler, (void *) &timeoutEnv);
+  (void) Cudd_SetTimeLimit(dd, timeout);
+
+  /* Try to build function.  This is expected to run out of time. */
+  f = Cudd_ReadOne(dd);
+  Cudd_Ref(f);
+  for (i = 0; i < N; i++) {
+    DdNode * tmp;
+    var1 = Cudd_bddIthVar(dd, i);
+    if (!var1) {
+      if (verbosity) {
+        printf("computation failed\n");
+        return -1;
+      }
+    }
+    var2 = Cudd_bddIthVar(dd, i+N);
+    if (!var2) {
+      if (verbosity) {
+        printf("computation failed\n");
+        return -1;
+      }
+    }
+    clause = Cudd_bddOr(dd, var1, var2);
+    if (!clause) {
+      if (verbosity) {
+        printf("computation failed\n");
+      }
+      return -1;
+    }
+    Cudd_Ref(clause);
+    tmp = Cudd_bddAnd(dd, f, clause);
+    if (!tmp) {
+      if (verbosity) {
+        printf("computation failed\n");
+      }
+      return -1;
+    }
+    Cudd_Ref(tmp);
+    Cudd_RecursiveDeref(dd, clause);
+    clause = NULL;
+    Cudd_RecursiveDeref(dd, f);
+    f = tmp;
+  }
+  if (verbosity > 1) {
+    Cudd_bddPrintCover(dd, f, f);
+  }
+
+ finally:
+  if (verbosity) {
+    printf("so far");
+    Cudd_PrintSummary(dd, f, 2*N, 0);
+  }
+  count = 0;
+  for (i = 0; i < N-1; i += 2) {
+    var1 = Cudd_bddIthVar(dd, i);
+    if (!var1) {
+      printf("computation failed\n");
+      return -1;
+    }
+    var2 = Cudd_bddIthVar(dd, i+1);
+    if (!var2) {
+      printf("computation failed\n");
+      return -1;
+    }
+    clause = Cudd_bddOr(dd, var1, var2);
+    if (!clause) {
+      printf("computation failed\n");
+      return -1;
+    }
+    Cudd_Ref(clause);
+    if (Cudd_bddLeq(dd, f, clause)) {
+      count++;
+    }
+    Cudd_RecursiveDeref(dd, clause);
+  }
+  if (verbosity) {
+    printf("f implies %d clauses\n", count);
+  }
+  Cudd_RecursiveDeref(dd, f);
+  ret = Cudd_CheckZeroRef(dd);
+  if (verbosity) {
+    Cudd_PrintInfo(dd, stdout);
+    if (ret != 0) {
+      printf("%d non-zero references\n", ret);
+    }
+  }
+  Cudd_Quit(dd);
+  return 0;
+}
+
+/**
+ * @brief Timeout handler.
+ */
+static void
+timeoutHandler(DdManager * dd, void * arg)
+{
+  jmp_buf * timeoutEnv = (jmp_buf *) arg;
+  /* Reset manager. */
+  Cudd_ClearErrorCode(dd);
+  Cudd_UnsetTimeLimit(dd);
+  Cudd_RegisterTimeoutHandler(dd, NULL, NULL);
+
+  longjmp(*timeoutEnv, 1);
+}
+
+/**
+ * @brief Reordering trigger that records its calls.
+ *
+ * @return the answer set in the TriggerLog.
+ */
+static int
+logTrigger(DdManager * dd, void * arg)
+{
+  TriggerLog * log = (TriggerLog *) arg;
+
+  (void) dd;
+  log->calls++;
+  return log->answer;
+}
+
+/**
+ * @brief Telemetry callback that counts the events of each type.
+ */
+static void
+countEvent(DdManager * dd, DdReorderEvent const * event, void * arg)
+{
+  EventLog * log = (EventLog *) arg;
+
+  log->count[event->type]++;
+  if (event->type == CUDD_REORDER_EVENT_SIFT) {
+    if (event->index < 0 || event->index >= Cudd_ReadSize(dd) ||
+        event->sizeAfter > event->sizeBefore) {
+      log->bad++;
+    }
+  } else if (event->index != -1) {
+    log->bad++;
+  }
+}
+
+/**
+ * @brief Skips a JSON value.
+ *
+ * @details Only accepts what the reordering summary may contain:
+ * objects, strings without escapes, and numbers.
+ *
+ * @return 1 if a value was skipped; 0 otherwise.
+ */
+static int
+skipJson(char const ** s)
+{
+  char *end;
+
+  while (isspace((unsigned char) **s)) (*s)++;
+  if (**s == '{') {
+    (*s)++;
+    while (isspace((unsigned char) **s)) (*s)++;
+    if (**s == '}') {
+      (*s)++;
+    } else {
+      for (;;) {
+        if (**s != '"' || !skipJson(s)) return 0;
+        while (isspace((unsigned char) **s)) (*s)++;
+        if (**s != ':') return 0;
+        (*s)++;
+        if (!skipJson(s)) return 0;
+        while (isspace((unsigned char) **s)) (*s)++;
+        if (**s == '}') {
+          (*s)++;
+          break;
+        }
+        if (**s != ',') return 0;
+        (*s)++;
+        while (isspace((unsigned char) **s)) (*s)++;
+      }
+    }
+  } else if (**s == '"') {
+    for ((*s)++; **s != '"'; (*s)++) {
+      if (**s == '\0' || **s == '\\') return 0;
+    }
+    (*s)++;
+  } else if (**s == '-' || isdigit((unsigned char) **s)) {
+    (void) strtod(*s, &end);
+    *s = end;
+  } else {
+    return 0;
+  }
+  while (isspace((unsigned char) **s)) (*s)++;
+  return 1;
+}
+
+/**
+ * @brief Memory pressure handler.
+ *
+ * @details Gives up the functions remembered in the Memo.
+ */
+static void
+pressureHandler(DdManager * dd, void * arg)
+{
+  Memo * memo = (Memo *) arg;
+  int i;
+
+  memo->calls++;
+  for (i = 0; i < 16; i++) {
+    if (memo->f[i] != NULL) {
+      Cudd_RecursiveDeref(dd, memo->f[i]);
+      memo->f[i] = NULL;
+    }
+  }
+}
+
+/**
+ * @brief Builds a random sum of products.
+ *
+ * @details The function is the disjunction of ncubes cubes of width
+ * literals over the first n variables.  The pseudo-random sequence
+ * depends only on seed, so that the output is the same everywhere.
+ *
+ * @return the referenced function if successful; NULL otherwise.
+ */
+static DdNode *
+randomFunction(DdManager * dd, int n, int ncubes, int width,
+               unsigned int * seed)
+{
+  DdNode *f, *cube, *tmp, *var;
+  int i, j;
+
+  f = Cudd_ReadLogicZero(dd);
+  Cudd_Ref(f);
+  for (i = 0; i < ncubes; i++) {
+    cube = Cudd_ReadOne(dd);
+    Cudd_Ref(cube);
+    for (j = 0; j < width; j++) {
+      *seed = *seed * 1103515245U + 12345U;
+      var = Cudd_bddIthVar(dd, (int) ((*seed >> 16) % (unsigned) n));
+      if (!var) {
+        return NULL;
+      }
+      tmp = Cudd_bddAnd(dd, cube, Cudd_NotCond(var, (*seed >> 8) & 1));
+      if (!tmp) {
+        return NULL;
+      }
+      Cudd_Ref(tmp);
+      Cudd_RecursiveDeref(dd, cube);
+      cube = tmp;
+    }
+    tmp = Cudd_bddOr(dd, f, cube);
+    if (!tmp) {
+      return NULL;
+    }
+    Cudd_Ref(tmp);
+    Cudd_RecursiveDeref(dd, cube);
+    Cudd_RecursiveDeref(dd, f);
+    f = tmp;
+  }
+  return f;
+}
+
+/**
+ * @brief Evaluates a BDD for all assignments to its first n variables.
+ *
+ * @details Variable i has the value of bit i of the assignment; the
+ * other variables are 0.
+ *
+ * @return an array of 2^n values allocated with ALLOC; NULL if
+ * out of memory.
+ */
+static char *
+truthTable(DdManager * dd, DdNode * f, int n)
+{
+  char *table;
+  int *inputs;
+  int size = Cudd_ReadSize(dd);
+  long m, minterms = 1L << n;
+  int i;
+
+  table = ALLOC(char, minterms);
+  inputs = ALLOC(int, size > n ? size : n);
+  if (!table || !inputs) {
+    return NULL;
+  }
+  for (i = 0; i < (size > n ? size : n); i++) {
+    inputs[i] = 0;
+  }
+  for (m = 0; m < minterms; m++) {
+    for (i = 0; i < n; i++) {
+      inputs[i] = (int) ((m >> i) & 1);
+    }
+    table[m] = Cudd_Eval(dd, f, inputs) == Cudd_ReadOne(dd);
+  }
+  FREE(inputs);
+  return table;
+}
+
+/**
+ * @brief Checks a BDD against a table built by truthTable.
+ * @return 1 if the BDD has the tabulated values; 0 otherwise.
+ */
+static int
+sameFunction(DdManager * dd, DdNode * f, int n, char const * table)
+{
+  char *other;
+  long m;
+  int same;
+
+  other = truthTable(dd, f, n);
+  if (!other) {
+    return 0;
+  }
+  same = 1;
+  for (m = 0; m < (1L << n); m++) {
+    if (other[m] != table[m]) {
+      same = 0;
+      break;
+    }
+  }
+  FREE(other);
+  return same;
+}
+
+/**
+ * @brief Checks the consistency of the manager and its references.
+ *
+ * @details Meant to be called when the caller holds no references.
+ *
+ * @return 0 if successful; -1 otherwise.
+ */
+static int
+checkManager(DdManager * dd, int verbosity)
+{
+  int ret;
+
+  if (Cudd_DebugCheck(dd) != 0) {
+    if (verbosity) {
+      printf("inconsistent manager\n");
+    }
+    return -1;
+  }
+  ret = Cudd_CheckZeroRef(dd);
+  if (ret != 0) {
+    if (verbosity) {
+      printf("%d non-zero references\n", ret);
+    }
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Reads a whole file.
+ * @return a buffer allocated with ALLOC if successful; NULL otherwise.
+ */
+static char *
+readFile(char const * path, long * size)
+{
+  FILE *fp;
+  char *buf;
+
+  fp = fopen(path, "rb");
+  if (!fp) {
+    return NULL;
+  }
+  if (fseek(fp, 0L, SEEK_END) != 0 || (*size = ftell(fp)) <= 0 ||
+      fseek(fp, 0L, SEEK_SET) != 0) {
+    fclose(fp);
+    return NULL;
+  }
+  buf = ALLOC(char, *size);
+  if (buf && fread(buf, 1, (size_t) *size, fp) != (size_t) *size) {
+    FREE(buf);
+    buf = NULL;
+  }
+  fclose(fp);
+  return buf;
 }
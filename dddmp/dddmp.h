@@ -67,6 +67,9 @@ extern "C" {
 
 #define DDDMP_MODE_TEXT           ((int)'A')
 #define DDDMP_MODE_BINARY         ((int)'B')
+#define DDDMP_MODE_STREAM         ((int)'S')
+#define DDDMP_MODE_COMPACT        ((int)'C')
+#define DDDMP_MODE_SEGMENTED      ((int)'G')
 #define DDDMP_MODE_DEFAULT        ((int)'D')
 
 /*---------------------------------------------------------------------------*/
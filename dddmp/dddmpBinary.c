@@ -33,6 +33,7 @@
 
 ******************************************************************************/
 
+#include <limits.h>
 #include "dddmpInt.h"
 
 /*---------------------------------------------------------------------------*/
@@ -59,6 +60,11 @@
 
 static int WriteByteBinary(FILE *fp, unsigned char c);
 static int ReadByteBinary(FILE *fp, unsigned char *cp);
+static int ReadByteBuffer(unsigned char **pbuf, unsigned char *end, unsigned char *cp);
+static int StreamFlush(Dddmp_Stream_t *stream);
+static int StreamFill(Dddmp_Stream_t *stream);
+static int StreamPutByte(Dddmp_Stream_t *stream, unsigned char c);
+static int StreamGetByte(Dddmp_Stream_t *stream, unsigned char *cp);
 
 /**AutomaticEnd***************************************************************/
 
@@ -230,6 +236,481 @@ DddmpReadInt (
   return (i+1);
 }
 
+/**Function********************************************************************
+
+  Synopsis    [Reads a 1 byte node code from a memory buffer]
+
+  Description [Reads a 1 byte node code from the buffer pointed by
+    *pbuf, and advances *pbuf past the (possibly escaped) byte.
+    The buffer holds the same byte sequence written by DddmpWriteCode(),
+    e.g., the node section of a binary file mapped in memory.
+    Returns 1 on success, 0 if the end of the buffer is reached.]
+
+  SideEffects [*pbuf is advanced]
+
+  SeeAlso     [DddmpReadCode() DddmpReadIntBuf()]
+
+******************************************************************************/
+
+int
+DddmpReadCodeBuf (
+  unsigned char **pbuf         /* IN/OUT: current position in the buffer */,
+  unsigned char *end           /* IN: end of the buffer */,
+  struct binary_dd_code *pcode /* OUT: the read code */
+  )
+{
+  unsigned char c;
+
+  if (ReadByteBuffer (pbuf, end, &c) == 0) {
+    return (0);
+  }
+
+  pcode->Unused =  c>>7;
+  pcode->V      = (c>>5) & 3;
+  pcode->T      = (c>>3) & 3;
+  pcode->Ecompl = (c>>2) & 1;
+  pcode->E      =  c     & 3;
+
+  return (1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Reads a "packed integer" from a memory buffer]
+
+  Description [Reads an integer coded on a sequence of bytes from the
+    buffer pointed by *pbuf. See DddmpWriteInt() for format.
+    Returns the number of bytes read (not counting escapes), 0 on failure.]
+
+  SideEffects [*pbuf is advanced]
+
+  SeeAlso     [DddmpReadInt() DddmpReadCodeBuf()]
+
+******************************************************************************/
+
+int
+DddmpReadIntBuf (
+  unsigned char **pbuf  /* IN/OUT: current position in the buffer */,
+  unsigned char *end    /* IN: end of the buffer */,
+  int *pid              /* OUT: the read integer */
+  )
+{
+  unsigned char c;
+  int i;
+  unsigned int id;
+
+  id = 0;
+  for (i=0; i<4; i++) {
+    if (ReadByteBuffer (pbuf, end, &c) == 0)
+      return (0);
+    id = (id<<7) | (c>>1);
+    if ((c & 1) == 0)
+      break;
+  }
+
+  if (i>=4) {
+    return (0);
+  }
+
+  *pid = id;
+
+  return (i+1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Opens a buffered stream on a file]
+
+  Description [Allocates a buffer of DDDMP_STREAM_CHUNK bytes and
+    associates it with fp, for reading (output=0) or writing (output=1).
+    Returns 1 on success, 0 on failure.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpStreamClose()]
+
+******************************************************************************/
+
+int
+DddmpStreamOpen (
+  Dddmp_Stream_t *stream  /* OUT: the stream */,
+  FILE *fp                /* IN: file */,
+  int output              /* IN: 1 for output, 0 for input */
+  )
+{
+  stream->fp = fp;
+  stream->size = DDDMP_STREAM_CHUNK;
+  stream->pos = 0;
+  stream->len = 0;
+  stream->output = output;
+  stream->bits = 0;
+  stream->nbits = 0;
+  stream->buf = DDDMP_ALLOC (unsigned char, stream->size);
+
+  return (stream->buf != NULL);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Opens an input stream on a memory buffer]
+
+  Description [The bytes from buf to end (excluded), with escapes, are
+    read as if they came from a file. The buffer is neither copied nor
+    freed by DddmpStreamClose(). Returns 1 on success, 0 if the buffer is
+    too large.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpStreamOpen() DddmpStreamClose()]
+
+******************************************************************************/
+
+int
+DddmpStreamOpenBuffer (
+  Dddmp_Stream_t *stream  /* OUT: the stream */,
+  unsigned char *buf      /* IN: first byte of the buffer */,
+  unsigned char *end      /* IN: one past the last byte of the buffer */
+  )
+{
+  if (end - buf > INT_MAX) {
+    return (0);
+  }
+
+  stream->fp = NULL;
+  stream->buf = buf;
+  stream->size = stream->len = (int) (end - buf);
+  stream->pos = 0;
+  stream->output = 0;
+  stream->bits = 0;
+  stream->nbits = 0;
+
+  return (1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Closes a buffered stream]
+
+  Description [Output streams are flushed, after padding the pending
+    bits, if any, with zeros up to a full byte. For input streams the
+    bytes read from file and not yet consumed are given back,
+    repositioning the file, so that the caller may go on reading from
+    fp; the pending bits of a partially read byte are dropped. The buffer
+    is freed in any case, unless it was given to DddmpStreamOpenBuffer(),
+    and the file is not closed. Returns 1 on success, 0 on failure.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpStreamOpen()]
+
+******************************************************************************/
+
+int
+DddmpStreamClose (
+  Dddmp_Stream_t *stream  /* IN: the stream */
+  )
+{
+  int retValue = 1;
+
+  if (stream->buf == NULL) {
+    return (0);
+  }
+
+  if (stream->fp == NULL) {
+    stream->buf = NULL;
+    return (1);
+  }
+
+  if (stream->output) {
+    if (stream->nbits > 0) {
+      retValue = StreamPutByte (stream,
+        (unsigned char) (stream->bits << (8 - stream->nbits)));
+    }
+    retValue = StreamFlush (stream) && retValue;
+  } else if (stream->pos < stream->len) {
+    retValue = (fseek (stream->fp, (long) (stream->pos - stream->len),
+      SEEK_CUR) == 0);
+  }
+
+  DDDMP_FREE (stream->buf);
+  stream->buf = NULL;
+
+  return (retValue);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Writes an unsigned integer to a stream]
+
+  Description [The integer is coded as a LEB128 sequence of bytes: 7 bits
+    per byte, least significant group first, the most significant bit
+    of each byte being set iff more bytes follow. Bytes are escaped as
+    in WriteByteBinary(). Returns the number of bytes written (not
+    counting escapes), 0 on failure.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpStreamReadUint()]
+
+******************************************************************************/
+
+int
+DddmpStreamWriteUint (
+  Dddmp_Stream_t *stream  /* IN: output stream */,
+  unsigned int n         /* IN: integer to be written */
+  )
+{
+  int i = 0;
+
+  do {
+    unsigned char c = (unsigned char) (n & 0x7f);
+
+    n >>= 7;
+    if (n != 0) {
+      c |= 0x80;
+    }
+    if (StreamPutByte (stream, c) == 0) {
+      return (0);
+    }
+    i++;
+  } while (n != 0);
+
+  return (i);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Reads an unsigned integer from a stream]
+
+  Description [Reads an integer written by DddmpStreamWriteUint().
+    Returns the number of bytes read (not counting escapes), 0 on failure
+    or if the integer does not fit an unsigned int.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpStreamWriteUint()]
+
+******************************************************************************/
+
+int
+DddmpStreamReadUint (
+  Dddmp_Stream_t *stream  /* IN: input stream */,
+  unsigned int *pn        /* OUT: the read integer */
+  )
+{
+  unsigned char c;
+  unsigned int n = 0;
+  int shift = 0;
+  int i = 0;
+
+  do {
+    if (shift >= (int) (8*sizeof(unsigned int)) ||
+      StreamGetByte (stream, &c) == 0) {
+      return (0);
+    }
+    n |= ((unsigned int) (c & 0x7f)) << shift;
+    shift += 7;
+    i++;
+  } while (c & 0x80);
+
+  *pn = n;
+
+  return (i);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Writes a sequence of bits to a stream]
+
+  Description [Writes the nbits (at most 32) least significant bits of
+    n, most significant first. Bits are packed into bytes, which are
+    escaped as in WriteByteBinary(); a partial byte is completed by the
+    next call or padded with zeros by DddmpStreamClose(). Returns 1 on
+    success, 0 on failure.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpStreamWriteGolomb() DddmpStreamReadBit()]
+
+******************************************************************************/
+
+int
+DddmpStreamWriteBits (
+  Dddmp_Stream_t *stream  /* IN: output stream */,
+  unsigned int n          /* IN: bits to be written */,
+  int nbits               /* IN: number of bits */
+  )
+{
+  while (nbits > 0) {
+    nbits--;
+    stream->bits = (stream->bits << 1) | ((n >> nbits) & 1);
+    if (++stream->nbits == 8) {
+      if (StreamPutByte (stream, (unsigned char) stream->bits) == 0) {
+        return (0);
+      }
+      stream->bits = 0;
+      stream->nbits = 0;
+    }
+  }
+
+  return (1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Reads a bit from a stream]
+
+  Description [Reads a bit written by DddmpStreamWriteBits(). Returns 1
+    on success, 0 at end of file or on failure.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpStreamWriteBits() DddmpStreamReadGolomb()]
+
+******************************************************************************/
+
+int
+DddmpStreamReadBit (
+  Dddmp_Stream_t *stream  /* IN: input stream */,
+  unsigned int *pbit      /* OUT: the read bit */
+  )
+{
+  unsigned char c;
+
+  if (stream->nbits == 0) {
+    if (StreamGetByte (stream, &c) == 0) {
+      return (0);
+    }
+    stream->bits = c;
+    stream->nbits = 8;
+  }
+  stream->nbits--;
+  *pbit = (stream->bits >> stream->nbits) & 1;
+
+  return (1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Writes an Exp-Golomb code to a stream]
+
+  Description [Writes n (smaller than 2^31) as an Exp-Golomb code of
+    order k: if m = n + 2^k has b+1 significant bits, b-k zeros are
+    written followed by the b+1 bits of m. Small values thus take few
+    bits: with k=0, 0 takes 1 bit and 1 or 2 take 3 bits; with k=1, 0 or
+    1 take 2 bits. Returns 1 on success, 0 on failure.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpStreamReadGolomb() DddmpStreamWriteBits()]
+
+******************************************************************************/
+
+int
+DddmpStreamWriteGolomb (
+  Dddmp_Stream_t *stream  /* IN: output stream */,
+  unsigned int n          /* IN: integer to be written */,
+  int k                   /* IN: order of the code */
+  )
+{
+  unsigned int m = n + (1U << k);
+  int b = 0;
+
+  while ((m >> b) > 1) {
+    b++;
+  }
+
+  return (DddmpStreamWriteBits (stream, 0, b-k) &&
+    DddmpStreamWriteBits (stream, m, b+1));
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Reads an Exp-Golomb code from a stream]
+
+  Description [Reads an integer written by DddmpStreamWriteGolomb() with
+    the same order k. Returns 1 on success, 0 on failure or if the code
+    is too long for an integer.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpStreamWriteGolomb()]
+
+******************************************************************************/
+
+int
+DddmpStreamReadGolomb (
+  Dddmp_Stream_t *stream  /* IN: input stream */,
+  int k                   /* IN: order of the code */,
+  unsigned int *pn        /* OUT: the read integer */
+  )
+{
+  unsigned int bit, m;
+  int b = k;
+
+  for (;;) {
+    if (DddmpStreamReadBit (stream, &bit) == 0) {
+      return (0);
+    }
+    if (bit) {
+      break;
+    }
+    if (++b > 30) {
+      return (0);
+    }
+  }
+
+  for (m=1; b>0; b--) {
+    if (DddmpStreamReadBit (stream, &bit) == 0) {
+      return (0);
+    }
+    m = (m << 1) | bit;
+  }
+  *pn = m - (1U << k);
+
+  return (1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Reads a line of text from a stream]
+
+  Description [Same as fgets(), but reads from an input stream. Used to
+    read the text lines that follow the node section of a file.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpStreamReadUint()]
+
+******************************************************************************/
+
+char *
+DddmpStreamGets (
+  Dddmp_Stream_t *stream  /* IN: input stream */,
+  char *str               /* OUT: the read line */,
+  int n                   /* IN: size of str */
+  )
+{
+  int i = 0;
+
+  while (i < n-1) {
+    if (stream->pos >= stream->len && StreamFill (stream) == 0) {
+      break;
+    }
+    str[i++] = (char) stream->buf[stream->pos++];
+    if (str[i-1] == '\n') {
+      break;
+    }
+  }
+
+  if (i == 0) {
+    return (NULL);
+  }
+  str[i] = '\0';
+
+  return (str);
+}
+
 /*---------------------------------------------------------------------------*/
 /* Definition of static functions                                            */
 /*---------------------------------------------------------------------------*/
@@ -340,4 +821,218 @@ ReadByteBinary (
   return (1);
 }
 
+/**Function********************************************************************
+
+  Synopsis    [Reads a byte from a memory buffer with escaped <CR>, <LF>
+    and <ctrl-Z>]
+
+  Description [Buffer counterpart of ReadByteBinary(). Returns 1 on
+    success, 0 if the end of the buffer is reached.]
+
+  SideEffects [*pbuf is advanced]
+
+  SeeAlso     [ReadByteBinary()]
+
+******************************************************************************/
+
+static int
+ReadByteBuffer (
+  unsigned char **pbuf  /* IN/OUT: current position in the buffer */,
+  unsigned char *end    /* IN: end of the buffer */,
+  unsigned char *cp     /* OUT: the read byte */
+  )
+{
+  unsigned char *p = *pbuf;
+
+  if (p >= end) {
+    return (0);
+  }
+
+  *cp = *p++;
+
+  if (*cp == 0x00) { /* Escape */
+    if (p >= end) {
+      return (0);
+    }
+    *cp = *p++;
+
+    switch (*cp) {
+
+      case 0x00: /* Escape */
+        break;
+      case 0x01: /* <LF> */
+        *cp = 0x0a;
+        break;
+      case 0x02: /* <CR> */
+        *cp = 0x0d;
+        break;
+      case 0x03: /* <ctrl-Z> */
+        *cp = 0x1a;
+        break;
+    }
+  }
+
+  *pbuf = p;
+
+  return (1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Writes the content of the buffer of an output stream]
+
+  Description [Returns 1 on success, 0 on failure.]
+
+  SideEffects [None]
+
+  SeeAlso     [StreamPutByte()]
+
+******************************************************************************/
+
+static int
+StreamFlush (
+  Dddmp_Stream_t *stream  /* IN: output stream */
+  )
+{
+  size_t n = (size_t) stream->pos;
+
+  stream->pos = 0;
+  if (n > 0 && fwrite (stream->buf, 1, n, stream->fp) != n) {
+    return (0);
+  }
+
+  return (1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Reads the next chunk of an input stream]
+
+  Description [Returns 1 on success, 0 at end of file or on failure.
+    Streams on a memory buffer have no next chunk.]
+
+  SideEffects [None]
+
+  SeeAlso     [StreamGetByte()]
+
+******************************************************************************/
+
+static int
+StreamFill (
+  Dddmp_Stream_t *stream  /* IN: input stream */
+  )
+{
+  size_t n;
+
+  if (stream->fp == NULL) {
+    return (0);
+  }
+
+  n = fread (stream->buf, 1, (size_t) stream->size, stream->fp);
+  stream->pos = 0;
+  stream->len = (int) n;
+
+  return (n > 0);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Writes a byte to a stream filtering <CR>, <LF> and <ctrl-Z>]
+
+  Description [Stream counterpart of WriteByteBinary(). Returns 1 on
+    success, 0 on failure.]
+
+  SideEffects [None]
+
+  SeeAlso     [WriteByteBinary() StreamGetByte()]
+
+******************************************************************************/
+
+static int
+StreamPutByte (
+  Dddmp_Stream_t *stream  /* IN: output stream */,
+  unsigned char c         /* IN: the byte to be written */
+  )
+{
+  unsigned char e = 0;
+  int escape = 1;
+
+  switch (c) {
+    case 0x00: /* Escape */
+      e = 0x00;
+      break;
+    case 0x0a: /* <LF> */
+      e = 0x01;
+      break;
+    case 0x0d: /* <CR> */
+      e = 0x02;
+      break;
+    case 0x1a: /* <ctrl-Z> */
+      e = 0x03;
+      break;
+    default:
+      escape = 0;
+      break;
+  }
+
+  if (stream->pos+2 > stream->size && StreamFlush (stream) == 0) {
+    return (0);
+  }
+
+  if (escape) {
+    stream->buf[stream->pos++] = 0x00;
+    c = e;
+  }
+  stream->buf[stream->pos++] = c;
+
+  return (1);
+}
+
+/**Function********************************************************************
 
+  Synopsis    [Reads a byte from a stream with escaped <CR>, <LF> and
+    <ctrl-Z>]
+
+  Description [Stream counterpart of ReadByteBinary(). Returns 1 on
+    success, 0 at end of file or on failure.]
+
+  SideEffects [None]
+
+  SeeAlso     [ReadByteBinary() StreamPutByte()]
+
+******************************************************************************/
+
+static int
+StreamGetByte (
+  Dddmp_Stream_t *stream  /* IN: input stream */,
+  unsigned char *cp       /* OUT: the read byte */
+  )
+{
+  if (stream->pos >= stream->len && StreamFill (stream) == 0) {
+    return (0);
+  }
+  *cp = stream->buf[stream->pos++];
+
+  if (*cp == 0x00) { /* Escape */
+    if (stream->pos >= stream->len && StreamFill (stream) == 0) {
+      return (0);
+    }
+    *cp = stream->buf[stream->pos++];
+
+    switch (*cp) {
+      case 0x00: /* Escape */
+        break;
+      case 0x01: /* <LF> */
+        *cp = 0x0a;
+        break;
+      case 0x02: /* <CR> */
+        *cp = 0x0d;
+        break;
+      case 0x03: /* <ctrl-Z> */
+        *cp = 0x1a;
+        break;
+    }
+  }
+
+  return (1);
+}
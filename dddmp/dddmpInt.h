@@ -55,6 +55,16 @@ extern "C" {
 
 #define DDDMP_MAXSTRLEN 500
 
+/*
+ *  Orders of the Exp-Golomb codes used in compact mode for the variable
+ *  distance and for the child references of a node.
+ */
+#define DDDMP_COMPACT_VAR_K  0
+#define DDDMP_COMPACT_REF_K  1
+
+/* size of the buffers used to read and write files in stream mode */
+#define DDDMP_STREAM_CHUNK 65536
+
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
 /*---------------------------------------------------------------------------*/
@@ -115,6 +125,57 @@ struct Dddmp_Hdr_s {
   int nClausesCnf;  
 };	
 
+/**Struct*********************************************************************
+
+ Synopsis    [In-memory view of the tail of a dump file]
+
+ Description [Describes the bytes of a dump file from a given offset to
+              the end of the file, as made available by DddmpMapOpen().
+              When the platform supports it the file is mapped with mmap
+              and pages are brought in on demand; otherwise the bytes are
+              read into a heap buffer.
+              ]
+
+ SeeAlso     [DddmpMapOpen DddmpMapClose]
+
+******************************************************************************/
+
+typedef struct Dddmp_Map_s {
+  unsigned char *base;  /* start of the mapped (or allocated) region */
+  size_t length;        /* length of the mapped (or allocated) region */
+  unsigned char *data;  /* first byte of the requested section */
+  unsigned char *end;   /* one past the last byte of the file */
+  int mapped;           /* 1 if obtained with mmap, 0 if heap allocated */
+} Dddmp_Map_t;
+
+/**Struct*********************************************************************
+
+ Synopsis    [Buffered stream used by the stream mode]
+
+ Description [Bytes are moved between the file and a buffer of fixed
+              size (DDDMP_STREAM_CHUNK) in a single fread/fwrite call, so
+              that the memory needed to transfer the node section of a
+              file does not depend on its size. A stream is either an
+              input or an output stream. Streams may also carry
+              sequences of bits (see DddmpStreamWriteBits); the bits
+              not yet forming a byte are kept in bits.
+              ]
+
+ SeeAlso     [DddmpStreamOpen DddmpStreamClose]
+
+******************************************************************************/
+
+typedef struct Dddmp_Stream_s {
+  FILE *fp;             /* underlying file */
+  unsigned char *buf;   /* chunk buffer */
+  int size;             /* size of the buffer */
+  int pos;              /* next byte to be read or written */
+  int len;              /* number of valid bytes (input streams only) */
+  int output;           /* 1 for output streams, 0 for input streams */
+  unsigned int bits;    /* pending bits of a partial byte */
+  int nbits;            /* number of pending bits */
+} Dddmp_Stream_t;
+
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -172,6 +233,18 @@ extern int DddmpWriteCode(FILE *fp, struct binary_dd_code code);
 extern int DddmpReadCode(FILE *fp, struct binary_dd_code *pcode);
 extern int DddmpWriteInt(FILE *fp, int id);
 extern int DddmpReadInt(FILE *fp, int *pid);
+extern int DddmpReadCodeBuf(unsigned char **pbuf, unsigned char *end, struct binary_dd_code *pcode);
+extern int DddmpReadIntBuf(unsigned char **pbuf, unsigned char *end, int *pid);
+extern int DddmpStreamOpen(Dddmp_Stream_t *stream, FILE *fp, int output);
+extern int DddmpStreamOpenBuffer(Dddmp_Stream_t *stream, unsigned char *buf, unsigned char *end);
+extern int DddmpStreamClose(Dddmp_Stream_t *stream);
+extern int DddmpStreamWriteUint(Dddmp_Stream_t *stream, unsigned int n);
+extern int DddmpStreamReadUint(Dddmp_Stream_t *stream, unsigned int *pn);
+extern int DddmpStreamWriteBits(Dddmp_Stream_t *stream, unsigned int n, int nbits);
+extern int DddmpStreamWriteGolomb(Dddmp_Stream_t *stream, unsigned int n, int k);
+extern int DddmpStreamReadGolomb(Dddmp_Stream_t *stream, int k, unsigned int *pn);
+extern int DddmpStreamReadBit(Dddmp_Stream_t *stream, unsigned int *pbit);
+extern char * DddmpStreamGets(Dddmp_Stream_t *stream, char *str, int n);
 extern int DddmpNumberAddNodes(DdManager *ddMgr, DdNode **f, int n);
 extern void DddmpUnnumberAddNodes(DdManager *ddMgr, DdNode **f, int n);
 extern void DddmpWriteNodeIndexAdd(DdNode *f, int id);
@@ -206,6 +279,8 @@ extern void DddmpStrArrayFree(char **array, int n);
 extern int * DddmpIntArrayDup(int *array, int n);
 extern int * DddmpIntArrayRead(FILE *fp, int n);
 extern int DddmpIntArrayWrite(FILE *fp, int *array, int n);
+extern int DddmpMapOpen(FILE *fp, Dddmp_Map_t *map);
+extern void DddmpMapClose(Dddmp_Map_t *map);
 
 /**AutomaticEnd***************************************************************/
 
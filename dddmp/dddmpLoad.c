@@ -37,11 +37,90 @@
 ******************************************************************************/
 
 #include "dddmpInt.h"
+#ifdef DD_USE_THREADS
+#include <pthread.h>
+#endif
 
 /*---------------------------------------------------------------------------*/
 /* Stucture declarations                                                     */
 /*---------------------------------------------------------------------------*/
 
+/**Struct*********************************************************************
+
+ Synopsis    [Entry of the table of live nodes used in stream mode]
+
+ Description [Associates a node id of the file with the corresponding
+              node of the manager and with the number of references to
+              it not yet read. Id 0 marks an empty entry.]
+
+******************************************************************************/
+
+typedef struct Dddmp_StreamEntry_s {
+  int id;
+  int refs;
+  DdNode *node;
+} Dddmp_StreamEntry_t;
+
+/**Struct*********************************************************************
+
+ Synopsis    [Table of live nodes used in stream mode]
+
+ Description [Open addressing hash table, with linear probing, of the
+              nodes loaded from a file in stream mode whose references
+              have not all been read yet. The size is a power of 2.]
+
+******************************************************************************/
+
+typedef struct Dddmp_StreamTable_s {
+  Dddmp_StreamEntry_t *entries;
+  int size;
+  int count;
+} Dddmp_StreamTable_t;
+
+/**Struct*********************************************************************
+
+ Synopsis    [Segment of a file in segmented mode]
+
+ Description [Bytes and decoded nodes of the segment of one root. Node k
+              (1<=k<=nnodes) has variable (position in the support) in
+              vars\[k\], the constant having nsuppvars; its children ids
+              are in children\[2k\] (Then) and children\[2k+1\] (Else,
+              shifted left by one, with the complement bit as the least
+              significant one). The buffers are owned by the caller.]
+
+******************************************************************************/
+
+typedef struct Dddmp_Segment_s {
+  unsigned char *start;
+  unsigned char *end;
+  int nnodes;
+  int *vars;
+  int *children;
+  int status;
+} Dddmp_Segment_t;
+
+/**Struct*********************************************************************
+
+ Synopsis    [Queue of the segments to be decoded]
+
+ Description [Shared by the threads that decode the segments of a file in
+              segmented mode: each thread takes the next segment not yet
+              decoded. The lock is used only if shared is set. No DD
+              manager is ever accessed through it.]
+
+******************************************************************************/
+
+typedef struct Dddmp_SegmentQueue_s {
+  Dddmp_Segment_t *segments;
+  int nSegments;
+  int next;
+  int nsuppvars;
+#ifdef DD_USE_THREADS
+  int shared;
+  pthread_mutex_t lock;
+#endif
+} Dddmp_SegmentQueue_t;
+
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
 /*---------------------------------------------------------------------------*/
@@ -56,6 +135,10 @@
 
 #define matchkeywd(str,key) (strncmp(str,key,strlen(key))==0)
 
+/* hash function for the node ids of the stream table */
+#define DddmpStreamHash(id,size) \
+  ((int)(((unsigned int)(id) * 2654435761U) & (unsigned int)((size)-1)))
+
 /**AutomaticStart*************************************************************/
 
 /*---------------------------------------------------------------------------*/
@@ -65,6 +148,17 @@
 static int DddmpCuddDdArrayLoad(Dddmp_DecompType ddType, DdManager *ddMgr, Dddmp_RootMatchType rootMatchMode, char **rootmatchnames, Dddmp_VarMatchType varMatchMode, char **varmatchnames, int *varmatchauxids, int *varcomposeids, int mode, char *file, FILE *fp, DdNode ***pproots);
 static Dddmp_Hdr_t * DddmpBddReadHeader(char *file, FILE *fp);
 static void DddmpFreeHeader(Dddmp_Hdr_t *Hdr);
+static int DddmpCuddBddBinaryBulkLoad(DdManager *ddMgr, Dddmp_Hdr_t *Hdr, int *convertids, Dddmp_Map_t *map, DdNode **pnodes, long *pconsumed);
+static int DddmpDecodeBinaryNode(unsigned char **pbuf, unsigned char *end, int i, int *pvars, int nsuppvars, int *pvar, int *pidT, int *pidE, int *pEcompl);
+static int DddmpDecodeBinaryChild(unsigned char **pbuf, unsigned char *end, int i, int c, int *pid);
+static DdNode ** DddmpCuddBddStreamLoad(DdManager *ddMgr, Dddmp_Hdr_t *Hdr, int *convertids, int maxv, FILE *fp);
+static DdNode * DddmpStreamTableUse(Dddmp_StreamTable_t *table, int id);
+static int DddmpStreamTableInsert(Dddmp_StreamTable_t *table, int id, int refs, DdNode *node);
+static void DddmpStreamTableFree(DdManager *ddMgr, Dddmp_StreamTable_t *table);
+static DdNode ** DddmpCuddBddSegmentedLoad(DdManager *ddMgr, Dddmp_Hdr_t *Hdr, int *convertids, int maxv, FILE *fp);
+static int DddmpReadSegmentIndex(Dddmp_Map_t *map, int nRoots, Dddmp_Segment_t *segments, long *pconsumed);
+static void * DddmpDecodeSegments(void *arg);
+static int DddmpDecodeSegment(Dddmp_Segment_t *segment, int nsuppvars);
 
 /**AutomaticEnd***************************************************************/
 
@@ -635,8 +729,13 @@ DddmpCuddDdArrayLoad (
   DdNode **proots = NULL;
   int fileToClose = 0;
   char *retval;
+  Dddmp_Map_t map;
+  Dddmp_Stream_t stream;
+  unsigned int code1, dT, dE, ecompl;
+  long consumed;
 
   *pproots = NULL;
+  stream.buf = NULL;
 
   if (fp == NULL) {
     fp = fopen (file, "r");
@@ -860,6 +959,38 @@ DddmpCuddDdArrayLoad (
     invconvertids[convertids[i]] = i;
   }
 
+  /*
+   *  Stream mode: nodes are kept only as long as they are referenced
+   */
+
+  if (mode == DDDMP_MODE_STREAM) {
+    Dddmp_CheckAndGotoLabel (ddType!=DDDMP_BDD,
+      "Stream Mode Supported for BDDs Only.", failure);
+    proots = DddmpCuddBddStreamLoad (ddMgr, Hdr, convertids, maxv, fp);
+    Dddmp_CheckAndGotoLabel (proots==NULL,
+      "Error Reading Nodes in Stream Mode.", failure);
+    if (fileToClose) {
+      fclose (fp);
+    }
+    goto load_end;
+  }
+
+  /*
+   *  Segmented mode: roots are decoded in parallel, then merged
+   */
+
+  if (mode == DDDMP_MODE_SEGMENTED) {
+    Dddmp_CheckAndGotoLabel (ddType!=DDDMP_BDD,
+      "Segmented Mode Supported for BDDs Only.", failure);
+    proots = DddmpCuddBddSegmentedLoad (ddMgr, Hdr, convertids, maxv, fp);
+    Dddmp_CheckAndGotoLabel (proots==NULL,
+      "Error Reading Nodes in Segmented Mode.", failure);
+    if (fileToClose) {
+      fclose (fp);
+    }
+    goto load_end;
+  }
+
   pnodes = DDDMP_ALLOC(DdNode *,(Hdr->nnodes+1));
   Dddmp_CheckAndGotoLabel (pnodes==NULL, "Error allocating memory.",
     failure);
@@ -880,11 +1011,48 @@ DddmpCuddDdArrayLoad (
     goto failure;
   }
 
+  /*--------- Fast Path: Bulk Load of Order Compatible Binary BDDs ---------*/
+
+  /*
+   *  When the variables in the file appear in the same relative order
+   *  as in the manager, every node can be inserted directly into the
+   *  unique table (children are stored before parents), with no need
+   *  for ITE. The node section is accessed in memory (mapped when
+   *  possible) and the unique subtables are sized in advance.
+   */
+
+  if (ddType == DDDMP_BDD && mode == DDDMP_MODE_BINARY) {
+    if (maxv >= ddMgr->size) {
+      Dddmp_CheckAndGotoLabel (Cudd_bddIthVar (ddMgr, maxv) == NULL,
+        "Error creating variables.", failure);
+    }
+    for (i=1; i<Hdr->nsuppvars; i++) {
+      if (ddMgr->perm[convertids[i-1]] >= ddMgr->perm[convertids[i]]) {
+        break;
+      }
+    }
+    if (i >= Hdr->nsuppvars && DddmpMapOpen (fp, &map)) {
+      retValue = DddmpCuddBddBinaryBulkLoad (ddMgr, Hdr, convertids, &map,
+        pnodes, &consumed);
+      DddmpMapClose (&map);
+      Dddmp_CheckAndGotoLabel (retValue==DDDMP_FAILURE,
+        "Error Loading Nodes in Bulk.", failure);
+      Dddmp_CheckAndGotoLabel (fseek (fp, consumed, SEEK_CUR) != 0,
+        "Error seeking file.", failure);
+      goto load_tail;
+    }
+  }
+
   /*-------------- Deal With Nodes ... One Row File at a Time --------------*/
+
+  if (mode == DDDMP_MODE_COMPACT) {
+    Dddmp_CheckAndGotoLabel (DddmpStreamOpen (&stream, fp, 0)==0,
+      "Error allocating memory.", failure);
+  }
  
   for (i=1; i<=Hdr->nnodes; i++) {
 
-    Dddmp_CheckAndGotoLabel (feof(fp),
+    Dddmp_CheckAndGotoLabel (mode!=DDDMP_MODE_COMPACT && feof(fp),
       "Unexpected EOF While Reading DD Nodes.", failure);
 
     switch (mode) {
@@ -1075,6 +1243,53 @@ DddmpCuddDdArrayLoad (
 #endif
 
       break;
+
+      /*
+       *  Compact FORMAT
+       */
+
+      case DDDMP_MODE_COMPACT:
+
+        if (i == 1) {
+          /* only 1 terminal presently supported */
+          pnodes[i] = Cudd_ReadOne (ddMgr);
+          Cudd_Ref (pnodes[i]);
+          if (pvars1byte != NULL) {
+            pvars1byte[i] = (unsigned char) Hdr->nsuppvars;
+          } else {
+            pvars2byte[i] = (unsigned short) Hdr->nsuppvars;
+          }
+          continue;
+        }
+
+        Dddmp_CheckAndGotoLabel (
+          DddmpStreamReadGolomb (&stream, DDDMP_COMPACT_VAR_K, &code1)==0 ||
+          DddmpStreamReadBit (&stream, &ecompl)==0 ||
+          DddmpStreamReadGolomb (&stream, DDDMP_COMPACT_REF_K, &dT)==0 ||
+          DddmpStreamReadGolomb (&stream, DDDMP_COMPACT_REF_K, &dE)==0,
+          "Unexpected EOF While Reading DD Nodes.", failure);
+        Dddmp_CheckAndGotoLabel (dT>=(unsigned int) i ||
+          dE>=(unsigned int) i, "Wrong Node Index.", failure);
+        idT = (dT == 0) ? 1 : i - (int) dT;
+        idE = (dE == 0) ? 1 : i - (int) dE;
+
+        T = pnodes[idT];
+        E = pnodes[idE];
+        if (pvars1byte != NULL) {
+          vT = pvars1byte[idT];
+          vE = pvars1byte[idE];
+        } else {
+          vT = pvars2byte[idT];
+          vE = pvars2byte[idE];
+        }
+        var = ((vT<vE) ? vT : vE) - (int) code1 - 1;
+        Dddmp_CheckAndGotoLabel (var<0, "Wrong Variable Index.", failure);
+
+        if (ecompl) {
+          E = Cudd_Not(E);
+        }
+
+      break;
     }
 
     if (pvars1byte != NULL) {
@@ -1108,8 +1323,15 @@ DddmpCuddDdArrayLoad (
     cuddRef (pnodes[i]);
   }
 
+  if (mode == DDDMP_MODE_COMPACT) {
+    Dddmp_CheckAndGotoLabel (DddmpStreamClose (&stream)==0,
+      "Error on reading file tail.", failure);
+  }
+
   /*------------------------ Deal With the File Tail -----------------------*/
 
+load_tail:
+
   retval = fgets (buf, DDDMP_MAXSTRLEN-1,fp);
   Dddmp_CheckAndGotoLabel (!retval, "Error on reading file tail.", failure);
   Dddmp_CheckAndGotoLabel (!matchkeywd(buf, ".end"),
@@ -1200,6 +1422,10 @@ load_end:
 
 failure:
 
+  if (stream.buf != NULL) {
+    (void) DddmpStreamClose (&stream);
+  }
+
   if (fileToClose) {
     fclose (fp);
   }
@@ -1211,6 +1437,1051 @@ failure:
   goto load_end; /* this is done to free memory */
 }
 
+/**Function********************************************************************
+
+  Synopsis    [Loads the nodes of a binary BDD dump directly into the
+    unique table.
+    ]
+
+  Description [Fast path of DddmpCuddDdArrayLoad, applicable when the
+    variables in the file (as translated by convertids) are in the same
+    relative order as in the manager. The node section, made available
+    in memory by DddmpMapOpen, is scanned twice. The first scan decodes
+    the variable of each node and counts the nodes per variable, so
+    that the unique subtables can be enlarged once, in advance. The
+    second scan creates the nodes bottom-up with cuddUniqueInter,
+    exploiting the fact that children are always stored before their
+    parents. Dynamic reordering is disabled while nodes are created.
+    On success pnodes[1..nnodes] are filled with referenced nodes,
+    *pconsumed is set to the number of bytes of the node section, and
+    DDDMP_SUCCESS is returned. On failure the nodes created so far are
+    dereferenced and DDDMP_FAILURE is returned.
+    ]
+
+  SideEffects [Unique subtables may be enlarged.]
+
+  SeeAlso     [DddmpCuddDdArrayLoad cuddReserveSubtable]
+
+******************************************************************************/
+
+static int
+DddmpCuddBddBinaryBulkLoad (
+  DdManager *ddMgr    /* IN: DD Manager */,
+  Dddmp_Hdr_t *Hdr    /* IN: header of the file */,
+  int *convertids     /* IN: file positions to manager ids */,
+  Dddmp_Map_t *map    /* IN: node section of the file */,
+  DdNode **pnodes     /* OUT: loaded nodes, indexed by file ids */,
+  long *pconsumed     /* OUT: length of the node section */
+  )
+{
+  unsigned char *p;
+  int *pvars = NULL;
+  int *count = NULL;
+  int i, nnodes, nsuppvars, var, idT, idE, ecompl;
+  int savedAutoDyn;
+  DdNode *T, *E, *f;
+
+  nnodes = Hdr->nnodes;
+  nsuppvars = Hdr->nsuppvars;
+  var = idT = idE = ecompl = 0;
+
+  pvars = DDDMP_ALLOC (int, nnodes+1);
+  Dddmp_CheckAndGotoLabel (pvars==NULL, "Error allocating memory.",
+    failure);
+  count = DDDMP_ALLOC (int, nsuppvars);
+  Dddmp_CheckAndGotoLabel (count==NULL, "Error allocating memory.",
+    failure);
+  for (i=0; i<nsuppvars; i++) {
+    count[i] = 0;
+  }
+
+  /*
+   *  First scan: decode variables and count nodes per variable
+   */
+
+  p = map->data;
+  for (i=1; i<=nnodes; i++) {
+    Dddmp_CheckAndGotoLabel (DddmpDecodeBinaryNode (&p, map->end, i, pvars,
+      nsuppvars, &var, &idT, &idE, &ecompl) == 0,
+      "Error Reading Nodes in Binary Mode.", failure);
+    pvars[i] = var;
+    if (var < nsuppvars) {
+      count[var]++;
+    }
+  }
+  *pconsumed = (long) (p - map->data);
+
+  for (i=0; i<nsuppvars; i++) {
+    if (count[i] > 0) {
+      (void) cuddReserveSubtable (ddMgr, ddMgr->perm[convertids[i]],
+        (unsigned int) count[i]);
+    }
+  }
+
+  /*
+   *  Second scan: create nodes bottom-up
+   */
+
+  savedAutoDyn = ddMgr->autoDyn;
+  ddMgr->autoDyn = 0;
+
+  p = map->data;
+  for (i=1; i<=nnodes; i++) {
+    (void) DddmpDecodeBinaryNode (&p, map->end, i, pvars, nsuppvars,
+      &var, &idT, &idE, &ecompl);
+    if (var == nsuppvars) {
+      /* only 1 terminal presently supported */
+      f = Cudd_ReadOne (ddMgr);
+    } else {
+      T = pnodes[idT];
+      E = pnodes[idE];
+      if (ecompl) {
+        E = Cudd_Not (E);
+      }
+      if (T == E) {
+        f = T;
+      } else {
+        f = cuddUniqueInter (ddMgr, convertids[var], T, E);
+      }
+    }
+    if (f == NULL) {
+      while (--i > 0) {
+        Cudd_RecursiveDeref (ddMgr, pnodes[i]);
+      }
+      ddMgr->autoDyn = savedAutoDyn;
+      (void) fprintf (stderr, "DdLoad Error: Unable to create node.\n");
+      fflush (stderr);
+      goto failure;
+    }
+    cuddRef (f);
+    pnodes[i] = f;
+  }
+
+  ddMgr->autoDyn = savedAutoDyn;
+
+  DDDMP_FREE (pvars);
+  DDDMP_FREE (count);
+
+  return (DDDMP_SUCCESS);
+
+  failure:
+
+    DDDMP_FREE (pvars);
+    DDDMP_FREE (count);
+
+    return (DDDMP_FAILURE);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Decodes a node of a binary dump file held in memory.]
+
+  Description [Decodes node i from the buffer pointed by *pbuf. pvars
+    holds the (file position of the) variable of the nodes already
+    decoded, terminal nodes having nsuppvars. The variable of the node
+    is returned in *pvar (nsuppvars for a terminal node), the ids of the
+    children in *pidT and *pidE, and the complement flag of the else
+    child in *pEcompl. Children ids and variables are checked for
+    consistency. Returns 1 on success, 0 on failure.
+    ]
+
+  SideEffects [*pbuf is advanced]
+
+  SeeAlso     [DddmpCuddBddBinaryBulkLoad DddmpReadCodeBuf]
+
+******************************************************************************/
+
+static int
+DddmpDecodeBinaryNode (
+  unsigned char **pbuf  /* IN/OUT: current position in the buffer */,
+  unsigned char *end    /* IN: end of the buffer */,
+  int i                 /* IN: id of the node */,
+  int *pvars            /* IN: variables of the nodes decoded so far */,
+  int nsuppvars         /* IN: number of support variables */,
+  int *pvar             /* OUT: variable (file position) of the node */,
+  int *pidT             /* OUT: id of the then child */,
+  int *pidE             /* OUT: id of the else child */,
+  int *pEcompl          /* OUT: complement flag of the else child */
+  )
+{
+  struct binary_dd_code code;
+  int var, vT, vE;
+
+  if (DddmpReadCodeBuf (pbuf, end, &code) == 0) {
+    return (0);
+  }
+
+  var = 0;
+  switch (code.V) {
+    case DDDMP_TERMINAL:
+      *pvar = nsuppvars;
+      return (1);
+    case DDDMP_RELATIVE_1:
+      break;
+    case DDDMP_RELATIVE_ID:
+    case DDDMP_ABSOLUTE_ID:
+      if (DddmpReadIntBuf (pbuf, end, &var) == 0) {
+        return (0);
+      }
+      break;
+  }
+
+  if (DddmpDecodeBinaryChild (pbuf, end, i, code.T, pidT) == 0 ||
+    DddmpDecodeBinaryChild (pbuf, end, i, code.E, pidE) == 0) {
+    return (0);
+  }
+
+  vT = pvars[*pidT];
+  vE = pvars[*pidE];
+
+  switch (code.V) {
+    case DDDMP_RELATIVE_1:
+      var = (vT<vE) ? vT-1 : vE-1;
+      break;
+    case DDDMP_RELATIVE_ID:
+      var = (vT<vE) ? vT-var : vE-var;
+      break;
+  }
+
+  if (var < 0 || var >= vT || var >= vE) {
+    return (0);
+  }
+
+  *pvar = var;
+  *pEcompl = code.Ecompl;
+
+  return (1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Decodes the id of a child of a node of a binary dump.]
+
+  Description [Decodes the id of a child of node i, coded as c, from the
+    buffer pointed by *pbuf. Returns 1 on success, 0 on failure or if
+    the decoded id is not in the range [1,i-1].
+    ]
+
+  SideEffects [*pbuf is advanced]
+
+  SeeAlso     [DddmpDecodeBinaryNode]
+
+******************************************************************************/
+
+static int
+DddmpDecodeBinaryChild (
+  unsigned char **pbuf  /* IN/OUT: current position in the buffer */,
+  unsigned char *end    /* IN: end of the buffer */,
+  int i                 /* IN: id of the parent node */,
+  int c                 /* IN: code of the child */,
+  int *pid              /* OUT: id of the child */
+  )
+{
+  int id = 0;
+
+  switch (c) {
+    case DDDMP_TERMINAL:
+      id = 1;
+      break;
+    case DDDMP_RELATIVE_1:
+      id = i-1;
+      break;
+    case DDDMP_RELATIVE_ID:
+      if (DddmpReadIntBuf (pbuf, end, &id) == 0) {
+        return (0);
+      }
+      id = i-id;
+      break;
+    case DDDMP_ABSOLUTE_ID:
+      if (DddmpReadIntBuf (pbuf, end, &id) == 0) {
+        return (0);
+      }
+      break;
+  }
+
+  if (id < 1 || id >= i) {
+    return (0);
+  }
+
+  *pid = id;
+
+  return (1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Reads the nodes of a dump file in stream mode.]
+
+  Description [Reads the node section and the tail of a file in stream
+    mode (see NodeStreamStoreBdd for the format) and returns the array
+    of (referenced) roots, or NULL on failure. The file is read in
+    chunks of DDDMP_STREAM_CHUNK bytes. Nodes are kept in a hash table
+    only until their last reference (as recorded in the file) has been
+    read, so that the memory used, beyond the one of the loaded BDDs,
+    is proportional to the largest set of nodes still waiting for a
+    parent rather than to the total number of nodes. Nodes are built
+    with cuddUniqueInter if the variables in the file are in the same
+    relative order as in the manager, with ITE otherwise.
+    ]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpCuddDdArrayLoad]
+
+******************************************************************************/
+
+static DdNode **
+DddmpCuddBddStreamLoad (
+  DdManager *ddMgr    /* IN: DD Manager */,
+  Dddmp_Hdr_t *Hdr    /* IN: header of the file */,
+  int *convertids     /* IN: file positions to manager ids */,
+  int maxv            /* IN: largest manager id in convertids */,
+  FILE *fp            /* IN: file pointer */
+  )
+{
+  Dddmp_Stream_t stream;
+  Dddmp_StreamTable_t table;
+  DdNode **proots = NULL;
+  DdNode *T, *E, *f;
+  char buf[DDDMP_MAXSTRLEN];
+  unsigned int v, dT, dE, refs;
+  int i, id, direct, savedAutoDyn;
+
+  stream.buf = NULL;
+  table.size = 1024;
+  table.count = 0;
+  table.entries = NULL;
+  savedAutoDyn = ddMgr->autoDyn;
+  direct = 0;
+
+  if (maxv >= ddMgr->size) {
+    Dddmp_CheckAndGotoLabel (Cudd_bddIthVar (ddMgr, maxv) == NULL,
+      "Error creating variables.", failure);
+  }
+
+  /* Insert nodes directly if the order is compatible. */
+  direct = 1;
+  for (i=1; i<Hdr->nsuppvars; i++) {
+    if (ddMgr->perm[convertids[i-1]] >= ddMgr->perm[convertids[i]]) {
+      direct = 0;
+      break;
+    }
+  }
+  if (direct) {
+    ddMgr->autoDyn = 0;
+  }
+
+  table.entries = DDDMP_ALLOC (Dddmp_StreamEntry_t, table.size);
+  Dddmp_CheckAndGotoLabel (table.entries==NULL, "Error allocating memory.",
+    failure);
+  for (i=0; i<table.size; i++) {
+    table.entries[i].id = 0;
+  }
+
+  Dddmp_CheckAndGotoLabel (DddmpStreamOpen (&stream, fp, 0)==0,
+    "Error allocating memory.", failure);
+
+  /*-------------------------- Deal With Nodes -----------------------------*/
+
+  for (i=1; i<=Hdr->nnodes; i++) {
+    Dddmp_CheckAndGotoLabel (DddmpStreamReadUint (&stream, &v)==0,
+      "Unexpected EOF While Reading DD Nodes.", failure);
+    Dddmp_CheckAndGotoLabel (v > (unsigned int) Hdr->nsuppvars,
+      "Wrong Variable Index.", failure);
+
+    if (v == 0) {
+      /* only 1 terminal presently supported */
+      f = Cudd_ReadOne (ddMgr);
+    } else {
+      Dddmp_CheckAndGotoLabel (DddmpStreamReadUint (&stream, &dT)==0 ||
+        DddmpStreamReadUint (&stream, &dE)==0,
+        "Unexpected EOF While Reading DD Nodes.", failure);
+      Dddmp_CheckAndGotoLabel (dT == 0 || dT >= (unsigned int) i ||
+        (dE>>1) == 0 || (dE>>1) >= (unsigned int) i,
+        "Wrong Node Index.", failure);
+      T = DddmpStreamTableUse (&table, i - (int) dT);
+      E = DddmpStreamTableUse (&table, i - (int) (dE>>1));
+      Dddmp_CheckAndGotoLabel (T==NULL || E==NULL,
+        "Reference to a Released Node.", failure);
+      E = Cudd_NotCond (E, dE & 1);
+      if (T == E) {
+        f = T;
+      } else if (direct) {
+        f = cuddUniqueInter (ddMgr, convertids[v-1], T, E);
+      } else {
+        f = Cudd_bddIte (ddMgr, Cudd_bddIthVar (ddMgr, convertids[v-1]),
+          T, E);
+      }
+      if (f != NULL) {
+        cuddRef (f);
+      }
+      Cudd_RecursiveDeref (ddMgr, T);
+      Cudd_RecursiveDeref (ddMgr, Cudd_Regular (E));
+      Dddmp_CheckAndGotoLabel (f==NULL, "Unable to create node.", failure);
+      cuddDeref (f);
+    }
+
+    Dddmp_CheckAndGotoLabel (DddmpStreamReadUint (&stream, &refs)==0,
+      "Unexpected EOF While Reading DD Nodes.", failure);
+    if (refs > 0) {
+      cuddRef (f);
+      Dddmp_CheckAndGotoLabel (DddmpStreamTableInsert (&table, i,
+        (int) refs, f)==0, "Error allocating memory.", failure);
+    }
+  }
+
+  /*------------------------ Deal With the File Tail -----------------------*/
+
+  Dddmp_CheckAndGotoLabel (DddmpStreamGets (&stream, buf,
+    DDDMP_MAXSTRLEN-1)==NULL, "Error on reading file tail.", failure);
+  Dddmp_CheckAndGotoLabel (!matchkeywd(buf, ".end"),
+    "Error .end not found.", failure);
+  Dddmp_CheckAndGotoLabel (DddmpStreamClose (&stream)==0,
+    "Error on reading file tail.", failure);
+
+  /*------------------------------ BDD Roots -------------------------------*/
+
+  proots = DDDMP_ALLOC (DdNode *, Hdr->nRoots);
+  Dddmp_CheckAndGotoLabel (proots==NULL, "Error allocating memory.",
+    failure);
+
+  for (i=0; i<Hdr->nRoots; i++) {
+    id = Hdr->rootids[i];
+    if (id == 0) {
+      (void) fprintf (stderr, "DdLoad Warning: NULL root found in file\n");
+      fflush (stderr);
+      proots[i] = NULL;
+      continue;
+    }
+    f = DddmpStreamTableUse (&table, id<0 ? -id : id);
+    if (f == NULL) {
+      (void) fprintf (stderr,
+        "DdLoad Error: Reference to a Released Node.\n");
+      fflush (stderr);
+      while (--i >= 0) {
+        if (proots[i] != NULL) {
+          Cudd_RecursiveDeref (ddMgr, proots[i]);
+        }
+      }
+      DDDMP_FREE (proots);
+      goto failure;
+    }
+    proots[i] = Cudd_NotCond (f, id<0);
+  }
+
+  /* Nodes still in the table have more references than declared. */
+  DddmpStreamTableFree (ddMgr, &table);
+
+  if (direct) {
+    ddMgr->autoDyn = savedAutoDyn;
+  }
+
+  return (proots);
+
+  failure:
+
+    if (stream.buf != NULL) {
+      (void) DddmpStreamClose (&stream);
+    }
+    DddmpStreamTableFree (ddMgr, &table);
+    if (direct) {
+      ddMgr->autoDyn = savedAutoDyn;
+    }
+
+    return (NULL);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Consumes a reference to a node of the stream table.]
+
+  Description [Looks up the node with the given id and decrements the
+    number of its pending references. When no reference is left the
+    entry is removed from the table. In all cases the reference held by
+    the table is transferred to the caller, who is given a new
+    reference otherwise. Returns the node, or NULL if no entry for id
+    exists.
+    ]
+
+  SideEffects [The table may be modified.]
+
+  SeeAlso     [DddmpStreamTableInsert]
+
+******************************************************************************/
+
+static DdNode *
+DddmpStreamTableUse (
+  Dddmp_StreamTable_t *table   /* IN/OUT: table of live nodes */,
+  int id                       /* IN: id of the node */
+  )
+{
+  Dddmp_StreamEntry_t *entries = table->entries;
+  int mask = table->size - 1;
+  int i, j, k;
+  DdNode *node;
+
+  for (i=DddmpStreamHash (id, table->size); entries[i].id != id;
+    i=(i+1) & mask) {
+    if (entries[i].id == 0) {
+      return (NULL);
+    }
+  }
+
+  node = entries[i].node;
+  if (--entries[i].refs > 0) {
+    cuddRef (node);
+    return (node);
+  }
+
+  /* Last reference: remove the entry, shifting back the following ones. */
+  table->count--;
+  for (j=(i+1) & mask; entries[j].id != 0; j=(j+1) & mask) {
+    k = DddmpStreamHash (entries[j].id, table->size);
+    if ((j > i && (k <= i || k > j)) || (j < i && k <= i && k > j)) {
+      entries[i] = entries[j];
+      i = j;
+    }
+  }
+  entries[i].id = 0;
+
+  return (node);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Inserts a node in the stream table.]
+
+  Description [Inserts a node, with the number of its pending
+    references, doubling the table when it is half full. The table
+    takes over a reference to the node. Returns 1 on success, 0 on
+    failure.]
+
+  SideEffects [The table may be resized.]
+
+  SeeAlso     [DddmpStreamTableUse]
+
+******************************************************************************/
+
+static int
+DddmpStreamTableInsert (
+  Dddmp_StreamTable_t *table   /* IN/OUT: table of live nodes */,
+  int id                       /* IN: id of the node */,
+  int refs                     /* IN: number of pending references */,
+  DdNode *node                 /* IN: node */
+  )
+{
+  Dddmp_StreamEntry_t *old, *entries;
+  int i, j, size;
+
+  if (2*(table->count+1) > table->size) {
+    old = table->entries;
+    size = 2 * table->size;
+    entries = DDDMP_ALLOC (Dddmp_StreamEntry_t, size);
+    if (entries == NULL) {
+      return (0);
+    }
+    for (i=0; i<size; i++) {
+      entries[i].id = 0;
+    }
+    for (i=0; i<table->size; i++) {
+      if (old[i].id != 0) {
+        for (j=DddmpStreamHash (old[i].id, size); entries[j].id != 0;
+          j=(j+1) & (size-1));
+        entries[j] = old[i];
+      }
+    }
+    DDDMP_FREE (old);
+    table->entries = entries;
+    table->size = size;
+  }
+
+  for (i=DddmpStreamHash (id, table->size); table->entries[i].id != 0;
+    i=(i+1) & (table->size-1));
+  table->entries[i].id = id;
+  table->entries[i].refs = refs;
+  table->entries[i].node = node;
+  table->count++;
+
+  return (1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Frees the stream table.]
+
+  Description [Releases the references held by the table and frees it.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpStreamTableInsert]
+
+******************************************************************************/
+
+static void
+DddmpStreamTableFree (
+  DdManager *ddMgr             /* IN: DD Manager */,
+  Dddmp_StreamTable_t *table   /* IN/OUT: table of live nodes */
+  )
+{
+  int i;
+
+  if (table->entries == NULL) {
+    return;
+  }
+  for (i=0; i<table->size; i++) {
+    if (table->entries[i].id != 0) {
+      Cudd_RecursiveDeref (ddMgr, table->entries[i].node);
+    }
+  }
+  DDDMP_FREE (table->entries);
+  table->entries = NULL;
+  table->count = 0;
+
+  return;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Reads the nodes of a dump file in segmented mode.]
+
+  Description [Reads the node section and the tail of a file in segmented
+    mode (see NodeSegmentedStoreBdd for the format) and returns the array
+    of (referenced) roots, or NULL on failure. The file is accessed in
+    memory (mapped when possible). The segment index at the end of the
+    node section gives the bytes of each root, so that the segments are
+    decoded independently, by as many threads as there are processors
+    online (when compiled with DD_USE_THREADS), into buffers of their
+    own. The decoded segments are then merged into the manager, one
+    after the other, by the calling thread: nodes are built with
+    cuddUniqueInter if the variables in the file are in the same
+    relative order as in the manager, with ITE otherwise. The nodes
+    shared by several roots are found in the unique table.
+    ]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpCuddDdArrayLoad NodeSegmentedStoreBdd]
+
+******************************************************************************/
+
+static DdNode **
+DddmpCuddBddSegmentedLoad (
+  DdManager *ddMgr    /* IN: DD Manager */,
+  Dddmp_Hdr_t *Hdr    /* IN: header of the file */,
+  int *convertids     /* IN: file positions to manager ids */,
+  int maxv            /* IN: largest manager id in convertids */,
+  FILE *fp            /* IN: file pointer */
+  )
+{
+  Dddmp_Map_t map;
+  Dddmp_SegmentQueue_t queue;
+  Dddmp_Segment_t *segments = NULL;
+  DdNode **proots = NULL;
+  DdNode **pnodes = NULL;
+  DdNode *T, *E, *f;
+  int *data = NULL;
+  long consumed, total;
+  int i, k, n, id, maxn, nRoots, direct, savedAutoDyn;
+#ifdef DD_USE_THREADS
+  pthread_t *threads = NULL;
+  long nThreads = 1;
+  int nStarted = 0;
+#endif
+
+  map.base = NULL;
+  nRoots = Hdr->nRoots;
+  savedAutoDyn = ddMgr->autoDyn;
+  direct = 0;
+
+  if (maxv >= ddMgr->size) {
+    Dddmp_CheckAndGotoLabel (Cudd_bddIthVar (ddMgr, maxv) == NULL,
+      "Error creating variables.", failure);
+  }
+
+  /*----------------------- Locate and Check Segments ----------------------*/
+
+  Dddmp_CheckAndGotoLabel (DddmpMapOpen (fp, &map)==0,
+    "Error reading file.", failure);
+
+  segments = DDDMP_ALLOC (Dddmp_Segment_t, nRoots);
+  Dddmp_CheckAndGotoLabel (segments==NULL, "Error allocating memory.",
+    failure);
+
+  Dddmp_CheckAndGotoLabel (DddmpReadSegmentIndex (&map, nRoots, segments,
+    &consumed)==DDDMP_FAILURE, "Error reading segment index.", failure);
+
+  total = 0;
+  maxn = 0;
+  for (i=0; i<nRoots; i++) {
+    n = Hdr->rootids[i] < 0 ? -Hdr->rootids[i] : Hdr->rootids[i];
+    /* each node but the constant takes at least 6 bits */
+    Dddmp_CheckAndGotoLabel (
+      6 * ((long) n - 1) > 8 * (long) (segments[i].end - segments[i].start),
+      "Wrong Segment Size.", failure);
+    segments[i].nnodes = n;
+    total += 3 * (n + 1);
+    if (n > maxn) {
+      maxn = n;
+    }
+  }
+
+  data = DDDMP_ALLOC (int, total);
+  Dddmp_CheckAndGotoLabel (data==NULL, "Error allocating memory.",
+    failure);
+  pnodes = DDDMP_ALLOC (DdNode *, maxn+1);
+  Dddmp_CheckAndGotoLabel (pnodes==NULL, "Error allocating memory.",
+    failure);
+  proots = DDDMP_ALLOC (DdNode *, nRoots);
+  Dddmp_CheckAndGotoLabel (proots==NULL, "Error allocating memory.",
+    failure);
+
+  total = 0;
+  for (i=0; i<nRoots; i++) {
+    segments[i].vars = data + total;
+    segments[i].children = data + total + segments[i].nnodes + 1;
+    total += 3 * (segments[i].nnodes + 1);
+  }
+
+  /*---------------------------- Decode Segments ---------------------------*/
+
+  queue.segments = segments;
+  queue.nSegments = nRoots;
+  queue.next = 0;
+  queue.nsuppvars = Hdr->nsuppvars;
+
+#ifdef DD_USE_THREADS
+  queue.shared = 0;
+#if defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+  nThreads = sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+  if (nThreads > nRoots) {
+    nThreads = nRoots;
+  }
+  if (nThreads > 1 && pthread_mutex_init (&queue.lock, NULL) == 0) {
+    /* the calling thread is one of the decoders */
+    queue.shared = 1;
+    threads = DDDMP_ALLOC (pthread_t, nThreads-1);
+    for (i=0; threads != NULL && i<nThreads-1; i++) {
+      if (pthread_create (&threads[i], NULL, DddmpDecodeSegments,
+        (void *) &queue) != 0) {
+        break;
+      }
+      nStarted++;
+    }
+    (void) DddmpDecodeSegments ((void *) &queue);
+    for (i=0; i<nStarted; i++) {
+      (void) pthread_join (threads[i], NULL);
+    }
+    DDDMP_FREE (threads);
+    (void) pthread_mutex_destroy (&queue.lock);
+  } else {
+    nThreads = 1;
+  }
+  if (nThreads <= 1) {
+    (void) DddmpDecodeSegments ((void *) &queue);
+  }
+#else
+  (void) DddmpDecodeSegments ((void *) &queue);
+#endif
+
+  for (i=0; i<nRoots; i++) {
+    Dddmp_CheckAndGotoLabel (segments[i].status==DDDMP_FAILURE,
+      "Error Decoding Segment.", failure);
+  }
+
+  DddmpMapClose (&map);
+  Dddmp_CheckAndGotoLabel (fseek (fp, consumed, SEEK_CUR) != 0,
+    "Error seeking file.", failure);
+
+  /*---------------------------- Merge Segments ----------------------------*/
+
+  /* Insert nodes directly if the order is compatible. */
+  direct = 1;
+  for (i=1; i<Hdr->nsuppvars; i++) {
+    if (ddMgr->perm[convertids[i-1]] >= ddMgr->perm[convertids[i]]) {
+      direct = 0;
+      break;
+    }
+  }
+  if (direct) {
+    ddMgr->autoDyn = 0;
+  }
+
+  for (i=0; i<nRoots; i++) {
+    n = segments[i].nnodes;
+    if (n == 0) {
+      (void) fprintf (stderr, "DdLoad Warning: NULL root found in file\n");
+      fflush (stderr);
+      proots[i] = NULL;
+      continue;
+    }
+    for (k=1; k<=n; k++) {
+      if (segments[i].vars[k] == Hdr->nsuppvars) {
+        /* only 1 terminal presently supported */
+        f = Cudd_ReadOne (ddMgr);
+      } else {
+        T = pnodes[segments[i].children[2*k]];
+        id = segments[i].children[2*k+1];
+        E = Cudd_NotCond (pnodes[id>>1], id & 1);
+        if (T == E) {
+          f = T;
+        } else if (direct) {
+          f = cuddUniqueInter (ddMgr, convertids[segments[i].vars[k]], T, E);
+        } else {
+          f = Cudd_bddIte (ddMgr,
+            Cudd_bddIthVar (ddMgr, convertids[segments[i].vars[k]]), T, E);
+        }
+      }
+      if (f == NULL) {
+        while (--k >= 1) {
+          Cudd_RecursiveDeref (ddMgr, pnodes[k]);
+        }
+        while (--i >= 0) {
+          if (proots[i] != NULL) {
+            Cudd_RecursiveDeref (ddMgr, proots[i]);
+          }
+        }
+        goto failure;
+      }
+      cuddRef (f);
+      pnodes[k] = f;
+    }
+    proots[i] = Cudd_NotCond (pnodes[n], Hdr->rootids[i] < 0);
+    cuddRef (proots[i]);
+    for (k=1; k<=n; k++) {
+      Cudd_RecursiveDeref (ddMgr, pnodes[k]);
+    }
+  }
+
+  if (direct) {
+    ddMgr->autoDyn = savedAutoDyn;
+  }
+
+  DDDMP_FREE (segments);
+  DDDMP_FREE (data);
+  DDDMP_FREE (pnodes);
+
+  return (proots);
+
+  failure:
+
+    if (map.base != NULL) {
+      DddmpMapClose (&map);
+    }
+    if (direct) {
+      ddMgr->autoDyn = savedAutoDyn;
+    }
+    DDDMP_FREE (segments);
+    DDDMP_FREE (data);
+    DDDMP_FREE (pnodes);
+    DDDMP_FREE (proots);
+
+    return (NULL);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Reads the index of the segments of a file in segmented
+    mode.]
+
+  Description [The node section starts at map->data and contains no
+    newline (see NodeSegmentedStoreBdd), so the index is on the line
+    that follows the first newline. Sets the start and end of each of
+    the nRoots segments and, in *pconsumed, the number of bytes up to
+    the end of the ".end" line. Returns DDDMP_SUCCESS if the index is
+    consistent with the size of the node section, DDDMP_FAILURE
+    otherwise.
+    ]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpCuddBddSegmentedLoad NodeSegmentedStoreBdd]
+
+******************************************************************************/
+
+static int
+DddmpReadSegmentIndex (
+  Dddmp_Map_t *map             /* IN: mapped node section and tail */,
+  int nRoots                   /* IN: number of roots */,
+  Dddmp_Segment_t *segments    /* OUT: segments */,
+  long *pconsumed              /* OUT: bytes up to the end of the file */
+  )
+{
+  unsigned char *nl, *eol, *tail;
+  char *line = NULL, *scan, *next;
+  long size, offset, prev;
+  int i;
+
+  nl = (unsigned char *) memchr (map->data, '\n', map->end - map->data);
+  Dddmp_CheckAndGotoLabel (nl==NULL, "Segment index not found.", failure);
+  size = nl - map->data;
+
+  eol = (unsigned char *) memchr (nl+1, '\n', map->end - (nl+1));
+  Dddmp_CheckAndGotoLabel (eol==NULL, "Segment index not found.", failure);
+
+  line = DDDMP_ALLOC (char, (eol - nl));
+  Dddmp_CheckAndGotoLabel (line==NULL, "Error allocating memory.",
+    failure);
+  memcpy (line, nl+1, eol - (nl+1));
+  line[eol - (nl+1)] = '\0';
+
+  Dddmp_CheckAndGotoLabel (!matchkeywd(line, ".segindex"),
+    "Segment index not found.", failure);
+  scan = line + strlen (".segindex");
+  Dddmp_CheckAndGotoLabel (strtol (scan, &next, 10) != nRoots ||
+    next == scan, "Wrong number of segments.", failure);
+
+  prev = 0;
+  for (i=0; i<=nRoots; i++) {
+    scan = next;
+    offset = strtol (scan, &next, 10);
+    Dddmp_CheckAndGotoLabel (next == scan || offset < prev || offset > size ||
+      (i == 0 && offset != 0) || (i == nRoots && offset != size),
+      "Wrong segment offset.", failure);
+    if (i > 0) {
+      segments[i-1].start = map->data + prev;
+      segments[i-1].end = map->data + offset;
+    }
+    prev = offset;
+  }
+
+  tail = eol + 1;
+  Dddmp_CheckAndGotoLabel (map->end - tail < 4 ||
+    strncmp ((char *) tail, ".end", 4) != 0, "Error .end not found.",
+    failure);
+  eol = (unsigned char *) memchr (tail, '\n', map->end - tail);
+  *pconsumed = (eol == NULL) ? (long) (map->end - map->data) :
+    (long) (eol + 1 - map->data);
+
+  DDDMP_FREE (line);
+
+  return (DDDMP_SUCCESS);
+
+  failure:
+
+    DDDMP_FREE (line);
+
+    return (DDDMP_FAILURE);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Decodes the segments of a queue.]
+
+  Description [Repeatedly takes the next segment of the queue and decodes
+    it, until the queue is empty. Run by each decoding thread, with the
+    queue as argument. Only the bytes and the buffers of the segments are
+    accessed.]
+
+  SideEffects [Fills the buffers of the segments]
+
+  SeeAlso     [DddmpCuddBddSegmentedLoad DddmpDecodeSegment]
+
+******************************************************************************/
+
+static void *
+DddmpDecodeSegments (
+  void *arg    /* IN: queue of the segments (Dddmp_SegmentQueue_t *) */
+  )
+{
+  Dddmp_SegmentQueue_t *queue = (Dddmp_SegmentQueue_t *) arg;
+  int i;
+
+  for (;;) {
+#ifdef DD_USE_THREADS
+    if (queue->shared) {
+      (void) pthread_mutex_lock (&queue->lock);
+    }
+#endif
+    i = queue->next++;
+#ifdef DD_USE_THREADS
+    if (queue->shared) {
+      (void) pthread_mutex_unlock (&queue->lock);
+    }
+#endif
+    if (i >= queue->nSegments) {
+      break;
+    }
+    queue->segments[i].status = DddmpDecodeSegment (&queue->segments[i],
+      queue->nsuppvars);
+  }
+
+  return (NULL);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Decodes the nodes of a segment.]
+
+  Description [Decodes the nodes of one segment, written in compact
+    format (see NodeCompactStoreBdd), into the vars and children buffers
+    of the segment. Returns DDDMP_FAILURE if the bytes are not a valid
+    sequence of exactly segment->nnodes nodes.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpDecodeSegments]
+
+******************************************************************************/
+
+static int
+DddmpDecodeSegment (
+  Dddmp_Segment_t *segment  /* IN/OUT: segment to be decoded */,
+  int nsuppvars             /* IN: number of support variables */
+  )
+{
+  Dddmp_Stream_t stream;
+  unsigned int d, ecompl, ref[2];
+  int *vars = segment->vars;
+  int *children = segment->children;
+  int i, j, var, vT, vE;
+
+  if (DddmpStreamOpenBuffer (&stream, segment->start, segment->end) == 0) {
+    return (DDDMP_FAILURE);
+  }
+
+  for (i=1; i<=segment->nnodes; i++) {
+    if (i == 1) {
+      /* only 1 terminal presently supported */
+      vars[i] = nsuppvars;
+      children[2*i] = children[2*i+1] = 0;
+      continue;
+    }
+
+    if (DddmpStreamReadGolomb (&stream, DDDMP_COMPACT_VAR_K, &d) == 0 ||
+      DddmpStreamReadBit (&stream, &ecompl) == 0 ||
+      DddmpStreamReadGolomb (&stream, DDDMP_COMPACT_REF_K, &ref[0]) == 0 ||
+      DddmpStreamReadGolomb (&stream, DDDMP_COMPACT_REF_K, &ref[1]) == 0) {
+      return (DDDMP_FAILURE);
+    }
+
+    for (j=0; j<2; j++) {
+      /* j==0: Then child, j==1: Else child */
+      if (ref[j] >= (unsigned int) i) {
+        return (DDDMP_FAILURE);
+      }
+      children[2*i+j] = (ref[j] == 0) ? 1 : i - (int) ref[j];
+    }
+
+    vT = vars[children[2*i]];
+    vE = vars[children[2*i+1]];
+    var = ((vT<vE) ? vT : vE) - (int) d - 1;
+    if (var < 0) {
+      return (DDDMP_FAILURE);
+    }
+    vars[i] = var;
+    children[2*i+1] = (children[2*i+1] << 1) | (int) ecompl;
+  }
+
+  /* only the padding of the last byte may be left */
+  if (stream.pos != stream.len) {
+    return (DDDMP_FAILURE);
+  }
+  (void) DddmpStreamClose (&stream);
+
+  return (DDDMP_SUCCESS);
+}
+
 /**Function********************************************************************
 
   Synopsis    [Reads a the header of a dump file representing the
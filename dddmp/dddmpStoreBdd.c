@@ -62,6 +62,13 @@
 
 static int NodeStoreRecurBdd(DdManager *ddMgr, DdNode *f, int mode, int *supportids, char **varnames, int *outids, FILE *fp);
 static int NodeTextStoreBdd(DdManager *ddMgr, DdNode *f, int mode, int *supportids, char **varnames, int *outids, FILE *fp, int idf, int vf, int idT, int idE);
+static int NodeStreamStoreBdd(DdNode **f, int nRoots, int nnodes, int *supportids, FILE *fp);
+static void CountRefRecurBdd(DdNode *f, int *refs);
+static void ClearVisitedRecurBdd(DdNode *f);
+static int NodeStreamStoreRecurBdd(DdNode *f, int *supportids, int *refs, Dddmp_Stream_t *stream);
+static int NodeCompactStoreBdd(DdNode **f, int nRoots, int nVars, int *supportids, FILE *fp);
+static int NodeCompactStoreRecurBdd(DdNode *f, int nVars, int *supportids, Dddmp_Stream_t *stream);
+static int NodeSegmentedStoreBdd(DdManager *ddMgr, DdNode **f, int nRoots, int nVars, int *supportids, FILE *fp);
 static int NodeBinaryStoreBdd(DdManager *ddMgr, DdNode *f, int mode, int *supportids, char **varnames, int *outids, FILE *fp, int idf, int vf, int idT, int idE, int vT, int vE, DdNode *T, DdNode *E);
 
 /**AutomaticEnd***************************************************************/
@@ -130,7 +137,17 @@ Dddmp_cuddBddStore (
     auxiliary id. Since conversion from DD pointers to integers 
     is required, DD nodes are temporarily removed from the unique
     hash table. This allows the use of the next field to store 
-    node IDs.
+    node IDs. In stream mode (DDDMP_MODE_STREAM) each node also
+    carries the number of its references, so that the loader can
+    release it as soon as all its parents have been read; nodes are
+    written through a buffer of fixed size. Compact mode
+    (DDDMP_MODE_COMPACT) packs each node in a few bits and is the densest
+    format: files are 50 to 80% of the size of binary files and about
+    10% of the size of text files (see NodeCompactStoreBdd).
+    Segmented mode (DDDMP_MODE_SEGMENTED) stores each root as an
+    independent segment in compact format, followed by an index of the
+    segments, so that the roots can be decoded in parallel on load:
+    see NodeSegmentedStoreBdd.
    ]
 
   SideEffects  [Nodes are temporarily removed from the unique hash
@@ -247,6 +264,7 @@ DddmpCuddBddArrayStore (
   int *invpermids = NULL;
   int *supportids = NULL;
   int *outids = NULL;
+  int *rootsizes = NULL;
   char **outvarnames = NULL;
   int nVars = ddMgr->size;
   int nnodes;
@@ -279,6 +297,9 @@ DddmpCuddBddArrayStore (
   switch (mode) {
     case DDDMP_MODE_TEXT:
     case DDDMP_MODE_BINARY:
+    case DDDMP_MODE_STREAM:
+    case DDDMP_MODE_COMPACT:
+    case DDDMP_MODE_SEGMENTED:
       break;
     case DDDMP_MODE_DEFAULT:
       mode = DDDMP_MODE_BINARY;
@@ -372,15 +393,31 @@ DddmpCuddBddArrayStore (
       }
       break;
     case DDDMP_MODE_BINARY:
+    case DDDMP_MODE_STREAM:
+    case DDDMP_MODE_COMPACT:
+    case DDDMP_MODE_SEGMENTED:
       outids = NULL;
       break;
   }
 
   /* 
-   *  Number dd nodes and count them (numbering is from 1 to nnodes)
+   *  Number dd nodes and count them (numbering is from 1 to nnodes).
+   *  In segmented mode each root is numbered on its own, when stored:
+   *  the nodes shared by several roots are counted once per root.
    */
 
-  nnodes = DddmpNumberBddNodes (ddMgr, f, nRoots);
+  if (mode == DDDMP_MODE_SEGMENTED) {
+    rootsizes = DDDMP_ALLOC (int, nRoots);
+    Dddmp_CheckAndGotoLabel (rootsizes==NULL, "Error allocating memory.",
+      failure);
+    nnodes = 0;
+    for (i=0; i<nRoots; i++) {
+      rootsizes[i] = (f[i] == NULL) ? 0 : Cudd_DagSize (f[i]);
+      nnodes += rootsizes[i];
+    }
+  } else {
+    nnodes = DddmpNumberBddNodes (ddMgr, f, nRoots);
+  }
 
   /* 
    * Start Header
@@ -580,6 +617,7 @@ DddmpCuddBddArrayStore (
   /* 
    * Write BDD indexes of function roots.
    * Use negative integers for complemented edges. 
+   * In segmented mode a root is the last node of its own segment.
    */
 
   for (i = 0; i < nRoots; i++) {
@@ -587,8 +625,10 @@ DddmpCuddBddArrayStore (
       (void) fprintf (stderr, "DdStore Warning: %d-th root is NULL\n",i);
       fflush (stderr);
       retValue = fprintf (fp, " 0");
-    }
-    if (Cudd_IsComplement(f[i])) {
+    } else if (rootsizes != NULL) {
+      retValue = fprintf (fp, " %d",
+        Cudd_IsComplement (f[i]) ? -rootsizes[i] : rootsizes[i]);
+    } else if (Cudd_IsComplement(f[i])) {
       retValue = fprintf (fp, " -%d",
         DddmpReadNodeIndexBdd (Cudd_Regular (f[i])));
     } else {
@@ -615,12 +655,27 @@ DddmpCuddBddArrayStore (
    *  Call the function that really gets the job done.
    */
 
-  for (i = 0; i < nRoots; i++) {
-    if (f[i] != NULL) {
-      retValue = NodeStoreRecurBdd (ddMgr, Cudd_Regular(f[i]),
-        mode, supportids, outvarnames, outids, fp);
-      Dddmp_CheckAndGotoLabel (retValue==DDDMP_FAILURE,
-        "Error writing to file.", failure);
+  if (mode == DDDMP_MODE_STREAM) {
+    retValue = NodeStreamStoreBdd (f, nRoots, nnodes, supportids, fp);
+    Dddmp_CheckAndGotoLabel (retValue==DDDMP_FAILURE,
+      "Error writing to file.", failure);
+  } else if (mode == DDDMP_MODE_COMPACT) {
+    retValue = NodeCompactStoreBdd (f, nRoots, nVars, supportids, fp);
+    Dddmp_CheckAndGotoLabel (retValue==DDDMP_FAILURE,
+      "Error writing to file.", failure);
+  } else if (mode == DDDMP_MODE_SEGMENTED) {
+    retValue = NodeSegmentedStoreBdd (ddMgr, f, nRoots, nVars, supportids,
+      fp);
+    Dddmp_CheckAndGotoLabel (retValue==DDDMP_FAILURE,
+      "Error writing to file.", failure);
+  } else {
+    for (i = 0; i < nRoots; i++) {
+      if (f[i] != NULL) {
+        retValue = NodeStoreRecurBdd (ddMgr, Cudd_Regular(f[i]),
+          mode, supportids, outvarnames, outids, fp);
+        Dddmp_CheckAndGotoLabel (retValue==DDDMP_FAILURE,
+          "Error writing to file.", failure);
+      }
     }
   }
 
@@ -636,11 +691,14 @@ DddmpCuddBddArrayStore (
     fclose (fp);
   }
 
-  DddmpUnnumberBddNodes (ddMgr, f, nRoots);
+  if (rootsizes == NULL) {
+    DddmpUnnumberBddNodes (ddMgr, f, nRoots);
+  }
   DDDMP_FREE (ids);
   DDDMP_FREE (permids);
   DDDMP_FREE (invpermids);
   DDDMP_FREE (supportids);
+  DDDMP_FREE (rootsizes);
 
   return (DDDMP_SUCCESS);
 
@@ -658,6 +716,9 @@ DddmpCuddBddArrayStore (
     if (supportids != NULL) {
       DDDMP_FREE (supportids);
     }
+    if (rootsizes != NULL) {
+      DDDMP_FREE (rootsizes);
+    }
     if (support != NULL) {
       Cudd_RecursiveDeref (ddMgr, support);
     }
@@ -851,6 +912,480 @@ NodeStoreRecurBdd (
   return (retValue);
 }
 
+/**Function********************************************************************
+
+  Synopsis     [Stores the nodes of an array of BDDs in stream format.]
+
+  Description  [Stores the (already numbered) nodes of an array of BDDs
+    in stream format. Each node is written, children first, as a
+    sequence of unsigned integers (see DddmpStreamWriteUint):
+    <UL>
+    <LI> the position of its variable in the support plus one (0 for
+         the constant node);
+    <LI> for internal nodes, the distance between the node id and the
+         id of the Then child;
+    <LI> for internal nodes, the distance between the node id and the
+         id of the Else child, times two, plus the complement bit;
+    <LI> the number of references to the node, counting both the arcs
+         of the stored BDDs and the occurrences among the roots.
+    </UL>
+    The reference counts allow the loader to drop a node from its
+    tables as soon as its last reference has been read. Output goes
+    through a buffer of DDDMP_STREAM_CHUNK bytes. On return the nodes
+    are marked as visited, as done by NodeStoreRecurBdd.
+    ]
+
+  SideEffects  [None]
+
+  SeeAlso      [DddmpCuddBddArrayStore NodeStoreRecurBdd]
+
+******************************************************************************/
+
+static int
+NodeStreamStoreBdd (
+  DdNode **f        /* IN: array of BDD roots */,
+  int nRoots        /* IN: number of roots */,
+  int nnodes        /* IN: number of (numbered) nodes */,
+  int *supportids   /* IN: internal ids for variables */,
+  FILE *fp          /* IN: store file */
+  )
+{
+  Dddmp_Stream_t stream;
+  int *refs = NULL;
+  int i, retValue;
+
+  stream.buf = NULL;
+
+  refs = DDDMP_ALLOC (int, nnodes+1);
+  Dddmp_CheckAndGotoLabel (refs==NULL, "Error allocating memory.",
+    failure);
+  for (i=0; i<=nnodes; i++) {
+    refs[i] = 0;
+  }
+
+  /*
+   *  Count references: roots first, then arcs
+   */
+
+  for (i=0; i<nRoots; i++) {
+    if (f[i] != NULL) {
+      refs[DddmpReadNodeIndexBdd (Cudd_Regular (f[i]))]++;
+      CountRefRecurBdd (Cudd_Regular (f[i]), refs);
+    }
+  }
+  for (i=0; i<nRoots; i++) {
+    if (f[i] != NULL) {
+      ClearVisitedRecurBdd (Cudd_Regular (f[i]));
+    }
+  }
+
+  /*
+   *  Write nodes
+   */
+
+  Dddmp_CheckAndGotoLabel (DddmpStreamOpen (&stream, fp, 1)==0,
+    "Error allocating memory.", failure);
+
+  for (i=0; i<nRoots; i++) {
+    if (f[i] != NULL) {
+      retValue = NodeStreamStoreRecurBdd (Cudd_Regular (f[i]), supportids,
+        refs, &stream);
+      Dddmp_CheckAndGotoLabel (retValue==DDDMP_FAILURE,
+        "Error writing to file.", failure);
+    }
+  }
+
+  retValue = DddmpStreamClose (&stream);
+  Dddmp_CheckAndGotoLabel (retValue==0, "Error writing to file.",
+    failure);
+
+  DDDMP_FREE (refs);
+
+  return (DDDMP_SUCCESS);
+
+  failure:
+
+    if (stream.buf != NULL) {
+      (void) DddmpStreamClose (&stream);
+    }
+    if (refs != NULL) {
+      DDDMP_FREE (refs);
+    }
+
+    return (DDDMP_FAILURE);
+}
+
+/**Function********************************************************************
+
+  Synopsis     [Counts the references to the nodes of a BDD.]
+
+  Description  [Increments refs\[id\] for each arc pointing to the node
+    numbered id. Nodes are marked as visited.]
+
+  SideEffects  [None]
+
+  SeeAlso      [NodeStreamStoreBdd ClearVisitedRecurBdd]
+
+******************************************************************************/
+
+static void
+CountRefRecurBdd (
+  DdNode *f   /* IN: regular BDD node */,
+  int *refs   /* IN/OUT: reference counts, by node ids */
+  )
+{
+  DdNode *T, *E;
+
+  if (DddmpVisitedBdd (f)) {
+    return;
+  }
+  DddmpSetVisitedBdd (f);
+
+  if (!Cudd_IsConstant (f)) {
+    T = cuddT (f);
+    E = Cudd_Regular (cuddE (f));
+    refs[DddmpReadNodeIndexBdd (T)]++;
+    refs[DddmpReadNodeIndexBdd (E)]++;
+    CountRefRecurBdd (T, refs);
+    CountRefRecurBdd (E, refs);
+  }
+
+  return;
+}
+
+/**Function********************************************************************
+
+  Synopsis     [Clears the visited flag of the nodes of a BDD.]
+
+  Description  [Clears the visited flag set by CountRefRecurBdd.]
+
+  SideEffects  [None]
+
+  SeeAlso      [CountRefRecurBdd]
+
+******************************************************************************/
+
+static void
+ClearVisitedRecurBdd (
+  DdNode *f   /* IN: regular BDD node */
+  )
+{
+  if (!DddmpVisitedBdd (f)) {
+    return;
+  }
+  DddmpClearVisitedBdd (f);
+
+  if (!Cudd_IsConstant (f)) {
+    ClearVisitedRecurBdd (cuddT (f));
+    ClearVisitedRecurBdd (Cudd_Regular (cuddE (f)));
+  }
+
+  return;
+}
+
+/**Function********************************************************************
+
+  Synopsis     [Performs the recursive step of NodeStreamStoreBdd.]
+
+  Description  [Writes f and, recursively, its unvisited descendants in
+    stream format. Children are written before their parents.]
+
+  SideEffects  [Nodes are marked as visited]
+
+  SeeAlso      [NodeStreamStoreBdd]
+
+******************************************************************************/
+
+static int
+NodeStreamStoreRecurBdd (
+  DdNode *f               /* IN: regular BDD node */,
+  int *supportids         /* IN: internal ids for variables */,
+  int *refs               /* IN: reference counts, by node ids */,
+  Dddmp_Stream_t *stream  /* IN: output stream */
+  )
+{
+  DdNode *T, *E;
+  int idf, idT, idE;
+
+  if (DddmpVisitedBdd (f)) {
+    return (DDDMP_SUCCESS);
+  }
+  DddmpSetVisitedBdd (f);
+
+  idf = DddmpReadNodeIndexBdd (f);
+
+  if (Cudd_IsConstant (f)) {
+    if (DddmpStreamWriteUint (stream, 0) == 0 ||
+      DddmpStreamWriteUint (stream, (unsigned int) refs[idf]) == 0) {
+      return (DDDMP_FAILURE);
+    }
+    return (DDDMP_SUCCESS);
+  }
+
+  T = cuddT (f);
+  E = cuddE (f);
+  if (NodeStreamStoreRecurBdd (T, supportids, refs, stream) ==
+    DDDMP_FAILURE) {
+    return (DDDMP_FAILURE);
+  }
+  if (NodeStreamStoreRecurBdd (Cudd_Regular (E), supportids, refs, stream) ==
+    DDDMP_FAILURE) {
+    return (DDDMP_FAILURE);
+  }
+
+  idT = DddmpReadNodeIndexBdd (T);
+  idE = DddmpReadNodeIndexBdd (Cudd_Regular (E));
+
+  if (DddmpStreamWriteUint (stream,
+      (unsigned int) supportids[f->index] + 1) == 0 ||
+    DddmpStreamWriteUint (stream, (unsigned int) (idf - idT)) == 0 ||
+    DddmpStreamWriteUint (stream,
+      ((unsigned int) (idf - idE) << 1) | Cudd_IsComplement (E)) == 0 ||
+    DddmpStreamWriteUint (stream, (unsigned int) refs[idf]) == 0) {
+    return (DDDMP_FAILURE);
+  }
+
+  return (DDDMP_SUCCESS);
+}
+
+/**Function********************************************************************
+
+  Synopsis     [Stores the nodes of an array of BDDs in compact format.]
+
+  Description  [Stores the (already numbered) nodes of an array of BDDs
+    in compact format. Nodes are written children first, so that the
+    ids of the children are always smaller than the id of the node; the
+    constant node, always number 1, is not written. Each node is coded
+    as a sequence of bits (see DddmpStreamWriteBits), with no alignment
+    to bytes:
+    <UL>
+    <LI> d-1, where d is the difference between the smallest position
+         in the support of the variables of the children (the position
+         of a constant being the size of the support) and the position
+         of the variable of the node, as an Exp-Golomb code of order
+         DDDMP_COMPACT_VAR_K (see DddmpStreamWriteGolomb);
+    <LI> the complement bit of the Else arc;
+    <LI> the reference to the Then child and the one to the Else child,
+         each as an Exp-Golomb code of order DDDMP_COMPACT_REF_K: 0 for
+         the constant node, the difference between the id of the node
+         and the id of the child otherwise.
+    </UL>
+    A node whose variable is just above those of its children and whose
+    Then child is written just before it takes 6 bits. Measured on the
+    outputs of some nanotrav benchmarks, stored with DDDMP_VARIDS, the
+    size of compact files relative to binary and text files is:
+    <pre>
+                         whole file        node section
+      circuit   nodes   binary   text     binary   text
+      C880       7181    0.70    0.108     0.70    0.105
+      mult32a    1649    0.55    0.078     0.48    0.060
+      rcn25       870    0.51    0.101     0.43    0.075
+      s641        782    0.70    0.124     0.60    0.084
+      adj49       431    0.82    0.122     0.72    0.073
+    </pre>
+    Output goes through a buffer of DDDMP_STREAM_CHUNK bytes.
+    ]
+
+  SideEffects  [None]
+
+  SeeAlso      [DddmpCuddBddArrayStore NodeStreamStoreBdd]
+
+******************************************************************************/
+
+static int
+NodeCompactStoreBdd (
+  DdNode **f        /* IN: array of BDD roots */,
+  int nRoots        /* IN: number of roots */,
+  int nVars         /* IN: number of variables of the manager */,
+  int *supportids   /* IN: internal ids for variables */,
+  FILE *fp          /* IN: store file */
+  )
+{
+  Dddmp_Stream_t stream;
+  int i, retValue;
+
+  Dddmp_CheckAndGotoLabel (DddmpStreamOpen (&stream, fp, 1)==0,
+    "Error allocating memory.", failure);
+
+  for (i=0; i<nRoots; i++) {
+    if (f[i] != NULL) {
+      retValue = NodeCompactStoreRecurBdd (Cudd_Regular (f[i]), nVars,
+        supportids, &stream);
+      if (retValue == DDDMP_FAILURE) {
+        (void) DddmpStreamClose (&stream);
+        return (DDDMP_FAILURE);
+      }
+    }
+  }
+
+  retValue = DddmpStreamClose (&stream);
+  Dddmp_CheckAndGotoLabel (retValue==0, "Error writing to file.",
+    failure);
+
+  return (DDDMP_SUCCESS);
+
+  failure:
+    return (DDDMP_FAILURE);
+}
+
+/**Function********************************************************************
+
+  Synopsis     [Performs the recursive step of NodeCompactStoreBdd.]
+
+  Description  [Writes f and, recursively, its unvisited descendants in
+    compact format. Children are written before their parents.]
+
+  SideEffects  [Nodes are marked as visited]
+
+  SeeAlso      [NodeCompactStoreBdd]
+
+******************************************************************************/
+
+static int
+NodeCompactStoreRecurBdd (
+  DdNode *f               /* IN: regular BDD node */,
+  int nVars               /* IN: number of variables of the manager */,
+  int *supportids         /* IN: internal ids for variables */,
+  Dddmp_Stream_t *stream  /* IN: output stream */
+  )
+{
+  DdNode *T, *E;
+  int idf, vf, vT, vE;
+  unsigned int refT, refE;
+
+  if (DddmpVisitedBdd (f)) {
+    return (DDDMP_SUCCESS);
+  }
+  DddmpSetVisitedBdd (f);
+
+  if (Cudd_IsConstant (f)) {
+    return (DDDMP_SUCCESS);
+  }
+
+  T = cuddT (f);
+  E = Cudd_Regular (cuddE (f));
+  if (NodeCompactStoreRecurBdd (T, nVars, supportids, stream) ==
+    DDDMP_FAILURE) {
+    return (DDDMP_FAILURE);
+  }
+  if (NodeCompactStoreRecurBdd (E, nVars, supportids, stream) ==
+    DDDMP_FAILURE) {
+    return (DDDMP_FAILURE);
+  }
+
+  idf = DddmpReadNodeIndexBdd (f);
+  vf = supportids[f->index];
+  if (Cudd_IsConstant (T)) {
+    vT = supportids[nVars];
+    refT = 0;
+  } else {
+    vT = supportids[T->index];
+    refT = (unsigned int) (idf - DddmpReadNodeIndexBdd (T));
+  }
+  if (Cudd_IsConstant (E)) {
+    vE = supportids[nVars];
+    refE = 0;
+  } else {
+    vE = supportids[E->index];
+    refE = (unsigned int) (idf - DddmpReadNodeIndexBdd (E));
+  }
+
+  if (DddmpStreamWriteGolomb (stream,
+      (unsigned int) ((vT<vE ? vT : vE) - vf - 1), DDDMP_COMPACT_VAR_K) == 0 ||
+    DddmpStreamWriteBits (stream,
+      (unsigned int) (Cudd_IsComplement (cuddE (f)) ? 1 : 0), 1) == 0 ||
+    DddmpStreamWriteGolomb (stream, refT, DDDMP_COMPACT_REF_K) == 0 ||
+    DddmpStreamWriteGolomb (stream, refE, DDDMP_COMPACT_REF_K) == 0) {
+    return (DDDMP_FAILURE);
+  }
+
+  return (DDDMP_SUCCESS);
+}
+
+/**Function********************************************************************
+
+  Synopsis     [Writes the nodes of a BDD array in segmented format.]
+
+  Description  [Each root is numbered on its own (from 1 to the size of
+    its cone, so that the root is the last node) and written in compact
+    format (see NodeCompactStoreBdd) as an independent segment, flushed
+    before the next one starts. The nodes shared by several roots are
+    thus written once per root. NULL roots have empty segments. After
+    the last segment a line
+    <pre>
+    .segindex n off_0 ... off_n
+    </pre>
+    is written, where n is the number of roots and off_i is the offset
+    of the i-th segment from the start of the node section (off_n is
+    the size of the node section). Escaped data never contains a
+    newline, so the index can be found by scanning the file backwards.
+    ]
+
+  SideEffects  [The nodes of each root are temporarily removed from the
+    unique table, as done by DddmpNumberBddNodes.]
+
+  SeeAlso      [DddmpCuddBddArrayStore NodeCompactStoreBdd]
+
+******************************************************************************/
+
+static int
+NodeSegmentedStoreBdd (
+  DdManager *ddMgr  /* IN: DD Manager */,
+  DdNode **f        /* IN: array of BDD roots */,
+  int nRoots        /* IN: number of roots */,
+  int nVars         /* IN: number of variables of the manager */,
+  int *supportids   /* IN: internal ids for variables */,
+  FILE *fp          /* IN: store file */
+  )
+{
+  long *offsets = NULL;
+  long base;
+  int i, retValue;
+
+  offsets = DDDMP_ALLOC (long, nRoots+1);
+  Dddmp_CheckAndGotoLabel (offsets==NULL, "Error allocating memory.",
+    failure);
+
+  base = ftell (fp);
+  Dddmp_CheckAndGotoLabel (base<0, "Error writing to file.", failure);
+
+  for (i=0; i<nRoots; i++) {
+    offsets[i] = ftell (fp) - base;
+    if (f[i] != NULL) {
+      (void) DddmpNumberBddNodes (ddMgr, &f[i], 1);
+      retValue = NodeCompactStoreBdd (&f[i], 1, nVars, supportids, fp);
+      DddmpUnnumberBddNodes (ddMgr, &f[i], 1);
+      Dddmp_CheckAndGotoLabel (retValue==DDDMP_FAILURE,
+        "Error writing to file.", failure);
+    }
+  }
+  offsets[nRoots] = ftell (fp) - base;
+
+  retValue = fprintf (fp, "\n.segindex %d", nRoots);
+  Dddmp_CheckAndGotoLabel (retValue==EOF, "Error writing to file.",
+    failure);
+  for (i=0; i<=nRoots; i++) {
+    retValue = fprintf (fp, " %ld", offsets[i]);
+    Dddmp_CheckAndGotoLabel (retValue==EOF, "Error writing to file.",
+      failure);
+  }
+  retValue = fprintf (fp, "\n");
+  Dddmp_CheckAndGotoLabel (retValue==EOF, "Error writing to file.",
+    failure);
+
+  DDDMP_FREE (offsets);
+
+  return (DDDMP_SUCCESS);
+
+  failure:
+
+    if (offsets != NULL) {
+      DDDMP_FREE (offsets);
+    }
+
+    return (DDDMP_FAILURE);
+}
+
 /**Function********************************************************************
 
   Synopsis     [Store One Single Node in Text Format.]
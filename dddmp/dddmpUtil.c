@@ -26,6 +26,14 @@
 ******************************************************************************/
 
 #include "dddmpInt.h"
+#if HAVE_UNISTD_H == 1
+#include <unistd.h>
+#endif
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0 && HAVE_SYS_STAT_H == 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define DDDMP_USE_MMAP 1
+#endif
 
 /*---------------------------------------------------------------------------*/
 /* Stucture declarations                                                     */
@@ -430,6 +438,130 @@ DddmpIntArrayWrite (
   return (n);
 }
 
+/**Function********************************************************************
+
+  Synopsis    [Makes the rest of a dump file available in memory]
+
+  Description [Makes the bytes of fp from the current file position to
+    the end of the file available in memory.  Regular files are mapped
+    read-only with mmap where supported, so that only the pages actually
+    touched are read; otherwise (or if mmap fails) the remainder of the
+    file is read into a heap buffer.  On success map->data points to the
+    byte at the current position, map->end one past the last byte, and
+    the file position is left unchanged.  Returns 1 on success, 0 on
+    failure.
+    ]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpMapClose]
+
+******************************************************************************/
+
+int
+DddmpMapOpen (
+  FILE *fp           /* IN: input file */,
+  Dddmp_Map_t *map   /* OUT: description of the mapped region */
+  )
+{
+  long pos, last;
+  size_t n;
+
+  map->base = map->data = map->end = NULL;
+  map->length = 0;
+  map->mapped = 0;
+
+  pos = ftell (fp);
+  if (pos < 0) {
+    return (0);
+  }
+
+#ifdef DDDMP_USE_MMAP
+  {
+    struct stat st;
+    void *addr;
+
+    if (fstat (fileno (fp), &st) == 0 && S_ISREG (st.st_mode) &&
+      st.st_size > pos) {
+      addr = mmap (NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE,
+        fileno (fp), 0);
+      if (addr != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+        (void) madvise (addr, (size_t) st.st_size, MADV_SEQUENTIAL);
+#endif
+        map->base = (unsigned char *) addr;
+        map->length = (size_t) st.st_size;
+        map->data = map->base + pos;
+        map->end = map->base + map->length;
+        map->mapped = 1;
+        return (1);
+      }
+    }
+  }
+#endif
+
+  /* Fallback: read the remainder of the file. */
+  if (fseek (fp, 0L, SEEK_END) != 0) {
+    return (0);
+  }
+  last = ftell (fp);
+  if (last < pos || fseek (fp, pos, SEEK_SET) != 0) {
+    return (0);
+  }
+  map->length = (size_t) (last - pos);
+  map->base = DDDMP_ALLOC (unsigned char, map->length + 1);
+  if (map->base == NULL) {
+    return (0);
+  }
+  n = fread (map->base, 1, map->length, fp);
+  (void) fseek (fp, pos, SEEK_SET);
+  if (n != map->length) {
+    DDDMP_FREE (map->base);
+    map->base = NULL;
+    return (0);
+  }
+  map->data = map->base;
+  map->end = map->base + map->length;
+
+  return (1);
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Releases a region obtained with DddmpMapOpen]
+
+  Description [Unmaps or frees the memory described by map.]
+
+  SideEffects [None]
+
+  SeeAlso     [DddmpMapOpen]
+
+******************************************************************************/
+
+void
+DddmpMapClose (
+  Dddmp_Map_t *map   /* IN: region to be released */
+  )
+{
+  if (map->base == NULL) {
+    return;
+  }
+#ifdef DDDMP_USE_MMAP
+  if (map->mapped) {
+    (void) munmap ((void *) map->base, map->length);
+  } else {
+    DDDMP_FREE (map->base);
+  }
+#else
+  DDDMP_FREE (map->base);
+#endif
+  map->base = map->data = map->end = NULL;
+  map->length = 0;
+  map->mapped = 0;
+
+  return;
+}
+
 /*---------------------------------------------------------------------------*/
 /* Definition of static functions                                            */
 /*---------------------------------------------------------------------------*/
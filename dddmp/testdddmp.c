@@ -130,6 +130,7 @@ typedef struct dddmpVarInfo {
 Dddmp_RootMatchType rootmatchmode;
 Dddmp_VarMatchType varmatchmode;
 Dddmp_VarInfoType varoutinfo;
+int storemode;
 char varname[DDDMPTEST_MAX_STRING_LENGTH];
 
 /*---------------------------------------------------------------------------*/
@@ -171,6 +172,7 @@ static int BddStoreCnf(DdManager *ddMgr, DdNode **operandBdd, dddmpVarInfo_t *va
 static int BddArrayStoreCnf(DdManager *ddMgr, DdNode ***operandBddArray, int *operandBddArraySize, dddmpVarInfo_t *varInfo);
 static int DynamicReordering(DdManager *ddMgr);
 static int SetLoadMatchmode();
+static int SetStoreMode();
 static int CompleteInfoStruct(Dddmp_DecompType ddType, int nVars, int nSuppVars, char **suppVarNames, char **orderedVarNames, int *varIds, int *varComposeIds, int *varAuxIds, int nRoots, dddmpVarInfo_t *varInfo);
 static void ReadInt(Dddmp_MessageType message, int *i);
 static void ReadString(Dddmp_MessageType message, char string[]);
@@ -211,6 +213,7 @@ main(
   varmatchmode = DDDMP_VAR_MATCHNAMES;
 #endif
   varoutinfo = DDDMP_VARIDS;
+  storemode = DDDMP_MODE_TEXT;
 
   row = DDDMP_ALLOC (char, DDDMPTEST_MAX_STRING_LENGTH);
   Dddmp_CheckAndReturn (row==NULL, "Allocation error.");
@@ -251,6 +254,8 @@ main(
       IntArrayLoad (&varInfo, "cil");
     } else if (strncmp (row, "slm", 3)==0) {
       SetLoadMatchmode ();
+    } else if (strncmp (row, "ssm", 3)==0) {
+      SetStoreMode ();
     } else if (strncmp (row, "op", 2)==0) {
       Operation (ddMgr, operandBdd);
     } else if (strncmp (row, "oc", 2)==0) {
@@ -624,9 +629,25 @@ A2B(
   void
 )
 {
-  fprintf (stderr, "Not yet Implemented!!!\n");
+  char fileNameIn[DDDMPTEST_MAX_FILENAME_LENGTH];
+  char fileNameOut[DDDMPTEST_MAX_FILENAME_LENGTH];
 
-  return (DDDMP_FAILURE);
+  /*------------------------ Read Operation Operands ------------------------*/
+
+  ReadString (DDDMP_MESSAGE_FILE, fileNameIn);
+  ReadString (DDDMP_MESSAGE_FILE, fileNameOut);
+
+  /*------------------------------- Convert ---------------------------------*/
+
+  fprintf (stdout, "Converting %s to %s ...\n", fileNameIn, fileNameOut);
+
+  if (Dddmp_Text2Bin (fileNameIn, fileNameOut) == 0) {
+    fprintf (stderr, "Dddmp Test Error : %s is not converted\n",
+      fileNameIn);
+    return (DDDMP_FAILURE);
+  }
+
+  return (DDDMP_SUCCESS);
 }
 
 /**Function********************************************************************
@@ -646,9 +667,25 @@ B2A(
   void
 )
 {
-  fprintf (stderr, "Not yet Implemented!!!\n");
+  char fileNameIn[DDDMPTEST_MAX_FILENAME_LENGTH];
+  char fileNameOut[DDDMPTEST_MAX_FILENAME_LENGTH];
+
+  /*------------------------ Read Operation Operands ------------------------*/
+
+  ReadString (DDDMP_MESSAGE_FILE, fileNameIn);
+  ReadString (DDDMP_MESSAGE_FILE, fileNameOut);
+
+  /*------------------------------- Convert ---------------------------------*/
+
+  fprintf (stdout, "Converting %s to %s ...\n", fileNameIn, fileNameOut);
+
+  if (Dddmp_Bin2Text (fileNameIn, fileNameOut) == 0) {
+    fprintf (stderr, "Dddmp Test Error : %s is not converted\n",
+      fileNameIn);
+    return (DDDMP_FAILURE);
+  }
 
-  return (DDDMP_FAILURE);
+  return (DDDMP_SUCCESS);
 }
 
 /**Function********************************************************************
@@ -914,15 +951,15 @@ Help(
   fprintf (stdout, "\toil  : Load the order from a file (varAuxIds).\n");
   fprintf (stdout, "\tcil  : Load compose IDs from a file.\n");
   fprintf (stdout, "\tslm  : Set Load matchmode for variables.\n");
+  fprintf (stdout,
+    "\tssm  : Set Store mode (text, binary, stream, compact,\n"
+    "\t       segmented).\n");
   fprintf (stdout,
     "\top   : Operation (or, and, xor, not, =) between BDDs.\n");
   fprintf (stdout, "\toc   : Create a terminal-one BDD.\n");
   fprintf (stdout, "\tzc   : Create a terminal-zero BDD.\n");
   fprintf (stdout, "\tlc   : Create a single variable BDD (1 node).\n");
   fprintf (stdout, "\tbc   : Create a random BDD.\n");
-
-  fprintf (stdout, "NOT YET IMPLEMENTED\n");
-
   fprintf (stdout,
     "\ta2b  : Convert a file from the ASCII format to the binary one.\n");
   fprintf (stdout,
@@ -1554,7 +1591,7 @@ BddStore (
   /*----------------------------- Store BDDs -------------------------------*/
 
   retValue = Dddmp_cuddBddStore(ddMgr, NULL, f, varInfo->orderedVarNames,
-    varInfo->varAuxIdsAll, DDDMP_MODE_TEXT, varoutinfo, fileName, NULL);
+    varInfo->varAuxIdsAll, storemode, varoutinfo, fileName, NULL);
 
   Dddmp_CheckAndGotoLabel (retValue!=DDDMP_SUCCESS, "BDD NOT stored.",
     failure);
@@ -1601,7 +1638,7 @@ BddArrayStore (
   fflush (stdout);
 
   retValue = Dddmp_cuddBddArrayStore (ddMgr, NULL, nRoots, operandBddArray[i],
-    NULL, varInfo->orderedVarNames, varInfo->varAuxIdsAll, DDDMP_MODE_TEXT,
+    NULL, varInfo->orderedVarNames, varInfo->varAuxIdsAll, storemode,
     DDDMP_VARIDS, fileName, NULL);
 
   Dddmp_CheckAndGotoLabel (retValue!=DDDMP_SUCCESS, "BDD NOT stored.",
@@ -2286,6 +2323,60 @@ ReadString (
   return;
 }
 
+/**Function********************************************************************
+
+  Synopsis     [Selects the format used to store BDDs.]
+
+  Description  [Selects the format used to store BDDs.]
+
+  SideEffects  []
 
+  SeeAlso      []
 
+******************************************************************************/
 
+static int
+SetStoreMode (
+  )
+{
+  int sel;
+  char row[DDDMPTEST_MAX_FILENAME_LENGTH];
+  char *retval;
+
+  fprintf (stdout, "Store mode:\n");
+  fprintf (stdout, "Text                                     (1)\n");
+  fprintf (stdout, "Binary                                   (2)\n");
+  fprintf (stdout, "Stream                                   (3)\n");
+  fprintf (stdout, "Compact                                  (4)\n");
+  fprintf (stdout, "Segmented                                (5)\n");
+  fprintf (stdout, "Your choice: ");
+  fflush (stdout);
+
+  retval = fgets (row, DDDMPTEST_MAX_STRING_LENGTH, stdin);
+  if (!retval)
+    return (DDDMP_FAILURE);
+  sscanf (row, "%d", &sel);
+
+  switch (sel) {
+    case 1:
+      storemode = DDDMP_MODE_TEXT;
+      break;
+    case 2:
+      storemode = DDDMP_MODE_BINARY;
+      break;
+    case 3:
+      storemode = DDDMP_MODE_STREAM;
+      break;
+    case 4:
+      storemode = DDDMP_MODE_COMPACT;
+      break;
+    case 5:
+      storemode = DDDMP_MODE_SEGMENTED;
+      break;
+    default:
+      fprintf (stderr, "Wrong choice!\n");
+      break;
+  }
+
+  return (DDDMP_SUCCESS);
+}
@@ -95,6 +95,7 @@ static int bnetLevelDFS (BnetNetwork *net, BnetNode *node);
 static BnetNode ** bnetOrderRoots (BnetNetwork *net, int *nroots);
 static int bnetLevelCompare (BnetNode **x, BnetNode **y);
 static int bnetDfsOrder (DdManager *dd, BnetNetwork *net, BnetNode *node);
+static char ** bnetVarNames (DdManager *dd, BnetNetwork *net);
 
 /** \endcond */
 
@@ -1239,6 +1240,94 @@ Bnet_PrintOrder(
 } /* end of Bnet_PrintOrder */
 
 
+/**
+  @brief Applies the best matching order of a variable-order database.
+
+  @details Matches the primary inputs and present state variables of
+  the network by name against the orders saved in dbFile by
+  Bnet_SaveOrder.  A missing database is not an error.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect Reorders the variables of the manager.
+
+  @see Bnet_SaveOrder Cudd_LoadOrder
+
+*/
+int
+Bnet_LoadOrder(
+  DdManager * dd,
+  BnetNetwork * net,
+  char * dbFile,
+  int  pr)
+{
+    char **names;
+    FILE *fp;
+    int matched, result;
+
+    fp = fopen(dbFile, "r");
+    if (fp == NULL) {
+	if (pr > 0) {
+	    (void) printf("Order database %s not found\n", dbFile);
+	}
+	return(1);
+    }
+    names = bnetVarNames(dd, net);
+    if (names == NULL) {
+	(void) fclose(fp);
+	return(0);
+    }
+    result = Cudd_LoadOrder(dd, fp, (char const * const *) names, &matched);
+    FREE(names);
+    (void) fclose(fp);
+    if (result == 0) return(0);
+    if (pr > 0) {
+	(void) printf("Order database %s: %d of %d variables matched\n",
+		      dbFile, matched, Cudd_ReadSize(dd));
+    }
+    return(1);
+
+} /* end of Bnet_LoadOrder */
+
+
+/**
+  @brief Appends the variable order to a variable-order database.
+
+  @details The primary inputs and present state variables are saved
+  with their names.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect None
+
+  @see Bnet_LoadOrder Cudd_SaveOrder
+
+*/
+int
+Bnet_SaveOrder(
+  DdManager * dd,
+  BnetNetwork * net,
+  char * dbFile)
+{
+    char **names;
+    FILE *fp;
+    int result;
+
+    names = bnetVarNames(dd, net);
+    if (names == NULL) return(0);
+    fp = fopen(dbFile, "a");
+    if (fp == NULL) {
+	FREE(names);
+	return(0);
+    }
+    result = Cudd_SaveOrder(dd, fp, (char const * const *) names);
+    FREE(names);
+    if (fclose(fp) == EOF) return(0);
+    return(result);
+
+} /* end of Bnet_SaveOrder */
+
+
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -2229,3 +2318,46 @@ bnetDfsOrder(
     return(1);
 
 } /* end of bnetLevelDFS */
+
+
+/**
+  @brief Collects the names of the %DD variables of a network.
+
+  @details Only primary inputs and present states have names.
+
+  @return an array of names indexed by variable index if successful;
+  NULL otherwise.  The names are not copied.
+
+  @sideeffect None
+
+*/
+static char **
+bnetVarNames(
+  DdManager * dd,
+  BnetNetwork * net)
+{
+    char **names;
+    char *name;
+    BnetNode *node;
+    int i, nvars;
+
+    nvars = Cudd_ReadSize(dd);
+    names = ALLOC(char *, nvars + 1);
+    if (names == NULL) return(NULL);
+    for (i = 0; i < nvars; i++) {
+	names[i] = NULL;
+    }
+    for (i = 0; i < net->npis + net->nlatches; i++) {
+	name = i < net->npis ? net->inputs[i] :
+	    net->latches[i - net->npis][1];
+	if (!st_lookup(net->hash,name,(void **)&node)) {
+	    FREE(names);
+	    return(NULL);
+	}
+	if (node->dd != NULL && node->var >= 0 && node->var < nvars) {
+	    names[node->var] = node->name;
+	}
+    }
+    return(names);
+
+} /* end of bnetVarNames */
@@ -180,6 +180,8 @@ extern int Bnet_bddDump (DdManager *dd, BnetNetwork *network, char *dfile, int d
 extern int Bnet_bddArrayDump (DdManager *dd, BnetNetwork *network, char *dfile, DdNode **outputs, char **onames, int noutputs, int dumpFmt);
 extern int Bnet_ReadOrder (DdManager *dd, char *ordFile, BnetNetwork *net, int locGlob, int nodrop);
 extern int Bnet_PrintOrder (BnetNetwork * net, DdManager *dd);
+extern int Bnet_LoadOrder (DdManager *dd, BnetNetwork *net, char *dbFile, int pr);
+extern int Bnet_SaveOrder (DdManager *dd, BnetNetwork *net, char *dbFile);
 
 /** \endcond */
 
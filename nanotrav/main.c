@@ -227,6 +227,12 @@ main(
 	    if (result == 0) exit(2);
 	}
 
+	/* Save the final order for later runs. */
+	if (option->saveOrder != NULL) {
+	    result = Bnet_SaveOrder(dd,net1,option->saveOrder);
+	    if (result == 0) exit(2);
+	}
+
 	/* Print the re-encoded inputs. */
 	if (pr >= 1 && reencoded == 1) {
 	    for (i = 0; i < net1->npis; i++) {
@@ -427,6 +433,18 @@ main(
 	    (void) printf("Cudd_PrintInfo failed.\n");
 	}
     }
+    if (option->reordSummary) {
+	result = Cudd_PrintReorderingSummary(dd,stdout);
+	if (result != 1) {
+	    (void) printf("Cudd_PrintReorderingSummary failed.\n");
+	}
+    }
+    if (option->memBreakdown) {
+	result = Cudd_PrintMemoryBreakdown(dd,stdout);
+	if (result != 1) {
+	    (void) printf("Cudd_PrintMemoryBreakdown failed.\n");
+	}
+    }
 
 #if defined(DD_DEBUG) && !defined(DD_NO_DEATH_ROW)
     (void) fprintf(dd->err,"%d empty slots in death row\n",
@@ -563,15 +581,25 @@ mainInit(
     option->cacheSize      = 32768;
     option->maxMemory      = 0;	/* set automatically */
     option->maxMemHard     = 0; /* don't set */
+    option->releaseFrac    = 0.0; /* never release */
+    option->spillFile      = NULL;
     option->maxLive        = ~0U; /* very large number */
     option->slots          = CUDD_UNIQUE_SLOTS;
     option->ordering       = PI_PS_FROM_FILE;
     option->orderPiPs      = NULL;
+    option->loadOrder      = NULL;
+    option->saveOrder      = NULL;
     option->reordering     = CUDD_REORDER_NONE;
     option->autoMethod     = CUDD_REORDER_SIFT;
     option->autoDyn        = 0;
     option->treefile       = NULL;
     option->firstReorder   = DD_FIRST_REORDER;
+    option->adaptive       = FALSE;
+    option->reordSummary   = FALSE;
+    option->memBreakdown   = FALSE;
+    option->keepCache      = FALSE;
+    option->tightSift      = FALSE;
+    option->compact        = FALSE;
     option->countDead      = FALSE;
     option->maxGrowth      = 20;
     option->groupcheck     = CUDD_GROUP_CHECK7;
@@ -786,6 +814,12 @@ ntrReadOptions(
 	} else if (STRING_EQUAL(argv[i],"-memhard")) {
 	    i++;
 	    option->maxMemHard = 1048576 * (int) atoi(argv[i]);
+	} else if (STRING_EQUAL(argv[i],"-release")) {
+	    i++;
+	    option->releaseFrac = (double) atof(argv[i]);
+	} else if (STRING_EQUAL(argv[i],"-spill")) {
+	    i++;
+	    option->spillFile = util_strsav(argv[i]);
 	} else if (STRING_EQUAL(argv[i],"-maxlive")) {
 	    i++;
 	    option->maxLive = (unsigned int) atoi(argv[i]);
@@ -805,6 +839,12 @@ ntrReadOptions(
 	    i++;
 	    option->ordering = PI_PS_GIVEN;
 	    option->orderPiPs = util_strsav(argv[i]);
+	} else if (STRING_EQUAL(argv[i],"-loadorder")) {
+	    i++;
+	    option->loadOrder = util_strsav(argv[i]);
+	} else if (STRING_EQUAL(argv[i],"-saveorder")) {
+	    i++;
+	    option->saveOrder = util_strsav(argv[i]);
 	} else if (STRING_EQUAL(argv[i],"-reordering")) {
 	    i++;
 	    if (STRING_EQUAL(argv[i],"none")) {
@@ -850,6 +890,8 @@ ntrReadOptions(
 		option->reordering = CUDD_REORDER_LINEAR_CONVERGE;
 	    } else if (STRING_EQUAL(argv[i],"exact")) {
 		option->reordering = CUDD_REORDER_EXACT;
+	    } else if (STRING_EQUAL(argv[i],"incremental")) {
+		option->reordering = CUDD_REORDER_SIFT_INCREMENTAL;
 	    } else {
 		goto usage;
 	    }
@@ -904,6 +946,8 @@ ntrReadOptions(
 		option->autoMethod = CUDD_REORDER_LINEAR_CONVERGE;
 	    } else if (STRING_EQUAL(argv[i],"exact")) {
 		option->autoMethod = CUDD_REORDER_EXACT;
+	    } else if (STRING_EQUAL(argv[i],"incremental")) {
+		option->autoMethod = CUDD_REORDER_SIFT_INCREMENTAL;
 	    } else {
 		goto usage;
 	    }
@@ -913,6 +957,18 @@ ntrReadOptions(
 	} else if (STRING_EQUAL(argv[i],"-first")) {
 	    i++;
 	    option->firstReorder = (int)atoi(argv[i]);
+	} else if (STRING_EQUAL(argv[i],"-adaptive")) {
+	    option->adaptive = TRUE;
+	} else if (STRING_EQUAL(argv[i],"-reordsummary")) {
+	    option->reordSummary = TRUE;
+	} else if (STRING_EQUAL(argv[i],"-membreakdown")) {
+	    option->memBreakdown = TRUE;
+	} else if (STRING_EQUAL(argv[i],"-keepcache")) {
+	    option->keepCache = TRUE;
+	} else if (STRING_EQUAL(argv[i],"-tightsift")) {
+	    option->tightSift = TRUE;
+	} else if (STRING_EQUAL(argv[i],"-compact")) {
+	    option->compact = TRUE;
 	} else if (STRING_EQUAL(argv[i],"-countdead")) {
 	    option->countDead = TRUE;
 	} else if (STRING_EQUAL(argv[i],"-growth")) {
@@ -1259,6 +1315,9 @@ freeOption(
     if (option->file1 != NULL) FREE(option->file1);
     if (option->file2 != NULL) FREE(option->file2);
     if (option->orderPiPs != NULL) FREE(option->orderPiPs);
+    if (option->loadOrder != NULL) FREE(option->loadOrder);
+    if (option->spillFile != NULL) FREE(option->spillFile);
+    if (option->saveOrder != NULL) FREE(option->saveOrder);
     if (option->treefile != NULL) FREE(option->treefile);
     if (option->sinkfile != NULL) FREE(option->sinkfile);
     if (option->dumpfile != NULL) FREE(option->dumpfile);
@@ -1294,12 +1353,25 @@ startCudd(
     if (option->maxMemHard != 0) {
 	Cudd_SetMaxMemory(dd,option->maxMemHard);
     }
+    (void) Cudd_SetMemoryReleaseThreshold(dd,option->releaseFrac);
+    if (option->spillFile != NULL && !Cudd_EnableSpill(dd,option->spillFile)) {
+	(void) fprintf(stderr,"Cannot use %s for the node blocks\n",
+		       option->spillFile);
+    }
     Cudd_SetMaxLive(dd,option->maxLive);
     Cudd_SetGroupcheck(dd,option->groupcheck);
     if (option->autoDyn & 1) {
 	Cudd_AutodynEnable(dd,option->autoMethod);
     }
     dd->nextDyn = option->firstReorder;
+    if (option->adaptive) {
+	Cudd_SetReorderingTrigger(dd,Cudd_AdaptiveReorderingTrigger,NULL);
+    }
+    Cudd_SetCachePreservation(dd,option->keepCache);
+    Cudd_SetTightSifting(dd,option->tightSift);
+    if (option->compact) {
+	Cudd_EnableCompaction(dd);
+    }
     dd->countDead = (option->countDead == FALSE) ? ~0 : 0;
     dd->maxGrowth = 1.0 + ((float) option->maxGrowth / 100.0);
     dd->recomb = option->recomb;
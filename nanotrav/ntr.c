@@ -208,6 +208,12 @@ Ntr_buildDDs(
     /* At this point the BDDs of all primary inputs and present state
     ** variables have been built. */
 
+    /* Start from a saved order if one matches. */
+    if (net2 == NULL && option->loadOrder != NULL) {
+	result = Bnet_LoadOrder(dd,net,option->loadOrder,pr);
+	if (result == 0) return(0);
+    }
+
     /* Currently noBuild doesn't do much. */
     if (option->noBuild == TRUE)
 	return(1);
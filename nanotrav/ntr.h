@@ -143,15 +143,25 @@ typedef	struct	NtrOptions {
     int		cacheSize;	/**< computed table initial size */
     size_t	 maxMemory;	/**< target maximum memory */
     size_t	 maxMemHard;	/**< maximum allowed memory */
+    double	releaseFrac;	/**< occupancy below which memory is freed */
+    char	*spillFile;	/**< file for the node blocks (or NULL) */
     unsigned int maxLive;	/**< maximum number of nodes */
     int		slots;		/**< unique subtable initial slots */
     int		ordering;	/**< FANIN DFS ... */
     char	*orderPiPs;	/**< file for externally provided order */
+    char	*loadOrder;	/**< variable-order database to start from */
+    char	*saveOrder;	/**< variable-order database to append to */
     Cudd_ReorderingType	reordering; /**< NONE RANDOM PIVOT SIFTING ... */
     int		autoDyn;	/**< ON OFF */
     Cudd_ReorderingType autoMethod; /**< RANDOM PIVOT SIFTING CONVERGE ... */
     char	*treefile;	/**< file name for variable tree */
     int		firstReorder;	/**< when to do first reordering */
+    int		adaptive;	/**< reorder only when it is likely to pay */
+    int		reordSummary;	/**< print reordering telemetry summary */
+    int		memBreakdown;	/**< print where the memory goes */
+    int		keepCache;	/**< preserve the cache across reordering */
+    int		tightSift;	/**< sift with tighter bounds, by benefit */
+    int		compact;	/**< compact the heap after reordering */
     int		countDead;	/**< count dead nodes toward triggering
 				     reordering */
     int		maxGrowth;	/**< maximum growth during reordering (%) */
@@ -109,6 +109,31 @@ util_cpu_time(void)
 
 }
 
+/**
+ * @brief returns a long which represents the elapsed real
+ * time in milliseconds since some constant reference.
+ */
+long
+util_wall_time(void)
+{
+#if HAVE_SYSCONF == 1
+
+    /* Code for POSIX systems */
+
+    struct tms buffer;
+    long nticks;                /* number of clock ticks per second */
+
+    nticks = sysconf(_SC_CLK_TCK);
+    return (long) (times(&buffer) * (1000.0/nticks));
+
+#elif defined(_WIN32)
+    return (long) GetTickCount();
+#else
+    return 0L;
+#endif
+
+}
+
 /**
  * @brief returns a long which represents the elapsed processor
  * time in milliseconds since some constant reference.  It includes
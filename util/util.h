@@ -213,6 +213,7 @@ extern void (*MMoutOfMemory) (size_t);
 
 extern long util_cpu_time(void);
 extern long util_cpu_ctime(void);
+extern long util_wall_time(void);
 extern char *util_path_search(char const *);
 extern char *util_file_search(char const *, char *, char const *);
 extern void util_print_cpu_stats(FILE *);